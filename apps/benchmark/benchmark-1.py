@@ -0,0 +1,262 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import sys
+import fnmatch
+
+import IECore
+
+import Gaffer
+
+class benchmark( Gaffer.Application ) :
+
+	def __init__( self ) :
+
+		Gaffer.Application.__init__( self )
+
+		self.parameters().addParameters(
+
+			[
+				IECore.StringVectorParameter(
+					name = "benchmarks",
+					description = "The names of the benchmarks to run, which may contain "
+						"wildcards. If unspecified then all benchmarks are run.",
+					defaultValue = IECore.StringVectorData( [] ),
+				),
+
+				IECore.IntParameter(
+					name = "repeats",
+					description = "The number of times to repeat each benchmark once the "
+						"cache has been warmed. The fastest repeat is reported.",
+					defaultValue = 3,
+					minValue = 0,
+				),
+
+				IECore.FileNameParameter(
+					name = "output",
+					description = "A file to write the results to, in JSON format. A file "
+						"written in this way may be used as a baseline for future runs.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.FileNameParameter(
+					name = "baseline",
+					description = "A file containing previous results to compare against. "
+						"If any benchmark has regressed by more than the tolerance, the "
+						"application returns a failure status.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+					check = IECore.FileNameParameter.CheckType.MustExist,
+				),
+
+				IECore.FloatParameter(
+					name = "tolerance",
+					description = "The fractional increase over the baseline which is "
+						"tolerated before a measurement is considered to have regressed.",
+					defaultValue = 0.1,
+					minValue = 0,
+				),
+
+				IECore.IntVectorParameter(
+					name = "threads",
+					description = "The numbers of threads to run the benchmarks with. "
+						"Each count is run in a separate process, and the count is "
+						"appended to the names of the results. If unspecified, the "
+						"benchmarks are run once using all available cores.",
+					defaultValue = IECore.IntVectorData( [] ),
+				),
+
+				IECore.IntVectorParameter(
+					name = "resolutions",
+					description = "The resolutions at which to run the image benchmarks. "
+						"Each specifies the width and height of a square image.",
+					defaultValue = IECore.IntVectorData( [ 512, 1024, 2048 ] ),
+				),
+
+				IECore.BoolParameter(
+					name = "list",
+					description = "Lists the available benchmarks without running them.",
+					defaultValue = False,
+				),
+			]
+
+		)
+
+		self.parameters().userData()["parser"] = IECore.CompoundObject(
+			{
+				"flagless" : IECore.StringVectorData( [ "benchmarks" ] )
+			}
+		)
+
+	def _run( self, args ) :
+
+		import json
+		import GafferTest
+
+		if len( args["threads"] ) > 1 :
+			# TBB can only be limited to a particular number of threads once
+			# per process, so we launch a separate process for each count.
+			results = self.__runThreadCounts( args )
+		else :
+			if len( args["threads"] ) :
+				GafferTest.setNumThreads( args["threads"][0] )
+			results = self.__runBenchmarks( args )
+
+		if results is None :
+			return 1
+
+		if args["output"].value :
+			f = open( args["output"].value, "w" )
+			json.dump( results, f, indent = 4, sort_keys = True )
+			f.close()
+		elif not args["list"].value :
+			json.dump( results, sys.stdout, indent = 4, sort_keys = True )
+			sys.stdout.write( "\n" )
+
+		if args["baseline"].value :
+			f = open( args["baseline"].value )
+			baseline = json.load( f )
+			f.close()
+			regressions = GafferTest.Benchmark.compare( results, baseline, args["tolerance"].value )
+			for r in regressions :
+				IECore.msg( IECore.Msg.Level.Error, "gaffer benchmark", r )
+			if regressions :
+				return 1
+
+		return 0 if not self.__failures else 1
+
+	def __runBenchmarks( self, args ) :
+
+		import GafferTest
+		import GafferSceneTest
+		import GafferImageTest
+		import GafferUITest
+
+		self.__failures = []
+
+		benchmarks = []
+		candidates = GafferTest.CoreBenchmarks.benchmarks()
+		candidates += GafferSceneTest.SceneBenchmarks.benchmarks()
+		candidates += GafferImageTest.ImageBenchmarks.benchmarks( args["resolutions"] )
+		candidates += GafferUITest.UIBenchmarks.benchmarks()
+		for b in candidates :
+			if not len( args["benchmarks"] ) or True in [ fnmatch.fnmatch( b.name(), p ) for p in args["benchmarks"] ] :
+				benchmarks.append( b )
+
+		if args["list"].value :
+			for b in benchmarks :
+				print b.name()
+			return {}
+
+		if not benchmarks :
+			IECore.msg( IECore.Msg.Level.Error, "gaffer benchmark", "No benchmarks match \"%s\"" % " ".join( args["benchmarks"] ) )
+			return None
+
+		suffix = ".threads%d" % args["threads"][0] if len( args["threads"] ) else ""
+
+		# progress goes to stderr, so that stdout contains
+		# only the results when no output file is specified.
+		results = {}
+		for b in benchmarks :
+
+			name = b.name() + suffix
+			sys.stderr.write( "%s : " % name )
+
+			try :
+				result = b.execute( args["repeats"].value )
+			except Exception, e :
+				# we don't want one broken benchmark (an OpenColorIO
+				# benchmark without a config, for instance) to prevent
+				# the others from running.
+				sys.stderr.write( "failed\n" )
+				IECore.msg( IECore.Msg.Level.Error, "gaffer benchmark", "%s : %s" % ( name, e ) )
+				self.__failures.append( name )
+				continue
+
+			results[name] = result
+			sys.stderr.write(
+				", ".join(
+					[ "%s %.3fs" % ( r, result[r]["seconds"] ) for r in ( "cold", "warm" ) if r in result ]
+				) + "\n"
+			)
+
+		return results
+
+	def __runThreadCounts( self, args ) :
+
+		import json
+		import shutil
+		import tempfile
+		import subprocess
+
+		self.__failures = []
+
+		results = {}
+		directory = tempfile.mkdtemp( prefix = "gafferBenchmark" )
+		try :
+
+			for threads in args["threads"] :
+
+				outputFileName = os.path.join( directory, "threads%d.json" % threads )
+				command = [ "gaffer", "benchmark" ]
+				if len( args["benchmarks"] ) :
+					command += [ "-benchmarks" ] + list( args["benchmarks"] )
+				command += [
+					"-repeats", str( args["repeats"].value ),
+					"-resolutions" ] + [ str( r ) for r in args["resolutions"] ] + [
+					"-threads", str( threads ),
+					"-output", outputFileName,
+				]
+
+				if subprocess.call( command ) != 0 :
+					self.__failures.append( "threads%d" % threads )
+
+				if os.path.exists( outputFileName ) :
+					f = open( outputFileName )
+					results.update( json.load( f ) )
+					f.close()
+
+		finally :
+			shutil.rmtree( directory, ignore_errors = True )
+
+		return results
+
+IECore.registerRunTimeTyped( benchmark )
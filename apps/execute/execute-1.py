@@ -60,8 +60,10 @@ class execute( Gaffer.Application ) :
 				
 				IECore.StringVectorParameter(
 					name = "nodes",
-					description = "The names of the nodes to execute. If not specified "
-						"then all executable nodes will be found automatically.",
+					description = "The names of the nodes to execute. Nodes within Boxes "
+						"may be specified using their path relative to the script, for instance "
+						"\"Box.Writer\". If not specified then all executable nodes will be "
+						"found automatically.",
 					defaultValue = IECore.StringVectorData( [] ),
 				),
 				
@@ -72,6 +74,15 @@ class execute( Gaffer.Application ) :
 					allowEmptyList = False,
 				),
 				
+				IECore.StringVectorParameter(
+					name = "context",
+					description = "Context variables to be set for the execution, each "
+						"specified as \"name=value\". Values are set as strings, and take "
+						"precedence over the variables of the script itself, including "
+						"\"script:name\".",
+					defaultValue = IECore.StringVectorData( [] ),
+				),
+				
 			]
 			
 		)
@@ -92,7 +103,7 @@ class execute( Gaffer.Application ) :
 		nodes = []
 		if len( args["nodes"] ) :
 			for nodeName in args["nodes"] :
-				node = scriptNode.getChild( nodeName )
+				node = scriptNode.descendant( nodeName )
 				if node is None :
 					IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Node \"%s\" does not exist" % nodeName )
 					return 1
@@ -109,6 +120,13 @@ class execute( Gaffer.Application ) :
 				return 1
 		
 		context = Gaffer.Context( scriptNode.context() )
+		for variable in args["context"] :
+			name, equals, value = variable.partition( "=" )
+			if not name or not equals :
+				IECore.msg( IECore.Msg.Level.Error, "gaffer execute", "Context variable \"%s\" is not of the form name=value" % variable )
+				return 1
+			context[name] = value
+		
 		for frame in self.parameters()["frames"].getFrameListValue().asList() :
 			context.setFrame( frame )
 			for node in nodes :
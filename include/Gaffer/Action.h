@@ -78,6 +78,8 @@ class Action : public IECore::RunTimeTyped
 
 		/// Enacts the specified action by calling doAction() and
 		/// adding it to the undo queue in the appropriate ScriptNode.
+		/// Any running BackgroundTasks are cancelled and waited for
+		/// before the action is done.
 		static void enact( ActionPtr action );
 		/// Convenience function to enact a simple action without
 		/// needing to create a new Action subclass. The callables
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_BACKGROUNDTASK_H
+#define GAFFER_BACKGROUNDTASK_H
+
+#include "boost/function.hpp"
+#include "boost/thread.hpp"
+
+#include "tbb/atomic.h"
+
+#include "IECore/RefCounted.h"
+
+#include "Gaffer/Canceller.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( BackgroundTask )
+
+/// Runs a function on a separate thread, so that lengthy computations
+/// don't block the calling thread. This is primarily of use in the ui,
+/// where the results of computations are displayed - see
+/// GafferUI.BackgroundCompute for a convenient means of computing plug
+/// values and receiving the results on the ui thread. The function is
+/// passed a Canceller which it should set on the Context used for its
+/// computations, so that they may be abandoned when cancel() is called.
+///
+/// Plugs may not be edited while a computation is reading them, so all
+/// graph edits made via Action::enact(), ScriptNode::undo() and
+/// ScriptNode::redo() first cancel any running tasks and wait for them
+/// to finish. It is the responsibility of the client to restart a task
+/// if it is still required - GafferUI.BackgroundCompute does this
+/// automatically.
+class BackgroundTask : public IECore::RefCounted
+{
+
+	public :
+
+		typedef boost::function<void ( const Canceller &canceller )> Function;
+
+		/// Starts running the function immediately. Any Cancelled exception
+		/// thrown by the function is ignored, and any other exception is
+		/// reported via IECore::msg().
+		BackgroundTask( const Function &function );
+		/// Cancels the task and waits for it to finish.
+		virtual ~BackgroundTask();
+
+		IE_CORE_DECLAREMEMBERPTR( BackgroundTask );
+
+		/// Requests cancellation and returns immediately.
+		void cancel();
+		/// Waits for the function to return. This is virtual so that derived
+		/// classes may release any locks the function needs in order to finish -
+		/// the python bindings release the GIL for instance.
+		virtual void wait();
+		void cancelAndWait();
+		/// Returns true if the function has returned.
+		bool done() const;
+
+		/// Cancels all running tasks and waits for them to finish. Because tasks
+		/// may read from anywhere in the graph via connections between plugs, no
+		/// attempt is made to determine which tasks are affected by a particular
+		/// edit. Tasks running on the calling thread are skipped, as they can't be
+		/// waited for. It is assumed that graph edits and the destruction of tasks
+		/// both take place on the same (ui) thread.
+		static void cancelAndWaitForAll();
+
+	private :
+
+		void run();
+
+		Function m_function;
+		CancellerPtr m_canceller;
+		tbb::atomic<bool> m_done;
+		boost::thread m_thread;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_BACKGROUNDTASK_H
@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_CANCELLER_H
+#define GAFFER_CANCELLER_H
+
+#include "tbb/atomic.h"
+
+#include "IECore/RefCounted.h"
+#include "IECore/Exception.h"
+
+namespace Gaffer
+{
+
+/// The Canceller class is used to request the cancellation of a
+/// computation in progress. A Canceller is associated with a computation
+/// by setting it on the Context in which the computation is performed,
+/// and long running computations should call Canceller::check() at regular
+/// intervals. This typically means once per iteration of any loop
+/// which may be lengthy - for instance once per tile when processing an
+/// image or once per location when traversing a scene. Cancellers are
+/// reference counted, so that a Context may keep its Canceller alive
+/// for as long as the Context itself is alive.
+class Canceller : public IECore::RefCounted
+{
+
+	public :
+
+		Canceller();
+
+		IE_CORE_DECLAREMEMBERPTR( Canceller );
+
+		/// Requests cancellation. This may be called from any thread.
+		void cancel();
+		bool cancelled() const;
+
+		/// Throws Cancelled if canceller is non-null and has been cancelled.
+		static void check( const Canceller *canceller );
+
+	private :
+
+		tbb::atomic<bool> m_cancelled;
+
+};
+
+IE_CORE_DECLAREPTR( Canceller );
+
+/// The exception thrown by Canceller::check().
+class Cancelled : public IECore::Exception
+{
+
+	public :
+
+		Cancelled();
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_CANCELLER_H
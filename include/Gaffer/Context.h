@@ -42,6 +42,8 @@
 
 #include "boost/signals.hpp"
 
+#include "Gaffer/Canceller.h"
+
 namespace Gaffer
 {
 
@@ -94,6 +96,16 @@ class Context : public IECore::RefCounted
 		/// A signal emitted when an element of the context is changed.
 		ChangedSignal &changedSignal();
 		
+		/// Sets a Canceller which computations performed in this context
+		/// should check periodically, so that they may be cancelled while in
+		/// progress. The context holds a reference to the canceller, as do any
+		/// copies of the context, which inherit it. The canceller does not
+		/// contribute to hash() or the comparison operators, because it doesn't
+		/// affect the results of computations.
+		void setCanceller( ConstCancellerPtr canceller );
+		/// Returns the Canceller for this context, which may be 0.
+		const Canceller *canceller() const;
+		
 		IECore::MurmurHash hash() const;
 		
 		bool operator == ( const Context &other ) const;
@@ -105,7 +117,13 @@ class Context : public IECore::RefCounted
 		/// an abstract base class for dictionary-style access to things
 		/// then we could have a separate substitute() function capable
 		/// of accepting Contexts, CompoundData, CompoundObjects etc.
+		/// Parsed substitutions are cached, so repeated calls with the same input
+		/// are cheap, even across different contexts.
 		std::string substitute( const std::string &input ) const;
+		/// Returns a hash uniquely identifying the result of substitute( input ),
+		/// without performing the substitution. Only the values of the variables
+		/// referenced by input contribute to the hash.
+		IECore::MurmurHash substitutionHash( const std::string &input ) const;
 		
 		/// The Scope class is used to push and pop the current context on
 		/// the calling thread.
@@ -127,9 +145,11 @@ class Context : public IECore::RefCounted
 	private :
 
 		void substituteInternal( const std::string &s, std::string &result, const int recursionDepth ) const;
+		void substitutionHashInternal( const std::string &s, IECore::MurmurHash &h, bool &empty, const int recursionDepth ) const;
 	
 		IECore::CompoundDataPtr m_data;
 		ChangedSignal *m_changedSignal;
+		ConstCancellerPtr m_canceller;
 
 };
 
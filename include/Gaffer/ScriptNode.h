@@ -196,6 +196,9 @@ class ScriptNode : public Node
 		/// serialised nodes to those contained in the set.
 		virtual std::string serialise( const Node *parent = 0, const Set *filter = 0 ) const;
 		/// Calls serialise() and saves the result into the specified file.
+		/// If the file has a ".gfb" extension, a compact binary serialisation
+		/// is written instead, which can be loaded considerably faster than
+		/// the equivalent python.
 		virtual void serialiseToFile( const std::string &fileName, const Node *parent = 0, const Set *filter = 0 ) const;
 		/// Returns the plug which specifies the file used in all load and save
 		/// operations.
@@ -205,7 +208,9 @@ class ScriptNode : public Node
 		/// made since the last call to save().
 		BoolPlug *unsavedChangesPlug();
 		const BoolPlug *unsavedChangesPlug() const;
-		/// Loads the script specified in the filename plug.
+		/// Loads the script specified in the filename plug. Both python
+		/// (".gfr") and binary (".gfb") scripts are supported. Loading a binary
+		/// script emits scriptExecutedSignal() with an empty script string.
 		virtual void load();
 		/// Saves the script to the file specified by the filename plug.
 		virtual void save() const;
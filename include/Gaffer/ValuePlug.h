@@ -98,6 +98,42 @@ class ValuePlug : public Plug
 		static size_t getCacheMemoryLimit();
 		/// Sets the maximum amount of memory the cache may use in bytes.
 		static void setCacheMemoryLimit( size_t bytes );
+		/// Returns the amount of memory in bytes currently used by the cache.
+		static size_t cacheMemoryUsage();
+		/// Removes all values from the cache.
+		static void clearCache();
+		/// Registers a value which is held for the lifetime of the process
+		/// by some other registry, such as the uniform tiles shared by all
+		/// image nodes in GafferImage. Evicting such a value from the cache
+		/// would free no memory, so the cache doesn't charge for storing it.
+		static void registerPermanentValue( IECore::ConstObjectPtr value );
+		//@}
+		
+		/// @name Statistics
+		/// Counters describing the work performed in computing plug values,
+		/// accumulated across all threads. These are intended for use in
+		/// benchmarks and for diagnosing performance problems.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		struct Statistics
+		{
+			Statistics();
+			/// The number of calls made to ComputeNode::hash().
+			size_t hashCount;
+			/// The number of calls made to ComputeNode::compute().
+			size_t computeCount;
+			/// The number of values retrieved from the cache rather
+			/// than being computed.
+			size_t cacheHitCount;
+		};
+		/// Returns the statistics accumulated since the last call
+		/// to resetStatistics(). The counters are kept per thread, so
+		/// that counting doesn't introduce contention, and the results
+		/// are only exact when no computations are in progress.
+		static Statistics statistics();
+		/// Resets the statistics. This must not be called while
+		/// computations are in progress.
+		static void resetStatistics();
 		//@}
 
 	protected :
@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERBINDINGS_BINARYSERIALISATION_H
+#define GAFFERBINDINGS_BINARYSERIALISATION_H
+
+#include "IECore/CompoundObject.h"
+
+#include "Gaffer/Set.h"
+#include "Gaffer/GraphComponent.h"
+
+namespace GafferBindings
+{
+
+/// The BinarySerialisation class provides an alternative to the python Serialisation
+/// for saving and loading scripts. Rather than generating a python statement per plug,
+/// the node hierarchy, plug values and connections are stored in a compact binary form
+/// which can be reloaded without executing python for anything other than the construction
+/// of the nodes and dynamic plugs themselves. Serialisers which customise the postConstructor(),
+/// postHierarchy() or postScript() steps continue to work, because their output is stored
+/// verbatim and executed at the appropriate point during loading.
+class BinarySerialisation
+{
+
+	public :
+
+		BinarySerialisation( const Gaffer::GraphComponent *parent, const Gaffer::Set *filter = 0 );
+
+		/// Returns the result of the serialisation.
+		IECore::ConstCompoundObjectPtr result() const;
+		/// Writes the result to the specified file.
+		void save( const std::string &fileName ) const;
+
+		/// Recreates the serialised children under the specified parent. The executionDict
+		/// is used for the evaluation of constructors and any python steps provided by custom
+		/// Serialisers - it should contain the same "parent" and "script" variables that would
+		/// be provided for the execution of a python serialisation.
+		static void load( const IECore::CompoundObject *serialisation, Gaffer::GraphComponent *parent, boost::python::object &executionDict );
+		/// Reads a serialisation previously written with save().
+		static IECore::ConstCompoundObjectPtr read( const std::string &fileName );
+
+		/// Returns true if the filename has the extension used for binary
+		/// scripts, and should therefore be saved and loaded using this class
+		/// rather than the python Serialisation.
+		static bool isBinaryFileName( const std::string &fileName );
+		/// The extension used for binary scripts (".gfb").
+		static const std::string &fileExtension();
+
+	private :
+
+		class Writer;
+		class Loader;
+
+		IECore::CompoundObjectPtr m_result;
+
+};
+
+} // namespace GafferBindings
+
+#endif // GAFFERBINDINGS_BINARYSERIALISATION_H
@@ -113,6 +113,12 @@ class Serialisation
 	
 	private :	
 		
+		friend class BinarySerialisation;
+		
+		// Used by the BinarySerialisation to provide identifiers to Serialisers
+		// without also generating a python serialisation of the whole hierarchy.
+		Serialisation( const Gaffer::GraphComponent *parent, const std::string &parentName, const Gaffer::Set *filter, bool walk );
+		
 		const Gaffer::GraphComponent *m_parent;
 		const std::string m_parentName;
 		const Gaffer::Set *m_filter;
@@ -123,6 +129,7 @@ class Serialisation
 		
 		std::set<std::string> m_modules;
 		
+		void serialiseChildren();
 		void walk( const Gaffer::GraphComponent *parent, const std::string &parentIdentifier );
 		
 		typedef std::map<IECore::TypeId, SerialiserPtr> SerialiserMap;
@@ -54,6 +54,16 @@ class ValuePlugSerialiser : public PlugSerialiser
 		virtual void moduleDependencies( const Gaffer::GraphComponent *graphComponent, std::set<std::string> &modules ) const;
 		virtual std::string constructor( const Gaffer::GraphComponent *graphComponent ) const;
 		virtual std::string postConstructor( const Gaffer::GraphComponent *graphComponent, const std::string &identifier, const Serialisation &serialisation ) const;
+		
+		/// Returns true if postConstructor() does nothing more than the implementation
+		/// above - output a setValue() call when valueNeedsSerialisation() is true. The
+		/// BinarySerialisation uses this to store such values natively without first
+		/// serialising them as python. Derived classes which reimplement postConstructor()
+		/// must reimplement this to return false.
+		virtual bool postConstructorSetsValueOnly() const;
+		/// Returns true if the plug is a serialisable leaf input, without an input
+		/// from elsewhere in the serialisation, so that its value must be serialised.
+		static bool valueNeedsSerialisation( const Gaffer::Plug *plug, const Serialisation &serialisation );
 
 };
 
@@ -81,7 +81,8 @@ class ChannelDataProcessor : public ImageProcessor
 		virtual Imath::Box2i computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const;
 		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
 
-		/// Implemented to initialize the output tile and then call processChannelData() 
+		/// Implemented to initialize the output tile and then call processChannelData(), or to
+		/// call processUniformChannelData() when the input tile is an ImagePlug::uniformTile().
 		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
 
 		/// Should be implemented by derived classes to processes each channel's data.
@@ -92,6 +93,12 @@ class ChannelDataProcessor : public ImageProcessor
 		/// @param outData The tile where the result of the operation should be written. It is initialized with the coresponding tile data from inPlug() which should be used as the input data.
 		virtual void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, IECore::FloatVectorDataPtr outData ) const = 0;
 
+		/// May be implemented by derived classes to process an input tile in which every pixel has
+		/// the same value. Implementations should replace value with the processed value and return
+		/// true, in which case the output is a uniform tile and processChannelData() is not called.
+		/// The default implementation returns false.
+		virtual bool processUniformChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, float &value ) const;
+
 	private :
 		
 		static size_t g_firstPlugIndex;
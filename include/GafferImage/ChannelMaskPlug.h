@@ -37,6 +37,8 @@
 #ifndef GAFFERIMAGE_CHANNELMASKPLUG_H
 #define GAFFERIMAGE_CHANNELMASKPLUG_H
 
+#include "IECore/VectorTypedData.h"
+
 #include "GafferImage/TypeIds.h"
 #include "Gaffer/TypedObjectPlug.h"
 
@@ -61,11 +63,36 @@ class ChannelMaskPlug : public Gaffer::StringVectorDataPlug
 		/// Performs an in-place intersection of inChannels and the channels held within the StringVectorDataPlug.
 		void maskChannels( std::vector<std::string> &inChannels ) const;
 
+		/// Returns a bitset, indexed by channelId(), in which the bits are set for the channels
+		/// of inChannels which are also held within the StringVectorDataPlug. Results are cached,
+		/// so repeated calls with the same channels cost little more than the hashing of the two
+		/// channel lists, and the result can be queried using channelEnabled(). This makes it
+		/// suitable for use in per-tile computations.
+		IECore::ConstBoolVectorDataPtr channelMask( const IECore::StringVectorData *inChannels ) const;
+		/// As above, but taking the input channels from a plug. The cache is keyed on the hashes
+		/// of the plugs, so their values are only evaluated when the mask isn't cached already.
+		/// This is the preferred form for use in per-tile computations.
+		IECore::ConstBoolVectorDataPtr channelMask( const Gaffer::StringVectorDataPlug *inChannelsPlug ) const;
+		/// Returns true if the channel is enabled in a mask returned by channelMask().
+		static bool channelEnabled( const IECore::BoolVectorData *channelMask, const std::string &channel );
+		
+		/// Returns a small integer uniquely identifying the named channel. Ids are allocated
+		/// on first use and remain valid for the lifetime of the process. This function
+		/// is thread safe.
+		static size_t channelId( const std::string &channel );
+
 		/// Returns the index of a channel within it's layer.
-		static int channelIndex( std::string channel );
+		static int channelIndex( const std::string &channel );
 
 		/// Removes channels that have the same channelIndex as another so that the list only contains channels with a unique index.
 		static void removeDuplicateIndices( std::vector<std::string> &inChannels );
+		
+	private :
+	
+		IECore::ConstBoolVectorDataPtr computeChannelMask( const IECore::StringVectorData *inChannels ) const;
+		static IECore::ConstBoolVectorDataPtr findChannelMask( const IECore::MurmurHash &key );
+		static IECore::ConstBoolVectorDataPtr storeChannelMask( const IECore::MurmurHash &key, IECore::ConstBoolVectorDataPtr channelMask );
+		
 };
 
 IE_CORE_DECLAREPTR( ChannelMaskPlug );
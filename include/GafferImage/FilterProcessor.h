@@ -81,6 +81,8 @@ class FilterProcessor : public ImageProcessor
 		/// Reimplemented to hash the input plugs. We only hash those that are connected so that nodes which don't require a minimum number to
 		/// be connected such as the "Merge" node only have to overide enabled() (which requires ALL inputs to be connected by default).
 		/// This therefore caters for both nodes which require all inputs to be connected and nodes that do not (providing they overload enabled()).
+		/// The channel data of inputs whose data window doesn't intersect the tile is hashed as ImagePlug::blackTile(),
+		/// without querying the input, so derived classes may skip fetching such tiles in their computeChannelData().
 		virtual void hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual void hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
@@ -107,9 +107,25 @@ class Format
 		static void setDefaultFormat( Gaffer::ScriptNode *scriptNode, const std::string &name );
 		static const Format getDefaultFormat( Gaffer::ScriptNode *scriptNode );
 		
-		/// Accessors and creators for the format list.
+		/// Accessors and creators for the format list. All are safe to call
+		/// concurrently from multiple threads, but registerFormat() emits
+		/// formatAddedSignal() directly, so should only be called from the
+		/// main thread. The returned reference remains valid until the format
+		/// is removed. Registered formats are never replaced, because other
+		/// threads may be holding references to them - if the name is already
+		/// used by a different format, a warning is issued and the existing
+		/// format is returned.
 		static const Format &registerFormat( const Format &format, const std::string &name );
 		static const Format &registerFormat( const Format &format );
+		/// Registers a format from within a computation, which may be running on any thread.
+		/// The format list is updated immediately, but no signal is emitted - instead the
+		/// notification is queued until emitPendingSignals() is called. It is the
+		/// responsibility of the ui to call emitPendingSignals() periodically on the
+		/// main thread.
+		static const Format &registerFormatDeferred( const Format &format );
+		/// Emits formatAddedSignal() for each notification queued by
+		/// registerFormatDeferred(). Must be called on the main thread.
+		static void emitPendingSignals();
 		
 		static void removeFormat( const Format &format );
 		static void removeFormat( const std::string &name );
@@ -136,9 +152,14 @@ class Format
 		typedef std::pair< std::string, Format > FormatEntry;
 		typedef std::map< std::string, Format > FormatMap;
 		
-		/// Method to return a static instance of the format mappings
+		/// Method to return a static instance of the format mappings. Access
+		/// must be protected by the lock in Format.cpp.
 		inline static FormatMap &formatMap();
 		
+		/// Inserts the format if it isn't already registered, returning the registered
+		/// format and whether or not it was inserted. Thread safe.
+		static const Format &insertFormat( const Format &format, const std::string &name, bool &inserted );
+		
 		/// Generates a name for a given format. The result is returned in place.
 		static void generateFormatName( std::string &name, const Format &format);
 		
@@ -93,6 +93,7 @@ class Grade : public ChannelDataProcessor
 		
 		virtual void hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		void processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channelIndex, IECore::FloatVectorDataPtr outData ) const;
+		virtual bool processUniformChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, float &value ) const;
 
 	private :
 		
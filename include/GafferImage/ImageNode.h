@@ -69,6 +69,26 @@ class ImageNode : public Gaffer::ComputeNode
 		
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 		
+		/// @name Half precision tile storage
+		/// By default computed tiles are stored as FloatVectorData in the
+		/// generic ValuePlug cache. When the GAFFERIMAGE_HALFTILES environment
+		/// variable is set to 1 at startup, ImageNodes instead store their channel
+		/// data in a dedicated cache as half precision HalfVectorData, converting
+		/// back to float when a tile is fetched. This halves the memory and
+		/// memory bandwidth used by cached tiles, and loses nothing when working
+		/// with half float images. The most recently used tiles are also kept at
+		/// full precision in a smaller cache, so that tiles fetched repeatedly
+		/// aren't converted every time. The memory limit and usage below include
+		/// both caches, with a quarter of the limit given to the smaller one.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		static bool halfTileStorage();
+		static size_t getHalfTileCacheMemoryLimit();
+		static void setHalfTileCacheMemoryLimit( size_t bytes );
+		/// Returns the memory currently used by the tiles in the cache.
+		static size_t halfTileCacheMemoryUsage();
+		//@}
+		
 	protected :
 		
 		/// The enabled() and channelEnabled( channel ) methods provide a means to disable the node
@@ -105,6 +125,12 @@ class ImageNode : public Gaffer::ComputeNode
 		
 		void computeImagePlugs( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
 		
+		/// Returns true if the results of computeChannelData() should be stored in the
+		/// half precision tile cache. The default implementation returns halfTileStorage(),
+		/// but derived classes which already cache their output efficiently may reimplement
+		/// it to return false.
+		virtual bool useHalfTileCache() const;
+		
 		/// Implemented to initialize the default format settings if they don't exist already.
 		void parentChanging( Gaffer::GraphComponent *newParent );
 		
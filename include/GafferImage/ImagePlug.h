@@ -123,11 +123,37 @@ class ImagePlug : public Gaffer::CompoundPlug
 		IECore::MurmurHash imageHash() const;
 		//@}
 		
-		static int tileSize() { return 64; };
+		/// Returns the width and height of the tiles into which all images are
+		/// divided. This is fixed for the lifetime of the process, and may be
+		/// chosen at startup by setting the GAFFERIMAGE_TILESIZE environment
+		/// variable to one of 64 (the default), 128 or 256. Performance critical
+		/// loops may therefore switch on tileSize() to call a version of their
+		/// inner loop templated on the tile size.
+		static int tileSize() { return g_tileSize; };
 		static Imath::Box2i tileBound( const Imath::V2i &tileOrigin ) { return Imath::Box2i( tileOrigin * tileSize(), ( tileOrigin + Imath::V2i( 1 ) ) * tileSize() - Imath::V2i( 1 ) ); }
 		static const IECore::FloatVectorData *blackTile();
 		static const IECore::FloatVectorData *whiteTile();
 		
+		/// @name Uniform tiles
+		/// Many tiles contain the same value in every pixel - black tiles
+		/// outside the objects in a CG element being the most common example.
+		/// Nodes may return a tile from uniformTile() for these, and because
+		/// such tiles are shared between all nodes they cost almost nothing in
+		/// the cache. Nodes may then use isUniformTile() to cheaply identify
+		/// uniform inputs and compute their output from the single value
+		/// rather than by processing every pixel.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns a tile with every pixel set to value. blackTile() and
+		/// whiteTile() are themselves uniform tiles.
+		static IECore::ConstFloatVectorDataPtr uniformTile( float value );
+		/// Returns true if tile was returned by uniformTile(), setting value
+		/// to the value of its pixels. This is a constant time operation -
+		/// tiles which happen to contain a single value but which were not
+		/// created by uniformTile() are not identified.
+		static bool isUniformTile( const IECore::FloatVectorData *tile, float &value );
+		//@}
+		
 		/// Returns the origin of the tile that contains the point.
 		inline static Imath::V2i tileOrigin( const Imath::V2i &point )
 		{
@@ -140,6 +166,8 @@ class ImagePlug : public Gaffer::CompoundPlug
 	private :
 		
 		static size_t g_firstPlugIndex;
+		static const int g_tileSize;
+
 };
 
 IE_CORE_DECLAREPTR( ImagePlug );
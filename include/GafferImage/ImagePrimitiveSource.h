@@ -86,6 +86,17 @@ class ImagePrimitiveSource : public BaseType
 		Gaffer::ObjectPlug *inputImagePrimitivePlug();
 		const Gaffer::ObjectPlug *inputImagePrimitivePlug() const;
 		
+		/// The image primitive is converted into this tiled representation
+		/// once, and the outPlug() computations are then simple lookups
+		/// into it. It holds a CompoundObject containing the format, data
+		/// window and channel names of the image along with an ObjectVector
+		/// of tiles for each channel.
+		Gaffer::ObjectPlug *tilesPlug();
+		const Gaffer::ObjectPlug *tilesPlug() const;
+		
+		IECore::ConstCompoundObjectPtr tiles() const;
+		IECore::ConstObjectPtr computeTiles( const IECore::ImagePrimitive *image ) const;
+		
 };
 
 typedef ImagePrimitiveSource<ImageNode> ImagePrimitiveNode;
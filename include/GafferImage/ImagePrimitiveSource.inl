@@ -38,6 +38,8 @@
 #include "IECore/BoxOps.h"
 #include "IECore/BoxAlgo.h"
 #include "IECore/NullObject.h"
+#include "IECore/CompoundObject.h"
+#include "IECore/ObjectVector.h"
 
 #include "GafferImage/ImagePrimitiveSource.h"
 
@@ -54,6 +56,7 @@ ImagePrimitiveSource<BaseType>::ImagePrimitiveSource( const std::string &name )
 	BaseType::addChild( new Gaffer::ObjectPlug( "__imagePrimitive", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
 	BaseType::addChild( new Gaffer::ObjectPlug( "__inputImagePrimitive", Gaffer::Plug::In, IECore::NullObject::defaultNullObject(), Gaffer::Plug::Default & ~Gaffer::Plug::Serialisable ) );
 	inputImagePrimitivePlug()->setInput( imagePrimitivePlug() );
+	BaseType::addChild( new Gaffer::ObjectPlug( "__tiles", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
 
 	// disable caching on our outputs, as we're basically caching the entire
 	// image ourselves in __inputImagePrimitive.
@@ -75,6 +78,7 @@ void ImagePrimitiveSource<BaseType>::affects( const Gaffer::Plug *input, Gaffer:
 	
 	if( input == inputImagePrimitivePlug() )
 	{
+		outputs.push_back( tilesPlug() );
 		for( Gaffer::ValuePlugIterator it( BaseType::outPlug() ); it != it.end(); it++ )
 		{
 			outputs.push_back( it->get() );
@@ -91,6 +95,11 @@ void ImagePrimitiveSource<BaseType>::hash( const Gaffer::ValuePlug *output, cons
 	{
 		hashImagePrimitive( context, h );
 	}
+	else if( output == tilesPlug() )
+	{
+		inputImagePrimitivePlug()->hash( h );
+		h.append( ImagePlug::tileSize() );
+	}
 }
 
 template<typename BaseType>
@@ -141,6 +150,24 @@ const Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::inputImagePrimitivePlu
 	return BaseType::template getChild<Gaffer::ObjectPlug>( "__inputImagePrimitive" );
 }
 		
+template<typename BaseType>
+Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::tilesPlug()
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__tiles" );
+}
+
+template<typename BaseType>
+const Gaffer::ObjectPlug *ImagePrimitiveSource<BaseType>::tilesPlug() const
+{
+	return BaseType::template getChild<Gaffer::ObjectPlug>( "__tiles" );
+}
+
+template<typename BaseType>
+IECore::ConstCompoundObjectPtr ImagePrimitiveSource<BaseType>::tiles() const
+{
+	return IECore::runTimeCast<const IECore::CompoundObject>( tilesPlug()->getValue() );
+}
+
 template<typename BaseType>
 void ImagePrimitiveSource<BaseType>::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
 {
@@ -151,19 +178,118 @@ void ImagePrimitiveSource<BaseType>::compute( Gaffer::ValuePlug *output, const G
 		plug->setValue( image ? image : plug->defaultValue() );
 		return;
 	}
+	else if( output == tilesPlug() )
+	{
+		IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
+		Gaffer::ObjectPlug *plug = static_cast<Gaffer::ObjectPlug *>( output );
+		plug->setValue( image ? computeTiles( image.get() ) : plug->defaultValue() );
+		return;
+	}
 	
 	return BaseType::compute( output, context );
 }
 
+template<typename BaseType>
+IECore::ConstObjectPtr ImagePrimitiveSource<BaseType>::computeTiles( const IECore::ImagePrimitive *image ) const
+{
+	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
+	
+	// convert the data window into the y-up space of GafferImage.
+	const Imath::Box2i displayWindow = image->getDisplayWindow();
+	const Imath::Box2i imageDataWindow = image->getDataWindow();
+	Imath::Box2i dataWindow = imageDataWindow;
+	const int yOffset = displayWindow.min.y + ( displayWindow.size().y + 1 ) - dataWindow.min.y;
+	dataWindow.min.y = yOffset - ( dataWindow.size().y + 1 );
+	dataWindow.max.y = yOffset - 1;
+	
+	IECore::StringVectorDataPtr channelNamesData = new IECore::StringVectorData;
+	image->channelNames( channelNamesData->writable() );
+	
+	result->members()["displayWindow"] = new IECore::Box2iData( displayWindow );
+	result->members()["dataWindow"] = new IECore::Box2iData( dataWindow );
+	result->members()["channelNames"] = channelNamesData;
+	
+	IECore::CompoundObjectPtr channelTiles = new IECore::CompoundObject;
+	result->members()["tiles"] = channelTiles;
+	if( dataWindow.isEmpty() )
+	{
+		return result;
+	}
+	
+	// split each channel into tiles, ordered by row from the
+	// tile at the bottom left of the data window.
+	const int tileSize = ImagePlug::tileSize();
+	const Imath::V2i minTileOrigin = ImagePlug::tileOrigin( dataWindow.min );
+	const Imath::V2i maxTileOrigin = ImagePlug::tileOrigin( dataWindow.max );
+	const int dataWidth = dataWindow.size().x + 1;
+	
+	const std::vector<std::string> &channelNames = channelNamesData->readable();
+	for( std::vector<std::string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it != eIt; ++it )
+	{
+		IECore::ConstFloatVectorDataPtr channelData = image->getChannel<float>( *it );
+		if( !channelData )
+		{
+			continue;
+		}
+		const std::vector<float> &channel = channelData->readable();
+		
+		IECore::ObjectVectorPtr tiles = new IECore::ObjectVector;
+		channelTiles->members()[*it] = tiles;
+		
+		for( int tileOriginY = minTileOrigin.y; tileOriginY <= maxTileOrigin.y; tileOriginY += tileSize )
+		{
+			for( int tileOriginX = minTileOrigin.x; tileOriginX <= maxTileOrigin.x; tileOriginX += tileSize )
+			{
+				const Imath::Box2i tileBound( Imath::V2i( tileOriginX, tileOriginY ), Imath::V2i( tileOriginX + tileSize - 1, tileOriginY + tileSize - 1 ) );
+				const Imath::Box2i bound = IECore::boxIntersection( tileBound, dataWindow );
+				
+				IECore::FloatVectorDataPtr tileData = new IECore::FloatVectorData;
+				std::vector<float> &tile = tileData->writable();
+				tile.resize( tileSize * tileSize, 0.0f );
+				
+				for( int y = bound.min.y; y <= bound.max.y; y++ )
+				{
+					const float *src = &channel[( dataWindow.max.y - y ) * dataWidth + bound.min.x - dataWindow.min.x];
+					float *dst = &tile[( y - tileBound.min.y ) * tileSize + bound.min.x - tileBound.min.x];
+					std::copy( src, src + bound.size().x + 1, dst );
+				}
+				
+				// substitute the shared uniform tiles where we can, so that
+				// downstream nodes can take advantage of them. the const_cast
+				// is safe because the tiles are never modified once stored.
+				bool uniform = true;
+				for( std::vector<float>::const_iterator vIt = tile.begin() + 1, vEIt = tile.end(); vIt != vEIt; ++vIt )
+				{
+					if( *vIt != tile[0] )
+					{
+						uniform = false;
+						break;
+					}
+				}
+				
+				if( uniform )
+				{
+					tiles->members().push_back( IECore::constPointerCast<IECore::FloatVectorData>( ImagePlug::uniformTile( tile[0] ) ) );
+				}
+				else
+				{
+					tiles->members().push_back( tileData );
+				}
+			}
+		}
+	}
+	
+	return result;
+}
+
 template<typename BaseType>
 GafferImage::Format ImagePrimitiveSource<BaseType>::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	Imath::Box2i result;
-	IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
-	if( image )
+	IECore::ConstCompoundObjectPtr t = tiles();
+	if( t )
 	{
-		result = image->getDisplayWindow();
-		return GafferImage::Format( result.size().x+1, result.size().y+1 );
+		const Imath::Box2i &displayWindow = t->member<IECore::Box2iData>( "displayWindow" )->readable();
+		return GafferImage::Format( displayWindow.size().x+1, displayWindow.size().y+1 );
 	}
 	return GafferImage::Format();
 }
@@ -171,79 +297,60 @@ GafferImage::Format ImagePrimitiveSource<BaseType>::computeFormat( const Gaffer:
 template<typename BaseType>
 Imath::Box2i ImagePrimitiveSource<BaseType>::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	Imath::Box2i result;
-	IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
-	if( image )
+	IECore::ConstCompoundObjectPtr t = tiles();
+	if( t )
 	{
-		Imath::Box2i displayWindow = image->getDisplayWindow();
-		result = image->getDataWindow();
-		const int yOffset = displayWindow.min.y + ( displayWindow.size().y + 1 ) - result.min.y;
-		result.min.y = yOffset - ( result.size().y + 1 );
-		result.max.y = yOffset - 1;
+		return t->member<IECore::Box2iData>( "dataWindow" )->readable();
 	}
-	return result;
+	return Imath::Box2i();
 }
 
 template<typename BaseType>
 IECore::ConstStringVectorDataPtr ImagePrimitiveSource<BaseType>::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::StringVectorDataPtr result = new IECore::StringVectorData();
-	IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
-	if( image )
+	IECore::ConstCompoundObjectPtr t = tiles();
+	if( t )
 	{
-		image->channelNames( result->writable() );
-	}
-	else
-	{
-		std::vector<std::string> &channelStrVector( result->writable() );
-		channelStrVector.push_back("R");
-		channelStrVector.push_back("G");
-		channelStrVector.push_back("B");
+		return t->member<IECore::StringVectorData>( "channelNames" );
 	}
 	
+	IECore::StringVectorDataPtr result = new IECore::StringVectorData();
+	std::vector<std::string> &channelStrVector( result->writable() );
+	channelStrVector.push_back("R");
+	channelStrVector.push_back("G");
+	channelStrVector.push_back("B");
 	return result;
 }
 
 template<typename BaseType>
 IECore::ConstFloatVectorDataPtr ImagePrimitiveSource<BaseType>::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::ConstImagePrimitivePtr image = IECore::runTimeCast<const IECore::ImagePrimitive>( inputImagePrimitivePlug()->getValue() );
-	if( !image )
+	IECore::ConstCompoundObjectPtr t = tiles();
+	if( !t )
 	{
 		return ImagePlug::blackTile();
 	}
 	
-	IECore::ConstFloatVectorDataPtr channelData = image->getChannel<float>( channelName );
-	if( !channelData )
+	const IECore::ObjectVector *channelTiles = t->member<IECore::CompoundObject>( "tiles" )->member<IECore::ObjectVector>( channelName );
+	if( !channelTiles )
 	{
 		return ImagePlug::blackTile();
 	}
-	const std::vector<float> &channel = channelData->readable();
-	
-	IECore::FloatVectorDataPtr resultData = new IECore::FloatVectorData;
-	std::vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize(), 0.0f );
 	
-	Imath::Box2i displayWindow = image->getDisplayWindow();
-	Imath::Box2i dataWindow = image->getDataWindow();
-	const int yOffset = displayWindow.min.y + ( displayWindow.size().y + 1 ) - dataWindow.min.y;
-	dataWindow.min.y = yOffset - ( dataWindow.size().y + 1 );
-	dataWindow.max.y = yOffset - 1;
-	Imath::Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( GafferImage::ImagePlug::tileSize() - 1 ) );
-	Imath::Box2i bound = IECore::boxIntersection( tileBound, dataWindow );
-	
-	for( int y = bound.min.y; y<=bound.max.y; y++ )
+	const Imath::Box2i &dataWindow = t->member<IECore::Box2iData>( "dataWindow" )->readable();
+	const Imath::V2i minTileOrigin = ImagePlug::tileOrigin( dataWindow.min );
+	const Imath::V2i maxTileOrigin = ImagePlug::tileOrigin( dataWindow.max );
+	if(
+		tileOrigin.x < minTileOrigin.x || tileOrigin.x > maxTileOrigin.x ||
+		tileOrigin.y < minTileOrigin.y || tileOrigin.y > maxTileOrigin.y
+	)
 	{
-		size_t srcIndex = ( dataWindow.size().y - ( y - dataWindow.min.y ) ) * ( dataWindow.size().x + 1 ) + bound.min.x - dataWindow.min.x;
-		size_t dstIndex = ( y - tileBound.min.y ) * GafferImage::ImagePlug::tileSize() + bound.min.x - tileBound.min.x;
-		const size_t srcEndIndex = srcIndex + bound.size().x;
-		while( srcIndex <= srcEndIndex )
-		{
-			result[dstIndex++] = channel[srcIndex++];
-		}
+		return ImagePlug::blackTile();
 	}
 	
-	return resultData;
+	const int numTilesX = ( maxTileOrigin.x - minTileOrigin.x ) / ImagePlug::tileSize() + 1;
+	const Imath::V2i tileIndex = ( tileOrigin - minTileOrigin ) / ImagePlug::tileSize();
+	return IECore::staticPointerCast<const IECore::FloatVectorData>( channelTiles->members()[tileIndex.y * numTilesX + tileIndex.x] );
 }
 
 } // namespace GafferImage
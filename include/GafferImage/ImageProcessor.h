@@ -62,15 +62,38 @@ class ImageProcessor : public ImageNode
 		virtual Gaffer::Plug *correspondingInput( const Gaffer::Plug *output );
 		virtual const Gaffer::Plug *correspondingInput( const Gaffer::Plug *output ) const;
 
+		/// @name Tile skipping statistics
+		/// Counts the tiles which have been skipped because they lie outside
+		/// a data window, and were therefore known to be black without any
+		/// input tiles being fetched. This includes both whole output tiles
+		/// and individual input tiles skipped by nodes such as Merge.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		static size_t tilesSkipped();
+		static void resetTilesSkipped();
+		//@}
+		
 	protected :
 	
 		/// Reimplemented to pass through the hashes of the first input when the node is disabled. When it is not
 		/// it will call hashXXXXXPlug() so that derived classes can implement their own hashing functions.
+		/// Tiles lying entirely outside the output data window are given the hash of ImagePlug::blackTile().
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;	
 		/// Reimplements the functionality of ImageNode::compute to pass through
-		/// the first input if the node is disabled.
+		/// the first input if the node is disabled. Tiles lying entirely outside the
+		/// output data window are black by definition, so ImagePlug::blackTile() is
+		/// output for them without calling computeChannelData().
 		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
 		
+		/// Returns true if the tile with the specified origin lies entirely
+		/// outside dataWindow, and is therefore black.
+		static bool tileOutsideDataWindow( const Imath::V2i &tileOrigin, const Imath::Box2i &dataWindow );
+		/// Returns the hash of ImagePlug::blackTile(), for use in hashing tiles
+		/// identified by tileOutsideDataWindow().
+		static const IECore::MurmurHash &blackTileHash();
+		/// Records that a tile was skipped, for reporting by tilesSkipped().
+		static void tileSkipped();
+		
 	private :
 	
 		static size_t g_firstPlugIndex;
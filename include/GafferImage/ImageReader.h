@@ -38,6 +38,8 @@
 #ifndef GAFFERSCENE_IMAGEREADER_H
 #define GAFFERSCENE_IMAGEREADER_H
 
+#include "Gaffer/NumericPlug.h"
+
 #include "GafferImage/ImageNode.h"
 
 namespace GafferImage
@@ -60,6 +62,16 @@ class ImageReader : public ImageNode
 		
 		Gaffer::StringPlug *fileNamePlug();
 		const Gaffer::StringPlug *fileNamePlug() const;
+		
+		/// Selects a level from files which contain mip-maps, where level 0
+		/// is the full resolution image. Levels beyond those available in the
+		/// file are clamped to the lowest resolution level.
+		Gaffer::IntPlug *mipLevelPlug();
+		const Gaffer::IntPlug *mipLevelPlug() const;
+		
+		/// Returns the number of mip levels in the current file, or 0
+		/// if the file can't be opened.
+		int numMipLevels() const;
 
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 		virtual bool enabled() const;
@@ -76,8 +88,17 @@ class ImageReader : public ImageNode
 		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
 		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
 
+		/// Reimplemented to return false, as the OIIO image cache already stores
+		/// our tiles in the native format of the file.
+		virtual bool useHalfTileCache() const;
+		
 	private :
 	
+		/// Appends the file name and the mip level which will actually be
+		/// read to h. Requested levels beyond those in the file are clamped,
+		/// so that they don't produce new hashes for identical data.
+		void hashFileNameAndMipLevel( IECore::MurmurHash &h ) const;
+	
 		static size_t g_firstPlugIndex;
 		
 };
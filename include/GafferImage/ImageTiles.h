@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGE_IMAGETILES_H
+#define GAFFERIMAGE_IMAGETILES_H
+
+#include <map>
+#include <vector>
+
+#include "OpenEXR/ImathColor.h"
+
+#include "IECore/RefCounted.h"
+#include "IECore/MurmurHash.h"
+#include "IECore/VectorTypedData.h"
+
+#include "GafferImage/ImagePlug.h"
+
+namespace GafferImage
+{
+
+/// Maintains a copy of the RGBA tiles of an image within a region of
+/// interest. Each call to update() computes only the tiles which are new
+/// to the region or whose hash has changed, so that clients such as the
+/// ImageView can redisplay an image cheaply when only a part of it has
+/// been modified, and never need to compute tiles which aren't visible.
+class ImageTiles : public IECore::RefCounted
+{
+
+	public :
+
+		ImageTiles();
+		virtual ~ImageTiles();
+
+		IE_CORE_DECLAREMEMBERPTR( ImageTiles );
+
+		struct Tile
+		{
+			/// The combined hash of all the channels in the tile.
+			IECore::MurmurHash hash;
+			/// The R, G, B and A channel data, with null entries
+			/// for channels which the image doesn't have.
+			IECore::ConstFloatVectorDataPtr channels[4];
+		};
+
+		struct OriginLess
+		{
+			bool operator()( const Imath::V2i &a, const Imath::V2i &b ) const
+			{
+				return a.y < b.y || ( a.y == b.y && a.x < b.x );
+			}
+		};
+
+		typedef std::map<Imath::V2i, Tile, OriginLess> TileMap;
+
+		/// Returns the origins of all the tiles which intersect
+		/// window, ordered by row from the bottom left.
+		static std::vector<Imath::V2i> tileOrigins( const Imath::Box2i &window );
+
+		/// Updates the tiles to hold the part of the image which lies
+		/// within window, computing any tiles which are not already held
+		/// or whose hash has changed. The computation is performed in
+		/// parallel, in the current context. Tiles outside the window are
+		/// discarded. Returns the number of tiles which were computed.
+		size_t update( const ImagePlug *image, const Imath::Box2i &window );
+		/// Discards all tiles.
+		void clear();
+
+		/// The window passed to the last call to update(), clipped
+		/// to the data window of the image.
+		const Imath::Box2i &window() const;
+		const TileMap &tiles() const;
+		/// Returns the tile with the specified origin, or 0 if
+		/// it isn't held.
+		const Tile *tile( const Imath::V2i &tileOrigin ) const;
+
+		/// Returns the colour of a pixel, or black if the pixel
+		/// isn't within one of the tiles held.
+		Imath::Color4f sample( const Imath::V2i &pixel ) const;
+
+	private :
+
+		Imath::Box2i m_window;
+		TileMap m_tiles;
+
+};
+
+IE_CORE_DECLAREPTR( ImageTiles );
+
+} // namespace GafferImage
+
+#endif // GAFFERIMAGE_IMAGETILES_H
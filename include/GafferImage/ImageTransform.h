@@ -49,6 +49,9 @@ namespace GafferImage
 
 IE_CORE_FORWARDDECLARE( Reformat );
 
+/// Applies a 2D transform to the image. Transforms which shrink the image are
+/// prefiltered to the scaled resolution by an internal Reformat node. All others
+/// are resampled from the input in a single filtered pass.
 class ImageTransform : public GafferImage::ImageProcessor
 {
 	public :
@@ -106,9 +106,24 @@ class Merge : public FilterProcessor
 	
 	private :
 		
+		/// Flags describing the circumstances in which an operation
+		/// leaves one of its inputs unchanged, allowing uniform black
+		/// and transparent tiles to be skipped entirely.
+		enum Identities
+		{
+			NoIdentities = 0,
+			/// The result is B when A and a are 0.
+			TransparentAIsIdentity = 1,
+			/// The result is A when B and b are 0.
+			TransparentBIsIdentity = 2
+		};
+		
 		/// Performs the merge operation using the functor 'F'.
 		template< typename F >
-		IECore::ConstFloatVectorDataPtr doMergeOperation( F f, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const;
+		IECore::ConstFloatVectorDataPtr doMergeOperation( F f, unsigned identities, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const;
+		/// Called by doMergeOperation() with TileSize equal to ImagePlug::tileSize().
+		template< int TileSize, typename F >
+		IECore::ConstFloatVectorDataPtr mergeTiles( F f, unsigned identities, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha ) const;
 
 		/// A useful method which returns true if the StringVector contains the channel "A".
 		inline bool hasAlpha( IECore::ConstStringVectorDataPtr channelNamesData ) const;
@@ -35,42 +35,89 @@
 //////////////////////////////////////////////////////////////////////////
 
 template< typename F >
-IECore::ConstFloatVectorDataPtr Merge::doMergeOperation( F f, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const
+IECore::ConstFloatVectorDataPtr Merge::doMergeOperation( F f, unsigned identities, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha, const Imath::V2i &tileOrigin ) const
 {
-	// Allocate the new tile
-	Imath::Box2i tile( tileOrigin, Imath::V2i( tileOrigin.x + ImagePlug::tileSize() - 1, tileOrigin.y + ImagePlug::tileSize() - 1 ) );
-	IECore::FloatVectorDataPtr outDataPtr = inData.back()->copy();
-	std::vector<float> &outData = outDataPtr->writable();
+	switch( ImagePlug::tileSize() )
+	{
+		case 128 : return mergeTiles<128>( f, identities, inData, inAlpha );
+		case 256 : return mergeTiles<256>( f, identities, inData, inAlpha );
+		default : return mergeTiles<64>( f, identities, inData, inAlpha );
+	}
+}
 
-	// Allocate a temporary tile that will hold the intermediate values of the alpha channel.
-	IECore::FloatVectorDataPtr aOut = inAlpha.back()->copy();
-	std::vector<float> &outAlpha = aOut->writable();
+template< int TileSize, typename F >
+IECore::ConstFloatVectorDataPtr Merge::mergeTiles( F f, unsigned identities, std::vector< IECore::ConstFloatVectorDataPtr > &inData, std::vector< IECore::ConstFloatVectorDataPtr > &inAlpha ) const
+{
+	// The result of the merge so far. We avoid allocating new tiles for
+	// this until we are forced to by a non-uniform input.
+	IECore::ConstFloatVectorDataPtr outData = inData.back();
+	IECore::ConstFloatVectorDataPtr outAlpha = inAlpha.back();
+	
+	// Tiles we have allocated to hold the result, and may therefore write to in place.
+	IECore::FloatVectorDataPtr scratchData;
+	IECore::FloatVectorDataPtr scratchAlpha;
 	
 	// Perform the operation.
 	unsigned int nIterations( inData.size() -1 );
 	for( unsigned int i = nIterations; i > 0; --i )
 	{
-		for( int y = tile.min.y; y<=tile.max.y; y++ )
+		// Deal with uniform tiles without touching the pixels.
+		float A, B, a, b;
+		const bool uniformA = ImagePlug::isUniformTile( outData.get(), A ) && ImagePlug::isUniformTile( outAlpha.get(), a );
+		const bool uniformB = ImagePlug::isUniformTile( inData[i-1].get(), B ) && ImagePlug::isUniformTile( inAlpha[i-1].get(), b );
+		if( uniformA && uniformB )
+		{
+			outData = ImagePlug::uniformTile( f( A, B, a, b ) );
+			outAlpha = ImagePlug::uniformTile( f( a, b, a, b ) );
+			continue;
+		}
+		else if( uniformA && A == 0.f && a == 0.f && ( identities & TransparentAIsIdentity ) )
+		{
+			outData = inData[i-1];
+			outAlpha = inAlpha[i-1];
+			continue;
+		}
+		else if( uniformB && B == 0.f && b == 0.f && ( identities & TransparentBIsIdentity ) )
 		{
-			// Compute the data values and afterwards, the intermediate alpha values.
-			const float *dIn1 = &(outData[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			const float *dIn2 = &(inData[i-1]->readable()[0]) + (y - tileOrigin.y) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);	
-			const float *aIn1 = &(outAlpha[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			const float *aIn2 = &(inAlpha[i-1]->readable()[0]) + (y - tileOrigin.y) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
+			continue;
+		}
+		
+		// Otherwise process every pixel, writing into our own tiles.
+		if( outData != scratchData )
+		{
+			scratchData = new IECore::FloatVectorData;
+			scratchData->writable().resize( TileSize * TileSize );
+		}
+		if( outAlpha != scratchAlpha )
+		{
+			scratchAlpha = new IECore::FloatVectorData;
+			scratchAlpha->writable().resize( TileSize * TileSize );
+		}
+
+		// Compute the data values and afterwards, the intermediate alpha values.
+		// Every tile covers TileSize * TileSize pixels, so we can iterate over each
+		// one as a single contiguous run whose length is known at compile time.
+		const float *dIn1 = &(outData->readable()[0]);
+		const float *dIn2 = &(inData[i-1]->readable()[0]);
+		const float *aIn1 = &(outAlpha->readable()[0]);
+		const float *aIn2 = &(inAlpha[i-1]->readable()[0]);
 
-			float *dOut = &(outData[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
-			float *aOut = &(outAlpha[0]) + ( y - tileOrigin.y ) * ImagePlug::tileSize() + (tile.min.x - tileOrigin.x);
+		float *dOut = &(scratchData->writable()[0]);
+		float *aOut = &(scratchAlpha->writable()[0]);
 
-			const float *END = dOut+(tile.max.x-tile.min.x)+1;
-			while( dOut != END )
-			{
-				*dOut++ = f( *dIn1++, *dIn2++, *aIn1, *aIn2 );
-				*aOut++ = f( *aIn1, *aIn2, *aIn1, *aIn2 );
-				++aIn1;
-				++aIn2;
-			}	
+		const float *END = dOut + TileSize * TileSize;
+		while( dOut != END )
+		{
+			*dOut++ = f( *dIn1++, *dIn2++, *aIn1, *aIn2 );
+			*aOut++ = f( *aIn1, *aIn2, *aIn1, *aIn2 );
+			++aIn1;
+			++aIn2;
 		}
+		
+		outData = scratchData;
+		outAlpha = scratchAlpha;
 	}
-	return outDataPtr;
+	
+	return outData;
 }
 
@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERIMAGE_MIPMAP_H
+#define GAFFERIMAGE_MIPMAP_H
+
+#include "Gaffer/NumericPlug.h"
+
+#include "GafferImage/ImageProcessor.h"
+
+namespace GafferImage
+{
+
+/// Outputs a single level of a mip-map pyramid built from the input image,
+/// where each level is half the resolution of the one above it, and level 0
+/// is the input itself. Each level is computed tile by tile from the tiles of
+/// the level above, so all the levels are cached independently and a low
+/// resolution level can be computed without ever building the full resolution
+/// image in one go. A pixel at level n covers the input pixels from
+/// pixel * 2^n to ( pixel + 1 ) * 2^n - 1.
+class MipMap : public ImageProcessor
+{
+
+	public :
+
+		MipMap( const std::string &name=defaultName<MipMap>() );
+		virtual ~MipMap();
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferImage::MipMap, MipMapTypeId, ImageProcessor );
+
+		/// The level to output. Values greater than maxLevel() are clamped.
+		Gaffer::IntPlug *levelPlug();
+		const Gaffer::IntPlug *levelPlug() const;
+
+		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
+		/// Returns false for level 0, where the input is passed through unchanged.
+		virtual bool enabled() const;
+
+		/// The maximum level which may be output.
+		static int maxLevel();
+		/// Returns the window at the specified level which covers the
+		/// specified window from level 0.
+		static Imath::Box2i levelWindow( const Imath::Box2i &window, int level );
+
+	protected :
+
+		virtual void hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+
+		virtual GafferImage::Format computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual Imath::Box2i computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
+
+	private :
+
+		// Returns the output of the internal node which computes the current level.
+		const ImagePlug *levelOutPlug() const;
+
+		static size_t g_firstPlugIndex;
+
+};
+
+IE_CORE_DECLAREPTR( MipMap );
+
+} // namespace GafferImage
+
+#endif // GAFFERIMAGE_MIPMAP_H
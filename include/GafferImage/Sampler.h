@@ -89,6 +89,30 @@ public :
 	/// Sub-samples the image using a filter.
 	inline float sample( float x, float y );
 
+	/// Returns a pointer to count consecutive integer samples from row y,
+	/// starting at x, with out of bounds samples treated as for sample( int, int ).
+	/// When the run lies within a single tile the pointer refers directly to the
+	/// tile data, otherwise the samples are gathered into an internal buffer.
+	/// Either way the pointer is only valid until the next call to sampleRow(),
+	/// sample( float, float ) or setSampleWindow(). Count must be at least 1.
+	const float *sampleRow( int x, int y, int count );
+
+	/// Fills out with count filtered samples taken along row y, such that
+	/// out[i] == sample( x + i * step, y ). The filter is applied separably,
+	/// so the vertical weights are computed only once for the whole row.
+	/// Step must be positive.
+	void sampleRow( float x, float y, float step, int count, float *out );
+
+	/// Computes all the tiles within the sample window in parallel, so that
+	/// subsequent sampling doesn't need to compute them one at a time. Tiles
+	/// are computed in the current context.
+	void prefetch();
+
+	/// Returns true if every sample will return the same value, because all the
+	/// tiles within the sample window are the same ImagePlug::uniformTile().
+	/// When this is the case, value is set to the value of the tiles.
+	bool uniform( float &value );
+
 	/// Accumulates the hashes of the tiles that it accesses.
 	void hash( IECore::MurmurHash &h ) const;
 
@@ -101,6 +125,10 @@ private:
 	/// @param tileIndex XY indices that can be used to access the colour value of point 'p' from tileData.
 	inline void cachedData( Imath::V2i p, const float *& tileData, Imath::V2i &tileOrigin, Imath::V2i &tileIndex );
 
+	/// Copies a run of samples from within the sample window, which may span
+	/// several tiles.
+	void copyRow( int x, int y, int count, float *out );
+
 	const ImagePlug *m_plug;
 	const std::string m_channelName;
 	Imath::Box2i m_sampleWindow;
@@ -113,6 +141,12 @@ private:
 	BoundingMode m_boundingMode;
 	ConstFilterPtr m_filter;
 
+	// Scratch space for sampleRow() and sample( float, float ).
+	std::vector<float> m_rowBuffer;
+	std::vector<float> m_columnBuffer;
+	std::vector<float> m_weightsX;
+	std::vector<float> m_weightsY;
+
 };
 
 }; // namespace GafferImage
@@ -50,38 +50,29 @@ float Sampler::sample( float x, float y )
 		return sample( IECore::fastFloatFloor( x ), IECore::fastFloatFloor( y ) );
 	}
 
-	// Otherwise do a filtered lookup.	
-	int tapX = m_filter->tap( x - m_cacheWindow.min.x );
+	// Otherwise do a filtered lookup.
 	const int width = m_filter->width();
-	float weightsX[width];
-	
-	for ( int i = 0; i < width; ++i )
-	{
-		weightsX[i] = m_filter->weight( x, tapX+i+m_cacheWindow.min.x );
-	}
+	m_weightsX.resize( width );
+	m_weightsY.resize( width );
 
-	int tapY = m_filter->tap( y - m_cacheWindow.min.y );
-	const int height = m_filter->width();
-	float weightsY[height];
-	
-	for ( int i = 0; i < height; ++i )
+	const int tapX = m_filter->tap( x - m_cacheWindow.min.x ) + m_cacheWindow.min.x;
+	const int tapY = m_filter->tap( y - m_cacheWindow.min.y ) + m_cacheWindow.min.y;
+	for ( int i = 0; i < width; ++i )
 	{
-		weightsY[i] = m_filter->weight( y, tapY+i+m_cacheWindow.min.y );
+		m_weightsX[i] = m_filter->weight( x, tapX + i );
+		m_weightsY[i] = m_filter->weight( y, tapY + i );
 	}
 
 	float weightedSum = 0.;
 	float colour = 0.f;
-	int absY = tapY + m_cacheWindow.min.y;
-	for ( int y = 0; y < height; ++y, ++absY )
+	for ( int j = 0; j < width; ++j )
 	{
-		int absX = tapX + m_cacheWindow.min.x;
-		for ( int x = 0; x < width; ++x, ++absX )
+		const float *row = sampleRow( tapX, tapY + j, width );
+		for ( int i = 0; i < width; ++i )
 		{
-			float c = 0.;
-			float w = weightsX[x] * weightsY[y];		
-			c = sample( absX, absY );
+			const float w = m_weightsX[i] * m_weightsY[j];
 			weightedSum += w;
-			colour += c * w;
+			colour += row[i] * w;
 		}
 	}
 
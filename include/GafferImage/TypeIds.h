@@ -79,6 +79,8 @@ enum TypeId
 	ImageStatsTypeId = 110783,
 	ImageTransformImplementationTypeId = 110784,
 	RemoveChannelsTypeId = 110785,
+	MipMapTypeId = 110786,
+	MipMapLevelTypeId = 110787,
 	
 	LastTypeId = 110849
 };
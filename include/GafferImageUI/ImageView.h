@@ -42,6 +42,9 @@
 
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/ImageStats.h"
+#include "GafferImage/ImageReader.h"
+#include "GafferImage/MipMap.h"
+#include "GafferImage/ImageTiles.h"
 
 #include "GafferImageUI/TypeIds.h"
 
@@ -75,6 +78,26 @@ class ImageView : public GafferUI::View
 
 	private:
 
+		/// Internal nodes used to provide a lower resolution mip level
+		/// of the image when the view is zoomed out. The reader is used
+		/// when the image comes straight from a file which already
+		/// contains mip levels, and the MipMap node is used otherwise.
+		GafferImage::MipMap *mipMapNode();
+		GafferImage::ImageReader *mipMapReaderNode();
+		/// Returns a plug providing the current mip level of the image.
+		const GafferImage::ImagePlug *mipLevelPlug( const GafferImage::ImagePlug *imagePlug );
+		/// Called by the gadget when it needs a different mip level, or the
+		/// tiles within a different window. The window is specified at full
+		/// resolution.
+		void tilesRequest( int mipLevel, const Imath::Box2i &window );
+		
+		int m_mipLevel;
+		Imath::Box2i m_tileWindow;
+		/// The tiles of the current mip level within m_tileWindow. These
+		/// persist between updates so that only modified tiles need be
+		/// recomputed.
+		GafferImage::ImageTilesPtr m_tiles;
+
 		int m_channelToView;
 		Imath::V2f m_mousePos;
 		Imath::Color4f m_sampleColor;
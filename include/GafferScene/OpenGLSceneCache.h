@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_OPENGLSCENECACHE_H
+#define GAFFERSCENE_OPENGLSCENECACHE_H
+
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/RefCounted.h"
+
+#include "GafferScene/ScenePlug.h"
+#include "GafferScene/PathMatcherData.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( Context )
+
+} // namespace Gaffer
+
+namespace IECoreGL
+{
+
+IE_CORE_FORWARDDECLARE( Scene )
+IE_CORE_FORWARDDECLARE( Group )
+
+} // namespace IECoreGL
+
+namespace GafferScene
+{
+
+/// Maintains an IECoreGL::Scene representing the output of a ScenePlug, for
+/// interactive display. Rendering a SceneProcedural with the IECoreGL::Renderer
+/// regenerates the entire scene every time, whereas the OpenGLSceneCache keeps
+/// the converted contents of each location between calls to update(), and uses
+/// the hashes of the scene plugs to reconvert only the locations which have
+/// actually changed. Transforms are updated independently of the contents of a
+/// location, so editing a transform never requires any geometry to be reconverted.
+/// The scene drawn is the same as that drawn by a SceneProcedural with the same
+/// expanded paths, except that motion blur is not represented.
+class OpenGLSceneCache : public IECore::RefCounted
+{
+
+	public :
+
+		OpenGLSceneCache();
+		virtual ~OpenGLSceneCache();
+
+		IE_CORE_DECLAREMEMBERPTR( OpenGLSceneCache );
+
+		/// Updates the scene to represent the specified plug, evaluated in a copy of
+		/// the specified context. If pathsToExpand is 0, all locations are expanded.
+		/// The hierarchy is walked in parallel, and the number of locations whose
+		/// contents had to be converted is returned.
+		size_t update( const ScenePlug *scene, const Gaffer::Context *context, const IECore::PathMatcherData *pathsToExpand = 0 );
+		/// Discards all the cached locations, so that the next call to update()
+		/// converts everything.
+		void clear();
+
+		/// Returns the scene, which is modified in place by update(). Each location
+		/// is represented by an IECoreGL::Group with a NameStateComponent holding
+		/// its full path, matching the "name" attribute output by the SceneProcedural.
+		IECoreGL::Scene *scene();
+		const IECoreGL::Scene *scene() const;
+
+	private :
+
+		struct Location;
+		typedef boost::shared_ptr<Location> LocationPtr;
+
+		class UpdateChildren;
+
+		struct UpdateState;
+		static void updateLocation( const UpdateState &state, Location *location, const ScenePlug::ScenePath &path, const IECore::MurmurHash &parentAttributesHash );
+		static void rebuildGroup( Location *location );
+
+		IECoreGL::ScenePtr m_scene;
+		LocationPtr m_root;
+
+};
+
+IE_CORE_DECLAREPTR( OpenGLSceneCache );
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_OPENGLSCENECACHE_H
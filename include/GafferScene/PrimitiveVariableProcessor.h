@@ -71,7 +71,9 @@ class PrimitiveVariableProcessor : public SceneElementProcessor
 		virtual void hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		virtual IECore::ConstObjectPtr computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const;
 		
-		/// Must be implemented by subclasses to process the primitive variable in place.
+		/// Must be implemented by subclasses to process the primitive variable in place. The
+		/// data of the variable is shared with inputGeometry, so it must be replaced with new
+		/// data rather than modified directly.
 		virtual void processPrimitiveVariable( const ScenePath &path, const Gaffer::Context *context, IECore::ConstPrimitivePtr inputGeometry, IECore::PrimitiveVariable &inputVariable ) const = 0;
 
 	private :
@@ -38,6 +38,8 @@
 #ifndef GAFFERSCENE_SCENEELEMENTPROCESSOR_H
 #define GAFFERSCENE_SCENEELEMENTPROCESSOR_H
 
+#include "IECore/Primitive.h"
+
 #include "GafferScene/FilteredSceneProcessor.h"
 
 namespace GafferScene
@@ -113,6 +115,15 @@ class SceneElementProcessor : public FilteredSceneProcessor
 		virtual IECore::ConstObjectPtr computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::ConstObjectPtr inputObject ) const;
 		//@}
 
+		/// Returns a copy of the primitive which shares the data of its primitive variables
+		/// (and blind data) with the original, rather than duplicating it. This is useful in
+		/// computeProcessedObject() implementations which modify only some of the
+		/// variables of an input primitive. Because the data is shared with the input, it
+		/// must be treated as read only - variables should be modified by replacing the
+		/// data with a new object rather than by editing the data in place. Primitive types
+		/// which can't be copied in this way are copied in full.
+		static IECore::PrimitivePtr shallowCopy( const IECore::Primitive *primitive );
+
 	private :
 	
 		enum BoundMethod
@@ -110,6 +110,14 @@ class SceneNode : public Gaffer::ComputeNode
 		Imath::Box3f unionOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out ) const;
 		/// A hash for the result of the computation in unionOfTransformedChildBounds().
 		IECore::MurmurHash hashOfTransformedChildBounds( const ScenePath &path, const ScenePlug *out ) const;
+		
+		/// Returns a new CompoundObject which shares the members of object, rather than
+		/// deep copying them as CompoundObject::copy() does. This should be used by compute*()
+		/// methods which add or replace members of attributes or globals computed upstream.
+		/// It's safe because the upstream members came from a compute and so are never modified,
+		/// but it does mean that members of the result must only ever be replaced, not edited
+		/// in place.
+		static IECore::CompoundObjectPtr shallowCopy( const IECore::CompoundObject *object );
 	
 	private :
 	
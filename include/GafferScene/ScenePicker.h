@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_SCENEPICKER_H
+#define GAFFERSCENE_SCENEPICKER_H
+
+#include <vector>
+
+#include "IECore/RefCounted.h"
+#include "IECore/LineSegment.h"
+#include "IECore/MeshPrimitive.h"
+
+#include "GafferScene/ScenePlug.h"
+#include "GafferScene/PathMatcherData.h"
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( Context )
+
+} // namespace Gaffer
+
+namespace GafferScene
+{
+
+/// Finds the objects in a scene intersected by a ray or a frustum, without
+/// requiring OpenGL. A bounding volume hierarchy is built over the world
+/// space bounds of the locations which are drawn by a SceneProcedural with
+/// the same expanded paths - the objects, and the bounding boxes of any
+/// locations whose children are not expanded. Queries are first answered
+/// using these bounds, and are then refined in parallel by testing against
+/// the faces of any MeshPrimitives which remain candidates. Objects are
+/// identified by their full path, as in the "name" attribute output by
+/// the SceneProcedural.
+class ScenePicker : public IECore::RefCounted
+{
+
+	public :
+
+		/// The scene is traversed in parallel, in a copy of the specified
+		/// context. If pathsToExpand is 0, all locations are expanded.
+		ScenePicker( const ScenePlug *scene, const Gaffer::Context *context, const IECore::PathMatcherData *pathsToExpand = 0 );
+		virtual ~ScenePicker();
+
+		IE_CORE_DECLAREMEMBERPTR( ScenePicker );
+
+		/// Returns the name of the object closest to line.p0 intersected by
+		/// the line, or "" if there is no such object.
+		std::string objectAt( const IECore::LineSegment3f &line ) const;
+		/// Fills objectNames with the names of all objects within the frustum
+		/// bounded by four lines, specified in order around the frustum. Returns
+		/// the new size of objectNames.
+		size_t objectsAt( const std::vector<IECore::LineSegment3f> &cornerLines, std::vector<std::string> &objectNames ) const;
+
+		/// Returns the number of objects in the hierarchy.
+		size_t numObjects() const;
+		/// Returns the world space bound of all the objects.
+		Imath::Box3f bound() const;
+
+		/// An object within the hierarchy.
+		struct Object
+		{
+			std::string name;
+			Imath::Box3f bound;
+			Imath::M44f transform;
+			/// Only set for objects which can be refined
+			/// beyond their bound.
+			IECore::ConstMeshPrimitivePtr mesh;
+		};
+
+	private :
+
+		struct Node
+		{
+			Imath::Box3f bound;
+			// the range of m_objects for leaf nodes, and the
+			// indices of the two children for interior nodes.
+			size_t begin;
+			size_t end;
+			bool leaf;
+		};
+
+		size_t build( size_t begin, size_t end );
+
+		std::vector<Object> m_objects;
+		std::vector<Node> m_nodes;
+
+};
+
+IE_CORE_DECLAREPTR( ScenePicker );
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_SCENEPICKER_H
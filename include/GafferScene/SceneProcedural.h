@@ -107,6 +107,16 @@ class SceneProcedural : public IECore::Renderer::Procedural
 		
 		Attributes m_attributes;
 		
+		/// Methods used by render() to output the individual parts of a location.
+		/// These are protected so that derived classes may render locations without
+		/// recursing to the children.
+		/// \todo The camera and light visualisations within renderObject() don't belong here.
+		void renderAttributes( const IECore::CompoundObject *attributes, IECore::Renderer *renderer ) const;
+		void renderObject( IECore::Renderer *renderer ) const;
+		/// Renders the bounding box of the location as a wireframe, as used to represent
+		/// unexpanded locations.
+		void renderBound( IECore::Renderer *renderer ) const;
+		
 	private :
 	
 		void updateAttributes( bool full );	
@@ -41,16 +41,17 @@
 #include "IECore/ObjectVector.h"
 #include "IECore/Shader.h"
 
-#include "Gaffer/DependencyNode.h"
+#include "Gaffer/ComputeNode.h"
 #include "Gaffer/CompoundPlug.h"
 #include "Gaffer/TypedPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "GafferScene/TypeIds.h"
 
 namespace GafferScene
 {
 
-class Shader : public Gaffer::DependencyNode
+class Shader : public Gaffer::ComputeNode
 {
 
 	public :
@@ -58,7 +59,7 @@ class Shader : public Gaffer::DependencyNode
 		Shader( const std::string &name=defaultName<Shader>() );
 		virtual ~Shader();
 
-		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferScene::Shader, ShaderTypeId, Gaffer::DependencyNode );
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferScene::Shader, ShaderTypeId, Gaffer::ComputeNode );
 		
 		/// A plug defining the name of the shader.
 		Gaffer::StringPlug *namePlug();
@@ -90,18 +91,24 @@ class Shader : public Gaffer::DependencyNode
 		virtual const Gaffer::BoolPlug *enabledPlug() const;
 		
 		/// Implemented so that the children of parametersPlug() affect
-		/// outPlug().
+		/// outPlug() and the internal state plug.
 		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
 		
 		/// Returns a hash representing the result of state().
 		IECore::MurmurHash stateHash() const;
 		void stateHash( IECore::MurmurHash &h ) const;
 		/// Returns a series of IECore::StateRenderables suitable for specifying this
-		/// shader (and it's inputs) to an IECore::Renderer.
+		/// shader (and it's inputs) to an IECore::Renderer. The result is computed
+		/// by an internal plug, so is cached and shared between all callers
+		/// using the same Context.
 		IECore::ConstObjectVectorPtr state() const;
 			
 	protected :
 		
+		/// Implemented to compute the state for the internal state plug.
+		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const;
+		
 		class NetworkBuilder
 		{
 		
@@ -149,6 +156,10 @@ class Shader : public Gaffer::DependencyNode
 
 	private :
 	
+		/// The result of state() is computed and cached on this plug.
+		Gaffer::ObjectPlug *statePlug();
+		const Gaffer::ObjectPlug *statePlug() const;
+	
 		static size_t g_firstPlugIndex;
 		
 };
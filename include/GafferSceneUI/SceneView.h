@@ -43,6 +43,7 @@
 
 #include "GafferScene/ScenePlug.h"
 #include "GafferScene/PathMatcherData.h"
+#include "GafferScene/OpenGLSceneCache.h"
 
 #include "GafferSceneUI/TypeIds.h"
 
@@ -77,6 +78,7 @@ class SceneView : public GafferUI::View3D
 		boost::signals::scoped_connection m_selectionChangedConnection;
 		
 		GafferUI::RenderableGadgetPtr m_renderableGadget;
+		GafferScene::OpenGLSceneCachePtr m_sceneCache;
 	
 		static ViewDescription<SceneView> g_viewDescription;
 	
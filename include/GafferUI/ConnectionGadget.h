@@ -64,6 +64,15 @@ class ConnectionGadget : public Gadget
 		virtual bool acceptsParent( const Gaffer::GraphComponent *potentialParent ) const;		
 		virtual Imath::Box3f bound() const;
 		
+		/// Returns a bound containing the whole of the curve drawn for the
+		/// connection. Unlike bound(), which contains just the end points,
+		/// this accounts for the curvature and width of the connection.
+		Imath::Box3f curveBound() const;
+		/// Returns the distance from the point to the centre line of the
+		/// curve drawn for the connection, allowing hit testing without
+		/// rendering in GL selection mode.
+		float distanceTo( const Imath::V3f &point ) const;
+		
 		/// Returns the Nodule representing the source plug in the connection.
 		/// Note that this may be 0 if the source plug belongs to a node which
 		/// has been hidden.
@@ -106,6 +115,14 @@ class ConnectionGadget : public Gadget
 		
 		bool nodeSelected( const Nodule *nodule ) const;
 		
+		/// Tells the parent GraphGadget that our bound has changed.
+		void dirtyIndex();
+		/// Returns true if the connection is drawn highlighted.
+		bool highlighted() const;
+		/// Returns the source position and tangent used to draw the
+		/// connection, taking minimisation into account.
+		void drawnSource( bool highlighted, Imath::V3f &srcPos, Imath::V3f &srcTangent ) const;
+		
 		Imath::V3f m_srcPos;
 		Imath::V3f m_srcTangent;
 		Imath::V3f m_dstPos;
@@ -38,6 +38,8 @@
 #ifndef GAFFERUI_GRAPHGADGET_H
 #define GAFFERUI_GRAPHGADGET_H
 
+#include <set>
+
 #include "GafferUI/ContainerGadget.h"
 
 namespace Gaffer
@@ -138,10 +140,17 @@ class GraphGadget : public ContainerGadget
 		GraphLayout *getLayout();
 		const GraphLayout *getLayout() const;
 		
-		/// Returns the nodeGadget under the specified line.
+		/// Returns the nodeGadget under the specified line. This uses
+		/// an internal spatial index rather than rendering, so doesn't
+		/// require a GL context.
 		NodeGadget *nodeGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
-		/// Returns the connectionGadget under the specified line.
+		/// Returns the connectionGadget under the specified line. As
+		/// above, this doesn't require a GL context.
 		ConnectionGadget *connectionGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
+		/// Appends to gadgets all the NodeGadgets and ConnectionGadgets
+		/// whose bounds intersect the box, in the order they are drawn.
+		/// Returns the new size of the vector.
+		size_t gadgetsIntersecting( const Imath::Box2f &box, std::vector<Gadget *> &gadgets ) const;
 		
 	protected :
 
@@ -149,12 +158,17 @@ class GraphGadget : public ContainerGadget
 		
 	private :
 		
+		// So that it can tell us when its bound changes during a drag.
+		friend class ConnectionGadget;
+		
 		void rootChildAdded( Gaffer::GraphComponent *root, Gaffer::GraphComponent *child );
 		void rootChildRemoved( Gaffer::GraphComponent *root, Gaffer::GraphComponent *child );
 		void filterMemberAdded( Gaffer::Set *set, IECore::RunTimeTyped *member );
 		void filterMemberRemoved( Gaffer::Set *set, IECore::RunTimeTyped *member );
 		void inputChanged( Gaffer::Plug *dstPlug );
 		void plugSet( Gaffer::Plug *plug );
+		void nodeChildrenChanged( Gaffer::GraphComponent *node, Gaffer::GraphComponent *child );
+		void nodeNameChanged( Gaffer::GraphComponent *node );
 	
 		bool keyPressed( GadgetPtr gadget, const KeyEvent &event );
 		
@@ -182,6 +196,18 @@ class GraphGadget : public ContainerGadget
 		void updateConnectionGadgetMinimisation( ConnectionGadget *gadget );
 		ConnectionGadget *reconnectionGadgetAt( NodeGadget *gadget, const IECore::LineSegment3f &lineInGadgetSpace ) const;
 		void updateDragReconnectCandidate( const DragDropEvent &event );
+		
+		// Spatial index. This is a uniform grid over the bounds of the node
+		// and connection gadgets, allowing us to find the gadgets in a region
+		// without rendering them all in GL selection mode. Gadgets whose bounds
+		// may have changed are marked dirty and are reindexed lazily before
+		// the next query.
+		void dirtyIndex( Gadget *gadget );
+		void dirtyIndex( const NodeGadget *nodeGadget, bool includeConnections );
+		void removeFromIndex( Gadget *gadget );
+		void updateIndex() const;
+		void indexGadget( Gadget *gadget ) const;
+		void unindexGadget( Gadget *gadget ) const;
 				
 		Gaffer::NodePtr m_root;
 		Gaffer::ScriptNodePtr m_scriptNode;
@@ -198,6 +224,9 @@ class GraphGadget : public ContainerGadget
 			NodeGadget *gadget;
 			boost::signals::connection inputChangedConnection;
 			boost::signals::connection plugSetConnection;
+			boost::signals::connection childAddedConnection;
+			boost::signals::connection childRemovedConnection;
+			boost::signals::connection nameChangedConnection;
 		};
 		typedef std::map<const Gaffer::Node *, NodeGadgetEntry> NodeGadgetMap;
 		NodeGadgetMap m_nodeGadgets;
@@ -223,6 +252,25 @@ class GraphGadget : public ContainerGadget
 		
 		GraphLayoutPtr m_layout;
 		
+		typedef std::pair<int, int> IndexCell;
+		struct IndexEntry
+		{
+			Imath::Box2f bound;
+			// The cells the gadget is stored in. Empty if it is
+			// too large to be stored in cells, or not yet indexed.
+			Imath::Box2i cells;
+			bool large;
+			// Used to return query results in drawing order.
+			size_t order;
+		};
+		typedef std::map<Gadget *, IndexEntry> IndexEntryMap;
+		typedef std::map<IndexCell, std::vector<Gadget *> > IndexCellMap;
+		mutable IndexEntryMap m_indexEntries;
+		mutable IndexCellMap m_indexCells;
+		mutable std::set<Gadget *> m_largeIndexedGadgets;
+		mutable std::set<Gadget *> m_dirtyIndexGadgets;
+		size_t m_nextIndexOrder;
+		
 };
 
 IE_CORE_DECLAREPTR( GraphGadget );
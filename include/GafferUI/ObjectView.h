@@ -55,6 +55,15 @@ class ObjectView : public View3D
 
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferUI::ObjectView, ObjectViewTypeId, View3D );
 
+		/// Returns the plug from which the displayed object is computed. This
+		/// is exposed so that the object may be computed on a background thread
+		/// and then displayed with setObject() - see GafferUI.Viewer.
+		Gaffer::ObjectPlug *objectPlug();
+		/// Displays the object, which would usually have been computed from
+		/// objectPlug() in getContext(). The object is framed if nothing was
+		/// displayed previously.
+		void setObject( IECore::ConstObjectPtr object );
+
 	protected :
 
 		virtual void update();
@@ -73,11 +73,50 @@ class RenderableGadget : public Gadget
 		void setRenderable( IECore::ConstVisibleRenderablePtr renderable );
 		IECore::ConstVisibleRenderablePtr getRenderable() const;
 		
+		/// Sets an IECoreGL::Scene to be drawn directly, bypassing the conversion
+		/// performed by setRenderable(). This allows clients to maintain a scene
+		/// incrementally themselves - after modifying the scene in place, setScene()
+		/// should be called again so that the selection is reapplied and a redraw
+		/// is requested. Calling setRenderable() subsequently replaces the scene.
+		void setScene( IECoreGL::ScenePtr scene );
+		IECoreGL::Scene *getScene();
+		const IECoreGL::Scene *getScene() const;
+		
 		/// Returns the IECoreGL::State object used as the base display
 		/// style for the Renderable. This may be modified freely to
 		/// change the display style.
 		IECoreGL::State *baseState();
 		
+		IE_CORE_FORWARDDECLARE( Picker )
+		
+		/// An optional means of finding objects without rendering the
+		/// renderable in GL selection mode, which can be slow for complex
+		/// renderables. Clients which know the structure of their renderable
+		/// may implement this to provide faster picking.
+		class Picker : public IECore::RefCounted
+		{
+		
+			public :
+			
+				IE_CORE_DECLAREMEMBERPTR( Picker );
+				
+				virtual ~Picker();
+				
+				/// Must return the name of the frontmost object intersecting the line,
+				/// or "" if there is no such object.
+				virtual std::string objectAt( const IECore::LineSegment3f &lineInGadgetSpace ) const = 0;
+				/// Must append to objectNames the names of all objects within the frustum
+				/// bounded by four lines, which are specified in order around the frustum.
+				virtual void objectsAt( const std::vector<IECore::LineSegment3f> &cornerLinesInGadgetSpace, std::vector<std::string> &objectNames ) const = 0;
+		
+		};
+		
+		/// Sets the Picker used by objectAt() and objectsAt(). Passing 0 reverts
+		/// to picking by rendering in GL selection mode.
+		void setPicker( PickerPtr picker );
+		Picker *getPicker();
+		const Picker *getPicker() const;
+		
 		/// Returns the name of the frontmost object intersecting the specified line
 		/// through gadget space, or "" if there is no such object.
 		std::string objectAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
@@ -138,6 +177,7 @@ class RenderableGadget : public Gadget
 		IECoreGL::StatePtr m_baseState;
 		IECoreGL::StateComponentPtr m_selectionColor;
 		IECoreGL::StateComponentPtr m_wireframeOn;
+		PickerPtr m_picker;
 		
 		Selection m_selection;
 		SelectionChangedSignal m_selectionChangedSignal;
@@ -38,6 +38,8 @@
 #ifndef GAFFERUI_STANDARDGRAPHLAYOUT_H
 #define GAFFERUI_STANDARDGRAPHLAYOUT_H
 
+#include <vector>
+
 #include "OpenEXR/ImathBox.h"
 
 #include "GafferUI/GraphLayout.h"
@@ -71,6 +73,37 @@ class StandardGraphLayout : public GraphLayout
 		virtual void positionNode( GraphGadget *graph, Gaffer::Node *node, const Imath::V2f &fallbackPosition = Imath::V2f( 0 ) ) const;
 		virtual void positionNodes( GraphGadget *graph, Gaffer::Set *nodes, const Imath::V2f &fallbackPosition = Imath::V2f( 0 ) ) const;		
 
+		/// Positions the specified nodes (or all the nodes in the graph if nodes
+		/// is 0) from scratch, arranging them in layers so that connections flow
+		/// from top to bottom, and ordering each layer so as to minimise crossing
+		/// connections. Unlike positionNodes(), which moves nodes relative to their
+		/// existing neighbours, this is intended for laying out large numbers of nodes,
+		/// such as a freshly imported graph. The centroid of the nodes is preserved,
+		/// and all positions are set within a single UndoContext.
+		void layoutNodes( GraphGadget *graph, Gaffer::Set *nodes = 0 ) const;
+
+		/// A snapshot of the connectivity of a set of nodes, for use with
+		/// layeredPositions(). This holds no references to the nodes themselves,
+		/// so may be laid out on a thread other than the UI thread.
+		struct Adjacency
+		{
+			/// The size of each node.
+			std::vector<Imath::V2f> sizes;
+			/// The connections between nodes, as pairs of ( source, destination )
+			/// indices into sizes.
+			std::vector<std::pair<size_t, size_t> > edges;
+		};
+
+		/// Fills adjacency with the connectivity of the specified nodes (or all
+		/// the nodes in the graph if nodes is 0), and nodesOut with the node for each
+		/// index. Only nodes visible in the graph are considered. Returns the number of nodes.
+		size_t adjacency( GraphGadget *graph, Gaffer::Set *nodes, Adjacency &adjacency, std::vector<Gaffer::Node *> &nodesOut ) const;
+		/// Computes a layered layout for the adjacency, filling positions with
+		/// the centre of each node. Cycles are broken arbitrarily. Runs in time roughly
+		/// proportional to E log V, where E includes the extra vertices inserted along
+		/// connections spanning more than one layer.
+		static void layeredPositions( const Adjacency &adjacency, std::vector<Imath::V2f> &positions );
+
 	private :
 	
 		bool connectNodeInternal( GraphGadget *graph, Gaffer::Node *node, Gaffer::Set *potentialInputs, bool insertIfPossible ) const;
@@ -0,0 +1,349 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import math
+import Queue
+import shutil
+import tempfile
+import threading
+import subprocess
+import multiprocessing
+
+import IECore
+
+import Gaffer
+
+## The LocalProcessDespatcher executes tasks by launching "gaffer execute" worker
+# processes on the local machine. This allows work which would otherwise be serialised
+# by the GIL within a single process to make use of all the available cores. The script
+# is saved to a temporary file for the workers to load, and tasks are handed out in
+# dependency order, with the ready frames of each node batched together to amortise
+# the cost of loading the script. Tasks which can't be reproduced by a worker (because
+# their context differs from the script context by more than the frame) are executed
+# in this process instead.
+class LocalProcessDespatcher( Gaffer.Despatcher ) :
+
+	__despatcher = None
+
+	def __init__( self ) :
+
+		Gaffer.Despatcher.__init__( self )
+
+		self.__frames = None
+		self.__maxProcesses = 0
+		self.__memoryPerProcess = 0
+
+	## Specifies the frames to be executed, as an IECore.FrameList. The default
+	# value of None executes only the current frame of the script.
+	def setFrames( self, frames ) :
+
+		self.__frames = frames
+
+	def getFrames( self ) :
+
+		return self.__frames
+
+	## Limits the number of worker processes which may run concurrently. The
+	# default value of 0 launches one process per core.
+	def setMaxProcesses( self, maxProcesses ) :
+
+		self.__maxProcesses = maxProcesses
+
+	def getMaxProcesses( self ) :
+
+		return self.__maxProcesses
+
+	## Specifies an estimate of the memory (in megabytes) required by each worker.
+	# When non-zero, the number of concurrent workers is further limited so that
+	# their combined memory doesn't exceed the physical memory of the machine.
+	def setMemoryPerProcess( self, memoryPerProcess ) :
+
+		self.__memoryPerProcess = memoryPerProcess
+
+	def getMemoryPerProcess( self ) :
+
+		return self.__memoryPerProcess
+
+	def _doDespatch( self, nodes ) :
+
+		if not nodes :
+			return
+
+		script = nodes[0].scriptNode()
+		if script is None :
+			# Without a script there is nothing for the workers to load,
+			# so we have no choice but to execute everything here.
+			Gaffer.Despatcher.despatcher( "local" ).despatch( nodes )
+			return
+
+		frames = [ script.context().getFrame() ]
+		if self.__frames is not None :
+			frames = self.__frames.asList()
+
+		taskList = []
+		for frame in frames :
+			context = Gaffer.Context( script.context() )
+			context.setFrame( frame )
+			taskList.extend( [ Gaffer.ExecutableNode.Task( n, context ) for n in nodes ] )
+
+		tasks = Gaffer.Despatcher._uniqueTasks( taskList )
+
+		tempDirectory = tempfile.mkdtemp( prefix = "gafferLocalProcessDespatcher" )
+		try :
+			scriptFileName = os.path.join( tempDirectory, "script.gfr" )
+			script.serialiseToFile( scriptFileName )
+			self.__executeTasks( script, scriptFileName, tasks )
+		finally :
+			shutil.rmtree( tempDirectory, ignore_errors = True )
+
+	def _addPlugs( self, despatcherPlug ) :
+
+		localProcessesPlug = Gaffer.CompoundPlug( "localProcesses", Gaffer.Plug.Direction.In )
+		# The maximum number of frames executed by a single worker. The default
+		# value of 0 divides the frames evenly between the available workers.
+		localProcessesPlug["batchSize"] = Gaffer.IntPlug( defaultValue = 0, minValue = 0 )
+		despatcherPlug["localProcesses"] = localProcessesPlug
+
+	@staticmethod
+	def _singleton():
+
+		if LocalProcessDespatcher.__despatcher is None :
+
+			LocalProcessDespatcher.__despatcher = LocalProcessDespatcher()
+
+		return LocalProcessDespatcher.__despatcher
+
+	def __executeTasks( self, script, scriptFileName, tasks ) :
+
+		# Tasks from nodes without an execution hash may appear more than
+		# once, so we map each task to all the indices it occupies, and make
+		# dependents wait for all of them.
+		indices = {}
+		for i, ( task, requirements ) in enumerate( tasks ) :
+			indices.setdefault( task, [] ).append( i )
+
+		requiredIndices = []
+		for i, ( task, requirements ) in enumerate( tasks ) :
+			requiredIndices.append( set( [ j for r in requirements for j in indices.get( r, [] ) if j != i ] ) )
+
+		maxWorkers = self.__maxWorkers()
+
+		remaining = range( 0, len( tasks ) )
+		done = set()
+		failed = set()
+		errors = []
+		running = []
+		finishedWorkers = Queue.Queue()
+
+		try :
+
+			while remaining or running :
+
+				# Tasks which require a failed task can never be executed.
+				for i in [ i for i in remaining if requiredIndices[i] & failed ] :
+					remaining.remove( i )
+					failed.add( i )
+
+				ready = [ i for i in remaining if requiredIndices[i] <= done ]
+				executedLocally = False
+				for batch in self.__batches( script, tasks, ready, maxWorkers ) :
+
+					# Each task is checked individually, because requirements
+					# may vary the context of tasks from the same node.
+					for i in [ i for i in batch if not self.__canExecuteInWorker( script, tasks[i][0] ) ] :
+						task = tasks[i][0]
+						batch.remove( i )
+						remaining.remove( i )
+						executedLocally = True
+						try :
+							task.node.execute( [ task.context ] )
+							done.add( i )
+						except Exception, e :
+							failed.add( i )
+							errors.append( "%s failed on frame %s : %s" % ( task.node.relativeName( script ), task.context.getFrame(), e ) )
+
+					if not batch or len( running ) >= maxWorkers :
+						continue
+
+					for i in batch :
+						remaining.remove( i )
+
+					running.append(
+						_Worker(
+							scriptFileName,
+							# The workers would otherwise take the name
+							# from the temporary file they load.
+							script.context()["script:name"],
+							tasks[batch[0]][0].node.relativeName( script ),
+							[ tasks[i][0].context.getFrame() for i in batch ],
+							batch,
+							finishedWorkers
+						)
+					)
+
+				if executedLocally :
+					continue
+
+				if not running :
+					if remaining :
+						raise RuntimeError( "Unable to schedule tasks with unsatisfiable requirements" )
+					break
+
+				worker = finishedWorkers.get()
+				running.remove( worker )
+				if worker.returnCode == 0 :
+					done.update( worker.batch )
+				else :
+					failed.update( worker.batch )
+					errors.append( "%s failed on frames %s :\n%s" % ( worker.nodeName, worker.frames, worker.output ) )
+
+				IECore.msg(
+					IECore.Msg.Level.Info, "LocalProcessDespatcher",
+					"%s frames %s %s (%d of %d tasks complete)" % (
+						worker.nodeName, worker.frames,
+						"succeeded" if worker.returnCode == 0 else "failed",
+						len( done ), len( tasks )
+					)
+				)
+
+		finally :
+
+			# If we're leaving early due to an exception, make
+			# sure that we don't leave any workers behind.
+			for worker in running :
+				worker.terminate()
+
+		if errors :
+			raise RuntimeError( "\n".join( errors ) )
+
+	def __maxWorkers( self ) :
+
+		result = self.__maxProcesses or multiprocessing.cpu_count()
+		if self.__memoryPerProcess :
+			physicalMemory = os.sysconf( "SC_PAGE_SIZE" ) * os.sysconf( "SC_PHYS_PAGES" ) / ( 1024 * 1024 )
+			result = min( result, physicalMemory / self.__memoryPerProcess )
+
+		return max( result, 1 )
+
+	# Groups the ready tasks by node, and divides each group
+	# into batches to be given to individual workers.
+	def __batches( self, script, tasks, ready, maxWorkers ) :
+
+		groups = []
+		groupsByNode = {}
+		for i in ready :
+			node = tasks[i][0].node
+			key = node.relativeName( script )
+			if key not in groupsByNode :
+				groupsByNode[key] = []
+				groups.append( ( node, groupsByNode[key] ) )
+			groupsByNode[key].append( i )
+
+		result = []
+		for node, group in groups :
+			batchSize = 0
+			localProcessesPlug = node["despatcherParameters"].getChild( "localProcesses" )
+			if localProcessesPlug is not None :
+				batchSize = localProcessesPlug["batchSize"].getValue()
+			if not batchSize :
+				batchSize = int( math.ceil( len( group ) / float( maxWorkers ) ) )
+			for i in range( 0, len( group ), batchSize ) :
+				result.append( group[i:i+batchSize] )
+
+		return result
+
+	@staticmethod
+	def __canExecuteInWorker( script, task ) :
+
+		if not script.isAncestorOf( task.node ) :
+			return False
+
+		frame = task.context.getFrame()
+		if frame != int( frame ) :
+			return False
+
+		workerContext = Gaffer.Context( script.context() )
+		workerContext.setFrame( frame )
+
+		return workerContext == task.context
+
+# Launches a single "gaffer execute" process, and collects its output on
+# a separate thread, notifying the despatcher via a queue on completion.
+class _Worker( threading.Thread ) :
+
+	def __init__( self, scriptFileName, scriptName, nodeName, frames, batch, finishedQueue ) :
+
+		threading.Thread.__init__( self )
+
+		self.nodeName = nodeName
+		self.frames = ",".join( [ str( int( f ) ) for f in frames ] )
+		self.batch = batch
+		self.output = ""
+		self.returnCode = None
+
+		self.__finishedQueue = finishedQueue
+		self.__process = subprocess.Popen(
+			[
+				"gaffer", "execute", scriptFileName,
+				"-nodes", nodeName,
+				"-frames", self.frames,
+				"-context", "script:name=" + scriptName,
+			],
+			stdout = subprocess.PIPE,
+			stderr = subprocess.STDOUT,
+		)
+
+		self.daemon = True
+		self.start()
+
+	def run( self ) :
+
+		try :
+			self.output = self.__process.stdout.read()
+			self.returnCode = self.__process.wait()
+		finally :
+			self.__finishedQueue.put( self )
+
+	def terminate( self ) :
+
+		if self.__process.poll() is None :
+			self.__process.terminate()
+
+IECore.registerRunTimeTyped( LocalProcessDespatcher, typeName = "Gaffer::LocalProcessDespatcher" )
+
+Gaffer.Despatcher._registerDespatcher( "localProcesses", LocalProcessDespatcher._singleton() )
@@ -65,4 +65,5 @@ from GraphComponentPath import GraphComponentPath
 from ParameterPath import ParameterPath
 from OutputRedirection import OutputRedirection
 from LocalDespatcher import LocalDespatcher
+from LocalProcessDespatcher import LocalProcessDespatcher
 
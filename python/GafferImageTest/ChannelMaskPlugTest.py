@@ -109,5 +109,64 @@ class ChannelMaskPlugTest( unittest.TestCase ) :
 		self.assertTrue( maskedChannels[1] == "B" )
 		self.assertTrue( maskedChannels[0] == "R" )
 
+	def testChannelId( self ) :
+	
+		self.assertEqual( GafferImage.ChannelMaskPlug.channelId( "R" ), GafferImage.ChannelMaskPlug.channelId( "R" ) )
+		self.assertNotEqual( GafferImage.ChannelMaskPlug.channelId( "R" ), GafferImage.ChannelMaskPlug.channelId( "G" ) )
+		self.assertNotEqual( GafferImage.ChannelMaskPlug.channelId( "R" ), GafferImage.ChannelMaskPlug.channelId( "diffuse.R" ) )
+	
+	def testChannelMaskBits( self ) :
+	
+		# lots of AOVs, as we might find in a multichannel EXR
+		channels = IECore.StringVectorData()
+		for i in range( 0, 100 ) :
+			for c in "RGBA" :
+				channels.append( "aov%d.%s" % ( i, c ) )
+		
+		mask = IECore.StringVectorData( [ "aov%d.R" % i for i in range( 0, 100, 2 ) ] + [ "notInImage.R" ] )
+		p = GafferImage.ChannelMaskPlug( "p", defaultValue = mask )
+		
+		m = p.channelMask( channels )
+		self.failUnless( isinstance( m, IECore.BoolVectorData ) )
+		for channel in channels :
+			self.assertEqual(
+				GafferImage.ChannelMaskPlug.channelEnabled( m, channel ),
+				channel in mask
+			)
+		
+		self.assertFalse( GafferImage.ChannelMaskPlug.channelEnabled( m, "notInImage.R" ) )
+		self.assertFalse( GafferImage.ChannelMaskPlug.channelEnabled( m, "neverSeenBefore.R" ) )
+		
+		self.assertEqual(
+			[ c for c in channels if GafferImage.ChannelMaskPlug.channelEnabled( m, c ) ],
+			p.maskChannels( channels ),
+		)
+		
+		# changing the mask must give us a new result, not a cached one
+		
+		p.setValue( IECore.StringVectorData( [ "aov1.G" ] ) )
+		m = p.channelMask( channels )
+		self.assertEqual( [ c for c in channels if GafferImage.ChannelMaskPlug.channelEnabled( m, c ) ], [ "aov1.G" ] )
+	
+	def testChannelMaskFromPlug( self ) :
+	
+		n = Gaffer.Node()
+		n["channels"] = Gaffer.StringVectorDataPlug( defaultValue = IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+		n["mask"] = GafferImage.ChannelMaskPlug( "mask", defaultValue = IECore.StringVectorData( [ "R", "B" ] ) )
+		
+		m = n["mask"].channelMask( n["channels"] )
+		self.assertEqual( m, n["mask"].channelMask( n["channels"].getValue() ) )
+		self.assertEqual( [ c for c in "RGBA" if GafferImage.ChannelMaskPlug.channelEnabled( m, c ) ], [ "R", "B" ] )
+		
+		# changing either plug must give us a new result, not a cached one
+		
+		n["channels"].setValue( IECore.StringVectorData( [ "R", "G" ] ) )
+		m = n["mask"].channelMask( n["channels"] )
+		self.assertEqual( [ c for c in "RGBA" if GafferImage.ChannelMaskPlug.channelEnabled( m, c ) ], [ "R" ] )
+		
+		n["mask"].setValue( IECore.StringVectorData( [ "G" ] ) )
+		m = n["mask"].channelMask( n["channels"] )
+		self.assertEqual( [ c for c in "RGBA" if GafferImage.ChannelMaskPlug.channelEnabled( m, c ) ], [ "G" ] )
+		
 if __name__ == "__main__":
 	unittest.main()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import time
 import unittest
 
 import IECore
@@ -57,6 +58,66 @@ class DisplayTest( unittest.TestCase ) :
 			self.assertEqual( p["format"].getValue(), GafferImage.Format.getDefaultFormat( s ) )
 			GafferImage.Format.setDefaultFormat( s, GafferImage.Format( 200, 150, 1. ) )
 			self.assertEqual( p["format"].getValue(), GafferImage.Format.getDefaultFormat( s ) )
+	
+	def testTileHashes( self ) :
+	
+		port = 2500
+		tileSize = GafferImage.ImagePlug.tileSize()
 		
+		d = GafferImage.Display()
+		d["port"].setValue( port )
+		
+		displayWindow = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( tileSize * 4 - 1 ) )
+		driver = IECore.ClientDisplayDriver(
+			displayWindow,
+			displayWindow,
+			[ "R", "G", "B" ],
+			{
+				"displayHost" : IECore.StringData( "localhost" ),
+				"displayPort" : IECore.StringData( str( port ) ),
+				"remoteDisplayType" : IECore.StringData( "GafferImage::GafferDisplayDriver" ),
+			}
+		)
+		
+		self.__waitFor( lambda : d["out"]["dataWindow"].getValue() == displayWindow )
+		
+		self.assertEqual( d["out"]["format"].getValue().getDisplayWindow(), displayWindow )
+		self.assertEqual( d["out"]["dataWindow"].getValue(), displayWindow )
+		self.assertEqual( d["out"]["channelNames"].getValue(), IECore.StringVectorData( [ "R", "G", "B" ] ) )
+		
+		tileOrigins = [ IECore.V2i( x, y ) for x in range( 0, tileSize * 4, tileSize ) for y in range( 0, tileSize * 4, tileSize ) ]
+		hashes = dict( [ ( t, d["out"].channelDataHash( "G", t ) ) for t in tileOrigins ] )
+		
+		# send a bucket at the top left of the image (in the y-down space of
+		# the renderer), which should only touch the top left tile.
+		
+		bucket = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( tileSize - 1 ) )
+		driver.imageData( bucket, IECore.FloatVectorData( [ 0.25, 0.5, 1 ] * tileSize * tileSize ) )
+		
+		topLeft = IECore.V2i( 0, tileSize * 3 )
+		self.__waitFor( lambda : d["out"].channelDataHash( "G", topLeft ) != hashes[topLeft] )
+		
+		for t in tileOrigins :
+			if t == topLeft :
+				self.assertNotEqual( d["out"].channelDataHash( "G", t ), hashes[t] )
+				self.assertEqual( d["out"].channelData( "G", t ), IECore.FloatVectorData( [ 0.5 ] * tileSize * tileSize ) )
+			else :
+				self.assertEqual( d["out"].channelDataHash( "G", t ), hashes[t] )
+				
+		self.assertEqual( d["out"]["format"].getValue().getDisplayWindow(), displayWindow )
+		
+		driver.imageClose()
+	
+	def __waitFor( self, condition ) :
+	
+		# the data is received on a background thread, so we must
+		# wait for it to arrive.
+		for i in range( 0, 100 ) :
+			if condition() :
+				return
+			time.sleep( 0.05 )
+		
+		self.fail( "Data not received" )
+			
 if __name__ == "__main__":
 	unittest.main()
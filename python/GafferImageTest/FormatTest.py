@@ -34,10 +34,14 @@
 #  
 ##########################################################################
 
+import os
+import shutil
 import unittest
+import threading
 
 import IECore
 import Gaffer
+import GafferTest
 
 import GafferImage
 
@@ -65,6 +69,34 @@ class FormatTest( unittest.TestCase ) :
 		# Get the new list of format names and check that it is the same as the old list
 		self.assertEqual( set( existingFormatNames ), set( GafferImage.Format.formatNames() ) )
 		
+	def testRegisterFormatDoesntReplaceExisting( self ) :
+	
+		GafferImage.Format.registerFormat( self.__testFormatValue(), self.__testFormatName() )
+		
+		addedSlot = GafferTest.CapturingSlot( GafferImage.Format.formatAddedSignal() )
+		otherFormat = GafferImage.Format( 100, 200, 1.0 )
+		with IECore.CapturingMessageHandler() as mh :
+			f = GafferImage.Format.registerFormat( otherFormat, self.__testFormatName() )
+		
+		# the existing format must be kept, because references
+		# to it may be held by other threads.
+		self.__assertTestFormat( f )
+		self.__assertTestFormat( GafferImage.Format.getFormat( self.__testFormatName() ) )
+		self.assertEqual( len( addedSlot ), 0 )
+		
+		# but we should be told about it.
+		self.assertEqual( len( mh.messages ), 1 )
+		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Warning )
+		
+		# registering the same format again is fine.
+		with IECore.CapturingMessageHandler() as mh :
+			f = GafferImage.Format.registerFormat( self.__testFormatValue(), self.__testFormatName() )
+		
+		self.__assertTestFormat( f )
+		self.assertEqual( len( mh.messages ), 0 )
+		
+		GafferImage.Format.removeFormat( self.__testFormatName() )
+	
 	def testDefaultFormatPlugExists( self ) :
 		# Create a node to make sure that we have a default format...
 		s = Gaffer.ScriptNode()
@@ -168,6 +200,86 @@ class FormatTest( unittest.TestCase ) :
 		# Get the new list of format names and check that it is the same as the old list
 		self.assertEqual( set( existingFormatNames ), set( GafferImage.Format.formatNames() ) )
 		
+	def testConcurrentRegistrationFromReaders( self ) :
+	
+		os.makedirs( self.__temporaryDirectory )
+		
+		# write out lots of images, each with a unique format
+		
+		sizes = [ ( 101 + i, 53 + i ) for i in range( 0, 50 ) ]
+		fileNames = []
+		c = GafferImage.Constant()
+		w = GafferImage.ImageWriter()
+		w["in"].setInput( c["out"] )
+		for width, height in sizes :
+			fileName = os.path.join( self.__temporaryDirectory, "%dx%d.exr" % ( width, height ) )
+			c["format"].setValue( GafferImage.Format( width, height, 1. ) )
+			w["fileName"].setValue( fileName )
+			w.execute( [ Gaffer.Context() ] )
+			fileNames.append( fileName )
+		
+		existingFormatNames = GafferImage.Format.formatNames()
+		for width, height in sizes :
+			self.assertFalse( "%dx%d 1.000" % ( width, height ) in existingFormatNames )
+			
+		# flush any notifications left pending by other tests
+		GafferImage.Format.emitPendingSignals()
+		
+		addedSlot = GafferTest.CapturingSlot( GafferImage.Format.formatAddedSignal() )
+		
+		# read them all back concurrently, several times over
+		
+		errors = []
+		def f( fileName, width, height ) :
+		
+			try :
+				r = GafferImage.ImageReader()
+				r["fileName"].setValue( fileName )
+				for i in range( 0, 10 ) :
+					format = r["out"]["format"].getValue()
+					if format.getDisplayWindow() != IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( width - 1, height - 1 ) ) :
+						errors.append( "%s has wrong format %s" % ( fileName, format ) )
+			except Exception, e :
+				errors.append( str( e ) )
+	
+		threads = []
+		for fileName, ( width, height ) in zip( fileNames, sizes ) * 4 :
+			t = threading.Thread( target = f, args = ( fileName, width, height ) )
+			t.start()
+			threads.append( t )
+		
+		for t in threads :
+			t.join()
+		
+		self.assertEqual( errors, [] )
+		
+		# all the formats should be registered, but the notifications
+		# should be waiting to be emitted on the main thread.
+		
+		formatNames = GafferImage.Format.formatNames()
+		for width, height in sizes :
+			self.assertTrue( "%dx%d 1.000" % ( width, height ) in formatNames )
+		
+		self.assertEqual( len( addedSlot ), 0 )
+		
+		GafferImage.Format.emitPendingSignals()
+		
+		self.assertEqual( len( addedSlot ), len( sizes ) )
+		self.assertEqual(
+			set( [ a[0] for a in addedSlot ] ),
+			set( [ "%dx%d 1.000" % s for s in sizes ] ),
+		)
+		
+		for width, height in sizes :
+			GafferImage.Format.removeFormat( "%dx%d 1.000" % ( width, height ) )
+		
+	def tearDown( self ) :
+	
+		if os.path.exists( self.__temporaryDirectory ) :
+			shutil.rmtree( self.__temporaryDirectory )
+	
+	__temporaryDirectory = "/tmp/gafferFormatTest"
+			
 	def __assertTestFormat( self, testFormat ):
 		self.assertEqual( testFormat.getPixelAspect(), 1.4 )
 		self.assertEqual( testFormat.width(), 1234 )
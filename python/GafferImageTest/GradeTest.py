@@ -88,6 +88,24 @@ class GradeTest( unittest.TestCase ) :
 		h2 = grade["out"].channelData( "R", IECore.V2i( GafferImage.ImagePlug().tileSize() ) ).hash()
 		self.assertNotEqual( h1, h2 )
 		
+	def testTilesOutsideDataWindowAreBlack( self ) :
+	
+		i = GafferImage.ImageReader()
+		i["fileName"].setValue( self.checkerFile )
+		
+		# lift would make black pixels grey, but tiles outside
+		# the data window are black regardless.
+		grade = GafferImage.Grade()
+		grade["in"].setInput(i["out"])
+		grade["lift"].setValue( IECore.Color3f( 0.5 ) )
+		
+		tileOrigin = IECore.V2i( -GafferImage.ImagePlug.tileSize() * 10 )
+		self.assertEqual( grade["out"].channelDataHash( "R", tileOrigin ), GafferImage.ImagePlug()["channelData"].defaultValue().hash() )
+		
+		GafferImage.ImageProcessor.resetTilesSkipped()
+		self.assertEqual( grade["out"].channelData( "R", tileOrigin ), GafferImage.ImagePlug()["channelData"].defaultValue() )
+		self.assertEqual( GafferImage.ImageProcessor.tilesSkipped(), 1 )
+		
 	def testEnableBehaviour( self ) :
 		
 		g = GafferImage.Grade()
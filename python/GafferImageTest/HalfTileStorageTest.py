@@ -0,0 +1,131 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import subprocess
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferImage
+
+## Half tile storage is chosen at startup, so these tests
+# launch subprocesses to compare it with the default.
+class HalfTileStorageTest( unittest.TestCase ) :
+
+	__scriptFileName = "/tmp/halfTileStorageTest.py"
+	__outputFileName = "/tmp/halfTileStorageTest.%s.exr"
+
+	# Grades and resizes an image twice, reporting whether or not the
+	# results match and the memory used by the half tile cache on stdout.
+	__script = """
+import os
+import IECore
+import Gaffer
+import GafferImage
+
+r = GafferImage.ImageReader()
+r["fileName"].setValue( os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checker.exr" ) )
+
+g = GafferImage.Grade()
+g["in"].setInput( r["out"] )
+g["gain"].setValue( IECore.Color3f( 0.5, 1, 2 ) )
+
+f = GafferImage.Reformat()
+f["in"].setInput( g["out"] )
+f["format"].setValue( GafferImage.Format( 2048, 1556, 1. ) )
+
+uncachedImage = f["out"].image()
+image = f["out"].image()
+
+IECore.Writer.create( image, argv[0] ).write()
+print GafferImage.ImageNode.halfTileStorage(), image == uncachedImage, GafferImage.ImageNode.halfTileCacheMemoryUsage()
+"""
+
+	def testDefault( self ) :
+
+		self.assertEqual( GafferImage.ImageNode.halfTileStorage(), os.environ.get( "GAFFERIMAGE_HALFTILES" ) == "1" )
+
+	def testHalfTileStorage( self ) :
+
+		halfTileStorage, halfMatches, halfMemory = self.__run( "1", self.__outputFileName % "half" )
+		self.assertEqual( halfTileStorage, "True" )
+		self.assertTrue( int( halfMemory ) > 0 )
+
+		floatTileStorage, floatMatches, floatMemory = self.__run( "0", self.__outputFileName % "float" )
+		self.assertEqual( floatTileStorage, "False" )
+		self.assertEqual( int( floatMemory ), 0 )
+
+		# the result must not depend on whether or not
+		# the tiles were already in the cache.
+		self.assertEqual( halfMatches, "True" )
+		self.assertEqual( floatMatches, "True" )
+
+		# results should be identical to within half precision
+		halfImage = IECore.Reader.create( self.__outputFileName % "half" ).read()
+		floatImage = IECore.Reader.create( self.__outputFileName % "float" ).read()
+		self.assertFalse( IECore.ImageDiffOp()( imageA = halfImage, imageB = floatImage, maxError = 0.005 ).value )
+
+	def __run( self, halfTiles, outputFileName ) :
+
+		f = open( self.__scriptFileName, "w" )
+		f.write( self.__script )
+		f.close()
+
+		env = os.environ.copy()
+		env["GAFFERIMAGE_HALFTILES"] = halfTiles
+
+		p = subprocess.Popen(
+			[ "gaffer", "python", self.__scriptFileName, "-arguments", outputFileName ],
+			env = env,
+			stdout = subprocess.PIPE,
+			stderr = subprocess.PIPE,
+		)
+		stdout, stderr = p.communicate()
+		self.failIf( p.returncode, stderr )
+
+		return stdout.strip().split( "\n" )[-1].split()
+
+	def tearDown( self ) :
+
+		for f in [ self.__scriptFileName, self.__outputFileName % "half", self.__outputFileName % "float" ] :
+			if os.path.exists( f ) :
+				os.remove( f )
+
+if __name__ == "__main__":
+	unittest.main()
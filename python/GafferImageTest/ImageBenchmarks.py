@@ -0,0 +1,409 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import shutil
+import tempfile
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferImage
+
+# The source images are cached by resolution, because
+# they are relatively expensive to generate in python.
+_sourceImages = {}
+
+# Returns an ImagePrimitive containing horizontal and vertical ramps
+# and a checkerboard, so that no tiles are uniform and no channels
+# are identical.
+def _sourceImage( width, height ) :
+
+	key = ( width, height )
+	if key in _sourceImages :
+		return _sourceImages[key]
+
+	window = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( width - 1, height - 1 ) )
+	image = IECore.ImagePrimitive( window, window )
+
+	red = [ x / float( width ) for x in range( 0, width ) ] * height
+
+	green = []
+	for y in range( 0, height ) :
+		green.extend( [ y / float( height ) ] * width )
+
+	checkerRows = [
+		( ( [ 0.0 ] * 8 + [ 1.0 ] * 8 ) * ( width / 16 + 1 ) )[:width],
+		( ( [ 1.0 ] * 8 + [ 0.0 ] * 8 ) * ( width / 16 + 1 ) )[:width],
+	]
+	blue = []
+	for y in range( 0, height ) :
+		blue.extend( checkerRows[(y/8)%2] )
+
+	alpha = [ 1.0 ] * ( width * height )
+
+	for name, values in ( ( "R", red ), ( "G", green ), ( "B", blue ), ( "A", alpha ) ) :
+		image[name] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( values ) )
+
+	_sourceImages[key] = image
+	return image
+
+## Base class for benchmarks which pull a whole image through a graph
+# fed by a procedurally generated source image, so that no files are
+# needed. The cold run includes the conversion of the source image into
+# tiles.
+class ImageBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, name, width, height ) :
+
+		GafferTest.Benchmark.__init__( self, "%s.%dx%d" % ( name, width, height ) )
+
+		self.width = width
+		self.height = height
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+		self.__script["source"] = GafferImage.ObjectToImage()
+		self.__script["source"]["object"].setValue( _sourceImage( *self._sourceSize() ) )
+
+		self.__out = self._buildGraph( self.__script, self.__script["source"]["out"] )
+
+		# Benchmark.execute() clears the ValuePlug cache before the cold
+		# run, but the half tile cache must be emptied separately.
+		limit = GafferImage.ImageNode.getHalfTileCacheMemoryLimit()
+		GafferImage.ImageNode.setHalfTileCacheMemoryLimit( 0 )
+		GafferImage.ImageNode.setHalfTileCacheMemoryLimit( limit )
+
+		GafferImage.ImageProcessor.resetTilesSkipped()
+
+	def run( self ) :
+
+		self.__out.image()
+
+	def tearDown( self ) :
+
+		del self.__script
+		del self.__out
+
+	def measurements( self, seconds ) :
+
+		# measurements() is called after each run, so we reset the
+		# count of skipped tiles here, ready for the next one.
+		tilesSkipped = GafferImage.ImageProcessor.tilesSkipped()
+		GafferImage.ImageProcessor.resetTilesSkipped()
+
+		return {
+			"megapixelsPerSecond" : self._pixelsProcessed() / ( 1000000.0 * max( seconds, 1e-6 ) ),
+			"halfTileCacheMemoryUsage" : GafferImage.ImageNode.halfTileCacheMemoryUsage(),
+			"tilesSkipped" : tilesSkipped,
+		}
+
+	## Must be implemented by derived classes to build a graph within
+	# script, returning the ImagePlug to be pulled on.
+	def _buildGraph( self, script, source ) :
+
+		raise NotImplementedError
+
+	## Returns the width and height of the source image. The default
+	# implementation returns the resolution of the benchmark.
+	def _sourceSize( self ) :
+
+		return self.width, self.height
+
+	## Returns the number of pixels processed by the nodes being measured
+	# during a single run, from which the throughput is reported. The default
+	# implementation returns the number of pixels in the source image.
+	def _pixelsProcessed( self ) :
+
+		return self.width * self.height
+
+## The ObjectToImage node on its own, so that the cold run measures
+# the conversion of the source image into tiles.
+class ObjectToImageBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "objectToImage", width, height )
+
+	def _buildGraph( self, script, source ) :
+
+		return source
+
+## A chain of Grade nodes.
+class GradeChainBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height, numNodes = 10 ) :
+
+		ImageBenchmark.__init__( self, "gradeChain", width, height )
+
+		self.__numNodes = numNodes
+
+	def _buildGraph( self, script, source ) :
+
+		upstream = source
+		for i in range( 0, self.__numNodes ) :
+			grade = GafferImage.Grade( "grade%d" % i )
+			script.addChild( grade )
+			grade["in"].setInput( upstream )
+			grade["gain"].setValue( IECore.Color3f( 1.01 ) )
+			grade["gamma"].setValue( IECore.Color3f( 0.99 ) )
+			upstream = grade["out"]
+
+		return upstream
+
+	def _pixelsProcessed( self ) :
+
+		return self.width * self.height * self.__numNodes
+
+## A Merge with many inputs, each offset from the last.
+class MergeBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height, numInputs = 8 ) :
+
+		ImageBenchmark.__init__( self, "merge", width, height )
+
+		self.__numInputs = numInputs
+
+	def _buildGraph( self, script, source ) :
+
+		script["merge"] = GafferImage.Merge()
+		script["merge"]["operation"].setValue( 8 ) # over
+
+		for i in range( 0, self.__numInputs ) :
+			transform = GafferImage.ImageTransform( "offset%d" % i )
+			script.addChild( transform )
+			transform["in"].setInput( source )
+			transform["transform"]["translate"].setValue( IECore.V2f( i * 10, i * 10 ) )
+			script["merge"]["in%s" % ( i or "" )].setInput( transform["out"] )
+
+		return script["merge"]["out"]
+
+	def _pixelsProcessed( self ) :
+
+		return self.width * self.height * self.__numInputs
+
+## A Reformat to a resolution scaled relative to the source.
+class ReformatBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height, scale ) :
+
+		ImageBenchmark.__init__( self, "reformatUp" if scale > 1 else "reformatDown", width, height )
+
+		self.__scale = scale
+
+	def _buildGraph( self, script, source ) :
+
+		script["reformat"] = GafferImage.Reformat()
+		script["reformat"]["in"].setInput( source )
+		script["reformat"]["format"].setValue(
+			GafferImage.Format( int( self.width * self.__scale ), int( self.height * self.__scale ), 1. )
+		)
+
+		return script["reformat"]["out"]
+
+	def _pixelsProcessed( self ) :
+
+		return int( self.width * self.__scale ) * int( self.height * self.__scale )
+
+## An ImageTransform rotating the image about its centre.
+class ImageTransformBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "imageTransformRotate", width, height )
+
+	def _buildGraph( self, script, source ) :
+
+		script["transform"] = GafferImage.ImageTransform()
+		script["transform"]["in"].setInput( source )
+		script["transform"]["transform"]["pivot"].setValue( IECore.V2f( self.width / 2., self.height / 2. ) )
+		script["transform"]["transform"]["rotate"].setValue( 30 )
+
+		return script["transform"]["out"]
+
+## A small graded element merged over a large constant plate, as is common
+# when most of a render is empty. This measures how well uniform tiles
+# avoid processing the empty areas. The source image is an eighth of the
+# resolution in each dimension, and is placed at the centre of the plate.
+class SparseMergeBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "sparseMerge", width, height )
+
+	def _sourceSize( self ) :
+
+		return max( self.width / 8, 1 ), max( self.height / 8, 1 )
+
+	def _buildGraph( self, script, source ) :
+
+		script["transform"] = GafferImage.ImageTransform()
+		script["transform"]["in"].setInput( source )
+		script["transform"]["transform"]["translate"].setValue( IECore.V2f( self.width / 2, self.height / 2 ) )
+
+		script["grade"] = GafferImage.Grade()
+		script["grade"]["in"].setInput( script["transform"]["out"] )
+		script["grade"]["gain"].setValue( IECore.Color3f( 2 ) )
+
+		script["plate"] = GafferImage.Constant()
+		script["plate"]["format"].setValue( GafferImage.Format( self.width, self.height, 1. ) )
+		script["plate"]["color"].setValue( IECore.Color4f( 0.1, 0.2, 0.3, 1 ) )
+
+		script["merge"] = GafferImage.Merge()
+		script["merge"]["operation"].setValue( 8 ) # over
+		script["merge"]["in"].setInput( script["plate"]["out"] )
+		script["merge"]["in1"].setInput( script["grade"]["out"] )
+
+		return script["merge"]["out"]
+
+## An ImageTransform which enlarges and rotates the image, and is
+# therefore resampled in a single pass.
+class ImageTransformScaleBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "imageTransformScaleRotate", width, height )
+
+	def _buildGraph( self, script, source ) :
+
+		script["transform"] = GafferImage.ImageTransform()
+		script["transform"]["in"].setInput( source )
+		script["transform"]["transform"]["scale"].setValue( IECore.V2f( 2 ) )
+		script["transform"]["transform"]["rotate"].setValue( 30 )
+
+		return script["transform"]["out"]
+
+	def _pixelsProcessed( self ) :
+
+		return self.width * self.height * 4
+
+## The two pass equivalent of ImageTransformScaleBenchmark, enlarging
+# the image with a Reformat before rotating it with an ImageTransform.
+class ReformatImageTransformBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "reformatImageTransformRotate", width, height )
+
+	def _buildGraph( self, script, source ) :
+
+		script["reformat"] = GafferImage.Reformat()
+		script["reformat"]["in"].setInput( source )
+		script["reformat"]["format"].setValue( GafferImage.Format( self.width * 2, self.height * 2, 1. ) )
+
+		script["transform"] = GafferImage.ImageTransform()
+		script["transform"]["in"].setInput( script["reformat"]["out"] )
+		script["transform"]["transform"]["rotate"].setValue( 30 )
+
+		return script["transform"]["out"]
+
+	def _pixelsProcessed( self ) :
+
+		return self.width * self.height * 4
+
+## An OpenColorIO conversion from linear to sRGB.
+class OpenColorIOBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "openColorIO", width, height )
+
+	def _buildGraph( self, script, source ) :
+
+		script["colorSpace"] = GafferImage.OpenColorIO()
+		script["colorSpace"]["in"].setInput( source )
+		script["colorSpace"]["inputSpace"].setValue( "linear" )
+		script["colorSpace"]["outputSpace"].setValue( "sRGB" )
+
+		return script["colorSpace"]["out"]
+
+## An ImageWriter writing to a temporary directory. Rather than
+# pulling on the output, each run executes the writer.
+class ImageWriterBenchmark( ImageBenchmark ) :
+
+	def __init__( self, width, height ) :
+
+		ImageBenchmark.__init__( self, "imageWriter", width, height )
+
+	def setUp( self ) :
+
+		self.__directory = tempfile.mkdtemp( prefix = "gafferImageWriterBenchmark" )
+		ImageBenchmark.setUp( self )
+
+	def run( self ) :
+
+		self.__writer.execute( [ Gaffer.Context() ] )
+
+	def tearDown( self ) :
+
+		del self.__writer
+		ImageBenchmark.tearDown( self )
+		shutil.rmtree( self.__directory, ignore_errors = True )
+
+	def _buildGraph( self, script, source ) :
+
+		script["writer"] = GafferImage.ImageWriter()
+		script["writer"]["in"].setInput( source )
+		script["writer"]["fileName"].setValue( os.path.join( self.__directory, "image.exr" ) )
+		script["writer"]["channels"].setValue( IECore.StringVectorData( [ "R", "G", "B", "A" ] ) )
+		self.__writer = script["writer"]
+
+		return script["writer"]["in"]
+
+## Returns the image benchmarks to be run by the "gaffer benchmark"
+# app, for each of the specified square resolutions.
+def benchmarks( resolutions = ( 512, 1024, 2048 ) ) :
+
+	result = []
+	for r in resolutions :
+		result.extend( [
+			ObjectToImageBenchmark( r, r ),
+			GradeChainBenchmark( r, r ),
+			MergeBenchmark( r, r ),
+			SparseMergeBenchmark( r, r ),
+			ReformatBenchmark( r, r, 2.0 ),
+			ReformatBenchmark( r, r, 0.5 ),
+			ImageTransformBenchmark( r, r ),
+			ImageTransformScaleBenchmark( r, r ),
+			ReformatImageTransformBenchmark( r, r ),
+			OpenColorIOBenchmark( r, r ),
+			ImageWriterBenchmark( r, r ),
+		] )
+
+	return result
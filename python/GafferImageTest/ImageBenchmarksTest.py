@@ -0,0 +1,85 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import unittest
+
+import IECore
+
+import GafferImage
+import GafferImageTest
+
+class ImageBenchmarksTest( unittest.TestCase ) :
+
+	def testSourceImage( self ) :
+
+		i = GafferImageTest.ImageBenchmarks._sourceImage( 64, 32 )
+		self.assertEqual( i.dataWindow, IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 63, 31 ) ) )
+		self.assertEqual( set( i.keys() ), set( [ "R", "G", "B", "A" ] ) )
+		for c in i.keys() :
+			self.assertEqual( len( i[c].data ), 64 * 32 )
+
+		self.failUnless( GafferImageTest.ImageBenchmarks._sourceImage( 64, 32 ).isSame( i ) )
+
+	def testExecute( self ) :
+
+		for benchmark in GafferImageTest.ImageBenchmarks.benchmarks( resolutions = ( 64, ) ) :
+
+			# the OpenColorIO benchmark depends on the config provided
+			# by the environment, which the unit tests shouldn't.
+			if isinstance( benchmark, GafferImageTest.ImageBenchmarks.OpenColorIOBenchmark ) :
+				continue
+
+			results = benchmark.execute( repeats = 1 )
+			self.failUnless( results["cold"]["megapixelsPerSecond"] > 0, benchmark.name() )
+			self.failUnless( results["cold"]["computeCount"] > 0, benchmark.name() )
+			self.failUnless( results["warm"]["computeCount"] < results["cold"]["computeCount"], benchmark.name() )
+
+	def testTilesSkipped( self ) :
+
+		# the source image covers only a small part of the plate,
+		# so the merge should skip most of the input tiles.
+		results = GafferImageTest.ImageBenchmarks.SparseMergeBenchmark( 512, 512 ).execute( repeats = 0 )
+		self.failUnless( results["cold"]["tilesSkipped"] > 0 )
+
+	def testBenchmarkNamesAreUnique( self ) :
+
+		names = [ b.name() for b in GafferImageTest.ImageBenchmarks.benchmarks() ]
+		self.assertEqual( len( names ), len( set( names ) ) )
+		self.failUnless( "gradeChain.1024x1024" in names )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -125,5 +125,22 @@ class ImagePlugTest( GafferTest.TestCase ) :
 		self.assertDefaultNamesAreCorrect( GafferImage )
 		self.assertDefaultNamesAreCorrect( GafferImageTest )
 	
+	def testCancellation( self ) :
+	
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 1, 0, 0, 1 ) )
+		
+		canceller = Gaffer.Canceller()
+		canceller.cancel()
+		
+		context = Gaffer.Context()
+		context.setCanceller( canceller )
+		with context :
+			self.assertRaises( RuntimeError, c["out"].image )
+			self.assertRaises( RuntimeError, c["out"].imageHash )
+		
+		# the cancelled computation mustn't affect subsequent ones
+		self.assertEqual( c["out"].image(), c["out"].image() )
+		
 if __name__ == "__main__":
 	unittest.main()
@@ -184,5 +184,25 @@ class ImageReaderTest( unittest.TestCase ) :
 		
 		self.assertEqual( image, image2 )
 				
+	def testMipLevelsClamped( self ) :
+	
+		# The checker isn't mip-mapped, so all levels
+		# should give the full resolution image.
+		n = GafferImage.ImageReader()
+		n["fileName"].setValue( self.fileName )
+		self.assertEqual( n.numMipLevels(), 1 )
+		
+		image = n["out"].image()
+		h = n["out"]["channelData"].hash()
+		
+		# the clamped level is hashed, so the identical
+		# data is given an identical hash.
+		n["mipLevel"].setValue( 2 )
+		self.assertEqual( n["out"]["channelData"].hash(), h )
+		self.assertEqual( n["out"].image(), image )
+		
+		n["fileName"].setValue( "" )
+		self.assertEqual( n.numMipLevels(), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
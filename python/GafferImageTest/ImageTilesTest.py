@@ -0,0 +1,149 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferImage
+
+class ImageTilesTest( unittest.TestCase ) :
+
+	fileName = os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checkerWithNegativeDataWindow.200x150.exr" )
+
+	def testTileOrigins( self ) :
+	
+		tileSize = GafferImage.ImagePlug.tileSize()
+		
+		self.assertEqual( GafferImage.ImageTiles.tileOrigins( IECore.Box2i() ), [] )
+		self.assertEqual(
+			GafferImage.ImageTiles.tileOrigins( IECore.Box2i( IECore.V2i( 1 ), IECore.V2i( 2 ) ) ),
+			[ IECore.V2i( 0 ) ]
+		)
+		self.assertEqual(
+			GafferImage.ImageTiles.tileOrigins( IECore.Box2i( IECore.V2i( -1, 0 ), IECore.V2i( tileSize, 1 ) ) ),
+			[ IECore.V2i( -tileSize, 0 ), IECore.V2i( 0, 0 ), IECore.V2i( tileSize, 0 ) ]
+		)
+
+	def testUpdate( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		dataWindow = r["out"]["dataWindow"].getValue()
+		
+		t = GafferImage.ImageTiles()
+		self.assertEqual( t.numTiles(), 0 )
+		
+		# Windows are clipped to the data window.
+		window = IECore.Box2i( dataWindow.min - IECore.V2i( 100 ), dataWindow.max + IECore.V2i( 100 ) )
+		numTiles = len( GafferImage.ImageTiles.tileOrigins( dataWindow ) )
+		self.assertEqual( t.update( r["out"], window ), numTiles )
+		self.assertEqual( t.window(), dataWindow )
+		self.assertEqual( t.numTiles(), numTiles )
+		
+		for tileOrigin in GafferImage.ImageTiles.tileOrigins( dataWindow ) :
+			self.assertEqual( t.channelData( tileOrigin, "R" ), r["out"].channelData( "R", tileOrigin ) )
+		
+		# Nothing has changed, so nothing should be computed.
+		self.assertEqual( t.update( r["out"], window ), 0 )
+		self.assertEqual( t.numTiles(), numTiles )
+
+	def testWindowChanges( self ) :
+	
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 512, 512, 1 ) )
+		tileSize = GafferImage.ImagePlug.tileSize()
+		
+		t = GafferImage.ImageTiles()
+		window1 = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 2 * tileSize - 1 ) )
+		self.assertEqual( t.update( c["out"], window1 ), 4 )
+		
+		# Only the tiles which weren't in the previous window
+		# should be computed.
+		window2 = IECore.Box2i( IECore.V2i( tileSize ), IECore.V2i( 3 * tileSize - 1 ) )
+		self.assertEqual( t.update( c["out"], window2 ), 3 )
+		self.assertEqual( t.numTiles(), 4 )
+		self.assertEqual( t.tileHash( IECore.V2i( 0 ) ), IECore.MurmurHash() )
+		self.assertNotEqual( t.tileHash( IECore.V2i( tileSize ) ), IECore.MurmurHash() )
+		
+		# But when the image changes, all tiles must be recomputed.
+		h = t.tileHash( IECore.V2i( tileSize ) )
+		c["color"].setValue( IECore.Color4f( 1, 0.5, 0.25, 1 ) )
+		self.assertEqual( t.update( c["out"], window2 ), 4 )
+		self.assertNotEqual( t.tileHash( IECore.V2i( tileSize ) ), h )
+		
+		t.clear()
+		self.assertEqual( t.numTiles(), 0 )
+		self.assertEqual( t.window(), IECore.Box2i() )
+
+	def testSample( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		dataWindow = r["out"]["dataWindow"].getValue()
+
+		t = GafferImage.ImageTiles()
+		t.update( r["out"], dataWindow )
+		
+		samplers = [ GafferImage.Sampler( r["out"], c, dataWindow ) for c in ( "R", "G", "B", "A" ) ]
+		for y in range( dataWindow.min.y, dataWindow.max.y + 1, 13 ) :
+			for x in range( dataWindow.min.x, dataWindow.max.x + 1, 11 ) :
+				c = t.sample( IECore.V2i( x, y ) )
+				for i in range( 0, 4 ) :
+					self.assertEqual( c[i], samplers[i].sample( x, y ) )
+	
+		self.assertEqual( t.sample( dataWindow.max + IECore.V2i( 1 ) ), IECore.Color4f( 0 ) )
+		
+	def testMissingChannels( self ) :
+	
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 1, 0.5, 0.25, 1 ) )
+		
+		d = GafferImage.RemoveChannels()
+		d["in"].setInput( c["out"] )
+		d["channels"].setValue( IECore.StringVectorData( [ "G" ] ) )
+		
+		t = GafferImage.ImageTiles()
+		t.update( d["out"], IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 10 ) ) )
+		
+		self.assertEqual( t.channelData( IECore.V2i( 0 ), "G" ), None )
+		self.assertEqual( t.sample( IECore.V2i( 5 ) ), IECore.Color4f( 1, 0, 0.25, 1 ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -175,6 +175,53 @@ class ImageTransformTest( unittest.TestCase ) :
 	def testSincFilter( self ) :
 		self.__testFilter( "Sinc" )
 
+	def testSinglePassMatchesChain( self ) :
+	
+		reader = GafferImage.ImageReader()
+		reader["fileName"].setValue( os.path.join( self.path, "checkerWithNegativeDataWindow.200x150.exr" ) )
+		
+		# An enlarging transform, which is resampled in a single pass.
+		singlePass = GafferImage.ImageTransform()
+		singlePass["in"].setInput( reader["out"] )
+		singlePass["transform"]["scale"].setValue( IECore.V2f( 2 ) )
+		singlePass["transform"]["rotate"].setValue( 30 )
+		singlePass["transform"]["translate"].setValue( IECore.V2f( 20, -10 ) )
+		
+		self.assertEqual( singlePass["__scaledFormat"].getValue(), reader["out"]["format"].getValue() )
+		
+		# The equivalent two pass chain, which scales first and then rotates.
+		displayWindow = reader["out"]["format"].getValue().getDisplayWindow()
+		self.assertEqual( displayWindow.min, IECore.V2i( 0 ) )
+		reformat = GafferImage.Reformat()
+		reformat["in"].setInput( reader["out"] )
+		reformat["format"].setValue( GafferImage.Format( IECore.Box2i( IECore.V2i( 0 ), displayWindow.max * 2 + IECore.V2i( 1 ) ), 1. ) )
+		
+		chain = GafferImage.ImageTransform()
+		chain["in"].setInput( reformat["out"] )
+		chain["transform"]["rotate"].setValue( 30 )
+		chain["transform"]["translate"].setValue( IECore.V2f( 20, -10 ) )
+		
+		# Compare the two where they both have data.
+		window = IECore.Box2i(
+			IECore.V2i( max( singlePass["out"]["dataWindow"].getValue().min.x, chain["out"]["dataWindow"].getValue().min.x ), max( singlePass["out"]["dataWindow"].getValue().min.y, chain["out"]["dataWindow"].getValue().min.y ) ),
+			IECore.V2i( min( singlePass["out"]["dataWindow"].getValue().max.x, chain["out"]["dataWindow"].getValue().max.x ), min( singlePass["out"]["dataWindow"].getValue().max.y, chain["out"]["dataWindow"].getValue().max.y ) ),
+		)
+		self.assertFalse( window.isEmpty() )
+		
+		width = window.size().x + 1
+		sumSquaredError = 0.0
+		with Gaffer.Context() :
+			s1 = GafferImage.Sampler( singlePass["out"], "R", window, GafferImage.BoundingMode.Black )
+			s2 = GafferImage.Sampler( chain["out"], "R", window, GafferImage.BoundingMode.Black )
+			for y in range( window.min.y, window.max.y + 1 ) :
+				r1 = s1.sampleRow( window.min.x, y, width )
+				r2 = s2.sampleRow( window.min.x, y, width )
+				for x in range( 0, width ) :
+					sumSquaredError += ( r1[x] - r2[x] ) ** 2
+		
+		rmsError = ( sumSquaredError / ( width * ( window.size().y + 1 ) ) ) ** 0.5
+		self.assertLess( rmsError, 0.05 )
+	
 	def __testFilter( self, filter ) :
 		
 		reader = GafferImage.ImageReader()
@@ -173,6 +173,40 @@ class MergeTest( unittest.TestCase ) :
 		
 		self.assertTrue( not IECore.ImageDiffOp()( imageA = expected, imageB = mergeResult, skipMissingChannels = False, maxError = 0.001 ).value )
 		
+	def testSkipInputsOutsideDataWindow( self ) :
+	
+		c = GafferImage.ImageReader()
+		c["fileName"].setValue( self.checkerPath )
+		
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.rPath )
+		
+		# move the red image well away from the checker,
+		# so no tile contains data from both.
+		t = GafferImage.ImageTransform()
+		t["in"].setInput( r["out"] )
+		t["transform"]["translate"].setValue( IECore.V2f( GafferImage.ImagePlug.tileSize() * 4, 0 ) )
+		
+		merge = GafferImage.Merge()
+		merge["operation"].setValue( 8 ) # over
+		merge["in"].setInput( c["out"] )
+		merge["in1"].setInput( t["out"] )
+		
+		GafferImage.ImageProcessor.resetTilesSkipped()
+		merge["out"].image()
+		self.assertTrue( GafferImage.ImageProcessor.tilesSkipped() > 0 )
+		
+		# the merged tiles must match the input tiles that they came from.
+		for channelName in [ "R", "G", "B" ] :
+			self.assertEqual(
+				merge["out"].channelData( channelName, IECore.V2i( 0 ) ),
+				c["out"].channelData( channelName, IECore.V2i( 0 ) )
+			)
+			self.assertEqual(
+				merge["out"].channelData( channelName, IECore.V2i( GafferImage.ImagePlug.tileSize() * 4, 0 ) ),
+				t["out"].channelData( channelName, IECore.V2i( GafferImage.ImagePlug.tileSize() * 4, 0 ) )
+			)
+
 
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,153 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferImage
+
+class MipMapTest( unittest.TestCase ) :
+
+	fileName = os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checkerWithNegativeDataWindow.200x150.exr" )
+
+	def testLevelWindow( self ) :
+	
+		w = IECore.Box2i( IECore.V2i( -5, -4 ), IECore.V2i( 10, 11 ) )
+		self.assertEqual( GafferImage.MipMap.levelWindow( w, 0 ), w )
+		self.assertEqual( GafferImage.MipMap.levelWindow( w, 1 ), IECore.Box2i( IECore.V2i( -3, -2 ), IECore.V2i( 5, 5 ) ) )
+		self.assertEqual( GafferImage.MipMap.levelWindow( w, 2 ), IECore.Box2i( IECore.V2i( -2, -1 ), IECore.V2i( 2, 2 ) ) )
+		self.assertEqual( GafferImage.MipMap.levelWindow( IECore.Box2i(), 2 ), IECore.Box2i() )
+
+	def testLevelZeroPassesThrough( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		
+		m = GafferImage.MipMap()
+		m["in"].setInput( r["out"] )
+		
+		self.assertEqual( m["out"].imageHash(), r["out"].imageHash() )
+		
+		m["level"].setValue( 1 )
+		self.assertNotEqual( m["out"].imageHash(), r["out"].imageHash() )
+
+	def testWindows( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		
+		m = GafferImage.MipMap()
+		m["in"].setInput( r["out"] )
+		
+		displayWindow = r["out"]["format"].getValue().getDisplayWindow()
+		dataWindow = r["out"]["dataWindow"].getValue()
+		
+		for level in range( 1, 6 ) :
+			m["level"].setValue( level )
+			self.assertEqual( m["out"]["format"].getValue().getDisplayWindow(), GafferImage.MipMap.levelWindow( displayWindow, level ) )
+			self.assertEqual( m["out"]["dataWindow"].getValue(), GafferImage.MipMap.levelWindow( dataWindow, level ) )
+			self.assertEqual( m["out"]["channelNames"].getValue(), r["out"]["channelNames"].getValue() )
+
+	def testAverages( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+		
+		m = GafferImage.MipMap()
+		m["in"].setInput( r["out"] )
+
+		dataWindow = r["out"]["dataWindow"].getValue()
+		
+		with Gaffer.Context() :
+		
+			for level in ( 1, 2, 3 ) :
+			
+				m["level"].setValue( level )
+				levelDataWindow = m["out"]["dataWindow"].getValue()
+				
+				inSampler = GafferImage.Sampler( r["out"], "R", dataWindow, GafferImage.BoundingMode.Black )
+				outSampler = GafferImage.Sampler( m["out"], "R", levelDataWindow, GafferImage.BoundingMode.Black )
+				
+				size = 2 ** level
+				for y in range( levelDataWindow.min.y, levelDataWindow.max.y + 1, 7 ) :
+					for x in range( levelDataWindow.min.x, levelDataWindow.max.x + 1, 5 ) :
+						s = 0.0
+						for j in range( 0, size ) :
+							row = inSampler.sampleRow( x * size, y * size + j, size )
+							s += sum( row )
+						self.assertAlmostEqual( outSampler.sample( x, y ), s / ( size * size ), 5 )
+	
+	def testUniformTilesStayUniform( self ) :
+	
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+		
+		m = GafferImage.MipMap()
+		m["in"].setInput( c["out"] )
+		m["level"].setValue( 2 )
+		
+		self.assertTrue( m["out"].isUniformTile( "R", IECore.V2i( 0 ) ) )
+		self.assertEqual( m["out"].channelData( "G", IECore.V2i( 0 ) )[0], 0.5 )
+
+	def testDirtyPropagation( self ) :
+	
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )
+
+		m = GafferImage.MipMap()
+		m["in"].setInput( r["out"] )
+		
+		cs = GafferTest.CapturingSlot( m.plugDirtiedSignal() )
+		m["level"].setValue( 2 )
+		
+		dirtiedPlugs = set( [ x[0].relativeName( x[0].node() ) for x in cs ] )
+		self.assertTrue( "out.format" in dirtiedPlugs )
+		self.assertTrue( "out.dataWindow" in dirtiedPlugs )
+		self.assertTrue( "out.channelData" in dirtiedPlugs )
+		
+		del cs[:]
+		r["fileName"].setValue( "" )
+		
+		dirtiedPlugs = set( [ x[0].relativeName( x[0].node() ) for x in cs ] )
+		self.assertTrue( "out.channelData" in dirtiedPlugs )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -66,6 +66,24 @@ class ObjectToImageTest( unittest.TestCase ) :
 		n["object"].setValue( i )
 		
 		self.assertEqual( n["out"].image(), i )
+	def testTiles( self ) :
+	
+		i = IECore.Reader.create( self.negFileName ).read()
+		i.blindData().clear()
+	
+		n = GafferImage.ObjectToImage()
+		n["object"].setValue( i )
+		
+		tileSize = GafferImage.ImagePlug.tileSize()
+		dataWindow = n["out"]["dataWindow"].getValue()
+		
+		# tiles outside the data window should be black
+		outside = GafferImage.ImagePlug.tileOrigin( dataWindow.max ) + IECore.V2i( tileSize )
+		self.assertEqual( n["out"].channelData( "R", outside ), IECore.FloatVectorData( [ 0 ] * tileSize * tileSize ) )
+		
+		# and tiles which don't change shouldn't be regenerated
+		origin = GafferImage.ImagePlug.tileOrigin( dataWindow.min )
+		self.assertTrue( n["out"].channelData( "R", origin, _copy = False ).isSame( n["out"].channelData( "R", origin, _copy = False ) ) )
 
 if __name__ == "__main__":
 	unittest.main()
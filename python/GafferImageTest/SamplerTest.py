@@ -175,6 +175,58 @@ class SamplerTest( unittest.TestCase ) :
 			self.assertEqual( s.sample( bounds.max.x+1, bounds.min.y ), br )
 			self.assertEqual( s.sample( bounds.max.x, bounds.min.y-1 ), br )
 	
+	def testSampleRow( self ) :
+	
+		s = Gaffer.ScriptNode()
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )		
+		s.addChild( r )
+
+		bounds = r["out"]["dataWindow"].getValue()
+		tileSize = GafferImage.ImagePlug.tileSize()
+		f = GafferImage.Filter.create( "Box" )
+		
+		c = Gaffer.Context()
+		with c :
+			for mode in ( GafferImage.BoundingMode.Black, GafferImage.BoundingMode.Clamp ) :
+				sampler = GafferImage.Sampler( r["out"], "R", bounds, f, mode )
+				sampler.prefetch()
+				# Runs within a tile, across tile boundaries and outside the data window.
+				for y in ( bounds.min.y - 2, bounds.min.y, bounds.min.y + tileSize + 3, bounds.max.y, bounds.max.y + 1 ) :
+					for x, count in (
+						( bounds.min.x, 1 ),
+						( bounds.min.x + 2, tileSize / 2 ),
+						( bounds.min.x + tileSize - 3, tileSize ),
+						( bounds.min.x - 5, bounds.size().x + 11 ),
+						( bounds.max.x + 1, 4 ),
+					) :
+						row = sampler.sampleRow( x, y, count )
+						self.assertEqual( len( row ), count )
+						for i in range( 0, count ) :
+							self.assertEqual( row[i], sampler.sample( x + i, y ) )
+
+	def testFilteredSampleRow( self ) :
+	
+		s = Gaffer.ScriptNode()
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.fileName )		
+		s.addChild( r )
+
+		bounds = r["out"]["dataWindow"].getValue()
+		
+		c = Gaffer.Context()
+		with c :
+			for filterName in ( "Box", "Bilinear", "Cubic", "Lanczos" ) :
+				sampler = GafferImage.Sampler( r["out"], "R", bounds, GafferImage.Filter.create( filterName ), GafferImage.BoundingMode.Clamp )
+				for x, y, step in (
+					( bounds.min.x + 0.5, bounds.min.y + 10.25, 1.0 ),
+					( bounds.min.x + 3.35, bounds.min.y + 20.5, 0.7 ),
+					( bounds.min.x + 1.1, bounds.max.y - 5.6, 2.5 ),
+				) :
+					row = sampler.sampleRow( x, y, step, 40 )
+					for i in range( 0, 40 ) :
+						self.assertAlmostEqual( row[i], sampler.sample( x + i * step, y ), 5 )
+
 	# Test that the hash() method accumulates all of the hashes of the tiles within the sample area
 	# for a large number of different sample areas.
 	def testSampleHash( self ) :
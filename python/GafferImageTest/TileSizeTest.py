@@ -0,0 +1,141 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import subprocess
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferImage
+
+## The tile size is fixed for the lifetime of a process, so these tests
+# launch subprocesses to exercise each of the supported sizes.
+class TileSizeTest( unittest.TestCase ) :
+
+	__scriptFileName = "/tmp/tileSizeTest.py"
+	__outputFileName = "/tmp/tileSizeTest.%d.exr"
+	__tileSizes = ( 64, 128, 256 )
+
+	__tileSizeScript = "import GafferImage\nprint GafferImage.ImagePlug.tileSize()\n"
+
+	# Reads an image, grades it, merges it over a large constant and
+	# writes the result.
+	__pipelineScript = """
+import os
+import IECore
+import Gaffer
+import GafferImage
+
+r = GafferImage.ImageReader()
+r["fileName"].setValue( os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checker.exr" ) )
+
+g = GafferImage.Grade()
+g["in"].setInput( r["out"] )
+g["gain"].setValue( IECore.Color3f( 0.5, 1, 2 ) )
+g["gamma"].setValue( IECore.Color3f( 1.2 ) )
+
+c = GafferImage.Constant()
+c["format"].setValue( GafferImage.Format( 2048, 1556, 1. ) )
+c["color"].setValue( IECore.Color4f( 0.1, 0.2, 0.3, 1 ) )
+
+m = GafferImage.Merge()
+m["operation"].setValue( 8 ) # over
+m["in"].setInput( c["out"] )
+m["in1"].setInput( g["out"] )
+
+w = GafferImage.ImageWriter()
+w["in"].setInput( m["out"] )
+w["fileName"].setValue( argv[0] )
+
+w.execute( [ Gaffer.Context() ] )
+"""
+
+	def testDefault( self ) :
+
+		self.assertTrue( GafferImage.ImagePlug.tileSize() in self.__tileSizes )
+		self.assertEqual( len( GafferImage.ImagePlug()["channelData"].defaultValue() ), GafferImage.ImagePlug.tileSize() ** 2 )
+
+	def testEnvironmentVariable( self ) :
+
+		for tileSize in self.__tileSizes :
+			self.assertEqual( self.__run( self.__tileSizeScript, str( tileSize ) ), str( tileSize ) )
+
+		# unsupported values fall back to the default
+		self.assertEqual( self.__run( self.__tileSizeScript, "100" ), "64" )
+
+	def testPipeline( self ) :
+
+		images = []
+		for tileSize in self.__tileSizes :
+			outputFileName = self.__outputFileName % tileSize
+			self.__run( self.__pipelineScript, str( tileSize ), [ outputFileName ] )
+			images.append( IECore.Reader.create( outputFileName ).read() )
+
+		# the tile size must never affect the result
+		for image in images[1:] :
+			self.assertEqual( image, images[0] )
+
+	def __run( self, script, tileSize, arguments = [] ) :
+
+		f = open( self.__scriptFileName, "w" )
+		f.write( script )
+		f.close()
+
+		env = os.environ.copy()
+		env["GAFFERIMAGE_TILESIZE"] = tileSize
+
+		p = subprocess.Popen(
+			[ "gaffer", "python", self.__scriptFileName ] + ( [ "-arguments" ] + arguments if arguments else [] ),
+			env = env,
+			stdout = subprocess.PIPE,
+			stderr = subprocess.PIPE,
+		)
+		stdout, stderr = p.communicate()
+		self.failIf( p.returncode, stderr )
+
+		return stdout.strip().split( "\n" )[-1]
+
+	def tearDown( self ) :
+
+		for f in [ self.__scriptFileName ] + [ self.__outputFileName % s for s in self.__tileSizes ] :
+			if os.path.exists( f ) :
+				os.remove( f )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,151 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferImage
+
+class UniformTileTest( unittest.TestCase ) :
+
+	checkerPath = os.path.expandvars( "$GAFFER_ROOT/python/GafferTest/images/checkerboard.100x100.exr" )
+
+	def testConstant( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		for channelName, value in zip( [ "R", "G", "B", "A" ], [ 0.25, 0.5, 0.75, 1 ] ) :
+			self.assertTrue( c["out"].isUniformTile( channelName, IECore.V2i( 0 ) ) )
+			self.assertEqual( c["out"].channelData( channelName, IECore.V2i( 0 ) ), IECore.FloatVectorData( [ value ] * GafferImage.ImagePlug.tileSize() ** 2 ) )
+
+	def testGrade( self ) :
+
+		c = GafferImage.Constant()
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		g = GafferImage.Grade()
+		g["in"].setInput( c["out"] )
+		g["multiply"].setValue( IECore.Color3f( 2 ) )
+
+		for channelName, value in zip( [ "R", "G", "B" ], [ 0.5, 1, 1.5 ] ) :
+			self.assertTrue( g["out"].isUniformTile( channelName, IECore.V2i( 0 ) ) )
+			self.assertEqual( g["out"].channelData( channelName, IECore.V2i( 0 ) ), IECore.FloatVectorData( [ value ] * GafferImage.ImagePlug.tileSize() ** 2 ) )
+
+	def testMergeUniforms( self ) :
+
+		c1 = GafferImage.Constant()
+		c1["color"].setValue( IECore.Color4f( 0.5, 0.5, 0.5, 0.5 ) )
+
+		c2 = GafferImage.Constant()
+		c2["color"].setValue( IECore.Color4f( 1, 0, 0, 1 ) )
+
+		m = GafferImage.Merge()
+		m["operation"].setValue( 8 ) # over
+		m["in"].setInput( c2["out"] )
+		m["in1"].setInput( c1["out"] )
+
+		for channelName, value in zip( [ "R", "G", "B", "A" ], [ 1, 0.5, 0.5, 1 ] ) :
+			self.assertTrue( m["out"].isUniformTile( channelName, IECore.V2i( 0 ) ) )
+			self.assertEqual( m["out"].channelData( channelName, IECore.V2i( 0 ) ), IECore.FloatVectorData( [ value ] * GafferImage.ImagePlug.tileSize() ** 2 ) )
+
+	def testMergeTransparentPassThrough( self ) :
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.checkerPath )
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100, 1. ) )
+		c["color"].setValue( IECore.Color4f( 0 ) )
+
+		# transparent black over the image. for these operations
+		# the result is the same as the image, and is obtained
+		# without processing any pixels.
+		for operation in ( 0, 1, 6, 8, 10 ) : # add, atop, matte, over, under
+
+			m = GafferImage.Merge()
+			m["operation"].setValue( operation )
+			m["in"].setInput( r["out"] )
+			m["in1"].setInput( c["out"] )
+
+			ts = GafferImage.ImagePlug.tileSize()
+			for tileOrigin in [ IECore.V2i( x, y ) for x in range( 0, 100, ts ) for y in range( 0, 100, ts ) ] :
+				for channelName in [ "R", "G", "B" ] :
+					self.assertEqual( m["out"].channelData( channelName, tileOrigin ), r["out"].channelData( channelName, tileOrigin ) )
+
+	def testReformat( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100, 1. ) )
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		r = GafferImage.Reformat()
+		r["in"].setInput( c["out"] )
+		r["format"].setValue( GafferImage.Format( 250, 150, 1. ) )
+
+		for channelName in [ "R", "G", "B", "A" ] :
+			self.assertTrue( r["out"].isUniformTile( channelName, IECore.V2i( 0 ) ) )
+			self.assertEqual( r["out"].channelData( channelName, IECore.V2i( 0 ) ), c["out"].channelData( channelName, IECore.V2i( 0 ) ) )
+
+	def testCacheMemoryUsage( self ) :
+
+		c = GafferImage.Constant()
+		c["format"].setValue( GafferImage.Format( 100, 100, 1. ) )
+		c["color"].setValue( IECore.Color4f( 0.25, 0.5, 0.75, 1 ) )
+
+		r = GafferImage.ImageReader()
+		r["fileName"].setValue( self.checkerPath )
+
+		tileMemory = GafferImage.ImagePlug.tileSize() ** 2 * 4
+
+		# uniform tiles are held permanently by ImagePlug, so
+		# the cache shouldn't charge for storing them.
+		Gaffer.ValuePlug.clearCache()
+		for channelName in [ "R", "G", "B", "A" ] :
+			c["out"].channelData( channelName, IECore.V2i( 0 ) )
+		self.failUnless( Gaffer.ValuePlug.cacheMemoryUsage() < tileMemory )
+
+		# but it should charge for everything else.
+		Gaffer.ValuePlug.clearCache()
+		r["out"].channelData( "R", IECore.V2i( 0 ) )
+		self.failUnless( Gaffer.ValuePlug.cacheMemoryUsage() >= tileMemory )
+
+if __name__ == "__main__":
+	unittest.main()
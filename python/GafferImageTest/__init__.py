@@ -54,6 +54,13 @@ from DisplayTest import DisplayTest
 from ImageStatsTest import ImageStatsTest
 from ImageTransformTest import ImageTransformTest
 from RemoveChannelsTest import RemoveChannelsTest
+from TileSizeTest import TileSizeTest
+from UniformTileTest import UniformTileTest
+from HalfTileStorageTest import HalfTileStorageTest
+from MipMapTest import MipMapTest
+from ImageTilesTest import ImageTilesTest
+import ImageBenchmarks
+from ImageBenchmarksTest import ImageBenchmarksTest
 
 if __name__ == "__main__":
 	import unittest
@@ -41,6 +41,7 @@ import GafferUI
 import GafferImage
 
 QtGui = GafferUI._qtImport( "QtGui" )
+QtCore = GafferUI._qtImport( "QtCore" )
 
 class FormatPlugValueWidget( GafferUI.PlugValueWidget ) :
 
@@ -95,6 +96,11 @@ class FormatPlugValueWidget( GafferUI.PlugValueWidget ) :
 			
 				# Otherwise update the UI from the plug.	
 				plugValue = self.getPlug().getValue()
+				
+				# Computing the value may have registered a new format, so make
+				# sure we've been notified of it before searching for it.
+				GafferImage.Format.emitPendingSignals()
+				
 				for name in self.__formats.keys() :
 					format = self.__formats[name]
 					if format == plugValue :
@@ -135,3 +141,13 @@ class FormatPlugValueWidget( GafferUI.PlugValueWidget ) :
 														
 GafferUI.PlugValueWidget.registerType( GafferImage.FormatPlug.staticTypeId(), FormatPlugValueWidget )
 
+## Formats may be registered by computations running on background threads, in which
+# case the registry queues the notifications rather than calling into python from those
+# threads. We poll for them here, emitting them on the ui thread.
+def __emitPendingFormatSignals() :
+
+	GafferImage.Format.emitPendingSignals()
+
+__pendingFormatsTimer = QtCore.QTimer()
+__pendingFormatsTimer.timeout.connect( __emitPendingFormatSignals )
+__pendingFormatsTimer.start( 250 )
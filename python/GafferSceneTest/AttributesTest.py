@@ -263,5 +263,86 @@ class AttributesTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( p["enabled"].getValue(), True )
 		self.assertEqual( p["value"].getValue(), False )
 
+	def testMembersAreShared( self ) :
+	
+		p = GafferScene.Plane()
+		
+		a1 = GafferScene.Attributes()
+		a1["in"].setInput( p["out"] )
+		a1["attributes"].addMember( "user:heavy", IECore.FloatVectorData( range( 0, 1000 ) ) )
+		
+		a2 = GafferScene.Attributes()
+		a2["in"].setInput( a1["out"] )
+		a2["attributes"].addMember( "ri:shadingRate", IECore.FloatData( 0.25 ) )
+		
+		a1Attributes = a1["out"].attributes( "/plane", _copy = False )
+		a2Attributes = a2["out"].attributes( "/plane", _copy = False )
+		
+		self.assertEqual( a2Attributes["ri:shadingRate"], IECore.FloatData( 0.25 ) )
+		self.assertTrue( a2Attributes["user:heavy"].isSame( a1Attributes["user:heavy"] ) )
+		self.assertFalse( "ri:shadingRate" in a1Attributes )
+		
+	def testPerLocationCostWithHeavyShaderAssignment( self ) :
+	
+		sphere = IECore.SpherePrimitive()
+		instanceInput = GafferSceneTest.CompoundObjectSource()
+		instanceInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( sphere.bound() ),
+				"children" : {
+					"sphere" : {
+						"object" : sphere,
+						"bound" : IECore.Box3fData( sphere.bound() ),
+					},
+				}
+			} )
+		)
+		
+		seeds = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( i, 0, 0 ) for i in range( 0, 2000 ) ] ) )
+		seedsInput = GafferSceneTest.CompoundObjectSource()
+		seedsInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( seeds.bound() ),
+				"children" : {
+					"seeds" : {
+						"bound" : IECore.Box3fData( seeds.bound() ),
+						"object" : seeds,
+					},
+				},
+			}, )
+		)
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( seedsInput["out"] )
+		instancer["instance"].setInput( instanceInput["out"] )
+		instancer["parent"].setValue( "/seeds" )
+		instancer["name"].setValue( "instances" )
+		
+		# A heavy set of attributes upstream, of the sort
+		# you get from a large shader assignment.
+		userData = GafferScene.Attributes()
+		userData["in"].setInput( instancer["out"] )
+		userData["attributes"].addMember( "user:heavy", IECore.FloatVectorData( range( 0, 10000 ) ) )
+		
+		shader = GafferSceneTest.TestShader()
+		shaderAssignment = GafferScene.ShaderAssignment()
+		shaderAssignment["in"].setInput( userData["out"] )
+		shaderAssignment["shader"].setInput( shader["out"] )
+		
+		attributes = GafferScene.Attributes()
+		attributes["in"].setInput( shaderAssignment["out"] )
+		attributes["attributes"].addMember( "ri:shadingRate", IECore.FloatData( 0.25 ) )
+		
+		paths = [ "/seeds/instances/" + str( n ) for n in instancer["out"].childNames( "/seeds/instances" ) ]
+		
+		# the heavy upstream attributes should be shared rather than
+		# copied at every location. The timing of this lives in the
+		# HeavyShaderAssignmentBenchmark in SceneBenchmarks.
+		for p in paths :
+			upstream = shaderAssignment["out"].attributes( p, _copy = False )
+			a = attributes["out"].attributes( p, _copy = False )
+			self.assertTrue( a["user:heavy"].isSame( upstream["user:heavy"] ) )
+			self.assertTrue( a["shader"].isSame( upstream["shader"] ) )
+
 if __name__ == "__main__":
 	unittest.main()
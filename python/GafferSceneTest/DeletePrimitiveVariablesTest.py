@@ -72,6 +72,52 @@ class DeletePrimitiveVariablesTest( GafferSceneTest.SceneTestCase ) :
 	
 		self.assertSceneValid( d["out"] )
 		self.failUnless( isinstance( d["out"].object( "/camera" ), IECore.Camera ) )
+	
+	def testUnmodifiedVariablesAreShared( self ) :
+	
+		p = GafferScene.Plane()
+		d = GafferScene.DeletePrimitiveVariables()
+		d["in"].setInput( p["out"] )
+		d["names"].setValue( "s" )
+		
+		inputPlane = p["out"].object( "/plane", _copy = False )
+		outputPlane = d["out"].object( "/plane", _copy = False )
+		
+		self.failUnless( "s" in inputPlane )
+		self.failUnless( "s" not in outputPlane )
+		self.failUnless( outputPlane["P"].data.isSame( inputPlane["P"].data ) )
+		self.failUnless( outputPlane["t"].data.isSame( inputPlane["t"].data ) )
+	
+	def testChainMemoryUsage( self ) :
+	
+		p = GafferScene.Plane()
+		p["divisions"].setValue( IECore.V2i( 1000 ) )
+		
+		m1 = GafferScene.MeshType()
+		m1["in"].setInput( p["out"] )
+		m1["meshType"].setValue( "catmullClark" )
+		
+		d1 = GafferScene.DeletePrimitiveVariables()
+		d1["in"].setInput( m1["out"] )
+		d1["names"].setValue( "s" )
+		
+		m2 = GafferScene.MeshType()
+		m2["in"].setInput( d1["out"] )
+		m2["meshType"].setValue( "linear" )
+		
+		d2 = GafferScene.DeletePrimitiveVariables()
+		d2["in"].setInput( m2["out"] )
+		d2["names"].setValue( "t" )
+		
+		m3 = GafferScene.MeshType()
+		m3["in"].setInput( d2["out"] )
+		m3["meshType"].setValue( "catmullClark" )
+		
+		inputPlane = p["out"].object( "/plane", _copy = False )
+		outputPlane = m3["out"].object( "/plane", _copy = False )
+		
+		self.failUnless( outputPlane["P"].data.isSame( inputPlane["P"].data ) )
+		self.assertEqual( outputPlane.keys(), [ "P" ] )
 		
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,234 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import unittest
+
+import IECore
+import IECoreGL
+
+import Gaffer
+import GafferTest
+import GafferScene
+import GafferSceneTest
+
+class OpenGLSceneCacheTest( GafferSceneTest.SceneTestCase ) :
+
+	def __scene( self ) :
+	
+		plane1 = GafferScene.Plane()
+		
+		plane2 = GafferScene.Plane()
+		plane2["name"].setValue( "plane2" )
+		plane2["transform"]["translate"].setValue( IECore.V3f( 2, 0, 0 ) )
+		
+		group = GafferScene.Group()
+		group["in"].setInput( plane1["out"] )
+		group["in1"].setInput( plane2["out"] )
+		
+		return group, plane1, plane2
+	
+	def testUpdate( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		cache = GafferScene.OpenGLSceneCache()
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 2 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+		
+		# nothing has changed, so nothing should be converted
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 0 )
+		
+		# until we ask for everything to be converted again
+		cache.clear()
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 2 )
+	
+	def testTransformEditsDontReconvert( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		cache = GafferScene.OpenGLSceneCache()
+		cache.update( group["out"], Gaffer.Context() )
+		
+		plane2["transform"]["translate"].setValue( IECore.V3f( 10, 0, 0 ) )
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 0 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+		
+		group["transform"]["translate"].setValue( IECore.V3f( 0, 5, 0 ) )
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 0 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+	
+	def testObjectEditsReconvertOnlyThatLocation( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		cache = GafferScene.OpenGLSceneCache()
+		cache.update( group["out"], Gaffer.Context() )
+		
+		plane2["dimensions"].setValue( IECore.V2f( 3 ) )
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 1 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+	
+	def testAttributeEditsReconvertDescendants( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+		
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["filter"].setInput( filter["match"] )
+		
+		cache = GafferScene.OpenGLSceneCache()
+		self.assertEqual( cache.update( attributes["out"], Gaffer.Context() ), 2 )
+		
+		# the attributes are inherited, so both planes must be reconverted
+		attributes["attributes"]["transformBlur"]["enabled"].setValue( True )
+		self.assertEqual( cache.update( attributes["out"], Gaffer.Context() ), 2 )
+		
+	def testInvisibleLocationsIgnored( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group/plane2" ] ) )
+		
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["filter"].setInput( filter["match"] )
+		
+		cache = GafferScene.OpenGLSceneCache()
+		cache.update( attributes["out"], Gaffer.Context() )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+		
+		attributes["attributes"]["visibility"]["enabled"].setValue( True )
+		attributes["attributes"]["visibility"]["value"].setValue( False )
+		self.assertEqual( cache.update( attributes["out"], Gaffer.Context() ), 0 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/group/plane" ) )
+		
+		attributes["attributes"]["visibility"]["value"].setValue( True )
+		self.assertEqual( cache.update( attributes["out"], Gaffer.Context() ), 1 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+	
+	def testPathsToExpand( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		# when the group isn't expanded it is drawn as a box
+		cache = GafferScene.OpenGLSceneCache()
+		self.assertEqual( cache.update( group["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/" ] ) ) ), 1 )
+		
+		# expanding it converts the children but not the box
+		self.assertEqual( cache.update( group["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/", "/group" ] ) ) ), 2 )
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 0 )
+		
+	def testCancellation( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		canceller = Gaffer.Canceller()
+		canceller.cancel()
+		
+		context = Gaffer.Context()
+		context.setCanceller( canceller )
+		
+		cache = GafferScene.OpenGLSceneCache()
+		self.assertRaises( RuntimeError, cache.update, group["out"], context )
+		
+		# the next update picks up where the cancelled one left off
+		self.assertEqual( cache.update( group["out"], Gaffer.Context() ), 2 )
+		self.assertEqual( cache.scene().root().bound(), group["out"].bound( "/" ) )
+		
+	def testTransformEditInManyInstances( self ) :
+	
+		plane = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -0.4 ), IECore.V2f( 0.4 ) ) )
+		instanceInput = GafferSceneTest.CompoundObjectSource()
+		instanceInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( plane.bound() ),
+				"children" : {
+					"plane" : {
+						"object" : plane,
+						"bound" : IECore.Box3fData( plane.bound() ),
+					},
+				}
+			} )
+		)
+		
+		seeds = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( x, y, 0 ) for x in range( 0, 20 ) for y in range( 0, 20 ) ] ) )
+		seedsInput = GafferSceneTest.CompoundObjectSource()
+		seedsInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( seeds.bound() ),
+				"children" : {
+					"seeds" : {
+						"bound" : IECore.Box3fData( seeds.bound() ),
+						"object" : seeds,
+					},
+				},
+			}, )
+		)
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( seedsInput["out"] )
+		instancer["instance"].setInput( instanceInput["out"] )
+		instancer["parent"].setValue( "/seeds" )
+		instancer["name"].setValue( "instances" )
+		
+		# 400 instances, each with a child plane. The timings for
+		# a larger version of this scene are in SceneBenchmarks.
+		
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/seeds/instances/200" ] ) )
+		
+		transform = GafferScene.Transform()
+		transform["in"].setInput( instancer["out"] )
+		transform["filter"].setInput( filter["match"] )
+		
+		cache = GafferScene.OpenGLSceneCache()
+		
+		numConverted = cache.update( transform["out"], Gaffer.Context() )
+		self.assertEqual( numConverted, 400 )
+		
+		transform["transform"]["translate"].setValue( IECore.V3f( 0, 0, 10 ) )
+		
+		numConverted = cache.update( transform["out"], Gaffer.Context() )
+		self.assertEqual( numConverted, 0 )
+		self.assertEqual( cache.scene().root().bound().max.z, 10 )
+		
+if __name__ == "__main__":
+	unittest.main()
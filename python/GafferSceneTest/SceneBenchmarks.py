@@ -0,0 +1,556 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import random
+import resource
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferScene
+import GafferSceneTest
+
+## Base class for benchmarks which time a full traversal of a
+# synthetic scene, built from standard nodes by _buildScene().
+class SceneTraversalBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, name ) :
+
+		GafferTest.Benchmark.__init__( self, name )
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+		self.__scene = self._buildScene( self.__script )
+		self.__context = Gaffer.Context()
+
+	def run( self ) :
+
+		GafferSceneTest.traverseScene( self.__scene, self.__context )
+
+	def tearDown( self ) :
+
+		del self.__script
+		del self.__scene
+
+	def measurements( self, seconds ) :
+
+		return { "locations" : self._numLocations(), "locationsPerSecond" : self._numLocations() / max( seconds, 1e-6 ) }
+
+	## Must be implemented by derived classes to build a scene within
+	# script, returning the ScenePlug to be traversed.
+	def _buildScene( self, script ) :
+
+		raise NotImplementedError
+
+	## Must be implemented by derived classes to return the number of
+	# locations in the scene, including the root.
+	def _numLocations( self ) :
+
+		raise NotImplementedError
+
+# Builds a hierarchy of Groups, each taking `branching` copies of the
+# output of the group below, with a Sphere at the bottom. Returns the
+# output plug of the top group.
+def _buildHierarchy( script, depth, branching, prefix = "" ) :
+
+	script[prefix + "sphere"] = GafferScene.Sphere()
+	upstream = script[prefix + "sphere"]["out"]
+	for i in range( 0, depth ) :
+		group = GafferScene.Group( prefix + "group%d" % i )
+		script.addChild( group )
+		for j in range( 0, branching ) :
+			group["in%s" % ( j or "" )].setInput( upstream )
+		upstream = group["out"]
+
+	return upstream
+
+# Returns the number of locations below the root
+# of a hierarchy made by _buildHierarchy().
+def _hierarchySize( depth, branching ) :
+
+	return sum( [ branching ** i for i in range( 0, depth + 1 ) ] )
+
+# Instances the scene from `instance` onto the points of
+# a grid, returning the output plug of the Instancer.
+def _buildInstancer( script, instance, numInstances ) :
+
+	width = int( numInstances ** 0.5 ) or 1
+	points = IECore.PointsPrimitive(
+		IECore.V3fVectorData( [ IECore.V3f( i % width, i / width, 0 ) for i in range( 0, numInstances ) ] )
+	)
+
+	script["seeds"] = GafferScene.ObjectToScene()
+	script["seeds"]["object"].setValue( points )
+
+	script["instancer"] = GafferScene.Instancer()
+	script["instancer"]["in"].setInput( script["seeds"]["out"] )
+	script["instancer"]["instance"].setInput( instance )
+	script["instancer"]["parent"].setValue( "/object" )
+	script["instancer"]["name"].setValue( "instances" )
+
+	return script["instancer"]["out"]
+
+## A narrow but deep hierarchy, in which every location is
+# computed through many levels of Group nodes.
+class DeepHierarchyBenchmark( SceneTraversalBenchmark ) :
+
+	def __init__( self, depth = 14, branching = 2 ) :
+
+		SceneTraversalBenchmark.__init__( self, "deepHierarchy" )
+
+		self.__depth = depth
+		self.__branching = branching
+
+	def _buildScene( self, script ) :
+
+		return _buildHierarchy( script, self.__depth, self.__branching )
+
+	def _numLocations( self ) :
+
+		return 1 + _hierarchySize( self.__depth, self.__branching )
+
+## A shallow hierarchy with a very large number
+# of children beneath a single location.
+class WideHierarchyBenchmark( SceneTraversalBenchmark ) :
+
+	def __init__( self, numChildren = 50000 ) :
+
+		SceneTraversalBenchmark.__init__( self, "wideHierarchy" )
+
+		self.__numChildren = numChildren
+
+	def _buildScene( self, script ) :
+
+		script["instance"] = GafferScene.Sphere()
+		return _buildInstancer( script, script["instance"]["out"], self.__numChildren )
+
+	def _numLocations( self ) :
+
+		# root, /object and /object/instances, plus each instance
+		# and the sphere beneath it.
+		return 3 + 2 * self.__numChildren
+
+## Many instances of a small hierarchy.
+class ManyInstancesBenchmark( SceneTraversalBenchmark ) :
+
+	def __init__( self, numInstances = 2500, depth = 3, branching = 3 ) :
+
+		SceneTraversalBenchmark.__init__( self, "manyInstances" )
+
+		self.__numInstances = numInstances
+		self.__depth = depth
+		self.__branching = branching
+
+	def _buildScene( self, script ) :
+
+		instance = _buildHierarchy( script, self.__depth, self.__branching, prefix = "instance" )
+		return _buildInstancer( script, instance, self.__numInstances )
+
+	def _numLocations( self ) :
+
+		return 3 + self.__numInstances * _hierarchySize( self.__depth, self.__branching )
+
+## A chain of Attributes nodes, each assigning many
+# attributes to every location in a hierarchy.
+class HeavyAttributesBenchmark( SceneTraversalBenchmark ) :
+
+	def __init__( self, depth = 12, branching = 2, numNodes = 10, numAttributes = 20 ) :
+
+		SceneTraversalBenchmark.__init__( self, "heavyAttributes" )
+
+		self.__depth = depth
+		self.__branching = branching
+		self.__numNodes = numNodes
+		self.__numAttributes = numAttributes
+
+	def _buildScene( self, script ) :
+
+		upstream = _buildHierarchy( script, self.__depth, self.__branching )
+
+		script["filter"] = GafferScene.PathFilter()
+		script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/..." ] ) )
+
+		for i in range( 0, self.__numNodes ) :
+			attributes = GafferScene.Attributes( "attributes%d" % i )
+			script.addChild( attributes )
+			attributes["in"].setInput( upstream )
+			attributes["filter"].setInput( script["filter"]["match"] )
+			for j in range( 0, self.__numAttributes ) :
+				attributes["attributes"].addMember( "user:attribute%d_%d" % ( i, j ), IECore.FloatData( j ) )
+			upstream = attributes["out"]
+
+		return upstream
+
+	def _numLocations( self ) :
+
+		return 1 + _hierarchySize( self.__depth, self.__branching )
+
+## A chain of Transform nodes, each with a PathFilter
+# matching many paths, some of them with wildcards.
+class FilterChainBenchmark( SceneTraversalBenchmark ) :
+
+	def __init__( self, depth = 12, branching = 2, numNodes = 20, numPaths = 100 ) :
+
+		SceneTraversalBenchmark.__init__( self, "filterChain" )
+
+		self.__depth = depth
+		self.__branching = branching
+		self.__numNodes = numNodes
+		self.__numPaths = numPaths
+
+	def _buildScene( self, script ) :
+
+		upstream = _buildHierarchy( script, self.__depth, self.__branching )
+
+		# seeded, so that the same scene is built every time
+		r = random.Random( 0 )
+		childNames = [ "group" ] + [ "group%d" % i for i in range( 1, self.__branching ) ]
+		for i in range( 0, self.__numNodes ) :
+
+			paths = []
+			for j in range( 0, self.__numPaths ) :
+				path = [ "group" ] + [ r.choice( childNames + [ "*" ] ) for k in range( 0, r.randint( 0, self.__depth - 1 ) ) ]
+				if r.random() < 0.1 :
+					path.append( "..." )
+				paths.append( "/" + "/".join( path ) )
+
+			filter = GafferScene.PathFilter( "filter%d" % i )
+			script.addChild( filter )
+			filter["paths"].setValue( IECore.StringVectorData( paths ) )
+
+			transform = GafferScene.Transform( "transform%d" % i )
+			script.addChild( transform )
+			transform["in"].setInput( upstream )
+			transform["filter"].setInput( filter["match"] )
+			transform["transform"]["translate"].setValue( IECore.V3f( 0, 0, 1 ) )
+			upstream = transform["out"]
+
+		return upstream
+
+	def _numLocations( self ) :
+
+		return 1 + _hierarchySize( self.__depth, self.__branching )
+
+## A chain of MeshType and DeletePrimitiveVariables nodes processing a
+# dense mesh. The primitive variables which pass through unmodified are
+# shared with the input, so the memory growth should be small relative
+# to the size of the mesh.
+class PrimitiveVariableChainBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, divisions = 1000 ) :
+
+		GafferTest.Benchmark.__init__( self, "primitiveVariableChain" )
+
+		self.__divisions = divisions
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+
+		self.__script["plane"] = GafferScene.Plane()
+		self.__script["plane"]["divisions"].setValue( IECore.V2i( self.__divisions ) )
+
+		upstream = self.__script["plane"]["out"]
+		for i, meshType, deleted in ( ( 1, "catmullClark", "s" ), ( 2, "linear", "t" ), ( 3, "catmullClark", None ) ) :
+
+			meshTypeNode = GafferScene.MeshType( "meshType%d" % i )
+			self.__script.addChild( meshTypeNode )
+			meshTypeNode["in"].setInput( upstream )
+			meshTypeNode["meshType"].setValue( meshType )
+			upstream = meshTypeNode["out"]
+
+			if deleted is not None :
+				deleteNode = GafferScene.DeletePrimitiveVariables( "delete%d" % i )
+				self.__script.addChild( deleteNode )
+				deleteNode["in"].setInput( upstream )
+				deleteNode["names"].setValue( deleted )
+				upstream = deleteNode["out"]
+
+		self.__out = upstream
+
+	def run( self ) :
+
+		maxRSS = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+		self.__out.object( "/plane", _copy = False )
+		self.__peakMemoryGrowth = resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss - maxRSS
+
+	def tearDown( self ) :
+
+		del self.__script
+		del self.__out
+
+	def measurements( self, seconds ) :
+
+		# ru_maxrss is measured in kilobytes.
+		return {
+			"faces" : self.__divisions * self.__divisions,
+			"peakMemoryGrowth" : self.__peakMemoryGrowth * 1024,
+		}
+
+## Queries the attributes of many instances beneath a heavy set of
+# upstream attributes, of the sort you get from a large shader assignment,
+# measuring the per-location cost of an Attributes node which adds to them.
+class HeavyShaderAssignmentBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numInstances = 2000, numUpstreamValues = 10000 ) :
+
+		GafferTest.Benchmark.__init__( self, "heavyShaderAssignment" )
+
+		self.__numInstances = numInstances
+		self.__numUpstreamValues = numUpstreamValues
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+
+		self.__script["sphere"] = GafferScene.Sphere()
+		instances = _buildInstancer( self.__script, self.__script["sphere"]["out"], self.__numInstances )
+
+		self.__script["userData"] = GafferScene.Attributes()
+		self.__script["userData"]["in"].setInput( instances )
+		self.__script["userData"]["attributes"].addMember( "user:heavy", IECore.FloatVectorData( range( 0, self.__numUpstreamValues ) ) )
+
+		self.__script["shader"] = GafferSceneTest.TestShader()
+		self.__script["shaderAssignment"] = GafferScene.ShaderAssignment()
+		self.__script["shaderAssignment"]["in"].setInput( self.__script["userData"]["out"] )
+		self.__script["shaderAssignment"]["shader"].setInput( self.__script["shader"]["out"] )
+
+		self.__script["attributes"] = GafferScene.Attributes()
+		self.__script["attributes"]["in"].setInput( self.__script["shaderAssignment"]["out"] )
+		self.__script["attributes"]["attributes"].addMember( "ri:shadingRate", IECore.FloatData( 0.25 ) )
+
+		self.__out = self.__script["attributes"]["out"]
+		self.__paths = [ "/object/instances/" + str( n ) for n in self.__out.childNames( "/object/instances" ) ]
+
+	def run( self ) :
+
+		for path in self.__paths :
+			self.__out.attributes( path, _copy = False )
+
+	def tearDown( self ) :
+
+		del self.__script
+		del self.__out
+
+	def measurements( self, seconds ) :
+
+		return { "locations" : len( self.__paths ), "locationsPerSecond" : len( self.__paths ) / max( seconds, 1e-6 ) }
+
+# Returns the output of an Instancer placing a plane with
+# the specified number of divisions at each point of a grid.
+def _buildPlaneGrid( script, numInstances, divisions = 20 ) :
+
+	script["plane"] = GafferScene.ObjectToScene()
+	script["plane"]["name"].setValue( "plane" )
+	script["plane"]["object"].setValue(
+		IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -0.4 ), IECore.V2f( 0.4 ) ), IECore.V2i( divisions ) )
+	)
+
+	return _buildInstancer( script, script["plane"]["out"], numInstances )
+
+## Times the construction of a ScenePicker for a scene
+# containing many objects.
+class ScenePickerBuildBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numInstances = 10000 ) :
+
+		GafferTest.Benchmark.__init__( self, "scenePickerBuild" )
+
+		self.__numInstances = numInstances
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+		self.__scene = _buildPlaneGrid( self.__script, self.__numInstances )
+
+	def run( self ) :
+
+		GafferScene.ScenePicker( self.__scene, Gaffer.Context() )
+
+	def tearDown( self ) :
+
+		del self.__script
+		del self.__scene
+
+	def measurements( self, seconds ) :
+
+		return { "objects" : self.__numInstances }
+
+## Times ray and frustum queries against a ScenePicker
+# containing many objects.
+class ScenePickerQueryBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numInstances = 10000, numRays = 100 ) :
+
+		GafferTest.Benchmark.__init__( self, "scenePickerQuery" )
+
+		self.__numInstances = numInstances
+		self.__numRays = numRays
+
+	def setUp( self ) :
+
+		self.__script = Gaffer.ScriptNode()
+		self.__picker = GafferScene.ScenePicker( _buildPlaneGrid( self.__script, self.__numInstances ), Gaffer.Context() )
+
+		# rays fired along a row through the middle of the grid, and a
+		# frustum enclosing a tenth of its width and height.
+		width = int( self.__numInstances ** 0.5 ) or 1
+		y = width / 2
+		self.__lines = [
+			IECore.LineSegment3f( IECore.V3f( float( x * width ) / self.__numRays, y, 10 ), IECore.V3f( float( x * width ) / self.__numRays, y, -10 ) )
+			for x in range( 0, self.__numRays )
+		]
+
+		frustumMin = width * 0.45 - 0.5
+		frustumMax = width * 0.55 - 0.5
+		self.__frustum = [
+			IECore.LineSegment3f( IECore.V3f( x, y, 10 ), IECore.V3f( x, y, -10 ) )
+			for x, y in ( ( frustumMin, frustumMin ), ( frustumMax, frustumMin ), ( frustumMax, frustumMax ), ( frustumMin, frustumMax ) )
+		]
+
+	def run( self ) :
+
+		for line in self.__lines :
+			self.__picker.objectAt( line )
+
+		self.__picker.objectsAt( self.__frustum )
+
+	def tearDown( self ) :
+
+		del self.__picker
+		del self.__script
+
+	def measurements( self, seconds ) :
+
+		return { "objects" : self.__picker.numObjects(), "rays" : self.__numRays }
+
+## Base class for benchmarks of OpenGLSceneCache updates, using
+# a scene with many instances and a Transform node applied to one
+# of them.
+class OpenGLSceneCacheBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, name, numInstances ) :
+
+		GafferTest.Benchmark.__init__( self, name )
+
+		self._numInstances = numInstances
+
+	def setUp( self ) :
+
+		self._script = Gaffer.ScriptNode()
+
+		self._script["filter"] = GafferScene.PathFilter()
+		self._script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/object/instances/%d" % ( self._numInstances / 2 ) ] ) )
+
+		self._script["transform"] = GafferScene.Transform()
+		self._script["transform"]["in"].setInput( _buildPlaneGrid( self._script, self._numInstances, divisions = 1 ) )
+		self._script["transform"]["filter"].setInput( self._script["filter"]["match"] )
+
+		self._scene = self._script["transform"]["out"]
+
+	def tearDown( self ) :
+
+		del self._scene
+		del self._script
+
+## Times the initial conversion of a scene by an OpenGLSceneCache.
+class OpenGLSceneCacheUpdateBenchmark( OpenGLSceneCacheBenchmark ) :
+
+	def __init__( self, numInstances = 50000 ) :
+
+		OpenGLSceneCacheBenchmark.__init__( self, "openGLSceneCacheUpdate", numInstances )
+
+	def run( self ) :
+
+		self.__numConverted = GafferScene.OpenGLSceneCache().update( self._scene, Gaffer.Context() )
+
+	def measurements( self, seconds ) :
+
+		return { "locationsConverted" : self.__numConverted }
+
+## Times the update of an OpenGLSceneCache following an edit
+# to the transform of a single location, which shouldn't
+# require any objects to be reconverted.
+class OpenGLSceneCacheTransformEditBenchmark( OpenGLSceneCacheBenchmark ) :
+
+	def __init__( self, numInstances = 50000 ) :
+
+		OpenGLSceneCacheBenchmark.__init__( self, "openGLSceneCacheTransformEdit", numInstances )
+
+	def setUp( self ) :
+
+		OpenGLSceneCacheBenchmark.setUp( self )
+
+		self.__cache = GafferScene.OpenGLSceneCache()
+		self.__cache.update( self._scene, Gaffer.Context() )
+		self.__numEdits = 0
+
+	def run( self ) :
+
+		# each run makes a new edit, so that there
+		# is always something to update.
+		self.__numEdits += 1
+		self._script["transform"]["transform"]["translate"].setValue( IECore.V3f( 0, 0, self.__numEdits ) )
+		self.__numConverted = self.__cache.update( self._scene, Gaffer.Context() )
+
+	def tearDown( self ) :
+
+		del self.__cache
+		OpenGLSceneCacheBenchmark.tearDown( self )
+
+	def measurements( self, seconds ) :
+
+		return { "locationsConverted" : self.__numConverted }
+
+## Returns the scene benchmarks to be run by the "gaffer benchmark" app.
+def benchmarks() :
+
+	return [
+		DeepHierarchyBenchmark(),
+		WideHierarchyBenchmark(),
+		ManyInstancesBenchmark(),
+		HeavyAttributesBenchmark(),
+		FilterChainBenchmark(),
+		PrimitiveVariableChainBenchmark(),
+		HeavyShaderAssignmentBenchmark(),
+		ScenePickerBuildBenchmark(),
+		ScenePickerQueryBenchmark(),
+		OpenGLSceneCacheUpdateBenchmark(),
+		OpenGLSceneCacheTransformEditBenchmark(),
+	]
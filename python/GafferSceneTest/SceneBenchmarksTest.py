@@ -0,0 +1,121 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import unittest
+
+import Gaffer
+import GafferSceneTest
+
+class SceneBenchmarksTest( GafferSceneTest.SceneTestCase ) :
+
+	def __countLocations( self, scene, path = "/" ) :
+
+		result = 1
+		for childName in scene.childNames( path ) :
+			result += self.__countLocations( scene, path.rstrip( "/" ) + "/" + str( childName ) )
+
+		return result
+
+	def testLocationCounts( self ) :
+
+		for benchmark in [
+			GafferSceneTest.SceneBenchmarks.DeepHierarchyBenchmark( depth = 3, branching = 2 ),
+			GafferSceneTest.SceneBenchmarks.WideHierarchyBenchmark( numChildren = 10 ),
+			GafferSceneTest.SceneBenchmarks.ManyInstancesBenchmark( numInstances = 4, depth = 2, branching = 2 ),
+			GafferSceneTest.SceneBenchmarks.HeavyAttributesBenchmark( depth = 2, branching = 2, numNodes = 2, numAttributes = 2 ),
+			GafferSceneTest.SceneBenchmarks.FilterChainBenchmark( depth = 3, branching = 2, numNodes = 2, numPaths = 5 ),
+		] :
+
+			script = Gaffer.ScriptNode()
+			scene = benchmark._buildScene( script )
+			self.assertEqual( self.__countLocations( scene ), benchmark._numLocations(), benchmark.name() )
+
+	def testExecute( self ) :
+
+		benchmark = GafferSceneTest.SceneBenchmarks.DeepHierarchyBenchmark( depth = 3, branching = 2 )
+		results = benchmark.execute( repeats = 2 )
+
+		self.assertEqual( results["cold"]["locations"], 16 )
+		self.failUnless( results["cold"]["computeCount"] > 0 )
+		self.failUnless( results["cold"]["hashCount"] > 0 )
+
+		# the warm runs should benefit from the cache
+		self.failUnless( results["warm"]["computeCount"] < results["cold"]["computeCount"] )
+		self.failUnless( results["warm"]["cacheHitCount"] > 0 )
+
+	def testPrimitiveVariableChain( self ) :
+
+		benchmark = GafferSceneTest.SceneBenchmarks.PrimitiveVariableChainBenchmark( divisions = 10 )
+		results = benchmark.execute( repeats = 1 )
+
+		self.assertEqual( results["cold"]["faces"], 100 )
+		self.failUnless( results["cold"]["computeCount"] > 0 )
+		self.failUnless( results["warm"]["computeCount"] < results["cold"]["computeCount"] )
+
+	def testHeavyShaderAssignment( self ) :
+
+		benchmark = GafferSceneTest.SceneBenchmarks.HeavyShaderAssignmentBenchmark( numInstances = 10, numUpstreamValues = 100 )
+		results = benchmark.execute( repeats = 1 )
+
+		self.assertEqual( results["cold"]["locations"], 10 )
+		self.failUnless( results["warm"]["computeCount"] < results["cold"]["computeCount"] )
+
+	def testScenePicker( self ) :
+
+		results = GafferSceneTest.SceneBenchmarks.ScenePickerBuildBenchmark( numInstances = 16 ).execute( repeats = 1 )
+		self.assertEqual( results["cold"]["objects"], 16 )
+
+		results = GafferSceneTest.SceneBenchmarks.ScenePickerQueryBenchmark( numInstances = 16, numRays = 4 ).execute( repeats = 1 )
+		self.assertEqual( results["cold"]["objects"], 16 )
+		self.assertEqual( results["cold"]["rays"], 4 )
+
+	def testOpenGLSceneCache( self ) :
+
+		results = GafferSceneTest.SceneBenchmarks.OpenGLSceneCacheUpdateBenchmark( numInstances = 16 ).execute( repeats = 1 )
+		self.assertEqual( results["cold"]["locationsConverted"], 16 )
+
+		results = GafferSceneTest.SceneBenchmarks.OpenGLSceneCacheTransformEditBenchmark( numInstances = 16 ).execute( repeats = 1 )
+		self.assertEqual( results["cold"]["locationsConverted"], 0 )
+		self.assertEqual( results["warm"]["locationsConverted"], 0 )
+
+	def testBenchmarkNamesAreUnique( self ) :
+
+		names = [ b.name() for b in GafferSceneTest.SceneBenchmarks.benchmarks() ]
+		self.assertEqual( len( names ), len( set( names ) ) )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,286 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferScene
+import GafferSceneTest
+
+class ScenePickerTest( GafferSceneTest.SceneTestCase ) :
+
+	def __scene( self ) :
+	
+		# a plane rotated into a diamond shape at the origin, and
+		# a second plane behind and to the right of it.
+	
+		plane1 = GafferScene.Plane()
+		plane1["transform"]["rotate"].setValue( IECore.V3f( 0, 0, 45 ) )
+		
+		plane2 = GafferScene.Plane()
+		plane2["name"].setValue( "plane2" )
+		plane2["transform"]["translate"].setValue( IECore.V3f( 0.6, 0, -5 ) )
+		
+		group = GafferScene.Group()
+		group["in"].setInput( plane1["out"] )
+		group["in1"].setInput( plane2["out"] )
+		
+		return group, plane1, plane2
+	
+	@staticmethod
+	def __line( x, y ) :
+	
+		return IECore.LineSegment3f( IECore.V3f( x, y, 10 ), IECore.V3f( x, y, -10 ) )
+	
+	@classmethod
+	def __cornerLines( cls, box ) :
+	
+		return [
+			cls.__line( box.min.x, box.min.y ),
+			cls.__line( box.max.x, box.min.y ),
+			cls.__line( box.max.x, box.max.y ),
+			cls.__line( box.min.x, box.max.y ),
+		]
+	
+	def testObjectAt( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		picker = GafferScene.ScenePicker( group["out"], Gaffer.Context() )
+		self.assertEqual( picker.numObjects(), 2 )
+		
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "/group/plane" )
+		self.assertEqual( picker.objectAt( self.__line( 0.9, 0 ) ), "/group/plane2" )
+		self.assertEqual( picker.objectAt( self.__line( 0, 10 ) ), "" )
+		
+		# this point is within the bound of the first plane but not within the
+		# plane itself, so we should see through to the second one.
+		self.assertEqual( picker.objectAt( self.__line( 0.45, 0.45 ) ), "/group/plane2" )
+		
+		# and looking from behind we should see the second plane first
+		self.assertEqual( picker.objectAt( IECore.LineSegment3f( IECore.V3f( 0.2, 0, -10 ), IECore.V3f( 0.2, 0, 10 ) ) ), "/group/plane2" )
+		
+		# the line is a segment, not an infinite ray
+		self.assertEqual( picker.objectAt( IECore.LineSegment3f( IECore.V3f( 0, 0, 10 ), IECore.V3f( 0, 0, 1 ) ) ), "" )
+	
+	def testObjectsAt( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		picker = GafferScene.ScenePicker( group["out"], Gaffer.Context() )
+		
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( -0.3 ), IECore.V2f( 0, 0.3 ) ) ) ), [ "/group/plane" ] )
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( 0.8, 0 ), IECore.V2f( 1 ) ) ) ), [ "/group/plane2" ] )
+		self.assertEqual( set( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( -2 ), IECore.V2f( 2 ) ) ) ) ), set( [ "/group/plane", "/group/plane2" ] ) )
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( 5 ), IECore.V2f( 6 ) ) ) ), [] )
+		
+		# within the bound of the first plane, but not the plane itself
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( 0.42 ), IECore.V2f( 0.48 ) ) ) ), [ "/group/plane2" ] )
+		
+		# entirely within a single face of the first plane, so there
+		# are no vertices or edges within the frustum.
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( -0.1 ), IECore.V2f( 0 ) ) ) ), [ "/group/plane" ] )
+		
+		self.assertRaises( Exception, picker.objectsAt, [ self.__line( 0, 0 ) ] )
+	
+	def testPathsToExpand( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		# when the group isn't expanded, it is drawn as a
+		# box, and should be picked as a whole.
+		
+		picker = GafferScene.ScenePicker( group["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/" ] ) ) )
+		self.assertEqual( picker.numObjects(), 1 )
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "/group" )
+		self.assertEqual( picker.objectAt( self.__line( 0.9, 0 ) ), "/group" )
+		
+		picker = GafferScene.ScenePicker( group["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/", "/group" ] ) ) )
+		self.assertEqual( picker.numObjects(), 2 )
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "/group/plane" )
+	
+	def testUnexpandedLocationWithObject( self ) :
+	
+		plane = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -0.5 ), IECore.V2f( 0.5 ) ) )
+		source = GafferSceneTest.CompoundObjectSource()
+		source["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( plane.bound() ),
+				"children" : {
+					"parent" : {
+						"object" : plane,
+						"bound" : IECore.Box3fData( plane.bound() ),
+						"children" : {
+							"child" : {
+								"object" : plane,
+								"bound" : IECore.Box3fData( plane.bound() ),
+							},
+						},
+					},
+				},
+			} )
+		)
+		
+		# the unexpanded location is drawn as a box enclosing both
+		# its object and its children, and must be picked just once.
+		
+		picker = GafferScene.ScenePicker( source["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/" ] ) ) )
+		self.assertEqual( picker.numObjects(), 1 )
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "/parent" )
+		self.assertEqual( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) ) ), [ "/parent" ] )
+		
+		# when expanded, the object and the child are separate.
+		
+		picker = GafferScene.ScenePicker( source["out"], Gaffer.Context(), GafferScene.PathMatcherData( GafferScene.PathMatcher( [ "/", "/parent" ] ) ) )
+		self.assertEqual( picker.numObjects(), 2 )
+		self.assertEqual(
+			sorted( picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( -1 ), IECore.V2f( 1 ) ) ) ) ),
+			[ "/parent", "/parent/child" ]
+		)
+	
+	def testTransforms( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		group["transform"]["translate"].setValue( IECore.V3f( 10, 0, 0 ) )
+		
+		picker = GafferScene.ScenePicker( group["out"], Gaffer.Context() )
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "" )
+		self.assertEqual( picker.objectAt( self.__line( 10, 0 ) ), "/group/plane" )
+		self.assertTrue( picker.bound().intersects( IECore.V3f( 10, 0, 0 ) ) )
+		self.assertFalse( picker.bound().intersects( IECore.V3f( 0 ) ) )
+	
+	def testInvisibleLocationsIgnored( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["attributes"]["visibility"]["enabled"].setValue( True )
+		attributes["attributes"]["visibility"]["value"].setValue( False )
+		
+		picker = GafferScene.ScenePicker( attributes["out"], Gaffer.Context() )
+		self.assertEqual( picker.numObjects(), 0 )
+		self.assertEqual( picker.objectAt( self.__line( 0, 0 ) ), "" )
+		
+	def testCancellation( self ) :
+	
+		group, plane1, plane2 = self.__scene()
+		
+		canceller = Gaffer.Canceller()
+		canceller.cancel()
+		
+		context = Gaffer.Context()
+		context.setCanceller( canceller )
+		self.assertRaises( RuntimeError, GafferScene.ScenePicker, group["out"], context )
+		
+	def testManyObjects( self ) :
+	
+		plane = IECore.MeshPrimitive.createPlane( IECore.Box2f( IECore.V2f( -0.4 ), IECore.V2f( 0.4 ) ), IECore.V2i( 20 ) )
+		instanceInput = GafferSceneTest.CompoundObjectSource()
+		instanceInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( plane.bound() ),
+				"children" : {
+					"plane" : {
+						"object" : plane,
+						"bound" : IECore.Box3fData( plane.bound() ),
+					},
+				}
+			} )
+		)
+		
+		seeds = IECore.PointsPrimitive( IECore.V3fVectorData( [ IECore.V3f( x, y, 0 ) for x in range( 0, 10 ) for y in range( 0, 10 ) ] ) )
+		seedsInput = GafferSceneTest.CompoundObjectSource()
+		seedsInput["in"].setValue(
+			IECore.CompoundObject( {
+				"bound" : IECore.Box3fData( seeds.bound() ),
+				"children" : {
+					"seeds" : {
+						"bound" : IECore.Box3fData( seeds.bound() ),
+						"object" : seeds,
+					},
+				},
+			}, )
+		)
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( seedsInput["out"] )
+		instancer["instance"].setInput( instanceInput["out"] )
+		instancer["parent"].setValue( "/seeds" )
+		instancer["name"].setValue( "instances" )
+		
+		# the timings for a larger version of this
+		# scene are in SceneBenchmarks.
+		
+		picker = GafferScene.ScenePicker( instancer["out"], Gaffer.Context() )
+		self.assertEqual( picker.numObjects(), 100 )
+		
+		for x in range( 0, 10 ) :
+			self.assertEqual( picker.objectAt( self.__line( x, 5 ) ), "/seeds/instances/%d/plane" % ( x * 10 + 5 ) )
+		
+		names = picker.objectsAt( self.__cornerLines( IECore.Box2f( IECore.V2f( 2.5 ), IECore.V2f( 6.5 ) ) ) )
+		self.assertEqual( len( names ), 16 )
+	
+	def testAxisAlignedRayOnBoxFace( self ) :
+	
+		# rays with zero direction components, starting on a face
+		# of the cube's bound, must still hit it. Computing the
+		# slab intersections naively gives 0 * inf = NaN for these.
+	
+		cube = GafferScene.Cube()
+		picker = GafferScene.ScenePicker( cube["out"], Gaffer.Context() )
+		self.assertEqual( picker.numObjects(), 1 )
+		
+		for p0, p1 in [
+			( IECore.V3f( 0.5, 0, 0 ), IECore.V3f( 0.5, 0, -10 ) ),
+			( IECore.V3f( -0.5, 0, 0 ), IECore.V3f( -0.5, 0, 10 ) ),
+			( IECore.V3f( 0, 0.5, 0 ), IECore.V3f( 10, 0.5, 0 ) ),
+			( IECore.V3f( 0, 0, 0.5 ), IECore.V3f( 0, 0, -10 ) ),
+		] :
+			self.assertEqual( picker.objectAt( IECore.LineSegment3f( p0, p1 ) ), "/cube" )
+		
+		# and rays parallel to the faces but outside
+		# the bound must miss.
+		self.assertEqual( picker.objectAt( IECore.LineSegment3f( IECore.V3f( 0.6, 0, 0 ), IECore.V3f( 0.6, 0, -10 ) ) ), "" )
+		self.assertEqual( picker.objectAt( IECore.LineSegment3f( IECore.V3f( 0, -0.6, 10 ), IECore.V3f( 0, -0.6, -10 ) ) ), "" )
+		
+		
+if __name__ == "__main__":
+	unittest.main()
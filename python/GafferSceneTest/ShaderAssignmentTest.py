@@ -165,6 +165,32 @@ class ShaderAssignmentTest( unittest.TestCase ) :
 		
 		self.assertTrue( "shader" in s["a"]["out"].attributes( "/plane" ) )
 		self.assertEqual( s["a2"]["out"].attributes( "/plane" )["shader"][-1].name, "test" )
+	
+	def testStateSharedBetweenLocations( self ) :
+	
+		s = Gaffer.ScriptNode()
+
+		s["p"] = GafferScene.Plane()
+		s["g"] = GafferScene.Group()
+		s["g"]["in"].setInput( s["p"]["out"] )
+		s["g"]["in1"].setInput( s["p"]["out"] )
+		
+		s["s"] = GafferSceneTest.TestShader()
+		
+		s["a"] = GafferScene.ShaderAssignment()
+		s["a"]["in"].setInput( s["g"]["out"] )
+		s["a"]["shader"].setInput( s["s"]["out"] )
+		
+		a1 = s["a"]["out"].attributes( "/group/plane", _copy = False )
+		a2 = s["a"]["out"].attributes( "/group/plane1", _copy = False )
+		
+		self.assertTrue( a1["shader"].isSame( a2["shader"] ) )
+		
+		s["s"]["parameters"]["i"].setValue( 10 )
+		
+		a3 = s["a"]["out"].attributes( "/group/plane", _copy = False )
+		self.assertFalse( a3["shader"].isSame( a1["shader"] ) )
+		self.assertEqual( a3["shader"][-1].parameters["i"], IECore.IntData( 10 ) )
 		
 if __name__ == "__main__":
 	unittest.main()
@@ -81,6 +81,10 @@ from TextTest import TextTest
 from MapProjectionTest import MapProjectionTest
 from PointConstraintTest import PointConstraintTest
 from SceneReaderTest import SceneReaderTest
+from ScenePickerTest import ScenePickerTest
+from OpenGLSceneCacheTest import OpenGLSceneCacheTest
+import SceneBenchmarks
+from SceneBenchmarksTest import SceneBenchmarksTest
 
 if __name__ == "__main__":
 	import unittest
@@ -0,0 +1,132 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import time
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class BackgroundTaskTest( unittest.TestCase ) :
+
+	def testRun( self ) :
+	
+		results = []
+		def f( canceller ) :
+		
+			results.append( canceller.cancelled() )
+		
+		t = Gaffer.BackgroundTask( f )
+		t.wait()
+		
+		self.assertTrue( t.done() )
+		self.assertEqual( results, [ False ] )
+	
+	def testCancel( self ) :
+	
+		def f( canceller ) :
+		
+			while True :
+				canceller.check()
+				time.sleep( 0.01 )
+		
+		t = Gaffer.BackgroundTask( f )
+		self.assertFalse( t.done() )
+		
+		startTime = time.time()
+		t.cancelAndWait()
+		self.assertTrue( t.done() )
+		self.assertTrue( time.time() - startTime < 1 )
+	
+	def testCancelComputation( self ) :
+	
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+		
+		results = []
+		def f( canceller ) :
+		
+			context = Gaffer.Context()
+			context.setCanceller( canceller )
+			with context :
+				while not Gaffer.Context.current().canceller().cancelled() :
+					time.sleep( 0.01 )
+				results.append( n["sum"].getValue() )
+				
+		t = Gaffer.BackgroundTask( f )
+		t.cancelAndWait()
+		
+		# AddNode doesn't check for cancellation, so the
+		# computation is allowed to complete.
+		self.assertEqual( results, [ 3 ] )
+	
+	def testContextOutlivesTask( self ) :
+	
+		contexts = []
+		def f( canceller ) :
+		
+			context = Gaffer.Context()
+			context.setCanceller( canceller )
+			contexts.append( Gaffer.Context( context ) )
+		
+		t = Gaffer.BackgroundTask( f )
+		t.wait()
+		del t
+		
+		# the context holds a reference to the canceller,
+		# so it remains valid after the task is destroyed.
+		self.assertEqual( len( contexts ), 1 )
+		self.assertTrue( contexts[0].canceller().cancelled() )
+	
+	def testDestructionCancels( self ) :
+	
+		def f( canceller ) :
+		
+			while True :
+				canceller.check()
+				time.sleep( 0.01 )
+		
+		t = Gaffer.BackgroundTask( f )
+		startTime = time.time()
+		del t
+		self.assertTrue( time.time() - startTime < 1 )
+		
+if __name__ == "__main__":
+	unittest.main()
@@ -0,0 +1,156 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+import time
+
+import Gaffer
+
+## Base class for the benchmarks run by the "gaffer benchmark" app. Derived
+# classes build a node graph in setUp() and perform the work to be measured
+# in run(). Benchmarks are timed once with an empty cache and then repeatedly
+# with a warm one, and the results are returned as dictionaries suitable for
+# serialisation with the json module, so that they may be stored as a
+# baseline and compared against future runs.
+class Benchmark( object ) :
+
+	def __init__( self, name ) :
+
+		self.__name = name
+
+	def name( self ) :
+
+		return self.__name
+
+	def setUp( self ) :
+
+		pass
+
+	## Must be implemented by derived classes to perform
+	# the work to be measured.
+	def run( self ) :
+
+		raise NotImplementedError
+
+	def tearDown( self ) :
+
+		pass
+
+	## May be implemented by derived classes to return additional measurements
+	# derived from the time taken by a single call to run(), as a dictionary
+	# mapping from names to values.
+	def measurements( self, seconds ) :
+
+		return {}
+
+	## Calls run() once with an empty cache and then the specified number of
+	# times with a warm cache, returning a dictionary containing the results.
+	# The fastest of the warm runs is reported.
+	def execute( self, repeats = 3 ) :
+
+		self.setUp()
+		try :
+			Gaffer.ValuePlug.clearCache()
+			cold = self.__timedRun()
+			warm = [ self.__timedRun() for i in range( 0, repeats ) ]
+		finally :
+			self.tearDown()
+
+		result = { "cold" : cold }
+		if warm :
+			result["warm"] = min( warm, key = lambda r : r["seconds"] )
+
+		return result
+
+	## The measurements compared by compare(), all of which
+	# are considered to have regressed when they increase.
+	comparedMeasurements = ( "seconds", "hashCount", "computeCount" )
+
+	## Compares results from execute() against a baseline of previous results,
+	# both being dictionaries mapping from benchmark names to results. Returns
+	# a list of descriptions of any measurements which are worse than the
+	# baseline by more than the specified tolerance (a fraction of the baseline
+	# value). Timings shorter than minimumSeconds are considered too noisy to
+	# compare.
+	@staticmethod
+	def compare( results, baseline, tolerance = 0.1, minimumSeconds = 0.01 ) :
+
+		regressions = []
+		for name in sorted( results.keys() ) :
+
+			if name not in baseline :
+				continue
+
+			for run in ( "cold", "warm" ) :
+
+				if run not in results[name] or run not in baseline[name] :
+					continue
+
+				for measurement in Benchmark.comparedMeasurements :
+
+					value = results[name][run].get( measurement )
+					baselineValue = baseline[name][run].get( measurement )
+					if value is None or baselineValue is None :
+						continue
+
+					if measurement == "seconds" and max( value, baselineValue ) < minimumSeconds :
+						continue
+
+					if value > baselineValue * ( 1 + tolerance ) :
+						regressions.append(
+							"%s (%s) : %s increased from %s to %s" % ( name, run, measurement, baselineValue, value )
+						)
+
+		return regressions
+
+	def __timedRun( self ) :
+
+		Gaffer.ValuePlug.resetStatistics()
+
+		t = time.time()
+		self.run()
+		seconds = time.time() - t
+
+		statistics = Gaffer.ValuePlug.statistics()
+		result = {
+			"seconds" : seconds,
+			"hashCount" : statistics.hashCount,
+			"computeCount" : statistics.computeCount,
+			"cacheHitCount" : statistics.cacheHitCount,
+			"cacheMemoryUsage" : Gaffer.ValuePlug.cacheMemoryUsage(),
+		}
+		result.update( self.measurements( seconds ) )
+
+		return result
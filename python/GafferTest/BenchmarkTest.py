@@ -0,0 +1,113 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import unittest
+
+import Gaffer
+import GafferTest
+
+class BenchmarkTest( GafferTest.TestCase ) :
+
+	class AddBenchmark( GafferTest.Benchmark ) :
+
+		def __init__( self ) :
+
+			GafferTest.Benchmark.__init__( self, "add" )
+
+		def setUp( self ) :
+
+			self.node = GafferTest.AddNode()
+			self.node["op1"].setValue( 1 )
+
+		def run( self ) :
+
+			self.node["sum"].getValue()
+
+		def measurements( self, seconds ) :
+
+			return { "sumsPerSecond" : 1 / max( seconds, 1e-6 ) }
+
+	def testExecute( self ) :
+
+		results = self.AddBenchmark().execute( repeats = 2 )
+
+		self.assertEqual( results["cold"]["computeCount"], 1 )
+		self.assertEqual( results["cold"]["hashCount"], 1 )
+		self.assertEqual( results["cold"]["cacheHitCount"], 0 )
+		self.failUnless( "sumsPerSecond" in results["cold"] )
+
+		self.assertEqual( results["warm"]["computeCount"], 0 )
+		self.assertEqual( results["warm"]["cacheHitCount"], 1 )
+
+	def testCompare( self ) :
+
+		baseline = {
+			"a" : {
+				"cold" : { "seconds" : 1.0, "hashCount" : 100, "computeCount" : 100 },
+				"warm" : { "seconds" : 0.5, "hashCount" : 100, "computeCount" : 0 },
+			},
+		}
+
+		self.assertEqual( GafferTest.Benchmark.compare( baseline, baseline ), [] )
+
+		# within tolerance
+		results = {
+			"a" : {
+				"cold" : { "seconds" : 1.05, "hashCount" : 100, "computeCount" : 100 },
+				"warm" : { "seconds" : 0.5, "hashCount" : 100, "computeCount" : 0 },
+			},
+			"b" : {
+				"cold" : { "seconds" : 100.0, "hashCount" : 100, "computeCount" : 100 },
+			},
+		}
+		self.assertEqual( GafferTest.Benchmark.compare( results, baseline, tolerance = 0.1 ), [] )
+
+		# outside tolerance
+		results["a"]["cold"]["seconds"] = 1.5
+		results["a"]["warm"]["computeCount"] = 10
+		regressions = GafferTest.Benchmark.compare( results, baseline, tolerance = 0.1 )
+		self.assertEqual( len( regressions ), 2 )
+		self.failUnless( "seconds" in regressions[0] )
+		self.failUnless( "computeCount" in regressions[1] )
+
+		# improvements aren't regressions
+		results["a"]["cold"]["seconds"] = 0.1
+		results["a"]["warm"]["computeCount"] = 0
+		self.assertEqual( GafferTest.Benchmark.compare( results, baseline, tolerance = 0.1 ), [] )
+
+if __name__ == "__main__":
+	unittest.main()
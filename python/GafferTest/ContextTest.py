@@ -34,6 +34,7 @@
 #  
 ##########################################################################
 
+import os
 import unittest
 import threading
 import weakref
@@ -244,6 +245,57 @@ class ContextTest( unittest.TestCase ) :
 		self.assertEqual( c.substitute( "$a/$dontExist/something.###.tif" ), "apple//something.020.tif" )
 		self.assertEqual( c.substitute( "${badlyFormed" ), "" )
 	
+	def testSubstituteNestedAndPadded( self ) :
+	
+		c = Gaffer.Context()
+		c.setFrame( -5 )
+		c["a"] = "${b}/${c}"
+		c["b"] = "bear"
+		c["c"] = 10
+		
+		self.assertEqual( c.substitute( "$a.#.####" ), "bear/10.-5.00-5" )
+		self.assertEqual( c.substitute( "noSubstitutions" ), "noSubstitutions" )
+		self.assertEqual( c.substitute( "~/a~b" ), os.path.expanduser( "~" ) + "/a~b" )
+		
+		# the same string should give the right answer
+		# in any context, despite the caching of the parsing.
+		c2 = Gaffer.Context()
+		c2.setFrame( 2 )
+		c2["a"] = "apple"
+		self.assertEqual( c2.substitute( "$a.#.####" ), "apple.2.0002" )
+		self.assertEqual( c.substitute( "$a.#.####" ), "bear/10.-5.00-5" )
+	
+	def testSubstitutionHash( self ) :
+	
+		c = Gaffer.Context()
+		c.setFrame( 1 )
+		c["a"] = "apple"
+		c["b"] = "${c}"
+		c["c"] = "cat"
+		
+		h = c.substitutionHash( "$a/$b.####.tif" )
+		self.assertEqual( h, c.substitutionHash( "$a/$b.####.tif" ) )
+		self.assertNotEqual( h, c.substitutionHash( "$a/$b.###.tif" ) )
+		
+		# variables which aren't referenced shouldn't affect the hash
+		c["unused"] = 10
+		self.assertEqual( h, c.substitutionHash( "$a/$b.####.tif" ) )
+		
+		# but those which are referenced should, including
+		# those referenced indirectly by other variables.
+		c["c"] = "dog"
+		self.assertNotEqual( h, c.substitutionHash( "$a/$b.####.tif" ) )
+		c["c"] = "cat"
+		self.assertEqual( h, c.substitutionHash( "$a/$b.####.tif" ) )
+		
+		c.setFrame( 2 )
+		self.assertNotEqual( h, c.substitutionHash( "$a/$b.####.tif" ) )
+		
+		# the frame should only matter when it is used
+		c2 = Gaffer.Context( c )
+		c2.setFrame( 100 )
+		self.assertEqual( c.substitutionHash( "$a" ), c2.substitutionHash( "$a" ) )
+	
 	def testNames( self ) :
 	
 		c = Gaffer.Context()
@@ -260,6 +312,45 @@ class ContextTest( unittest.TestCase ) :
 		self.assertEqual( set( c.names() ), set( [ "frame", "a" ] ) )
 		
 		self.assertEqual( cc.names(), cc.keys() )
+	
+	def testCanceller( self ) :
+	
+		c = Gaffer.Context()
+		self.assertEqual( c.canceller(), None )
+		
+		canceller = Gaffer.Canceller()
+		c.setCanceller( canceller )
+		self.assertFalse( c.canceller().cancelled() )
+		
+		# copies inherit the canceller, but it doesn't
+		# affect the hash or comparisons.
+		cc = Gaffer.Context( c )
+		self.assertFalse( cc.canceller() is None )
+		self.assertEqual( cc.hash(), Gaffer.Context().hash() )
+		self.assertEqual( cc, Gaffer.Context() )
+		
+		canceller.cancel()
+		self.assertTrue( cc.canceller().cancelled() )
+		self.assertRaises( RuntimeError, cc.canceller().check )
+		
+		c.setCanceller( None )
+		self.assertEqual( c.canceller(), None )
+	
+	def testCopiesKeepCancellerAlive( self ) :
+	
+		c = Gaffer.Context()
+		canceller = Gaffer.Canceller()
+		c.setCanceller( canceller )
+		cc = Gaffer.Context( c )
+		
+		# the copy holds its own reference, so
+		# remains valid once the others are gone.
+		del c
+		del canceller
+		
+		self.assertFalse( cc.canceller().cancelled() )
+		cc.canceller().cancel()
+		self.assertTrue( cc.canceller().cancelled() )
 		
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,120 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import shutil
+import tempfile
+
+import Gaffer
+import GafferTest
+
+## Times the loading of a large generated script, saved in
+# the format specified by the file extension, which may be
+# either ".gfr" or ".gfb".
+class ScriptLoadBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, extension, numNodes = 10000 ) :
+
+		GafferTest.Benchmark.__init__( self, "scriptLoad%s" % extension )
+
+		self.__extension = extension
+		self.__numNodes = numNodes
+
+	def setUp( self ) :
+
+		self.__directory = tempfile.mkdtemp( prefix = "gafferScriptLoadBenchmark" )
+		self.__fileName = os.path.join( self.__directory, "script" + self.__extension )
+
+		s = Gaffer.ScriptNode()
+		for i in range( 0, self.__numNodes ) :
+			n = GafferTest.AddNode( "AddNode" + str( i ) )
+			n["op2"].setValue( i )
+			if i :
+				n["op1"].setInput( s["AddNode" + str( i - 1 )]["sum"] )
+			s.addChild( n )
+
+		s["fileName"].setValue( self.__fileName )
+		s.save()
+
+	def run( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["fileName"].setValue( self.__fileName )
+		s.load()
+
+	def tearDown( self ) :
+
+		shutil.rmtree( self.__directory, ignore_errors = True )
+
+	def measurements( self, seconds ) :
+
+		return { "nodesPerSecond" : self.__numNodes / max( seconds, 1e-6 ) }
+
+## Times repeated variable substitutions in a Context whose frame
+# is changing, as is typical when computing file names.
+class ContextSubstitutionBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numSubstitutions = 100000 ) :
+
+		GafferTest.Benchmark.__init__( self, "contextSubstitution" )
+
+		self.__numSubstitutions = numSubstitutions
+
+	def setUp( self ) :
+
+		self.__context = Gaffer.Context()
+		self.__context["project"] = "myProject"
+		self.__context["shot"] = "s010"
+
+	def run( self ) :
+
+		for i in range( 0, self.__numSubstitutions ) :
+			self.__context.setFrame( i )
+			self.__context.substitute( "/jobs/${project}/${shot}/images/beauty.####.exr" )
+
+	def measurements( self, seconds ) :
+
+		return { "substitutionsPerSecond" : self.__numSubstitutions / max( seconds, 1e-6 ) }
+
+## Returns the core benchmarks to be run by the "gaffer benchmark" app.
+def benchmarks() :
+
+	return [
+		ScriptLoadBenchmark( ".gfr" ),
+		ScriptLoadBenchmark( ".gfb" ),
+		ContextSubstitutionBenchmark(),
+	]
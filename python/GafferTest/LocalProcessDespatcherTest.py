@@ -0,0 +1,168 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import os
+import shutil
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class LocalProcessDespatcherTest( unittest.TestCase ) :
+
+	__outputDirectory = "/tmp/localProcessDespatcherTest"
+
+	def setUp( self ) :
+
+		if not os.path.exists( self.__outputDirectory ) :
+			os.makedirs( self.__outputDirectory )
+
+	def __writer( self, script, name, fileName ) :
+
+		script[name] = Gaffer.ObjectWriter()
+		script[name]["in"].setInput( script["sphere"]["out"] )
+		script[name]["fileName"].setValue( os.path.join( self.__outputDirectory, fileName ) )
+
+		return script[name]
+
+	def testRegistration( self ) :
+
+		self.failUnless( "localProcesses" in Gaffer.Despatcher.despatcherNames() )
+		self.failUnless( Gaffer.Despatcher.despatcher( "localProcesses" ).isInstanceOf( Gaffer.LocalProcessDespatcher.staticTypeId() ) )
+
+	def testPlugs( self ) :
+
+		n = Gaffer.ObjectWriter()
+		self.failUnless( isinstance( n["despatcherParameters"]["localProcesses"]["batchSize"], Gaffer.IntPlug ) )
+		self.assertEqual( n["despatcherParameters"]["localProcesses"]["batchSize"].getValue(), 0 )
+
+	def testFrames( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["sphere"] = GafferTest.SphereNode()
+		w = self.__writer( s, "writer", "sphere.####.cob" )
+		w["despatcherParameters"]["localProcesses"]["batchSize"].setValue( 2 )
+
+		despatcher = Gaffer.LocalProcessDespatcher()
+		despatcher.setFrames( IECore.FrameRange( 1, 5 ) )
+		despatcher.setMaxProcesses( 2 )
+		despatcher.despatch( [ w ] )
+
+		for frame in range( 1, 6 ) :
+			self.failUnless( os.path.exists( os.path.join( self.__outputDirectory, "sphere.%04d.cob" % frame ) ) )
+
+	def testRequirementsExecuteFirst( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["sphere"] = GafferTest.SphereNode()
+		w1 = self.__writer( s, "writer1", "first.####.cob" )
+		w2 = self.__writer( s, "writer2", "second.####.cob" )
+
+		r = Gaffer.Plug( name = "r1" )
+		w2["requirements"].addChild( r )
+		r.setInput( w1["requirement"] )
+
+		despatcher = Gaffer.LocalProcessDespatcher()
+		despatcher.setFrames( IECore.FrameRange( 1, 4 ) )
+		despatcher.despatch( [ w2 ] )
+
+		for frame in range( 1, 5 ) :
+			first = os.path.join( self.__outputDirectory, "first.%04d.cob" % frame )
+			second = os.path.join( self.__outputDirectory, "second.%04d.cob" % frame )
+			self.failUnless( os.path.exists( first ) )
+			self.failUnless( os.path.exists( second ) )
+			self.failUnless( os.path.getmtime( second ) >= os.path.getmtime( first ) )
+
+	def testNodesInBoxes( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["sphere"] = GafferTest.SphereNode()
+		self.__writer( s, "writer", "boxed.####.cob" )
+		b = Gaffer.Box.create( s, Gaffer.StandardSet( [ s["writer"] ] ) )
+
+		despatcher = Gaffer.LocalProcessDespatcher()
+		despatcher.despatch( [ b["writer"] ] )
+
+		self.failUnless( os.path.exists( os.path.join( self.__outputDirectory, "boxed.0001.cob" ) ) )
+
+	def testFailureSkipsDependents( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["sphere"] = GafferTest.SphereNode()
+		w1 = self.__writer( s, "writer1", "bad.####.notAnExtension" )
+		w2 = self.__writer( s, "writer2", "dependent.####.cob" )
+
+		r = Gaffer.Plug( name = "r1" )
+		w2["requirements"].addChild( r )
+		r.setInput( w1["requirement"] )
+
+		despatcher = Gaffer.LocalProcessDespatcher()
+		despatcher.setFrames( IECore.FrameRange( 1, 2 ) )
+		self.assertRaises( RuntimeError, despatcher.despatch, [ w2 ] )
+
+		for frame in range( 1, 3 ) :
+			self.failIf( os.path.exists( os.path.join( self.__outputDirectory, "dependent.%04d.cob" % frame ) ) )
+
+	def testScriptNameMatchesInProcess( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["sphere"] = GafferTest.SphereNode()
+		w = self.__writer( s, "writer", "${script:name}Named.####.cob" )
+
+		despatcher = Gaffer.LocalProcessDespatcher()
+
+		# unsaved scripts have an empty name, and the workers
+		# must see the same name as this process, rather than
+		# one derived from the temporary file they load.
+		despatcher.despatch( [ w ] )
+		self.failUnless( os.path.exists( os.path.join( self.__outputDirectory, "Named.0001.cob" ) ) )
+
+		s["fileName"].setValue( os.path.join( self.__outputDirectory, "saved.gfr" ) )
+		despatcher.despatch( [ w ] )
+		self.failUnless( os.path.exists( os.path.join( self.__outputDirectory, "savedNamed.0001.cob" ) ) )
+
+		self.assertEqual( len( [ f for f in os.listdir( self.__outputDirectory ) if f.endswith( ".cob" ) ] ), 2 )
+
+	def tearDown( self ) :
+
+		if os.path.exists( self.__outputDirectory ) :
+			shutil.rmtree( self.__outputDirectory )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -1084,11 +1084,134 @@ a = A()"""
 		
 		self.assertEqual( s.currentActionStage(), Gaffer.Action.Stage.Invalid )
 		
+	def testBinarySaveAndLoad( self ) :
+	
+		s = Gaffer.ScriptNode()
+		
+		s["a1"] = GafferTest.AddNode()
+		s["a1"]["op1"].setValue( 5 )
+		s["a1"]["op2"].setValue( 6 )
+		s["a1"]["enabled"].setValue( False )
+		
+		s["a2"] = GafferTest.AddNode()
+		s["a2"]["op1"].setInput( s["a1"]["sum"] )
+		s["a2"]["op2"].setValue( 10 )
+		s["a2"]["op2"].setFlags( Gaffer.Plug.Flags.ReadOnly, True )
+		
+		s["a2"]["dynamicString"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["a2"]["dynamicString"].setValue( "hiThere" )
+		s["a2"]["dynamicColor"] = Gaffer.Color3fPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["a2"]["dynamicColor"].setValue( IECore.Color3f( 1, 2, 3 ) )
+		
+		s["customSetting"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["customSetting"].setValue( 100 )
+		
+		s["fileName"].setValue( "/tmp/test.gfb" )
+		s.save()
+		
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( "/tmp/test.gfb" )
+		s2.load()
+		
+		self.assertEqual( s2["a1"]["op1"].getValue(), 5 )
+		self.assertEqual( s2["a1"]["op2"].getValue(), 6 )
+		self.assertEqual( s2["a1"]["enabled"].getValue(), False )
+		self.assertTrue( s2["a2"]["op1"].getInput().isSame( s2["a1"]["sum"] ) )
+		self.assertEqual( s2["a2"]["op2"].getValue(), 10 )
+		self.assertTrue( s2["a2"]["op2"].getFlags( Gaffer.Plug.Flags.ReadOnly ) )
+		self.assertEqual( s2["a2"]["dynamicString"].getValue(), "hiThere" )
+		self.assertEqual( s2["a2"]["dynamicColor"].getValue(), IECore.Color3f( 1, 2, 3 ) )
+		self.assertEqual( s2["customSetting"].getValue(), 100 )
+		self.assertEqual( s2["unsavedChanges"].getValue(), False )
+	
+	def testBinaryLoadEmitsScriptExecutedSignal( self ) :
+	
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["fileName"].setValue( "/tmp/test.gfb" )
+		s.save()
+		
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( "/tmp/test.gfb" )
+		
+		cs = GafferTest.CapturingSlot( s2.scriptExecutedSignal() )
+		s2.load()
+		
+		self.assertEqual( len( cs ), 1 )
+		self.assertTrue( cs[0][0].isSame( s2 ) )
+		self.assertEqual( cs[0][1], "" )
+		
+	def testBinaryRoundTrip( self ) :
+	
+		s = Gaffer.ScriptNode()
+		
+		s["a1"] = GafferTest.AddNode()
+		s["a1"]["op1"].setValue( 1 )
+		s["a2"] = GafferTest.AddNode()
+		s["a2"]["op1"].setInput( s["a1"]["sum"] )
+		s["a2"]["op2"].setInput( s["a1"]["sum"] )
+		s["b"] = Gaffer.Box()
+		s["b"]["a3"] = GafferTest.AddNode()
+		s["b"]["a3"]["op2"].setValue( 20 )
+		s["b"]["a3"]["op1"].setInput( s["a2"]["sum"] )
+		
+		s["fileName"].setValue( "/tmp/test.gfr" )
+		s.save()
+		
+		# load the python script and convert it to binary
+		
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( "/tmp/test.gfr" )
+		s2.load()
+		s2["fileName"].setValue( "/tmp/test.gfb" )
+		s2.save()
+		
+		# load the binary script and convert it back to python
+		
+		s3 = Gaffer.ScriptNode()
+		s3["fileName"].setValue( "/tmp/test.gfb" )
+		s3.load()
+		s3["fileName"].setValue( "/tmp/test2.gfr" )
+		s3.save()
+		
+		self.assertEqual( s3.serialise(), s.serialise() )
+		self.assertEqual( open( "/tmp/test2.gfr" ).read(), open( "/tmp/test.gfr" ).read() )
+	
+	def testBinarySerialiseToFileWithFilter( self ) :
+	
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.AddNode()
+		s["n2"] = GafferTest.AddNode()
+		s["n2"]["op1"].setInput( s["n1"]["sum"] )
+		s["n2"]["op2"].setValue( 2 )
+		
+		s.serialiseToFile( "/tmp/test.gfb", filter = Gaffer.StandardSet( [ s["n2"] ] ) )
+		
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( "/tmp/test.gfb" )
+		s2.load()
+		
+		self.assertTrue( "n2" in s2 )
+		self.assertTrue( "n1" not in s2 )
+		self.assertEqual( s2["n2"]["op1"].getInput(), None )
+		self.assertEqual( s2["n2"]["op2"].getValue(), 2 )
+	
+	def testBinaryLoadFailureHandling( self ) :
+	
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["fileName"].setValue( "/this/file/doesnt/exist.gfb" )
+		self.assertRaises( Exception, s.load )
+		
+		# a failed load shouldn't have cleared the script
+		self.assertTrue( "n" in s )
+	
 	def tearDown( self ) :
 	
 		for f in (
 			"/tmp/test.gfr",
 			"/tmp/test2.gfr",
+			"/tmp/test.gfb",
 		) :
 			if os.path.exists( f ) :
 				os.remove( f )
@@ -34,6 +34,7 @@
 #  
 ##########################################################################
 
+import os
 import unittest
 
 import IECore
@@ -117,6 +118,40 @@ class SpeedTest( unittest.TestCase ) :
 			c = s[n]
 			self.assertEqual( c.getName(), n )
 					
+	# Checks that a large generated script survives a round trip
+	# through both the python and binary formats. The load times are
+	# measured by the "scriptLoad" benchmarks in GafferTest.CoreBenchmarks.
+	def testBinaryLoad( self ) :
+	
+		s = Gaffer.ScriptNode()
+		for i in range( 0, 10000 ) :
+			n = GafferTest.AddNode( "AddNode" + str( i ) )
+			n["op2"].setValue( i )
+			if i :
+				n["op1"].setInput( s["AddNode" + str( i - 1 )]["sum"] )
+			s.addChild( n )
+		
+		for fileName in ( "/tmp/speedTest.gfr", "/tmp/speedTest.gfb" ) :
+		
+			s["fileName"].setValue( fileName )
+			s.save()
+			
+			s2 = Gaffer.ScriptNode()
+			s2["fileName"].setValue( fileName )
+			s2.load()
+			self.assertEqual( len( s2.children( Gaffer.Node.staticTypeId() ) ), 10000 )
+			self.assertTrue( s2["AddNode9999"]["op1"].getInput().isSame( s2["AddNode9998"]["sum"] ) )
+			self.assertEqual( s2["AddNode9999"]["op2"].getValue(), 9999 )
+	
+	def tearDown( self ) :
+	
+		for f in (
+			"/tmp/speedTest.gfr",
+			"/tmp/speedTest.gfb",
+		) :
+			if os.path.exists( f ) :
+				os.remove( f )
+					
 if __name__ == "__main__":
 	unittest.main()
 	
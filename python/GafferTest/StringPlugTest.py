@@ -151,6 +151,44 @@ class StringPlugTest( GafferTest.TestCase ) :
 			self.assertEqual( n["out"].getValue(), "b" )
 			self.assertNotEqual( n["out"].hash(), h1 )
 			self.assertNotEqual( n["out"].hash(), h2 )
+	
+	def testHashDependsOnlyOnReferencedVariables( self ) :
+	
+		n = GafferTest.StringInOutNode()
+		n["in"].setValue( "${a}.####.exr" )
+		
+		context = Gaffer.Context()
+		context["a"] = "apple"
+		with context :
+			h = n["out"].hash()
+		
+		context["b"] = "bear"
+		with context :
+			self.assertEqual( n["out"].hash(), h )
+		
+		context["a"] = "anchovy"
+		with context :
+			self.assertNotEqual( n["out"].hash(), h )
+			self.assertEqual( n["out"].getValue(), "anchovy.0001.exr" )
+	
+	def testHashDoesntPerformSubstitution( self ) :
+	
+		# the hash should come from Context::substitutionHash(),
+		# rather than from hashing the result of substitute().
+		
+		n = GafferTest.StringInOutNode()
+		n["in"].setValue( "${a}.####.exr" )
+		
+		context = Gaffer.Context()
+		context["a"] = "apple"
+		with context :
+			h = n["in"].hash()
+		
+		self.assertEqual( h, context.substitutionHash( "${a}.####.exr" ) )
+		
+		substituted = IECore.MurmurHash()
+		substituted.append( "apple.0001.exr" )
+		self.assertNotEqual( h, substituted )
 		
 if __name__ == "__main__":
 	unittest.main()
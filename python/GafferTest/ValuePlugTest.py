@@ -140,6 +140,49 @@ class ValuePlugTest( GafferTest.TestCase ) :
 		self.assertEqual( s2["n"]["p"].getValue(), 100 )
 		self.assertEqual( s2["n"]["p"].getFlags( Gaffer.Plug.Flags.ReadOnly ), True )
 	
+	def testClearCache( self ) :
+	
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["sum"].getValue()
+		self.failUnless( Gaffer.ValuePlug.cacheMemoryUsage() > 0 )
+		
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage(), 0 )
+	
+	def testStatistics( self ) :
+	
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+		
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.resetStatistics()
+		
+		s = Gaffer.ValuePlug.statistics()
+		self.assertEqual( s.hashCount, 0 )
+		self.assertEqual( s.computeCount, 0 )
+		self.assertEqual( s.cacheHitCount, 0 )
+		
+		self.assertEqual( n["sum"].getValue(), 3 )
+		s = Gaffer.ValuePlug.statistics()
+		self.assertEqual( s.hashCount, 1 )
+		self.assertEqual( s.computeCount, 1 )
+		self.assertEqual( s.cacheHitCount, 0 )
+		
+		# second time around we should get the value from the cache
+		self.assertEqual( n["sum"].getValue(), 3 )
+		s = Gaffer.ValuePlug.statistics()
+		self.assertEqual( s.hashCount, 2 )
+		self.assertEqual( s.computeCount, 1 )
+		self.assertEqual( s.cacheHitCount, 1 )
+		
+		Gaffer.ValuePlug.resetStatistics()
+		s = Gaffer.ValuePlug.statistics()
+		self.assertEqual( s.hashCount, 0 )
+		self.assertEqual( s.computeCount, 0 )
+		self.assertEqual( s.cacheHitCount, 0 )
+	
 	def setUp( self ) :
 	
 		self.__originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
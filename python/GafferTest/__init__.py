@@ -89,6 +89,7 @@ from ApplicationRootTest import ApplicationRootTest
 from ObjectWriterTest import ObjectWriterTest
 from ExecuteApplicationTest import ExecuteApplicationTest
 from ContextTest import ContextTest
+from BackgroundTaskTest import BackgroundTaskTest
 from CompoundPathFilterTest import CompoundPathFilterTest
 from BadNode import BadNode
 from CapturingSlot import CapturingSlot
@@ -119,7 +120,12 @@ from BoxTest import BoxTest
 from OutputRedirectionTest import OutputRedirectionTest
 from ExecutableNodeTest import ExecutableNodeTest
 from ExecutableOpHolderTest import ExecutableOpHolderTest
+from Benchmark import Benchmark
+from BenchmarkTest import BenchmarkTest
+import CoreBenchmarks
+from CoreBenchmarksTest import CoreBenchmarksTest
 from DespatcherTest import DespatcherTest
+from LocalProcessDespatcherTest import LocalProcessDespatcherTest
 from RecursiveChildIteratorTest import RecursiveChildIteratorTest
 from FilteredRecursiveChildIteratorTest import FilteredRecursiveChildIteratorTest
 from ReferenceTest import ReferenceTest
@@ -0,0 +1,147 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import weakref
+import functools
+
+import IECore
+
+import Gaffer
+import GafferUI
+
+## The BackgroundCompute class computes plug values on a background thread, so
+# that lengthy computations don't block the ui, and delivers the results on the
+# ui thread. Making a new request cancels any request still in progress, so that
+# while a plug is being edited interactively, only the most recent value is
+# computed to completion. Edits to the graph also cancel the request in progress,
+# waiting for it to stop before the edit is made (see Gaffer.BackgroundTask) - in
+# this case the request is restarted automatically.
+class BackgroundCompute( object ) :
+
+	## The callback is called on the ui thread as callback( plug, value ) when a
+	# request completes. If the computation fails, the error is reported via
+	# IECore.msg() and the callback receives a value of None.
+	def __init__( self, callback ) :
+	
+		self.__callback = callback
+		self.__task = None
+		self.__cancelledTasks = []
+		self.__requestId = 0
+		
+	## Requests the value of plug, as computed in a copy of context. Any request
+	# still in progress is cancelled.
+	def request( self, plug, context ) :
+	
+		self.cancel()
+		
+		self.__requestId += 1
+		self.__task = Gaffer.BackgroundTask(
+			functools.partial(
+				self.__compute,
+				weakref.ref( self ),
+				plug,
+				Gaffer.Context( context ),
+				self.__requestId
+			)
+		)
+	
+	## Cancels the request in progress, if any. Returns immediately, without
+	# waiting for the computation to stop.
+	def cancel( self ) :
+	
+		# invalidate the current request so it is neither delivered nor restarted.
+		self.__requestId += 1
+		
+		if self.__task is not None :
+			self.__task.cancel()
+			# destroying a task waits for it to finish, so we keep cancelled tasks
+			# alive until they're done rather than blocking the ui.
+			self.__cancelledTasks.append( self.__task )
+			self.__task = None
+			
+		self.__cancelledTasks = [ t for t in self.__cancelledTasks if not t.done() ]
+	
+	## Returns True if a request is in progress.
+	def running( self ) :
+	
+		return self.__task is not None and not self.__task.done()
+	
+	# Called on the background thread. This is a staticmethod taking a weak reference
+	# so that the task doesn't keep us alive - we own the task after all.
+	@staticmethod
+	def __compute( selfRef, plug, context, requestId, canceller ) :
+	
+		context.setCanceller( canceller )
+		try :
+			with context :
+				value = plug.getValue()
+		except Exception, e :
+			value = None
+			if not canceller.cancelled() :
+				IECore.msg( IECore.Msg.Level.Error, "BackgroundCompute", str( e ) )
+		
+		if canceller.cancelled() :
+			# we may have been cancelled by an edit to the graph rather
+			# than by a call to cancel(), in which case we must try again.
+			GafferUI.EventLoop.executeOnUIThread( functools.partial( BackgroundCompute.__restart, selfRef, plug, context, requestId ) )
+			return
+			
+		GafferUI.EventLoop.executeOnUIThread( functools.partial( BackgroundCompute.__deliver, selfRef, plug, value, requestId ) )
+	
+	# Called on the ui thread.
+	@staticmethod
+	def __deliver( selfRef, plug, value, requestId ) :
+	
+		self = selfRef()
+		if self is None or requestId != self.__requestId :
+			# we've been destroyed, or a more recent
+			# request has been made since.
+			return
+		
+		self.__callback( plug, value )
+	
+	# Called on the ui thread.
+	@staticmethod
+	def __restart( selfRef, plug, context, requestId ) :
+	
+		self = selfRef()
+		if self is None or requestId != self.__requestId :
+			# we've been destroyed, or the request was superseded
+			# or cancelled, rather than being interrupted by an edit.
+			return
+			
+		self.request( plug, context )
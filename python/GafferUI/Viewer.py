@@ -100,6 +100,10 @@ class Viewer( GafferUI.NodeSetEditor ) :
 						if self.__currentView is not None:
 							self.__currentView.__updateRequestConnection = self.__currentView.updateRequestSignal().connect( Gaffer.WeakMethod( self.__updateRequest ) )
 							self.__currentView.__pendingUpdate = True
+							if isinstance( self.__currentView, GafferUI.ObjectView ) :
+								# ObjectViews are simple enough for us to compute their
+								# contents in the background, without blocking the ui.
+								self.__currentView.__backgroundCompute = GafferUI.BackgroundCompute( Gaffer.WeakMethod( self.__objectComputed ) )
 							self.__views.append( self.__currentView )
 					# if we succeeded in getting a suitable view, then
 					# don't bother checking the other plugs
@@ -126,8 +130,18 @@ class Viewer( GafferUI.NodeSetEditor ) :
 		
 		if not self.__currentView.getContext().isSame( self.getContext() ) :
 			self.__currentView.setContext( self.getContext() )
-				
-		self.__currentView._update()
+		
+		if isinstance( self.__currentView, GafferUI.ObjectView ) :
+			self.__currentView.__backgroundCompute.request( self.__currentView.objectPlug(), self.getContext() )
+		else :
+			self.__currentView._update()
+	
+	def __objectComputed( self, plug, value ) :
+	
+		for view in self.__views :
+			if isinstance( view, GafferUI.ObjectView ) and view.objectPlug().isSame( plug ) :
+				view.setObject( value )
+				break
 	
 	def __updateRequest( self, view ) :
 		
@@ -96,6 +96,7 @@ from ListContainer import ListContainer
 from GridContainer import GridContainer
 from MenuBar import MenuBar
 from EventLoop import EventLoop
+from BackgroundCompute import BackgroundCompute
 from TabbedContainer import TabbedContainer
 from TextWidget import TextWidget
 from NumericWidget import NumericWidget
@@ -0,0 +1,200 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import time
+import unittest
+import threading
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferUI
+import GafferUITest
+
+QtCore = GafferUI._qtImport( "QtCore" )
+QtGui = GafferUI._qtImport( "QtGui" )
+
+# A node which computes slowly, checking that its input isn't
+# modified while it does so.
+class _SlowNode( Gaffer.ComputeNode ) :
+
+	def __init__( self, name="_SlowNode" ) :
+	
+		Gaffer.ComputeNode.__init__( self, name )
+		
+		self.addChild( Gaffer.IntPlug( "in" ) )
+		self.addChild( Gaffer.IntPlug( "out", Gaffer.Plug.Direction.Out ) )
+		
+		self.duration = 0
+		self.computeStarted = threading.Event()
+		self.inputChangedDuringCompute = False
+		
+	def affects( self, input ) :
+	
+		if input.isSame( self["in"] ) :
+			return [ self["out"] ]
+		
+		return []
+		
+	def hash( self, output, context, h ) :
+	
+		self["in"].hash( h )
+		
+	def compute( self, plug, context ) :
+	
+		value = self["in"].getValue()
+		self.computeStarted.set()
+		
+		startTime = time.time()
+		while time.time() - startTime < self.duration :
+			if context.canceller() is not None :
+				context.canceller().check()
+			if self["in"].getValue() != value :
+				self.inputChangedDuringCompute = True
+			time.sleep( 0.01 )
+		
+		plug.setValue( value )
+
+IECore.registerRunTimeTyped( _SlowNode )
+
+class BackgroundComputeTest( GafferUITest.TestCase ) :
+
+	def testRequest( self ) :
+	
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+		
+		results = []
+		def callback( plug, value ) :
+		
+			results.append( ( plug, value, QtCore.QThread.currentThread() == QtGui.QApplication.instance().thread() ) )
+			GafferUI.EventLoop.mainEventLoop().stop()
+		
+		backgroundCompute = GafferUI.BackgroundCompute( callback )
+		backgroundCompute.request( n["sum"], Gaffer.Context() )
+		GafferUI.EventLoop.mainEventLoop().start()
+		
+		self.assertEqual( len( results ), 1 )
+		self.assertTrue( results[0][0].isSame( n["sum"] ) )
+		self.assertEqual( results[0][1], 3 )
+		# results must be delivered on the ui thread
+		self.assertTrue( results[0][2] )
+		self.assertFalse( backgroundCompute.running() )
+	
+	def testNewRequestSupersedesOld( self ) :
+	
+		n = GafferTest.FrameNode()
+		
+		results = []
+		def callback( plug, value ) :
+		
+			results.append( value )
+			GafferUI.EventLoop.addIdleCallback( stop )
+		
+		def stop() :
+		
+			GafferUI.EventLoop.mainEventLoop().stop()
+			return False
+		
+		context = Gaffer.Context()
+		backgroundCompute = GafferUI.BackgroundCompute( callback )
+		backgroundCompute.request( n["output"], context )
+		context.setFrame( 10 )
+		backgroundCompute.request( n["output"], context )
+		GafferUI.EventLoop.mainEventLoop().start()
+		
+		# even if the first request completed, its result
+		# should not have been delivered.
+		self.assertEqual( results, [ 10 ] )
+	
+	def testGraphEditsWaitForCompute( self ) :
+	
+		s = Gaffer.ScriptNode()
+		s["n"] = _SlowNode()
+		s["n"]["in"].setValue( 1 )
+		s["n"].duration = 10
+		
+		results = []
+		def callback( plug, value ) :
+		
+			results.append( value )
+			GafferUI.EventLoop.addIdleCallback( stop )
+		
+		def stop() :
+		
+			GafferUI.EventLoop.mainEventLoop().stop()
+			return False
+			
+		backgroundCompute = GafferUI.BackgroundCompute( callback )
+		backgroundCompute.request( s["n"]["out"], Gaffer.Context() )
+		self.assertTrue( s["n"].computeStarted.wait( 10 ) )
+		
+		# the edit must cancel the compute and wait for it
+		# to stop before modifying the input.
+		s["n"].duration = 0
+		with Gaffer.UndoContext( s ) :
+			s["n"]["in"].setValue( 2 )
+		
+		self.assertFalse( backgroundCompute.running() )
+		self.assertFalse( s["n"].inputChangedDuringCompute )
+		
+		# and the interrupted request should be restarted
+		# automatically, computing the new value.
+		GafferUI.EventLoop.mainEventLoop().start()
+		self.assertEqual( results, [ 2 ] )
+		
+		# as must undo and redo. the first compute was cancelled,
+		# so after undoing there's no cached value for it to use.
+		s.undo()
+		s["n"].duration = 10
+		s["n"].computeStarted.clear()
+		backgroundCompute.request( s["n"]["out"], Gaffer.Context() )
+		self.assertTrue( s["n"].computeStarted.wait( 10 ) )
+		
+		s["n"].duration = 0
+		s.redo()
+		
+		self.assertFalse( backgroundCompute.running() )
+		self.assertFalse( s["n"].inputChangedDuringCompute )
+		
+		GafferUI.EventLoop.mainEventLoop().start()
+		self.assertEqual( results, [ 2, 2 ] )
+		
+if __name__ == "__main__":
+	unittest.main()
@@ -845,6 +845,146 @@ class NodeGraphTest( GafferUITest.TestCase ) :
 		
 		self.assertFalse( c1.getMinimised() )
 		self.assertFalse( c2.getMinimised() )
+
+	def testNodeGadgetAt( self ) :
+	
+		script = Gaffer.ScriptNode()
+		
+		script["add1"] = GafferTest.AddNode()
+		script["add2"] = GafferTest.AddNode()
+		
+		g = GafferUI.GraphGadget( script )
+		g.setNodePosition( script["add1"], IECore.V2f( 0 ) )
+		g.setNodePosition( script["add2"], IECore.V2f( 20, 0 ) )
+		
+		def line( x, y ) :
+			return IECore.LineSegment3f( IECore.V3f( x, y, 1 ), IECore.V3f( x, y, -1 ) )
+			
+		self.assertTrue( g.nodeGadgetAt( line( 0, 0 ) ).node().isSame( script["add1"] ) )
+		self.assertTrue( g.nodeGadgetAt( line( 20, 0 ) ).node().isSame( script["add2"] ) )
+		self.assertEqual( g.nodeGadgetAt( line( 10, 0 ) ), None )
+		self.assertEqual( g.nodeGadgetAt( line( 0, 100 ) ), None )
+		
+		# the index must be updated when nodes move
+		
+		g.setNodePosition( script["add1"], IECore.V2f( 0, 100 ) )
+		self.assertEqual( g.nodeGadgetAt( line( 0, 0 ) ), None )
+		self.assertTrue( g.nodeGadgetAt( line( 0, 100 ) ).node().isSame( script["add1"] ) )
+		
+		# and when they're removed
+		
+		del script["add2"]
+		self.assertEqual( g.nodeGadgetAt( line( 20, 0 ) ), None )
+		
+	def testConnectionGadgetAt( self ) :
+	
+		script = Gaffer.ScriptNode()
+		
+		script["add1"] = GafferTest.AddNode()
+		script["add2"] = GafferTest.AddNode()
+		script["add2"]["op1"].setInput( script["add1"]["sum"] )
+		
+		g = GafferUI.GraphGadget( script )
+		g.setNodePosition( script["add1"], IECore.V2f( 0, 20 ) )
+		g.setNodePosition( script["add2"], IECore.V2f( 0, 0 ) )
+		
+		c = g.connectionGadget( script["add2"]["op1"] )
+		
+		srcPos = g.nodeGadget( script["add1"] ).nodule( script["add1"]["sum"] ).fullTransform( g ).translation()
+		dstPos = g.nodeGadget( script["add2"] ).nodule( script["add2"]["op1"] ).fullTransform( g ).translation()
+		
+		b = c.curveBound()
+		self.assertTrue( b.intersects( srcPos ) )
+		self.assertTrue( b.intersects( dstPos ) )
+		self.assertAlmostEqual( c.distanceTo( srcPos ), 0, 4 )
+		self.assertAlmostEqual( c.distanceTo( dstPos ), 0, 4 )
+		
+		def line( p ) :
+			return IECore.LineSegment3f( IECore.V3f( p.x, p.y, 1 ), IECore.V3f( p.x, p.y, -1 ) )
+		
+		midPoint = ( srcPos + dstPos ) / 2
+		self.assertTrue( g.connectionGadgetAt( line( midPoint ) ).isSame( c ) )
+		self.assertEqual( g.connectionGadgetAt( line( midPoint + IECore.V3f( 5, 0, 0 ) ) ), None )
+		
+		# moving a node must move the connection in the index
+		
+		g.setNodePosition( script["add1"], IECore.V2f( 40, 20 ) )
+		g.setNodePosition( script["add2"], IECore.V2f( 40, 0 ) )
+		self.assertEqual( g.connectionGadgetAt( line( midPoint ) ), None )
+		self.assertTrue( g.connectionGadgetAt( line( midPoint + IECore.V3f( 40, 0, 0 ) ) ).isSame( c ) )
+		
+		# as must disconnecting
+		
+		script["add2"]["op1"].setInput( None )
+		self.assertEqual( g.connectionGadgetAt( line( midPoint + IECore.V3f( 40, 0, 0 ) ) ), None )
+	
+	def testGadgetsIntersecting( self ) :
+	
+		script = Gaffer.ScriptNode()
+		
+		script["add1"] = GafferTest.AddNode()
+		script["add2"] = GafferTest.AddNode()
+		script["add3"] = GafferTest.AddNode()
+		script["add2"]["op1"].setInput( script["add1"]["sum"] )
+		
+		g = GafferUI.GraphGadget( script )
+		g.setNodePosition( script["add1"], IECore.V2f( 0, 20 ) )
+		g.setNodePosition( script["add2"], IECore.V2f( 0, 0 ) )
+		g.setNodePosition( script["add3"], IECore.V2f( 100, 0 ) )
+		
+		def contains( gadgets, gadget ) :
+			return len( [ x for x in gadgets if x.isSame( gadget ) ] ) == 1
+		
+		n1 = g.nodeGadget( script["add1"] )
+		n2 = g.nodeGadget( script["add2"] )
+		n3 = g.nodeGadget( script["add3"] )
+		c = g.connectionGadget( script["add2"]["op1"] )
+		
+		gadgets = g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( -50 ), IECore.V2f( 50 ) ) )
+		self.assertEqual( len( gadgets ), 3 )
+		self.assertTrue( contains( gadgets, n1 ) )
+		self.assertTrue( contains( gadgets, n2 ) )
+		self.assertTrue( contains( gadgets, c ) )
+		
+		gadgets = g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( 99, -1 ), IECore.V2f( 101, 1 ) ) )
+		self.assertEqual( len( gadgets ), 1 )
+		self.assertTrue( gadgets[0].isSame( n3 ) )
+		
+		self.assertEqual( g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( 200 ), IECore.V2f( 210 ) ) ), [] )
+		
+		# the index must be updated when nodes move
+		
+		g.setNodePosition( script["add3"], IECore.V2f( 205 ) )
+		gadgets = g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( 200 ), IECore.V2f( 210 ) ) )
+		self.assertEqual( len( gadgets ), 1 )
+		self.assertTrue( gadgets[0].isSame( n3 ) )
+		self.assertEqual( g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( 99, -1 ), IECore.V2f( 101, 1 ) ) ), [] )
+		
+	def testRenamingUpdatesIndex( self ) :
+	
+		script = Gaffer.ScriptNode()
+		script["add1"] = GafferTest.AddNode()
+		
+		g = GafferUI.GraphGadget( script )
+		g.setNodePosition( script["add1"], IECore.V2f( 0 ) )
+		
+		def line( x, y ) :
+			return IECore.LineSegment3f( IECore.V3f( x, y, 1 ), IECore.V3f( x, y, -1 ) )
+		
+		nodeGadget = g.nodeGadget( script["add1"] )
+		oldBound = nodeGadget.bound()
+		self.assertTrue( g.nodeGadgetAt( line( 0, 0 ) ).isSame( nodeGadget ) )
+		
+		# a longer name makes the NodeGadget wider, and the
+		# index must account for that.
+		
+		script["add1"].setName( "aVeryLongNameIndeedWhichMakesTheNodeGadgetMuchWiderThanBefore" )
+		newBound = nodeGadget.bound()
+		self.assertTrue( newBound.max.x > oldBound.max.x + 2 )
+		
+		x = ( oldBound.max.x + newBound.max.x ) / 2
+		self.assertTrue( g.nodeGadgetAt( line( x, 0 ) ).isSame( nodeGadget ) )
+		self.assertEqual( len( g.gadgetsIntersecting( IECore.Box2f( IECore.V2f( x, 0 ) ) ) ), 1 )
 		
 if __name__ == "__main__":
 	unittest.main()
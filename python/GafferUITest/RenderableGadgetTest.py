@@ -38,6 +38,7 @@ import unittest
 import weakref
 
 import IECore
+import IECoreGL
 
 import GafferTest
 import GafferUI
@@ -115,6 +116,31 @@ class RenderableGadgetTest( unittest.TestCase ) :
 		self.assertEqual( g.getSelection(), set( [ "/one" ] ) )
 		
 		self.assertEqual( len( cs ), 2 )
+	
+	def testSetScene( self ) :
+	
+		renderer = IECoreGL.Renderer()
+		renderer.setOption( "gl:mode", IECore.StringData( "deferred" ) )
+		with IECore.WorldBlock( renderer ) :
+			IECore.SpherePrimitive().render( renderer )
+		
+		g = GafferUI.RenderableGadget( IECore.SpherePrimitive() )
+		cs = GafferTest.CapturingSlot( g.renderRequestSignal() )
+		
+		g.setScene( renderer.scene() )
+		self.assertEqual( g.getRenderable(), None )
+		self.failUnless( g.getScene().isSame( renderer.scene() ) )
+		self.assertEqual( g.bound(), IECore.SpherePrimitive().bound() )
+		self.assertEqual( len( cs ), 1 )
+		
+		# setting the scene again, as is done after editing it in place,
+		# should request another render.
+		g.setScene( renderer.scene() )
+		self.assertEqual( len( cs ), 2 )
+		
+		g.setRenderable( None )
+		self.assertEqual( g.getScene(), None )
+		self.assertEqual( g.bound(), IECore.Box3f() )
 		
 if __name__ == "__main__":
 	unittest.main()
@@ -159,6 +159,99 @@ class StandardGraphLayoutTest( GafferUITest.TestCase ) :
 
 		self.assertEqual( len( s["add4"]["sum"].outputs() ), 0 )
 
+	def testLayoutNodes( self ) :
+	
+		s = Gaffer.ScriptNode()
+		
+		s["add1"] = GafferTest.AddNode()
+		s["add2"] = GafferTest.AddNode()
+		s["add3"] = GafferTest.AddNode()
+		s["add4"] = GafferTest.AddNode()
+		
+		s["add2"]["op1"].setInput( s["add1"]["sum"] )
+		s["add3"]["op1"].setInput( s["add1"]["sum"] )
+		s["add4"]["op1"].setInput( s["add2"]["sum"] )
+		s["add4"]["op2"].setInput( s["add3"]["sum"] )
+		
+		g = GafferUI.GraphGadget( s )
+		for i, n in enumerate( [ "add1", "add2", "add3", "add4" ] ) :
+			g.setNodePosition( s[n], IECore.V2f( 10, 10 + i ) )
+		
+		oldPositions = [ g.getNodePosition( s[n] ) for n in ( "add1", "add2", "add3", "add4" ) ]
+		
+		g.getLayout().layoutNodes( g )
+		
+		p1, p2, p3, p4 = [ g.getNodePosition( s[n] ) for n in ( "add1", "add2", "add3", "add4" ) ]
+		
+		# connections flow from top to bottom
+		self.assertTrue( p1.y > p2.y )
+		self.assertTrue( p1.y > p3.y )
+		self.assertEqual( p2.y, p3.y )
+		self.assertTrue( p2.y > p4.y )
+		
+		# nodes in the same layer don't overlap
+		self.assertFalse( g.nodeGadget( s["add2"] ).transformedBound( g ).intersects( g.nodeGadget( s["add3"] ).transformedBound( g ) ) )
+		
+		# the centroid is preserved
+		c = ( p1 + p2 + p3 + p4 ) / 4
+		self.assertAlmostEqual( c.x, 10, 4 )
+		self.assertAlmostEqual( c.y, 11.5, 4 )
+		
+		# and it's undoable in a single step
+		s.undo()
+		self.assertEqual( [ g.getNodePosition( s[n] ) for n in ( "add1", "add2", "add3", "add4" ) ], oldPositions )
+	
+	def testLayoutNodesSubset( self ) :
+	
+		s = Gaffer.ScriptNode()
+		
+		s["add1"] = GafferTest.AddNode()
+		s["add2"] = GafferTest.AddNode()
+		s["add3"] = GafferTest.AddNode()
+		s["add2"]["op1"].setInput( s["add1"]["sum"] )
+		
+		g = GafferUI.GraphGadget( s )
+		g.setNodePosition( s["add3"], IECore.V2f( 100 ) )
+		
+		g.getLayout().layoutNodes( g, Gaffer.StandardSet( [ s["add1"], s["add2"] ] ) )
+		
+		self.assertTrue( g.getNodePosition( s["add1"] ).y > g.getNodePosition( s["add2"] ).y )
+		self.assertEqual( g.getNodePosition( s["add3"] ), IECore.V2f( 100 ) )
+	
+	def testLayeredPositions( self ) :
+	
+		sizes = IECore.V2fVectorData( [ IECore.V2f( 10, 2 ) ] * 4 )
+		
+		# a cycle, which must be broken somewhere
+		edges = IECore.V2iVectorData( [ IECore.V2i( 0, 1 ), IECore.V2i( 1, 2 ), IECore.V2i( 2, 0 ), IECore.V2i( 2, 3 ) ] )
+		p = GafferUI.StandardGraphLayout.layeredPositions( sizes, edges )
+		self.assertEqual( len( p ), 4 )
+		self.assertTrue( p[0].y > p[1].y )
+		self.assertTrue( p[1].y > p[2].y )
+		self.assertTrue( p[2].y > p[3].y )
+		
+		# edges referencing nonexistent nodes are an error
+		self.assertRaises( Exception, GafferUI.StandardGraphLayout.layeredPositions, sizes, IECore.V2iVectorData( [ IECore.V2i( 0, 4 ) ] ) )
+	
+	def testLayeredPositionsOfRandomDAG( self ) :
+	
+		sizes, edges = GafferUITest.UIBenchmarks.randomDAG( 500 )
+		p = GafferUI.StandardGraphLayout.layeredPositions( sizes, edges )
+		
+		for e in edges :
+			self.assertTrue( p[e[0]].y > p[e[1]].y )
+	
+	def testLayoutNodesOfRandomGraph( self ) :
+	
+		s = GafferUITest.UIBenchmarks.randomScript( 200 )
+		
+		g = GafferUI.GraphGadget( s )
+		g.getLayout().layoutNodes( g )
+		
+		for n in s.children( Gaffer.Node.staticTypeId() ) :
+			if n["op1"].getInput() is not None :
+				self.assertTrue( g.getNodePosition( n["op1"].getInput().node() ).y > g.getNodePosition( n ).y )
+		
 if __name__ == "__main__":
 	unittest.main()
 	
@@ -0,0 +1,132 @@
+##########################################################################
+#  
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#  
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#  
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#  
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#  
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#  
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#  
+##########################################################################
+
+
+import random
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferUI
+
+# Generates a random dag where each node takes its inputs from one
+# of the preceding nodes, returning the sizes and edges in the form
+# expected by StandardGraphLayout.layeredPositions().
+def randomDAG( numNodes ) :
+
+	r = random.Random( 1 )
+	edges = IECore.V2iVectorData()
+	for i in range( 1, numNodes ) :
+		for j in range( 0, r.randint( 1, 2 ) ) :
+			edges.append( IECore.V2i( max( 0, i - r.randint( 1, 20 ) ), i ) )
+
+	return IECore.V2fVectorData( [ IECore.V2f( 10, 2 ) ] * numNodes ), edges
+
+# Makes a script containing a random network of AddNodes, each taking
+# its inputs from one of the preceding nodes.
+def randomScript( numNodes ) :
+
+	s = Gaffer.ScriptNode()
+
+	r = random.Random( 1 )
+	nodes = []
+	for i in range( 0, numNodes ) :
+		n = GafferTest.AddNode()
+		s.addChild( n )
+		if nodes :
+			n["op1"].setInput( nodes[max( 0, len( nodes ) - r.randint( 1, 20 ) )]["sum"] )
+			n["op2"].setInput( nodes[max( 0, len( nodes ) - r.randint( 1, 20 ) )]["sum"] )
+		nodes.append( n )
+
+	return s
+
+## Times StandardGraphLayout.layeredPositions() on a random dag.
+class LayeredPositionsBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numNodes ) :
+
+		GafferTest.Benchmark.__init__( self, "layeredPositions%d" % numNodes )
+
+		self.__numNodes = numNodes
+
+	def setUp( self ) :
+
+		self.__sizes, self.__edges = randomDAG( self.__numNodes )
+
+	def run( self ) :
+
+		GafferUI.StandardGraphLayout.layeredPositions( self.__sizes, self.__edges )
+
+	def measurements( self, seconds ) :
+
+		return { "nodes" : self.__numNodes, "edges" : len( self.__edges ) }
+
+## Times StandardGraphLayout.layoutNodes() on a random network of nodes.
+class LayoutNodesBenchmark( GafferTest.Benchmark ) :
+
+	def __init__( self, numNodes = 2000 ) :
+
+		GafferTest.Benchmark.__init__( self, "layoutNodes" )
+
+		self.__numNodes = numNodes
+
+	def setUp( self ) :
+
+		self.__script = randomScript( self.__numNodes )
+		self.__graphGadget = GafferUI.GraphGadget( self.__script )
+
+	def run( self ) :
+
+		self.__graphGadget.getLayout().layoutNodes( self.__graphGadget )
+
+	def tearDown( self ) :
+
+		del self.__graphGadget
+		del self.__script
+
+	def measurements( self, seconds ) :
+
+		return { "nodes" : self.__numNodes }
+
+## Returns the UI benchmarks to be run by the "gaffer benchmark" app.
+def benchmarks() :
+
+	return [
+		LayeredPositionsBenchmark( 2000 ),
+		LayeredPositionsBenchmark( 20000 ),
+		LayoutNodesBenchmark(),
+	]
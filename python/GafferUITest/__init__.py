@@ -51,6 +51,7 @@ from TabbedContainerTest import TabbedContainerTest
 from NodeGraphTest import NodeGraphTest
 from WidgetSignalTest import WidgetSignalTest
 from EventLoopTest import EventLoopTest
+from BackgroundComputeTest import BackgroundComputeTest
 from SplinePlugGadgetTest import SplinePlugGadgetTest
 from TextWidgetTest import TextWidgetTest
 from CheckBoxTest import CheckBoxTest
@@ -89,6 +90,8 @@ from ViewTest import ViewTest
 from SliderTest import SliderTest
 from NumericPlugValueWidgetTest import NumericPlugValueWidgetTest
 from CompoundNumericPlugValueWidgetTest import CompoundNumericPlugValueWidgetTest
+import UIBenchmarks
+from UIBenchmarksTest import UIBenchmarksTest
 
 if __name__ == "__main__":
 	unittest.main()
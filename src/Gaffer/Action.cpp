@@ -40,6 +40,7 @@
 
 #include "Gaffer/Action.h"
 #include "Gaffer/ScriptNode.h"
+#include "Gaffer/BackgroundTask.h"
 
 using namespace Gaffer;
 
@@ -60,6 +61,10 @@ Action::~Action()
 
 void Action::enact( ActionPtr action )
 {
+	// background computations may be reading the plugs
+	// we're about to edit, so they must stop first.
+	BackgroundTask::cancelAndWaitForAll();
+
 	ScriptNodePtr s = IECore::runTimeCast<ScriptNode>( action->subject() );
 	if( !s )
 	{
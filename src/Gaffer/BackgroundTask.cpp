@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <set>
+#include <vector>
+
+#include "boost/bind.hpp"
+
+#include "tbb/mutex.h"
+
+#include "IECore/MessageHandler.h"
+
+#include "Gaffer/BackgroundTask.h"
+
+using namespace Gaffer;
+
+typedef std::set<BackgroundTask *> TaskSet;
+
+static TaskSet &tasks()
+{
+	static TaskSet g_tasks;
+	return g_tasks;
+}
+
+static tbb::mutex &tasksMutex()
+{
+	static tbb::mutex g_mutex;
+	return g_mutex;
+}
+
+BackgroundTask::BackgroundTask( const Function &function )
+	:	m_function( function ), m_canceller( new Canceller )
+{
+	m_done = false;
+	{
+		tbb::mutex::scoped_lock lock( tasksMutex() );
+		tasks().insert( this );
+	}
+	m_thread = boost::thread( boost::bind( &BackgroundTask::run, this ) );
+}
+
+BackgroundTask::~BackgroundTask()
+{
+	cancelAndWait();
+	tbb::mutex::scoped_lock lock( tasksMutex() );
+	tasks().erase( this );
+}
+
+void BackgroundTask::cancel()
+{
+	m_canceller->cancel();
+}
+
+void BackgroundTask::wait()
+{
+	if( m_thread.joinable() )
+	{
+		m_thread.join();
+	}
+}
+
+void BackgroundTask::cancelAndWait()
+{
+	cancel();
+	wait();
+}
+
+bool BackgroundTask::done() const
+{
+	return m_done;
+}
+
+void BackgroundTask::cancelAndWaitForAll()
+{
+	std::vector<BackgroundTaskPtr> running;
+	{
+		tbb::mutex::scoped_lock lock( tasksMutex() );
+		for( TaskSet::const_iterator it = tasks().begin(), eIt = tasks().end(); it != eIt; ++it )
+		{
+			if( !(*it)->done() && (*it)->m_thread.get_id() != boost::this_thread::get_id() )
+			{
+				running.push_back( *it );
+			}
+		}
+	}
+
+	// we wait outside the lock, so that tasks may be
+	// created and destroyed while we're waiting.
+	for( std::vector<BackgroundTaskPtr>::const_iterator it = running.begin(), eIt = running.end(); it != eIt; ++it )
+	{
+		(*it)->cancelAndWait();
+	}
+}
+
+void BackgroundTask::run()
+{
+	try
+	{
+		m_function( *m_canceller );
+	}
+	catch( const std::exception &e )
+	{
+		// exceptions thrown through tbb may not retain their type, so
+		// we query the canceller rather than catching Cancelled specifically.
+		if( !m_canceller->cancelled() )
+		{
+			IECore::msg( IECore::Msg::Error, "BackgroundTask", e.what() );
+		}
+	}
+	m_done = true;
+}
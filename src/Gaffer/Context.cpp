@@ -40,14 +40,130 @@
 #include "tbb/enumerable_thread_specific.h"
 
 #include "boost/lexical_cast.hpp"
+#include "boost/shared_ptr.hpp"
 
 #include "IECore/SimpleTypedData.h"
+#include "IECore/LRUCache.h"
 
 #include "Gaffer/Context.h"
 
 using namespace Gaffer;
 using namespace IECore;
 
+//////////////////////////////////////////////////////////////////////////
+// Substitution templates
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Strings are parsed once into a list of tokens, which are cached so that
+// repeated substitutions don't need to reparse them. The cached templates
+// are independent of any particular Context, and so may be shared between
+// all of them.
+struct SubstitutionToken
+{
+
+	enum Type
+	{
+		Text,
+		Variable,
+		FramePadding,
+		Tilde
+	};
+
+	SubstitutionToken( Type t )
+		:	type( t ), padding( 0 )
+	{
+	}
+
+	Type type;
+	std::string text;
+	InternedString variable;
+	int padding;
+
+};
+
+typedef std::vector<SubstitutionToken> SubstitutionTemplate;
+typedef boost::shared_ptr<SubstitutionTemplate> SubstitutionTemplatePtr;
+typedef boost::shared_ptr<const SubstitutionTemplate> ConstSubstitutionTemplatePtr;
+
+bool hasSubstitutions( const std::string &s )
+{
+	return s.find_first_of( "$#~" ) != std::string::npos;
+}
+
+ConstSubstitutionTemplatePtr substitutionTemplateGetter( const std::string &s, size_t &cost )
+{
+	cost = 1;
+
+	SubstitutionTemplatePtr result( new SubstitutionTemplate );
+	for( size_t i=0, size=s.size(); i<size; )
+	{
+		if( s[i] == '$' )
+		{
+			i++; // skip $
+			size_t begin = i;
+			size_t end = i;
+			bool bracketed = ( i < size ) && s[i]=='{';
+			if( bracketed )
+			{
+				begin = ++i; // skip initial bracket
+				while( i < size && s[i] != '}' )
+				{
+					i++;
+				}
+				end = i;
+				i++; // skip final bracket
+			}
+			else
+			{
+				while( i < size && isalnum( s[i] ) )
+				{
+					i++;
+				}
+				end = i;
+			}
+			result->push_back( SubstitutionToken( SubstitutionToken::Variable ) );
+			result->back().variable = s.substr( begin, end - begin );
+		}
+		else if( s[i] == '#' )
+		{
+			result->push_back( SubstitutionToken( SubstitutionToken::FramePadding ) );
+			while( i < size && s[i]=='#' )
+			{
+				result->back().padding++;
+				i++;
+			}
+		}
+		else if( s[i] == '~' )
+		{
+			result->push_back( SubstitutionToken( SubstitutionToken::Tilde ) );
+			i++;
+		}
+		else
+		{
+			size_t end = s.find_first_of( "$#~", i );
+			end = end == std::string::npos ? size : end;
+			result->push_back( SubstitutionToken( SubstitutionToken::Text ) );
+			result->back().text = s.substr( i, end - i );
+			i = end;
+		}
+	}
+
+	return result;
+}
+
+typedef LRUCache<std::string, ConstSubstitutionTemplatePtr> SubstitutionTemplateCache;
+
+SubstitutionTemplateCache *substitutionTemplateCache()
+{
+	static SubstitutionTemplateCache *c = new SubstitutionTemplateCache( substitutionTemplateGetter, 10000 );
+	return c;
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Context implementation
 //////////////////////////////////////////////////////////////////////////
@@ -61,7 +177,7 @@ Context::Context()
 }
 
 Context::Context( const Context &other )
-	:	m_data( other.m_data->copy() ), m_changedSignal( 0 )
+	:	m_data( other.m_data->copy() ), m_changedSignal( 0 ), m_canceller( other.m_canceller )
 {
 }
 
@@ -104,6 +220,16 @@ Context::ChangedSignal &Context::changedSignal()
 	return *m_changedSignal;
 }
 
+void Context::setCanceller( ConstCancellerPtr canceller )
+{
+	m_canceller = canceller;
+}
+
+const Canceller *Context::canceller() const
+{
+	return m_canceller.get();
+}
+
 IECore::MurmurHash Context::hash() const
 {
 	return ((Object *)( m_data.get() ))->hash();
@@ -127,6 +253,14 @@ std::string Context::substitute( const std::string &s ) const
 	return result;
 }
 
+IECore::MurmurHash Context::substitutionHash( const std::string &s ) const
+{
+	IECore::MurmurHash result;
+	bool empty = true;
+	substitutionHashInternal( s, result, empty, 0 );
+	return result;
+}
+
 void Context::substituteInternal( const std::string &s, std::string &result, const int recursionDepth ) const
 {
 	if( recursionDepth > 8 )
@@ -134,85 +268,143 @@ void Context::substituteInternal( const std::string &s, std::string &result, con
 		throw IECore::Exception( "Context::substitute() : maximum recursion depth reached." );
 	}
 
-	for( size_t i=0, size=s.size(); i<size; )
+	if( !hasSubstitutions( s ) )
 	{
-		if( s[i] == '$' )
+		result += s;
+		return;
+	}
+
+	ConstSubstitutionTemplatePtr t = substitutionTemplateCache()->get( s );
+	for( SubstitutionTemplate::const_iterator it = t->begin(), eIt = t->end(); it != eIt; it++ )
+	{
+		switch( it->type )
 		{
-			std::string variableName;
-			i++; // skip $
-			bool bracketed = ( i < size ) && s[i]=='{';
-			if( bracketed )
-			{
-				i++; // skip initial bracket
-				while( i < size && s[i] != '}' )
+			case SubstitutionToken::Text :
+				result += it->text;
+				break;
+			case SubstitutionToken::Variable :
+				if( const IECore::Data *d = get<IECore::Data>( it->variable, 0 ) )
 				{
-					variableName.push_back( s[i] );
-					i++;
+					switch( d->typeId() )
+					{
+						case IECore::StringDataTypeId :
+							substituteInternal( static_cast<const IECore::StringData *>( d )->readable(), result, recursionDepth + 1 );
+							break;
+						case IECore::FloatDataTypeId :
+							result += boost::lexical_cast<std::string>(
+								static_cast<const IECore::FloatData *>( d )->readable()
+							);
+							break;
+						case IECore::IntDataTypeId :
+							result += boost::lexical_cast<std::string>(
+								static_cast<const IECore::IntData *>( d )->readable()
+							);
+							break;
+						default :
+							break;
+					}
 				}
-				i++; // skip final bracket
-			}
-			else
-			{
-				while( i < size && isalnum( s[i] ) )
+				else if( const char *v = getenv( it->variable.c_str() ) )
 				{
-					variableName.push_back( s[i] );
-					i++;
+					// variable not in context - try environment
+					result += v;
 				}
-			}
-			
-			const IECore::Data *d = get<IECore::Data>( variableName, 0 );
-			if( d )
+				break;
+			case SubstitutionToken::FramePadding :
 			{
-				switch( d->typeId() )
+				const std::string frame = boost::lexical_cast<std::string>( (int)round( getFrame() ) );
+				if( (int)frame.size() < it->padding )
 				{
-					case IECore::StringDataTypeId :
-						substituteInternal( static_cast<const IECore::StringData *>( d )->readable(), result, recursionDepth + 1 );
-						break;
-					case IECore::FloatDataTypeId :
-						result += boost::lexical_cast<std::string>(
-							static_cast<const IECore::FloatData *>( d )->readable()
-						);
-						break;
-					case IECore::IntDataTypeId :
-						result += boost::lexical_cast<std::string>(
-							static_cast<const IECore::IntData *>( d )->readable()
-						);
-						break;	
-					default :
-						break;
+					result.append( it->padding - frame.size(), '0' );
 				}
+				result += frame;
+				break;
 			}
-			else if( const char *v = getenv( variableName.c_str() ) )
-			{
-				// variable not in context - try environment
-				result += v;
-			}
-		}
-		else if( s[i] == '#' )
-		{
-			int padding = 0;
-			while( i < size && s[i]=='#' )
-			{
-				padding++;
-				i++;
-			}
-			int frame = (int)round( getFrame() );
-			std::ostringstream padder;
-			padder << std::setw( padding ) << std::setfill( '0' ) << frame;
-			result += padder.str();
-		}
-		else if( s[i] == '~' && result.size()==0 )
-		{
-			if( const char *v = getenv( "HOME" ) )
-			{
-				result += v;
-			}
-			i++;
+			case SubstitutionToken::Tilde :
+				if( !result.size() )
+				{
+					if( const char *v = getenv( "HOME" ) )
+					{
+						result += v;
+					}
+				}
+				else
+				{
+					result.push_back( '~' );
+				}
+				break;
 		}
-		else
+	}
+}
+
+void Context::substitutionHashInternal( const std::string &s, IECore::MurmurHash &h, bool &empty, const int recursionDepth ) const
+{
+	if( recursionDepth > 8 )
+	{
+		throw IECore::Exception( "Context::substitutionHash() : maximum recursion depth reached." );
+	}
+
+	// The template itself accounts for all the literal text in the result,
+	// so we need only append the values of the variables it references.
+	h.append( s );
+
+	if( !hasSubstitutions( s ) )
+	{
+		empty = empty && s.empty();
+		return;
+	}
+
+	ConstSubstitutionTemplatePtr t = substitutionTemplateCache()->get( s );
+	for( SubstitutionTemplate::const_iterator it = t->begin(), eIt = t->end(); it != eIt; it++ )
+	{
+		switch( it->type )
 		{
-			result.push_back( s[i] );
-			i++;
+			case SubstitutionToken::Text :
+				empty = false;
+				break;
+			case SubstitutionToken::Variable :
+				if( const IECore::Data *d = get<IECore::Data>( it->variable, 0 ) )
+				{
+					h.append( (int)d->typeId() );
+					switch( d->typeId() )
+					{
+						case IECore::StringDataTypeId :
+							substitutionHashInternal( static_cast<const IECore::StringData *>( d )->readable(), h, empty, recursionDepth + 1 );
+							break;
+						case IECore::FloatDataTypeId :
+							h.append( static_cast<const IECore::FloatData *>( d )->readable() );
+							empty = false;
+							break;
+						case IECore::IntDataTypeId :
+							h.append( static_cast<const IECore::IntData *>( d )->readable() );
+							empty = false;
+							break;
+						default :
+							break;
+					}
+				}
+				else if( const char *v = getenv( it->variable.c_str() ) )
+				{
+					h.append( v );
+					empty = empty && !*v;
+				}
+				break;
+			case SubstitutionToken::FramePadding :
+				h.append( (int)round( getFrame() ) );
+				empty = false;
+				break;
+			case SubstitutionToken::Tilde :
+				// a tilde is only expanded at the very start of the result
+				h.append( (int)empty );
+				if( empty )
+				{
+					if( const char *v = getenv( "HOME" ) )
+					{
+						h.append( v );
+						empty = !*v;
+					}
+				}
+				break;
 		}
 	}
 }
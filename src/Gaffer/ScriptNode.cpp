@@ -47,6 +47,7 @@
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/TypedPlug.h"
 #include "Gaffer/Action.h"
+#include "Gaffer/BackgroundTask.h"
 #include "Gaffer/ApplicationRoot.h"
 #include "Gaffer/Context.h"
 #include "Gaffer/CompoundPlug.h"
@@ -341,6 +342,8 @@ void ScriptNode::undo()
 		throw IECore::Exception( "Undo not available" );
 	}
 	
+	BackgroundTask::cancelAndWaitForAll();
+	
 	m_currentActionStage = Action::Undo;
 	
 		m_undoIterator--;
@@ -379,6 +382,8 @@ void ScriptNode::redo()
 		throw IECore::Exception( "Redo not available" );
 	}
 	
+	BackgroundTask::cancelAndWaitForAll();
+	
 	m_currentActionStage = Action::Redo;
 
 		(*m_undoIterator)->doAction();
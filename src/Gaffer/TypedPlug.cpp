@@ -74,9 +74,7 @@ IECore::MurmurHash StringPlug::hash() const
 		return ValuePlug::hash();
 	}
 	
-	IECore::MurmurHash result;
-	result.append( Context::current()->substitute( getValue() ) );
-	return result;
+	return Context::current()->substitutionHash( getValue() );
 }
 
 // explicit instantiation
@@ -38,6 +38,7 @@
 #include <stack>
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/concurrent_hash_map.h"
 
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
@@ -51,6 +52,39 @@
 
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Statistics
+//////////////////////////////////////////////////////////////////////////
+
+ValuePlug::Statistics::Statistics()
+	:	hashCount( 0 ), computeCount( 0 ), cacheHitCount( 0 )
+{
+}
+
+// The counters are incremented on every hash and compute, so we keep
+// them per thread rather than contending for shared atomics, and sum
+// them only when statistics() is called.
+typedef tbb::enumerable_thread_specific<ValuePlug::Statistics> ThreadSpecificStatistics;
+static ThreadSpecificStatistics g_statistics;
+
+//////////////////////////////////////////////////////////////////////////
+// Permanent values
+//////////////////////////////////////////////////////////////////////////
+
+typedef tbb::concurrent_hash_map<const IECore::Object *, IECore::ConstObjectPtr> PermanentValues;
+
+static PermanentValues &permanentValues()
+{
+	static PermanentValues g_permanentValues;
+	return g_permanentValues;
+}
+
+static bool isPermanentValue( const IECore::Object *value )
+{
+	PermanentValues::const_accessor accessor;
+	return permanentValues().find( accessor, value );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Computation implementation
 // The computation class is responsible for managing the transient storage
@@ -108,6 +142,7 @@ class ValuePlug::Computation
 					/// \todo This is not threadsafe!
 					/// Can we resolve this by doing the compute in the getter
 					/// or having the getter return 0 for failure?
+					++g_statistics.local().cacheHitCount;
 					return g_valueCache.get( hash );
 				}
 				else
@@ -115,7 +150,10 @@ class ValuePlug::Computation
 					computeOrSetFromInput();
 					if( m_resultWritten )
 					{
-						g_valueCache.set( hash, m_resultValue, m_resultValue->memoryUsage() );
+						// Permanent values are never freed, so evicting them from the
+						// cache would gain nothing - we don't charge for them.
+						const size_t cost = isPermanentValue( m_resultValue.get() ) ? 0 : m_resultValue->memoryUsage();
+						g_valueCache.set( hash, m_resultValue, cost );
 					}
 				}
 			}
@@ -172,6 +210,16 @@ class ValuePlug::Computation
 		{
 			return g_valueCache.setMaxCost( bytes );
 		}
+		
+		static size_t cacheMemoryUsage()
+		{
+			return g_valueCache.currentCost();
+		}
+		
+		static void clearCache()
+		{
+			g_valueCache.clear();
+		}
 	
 	private :
 	
@@ -191,6 +239,7 @@ class ValuePlug::Computation
 					throw IECore::Exception( boost::str( boost::format( "Unable to compute value for Plug \"%s\" as it has no ComputeNode." ) % m_resultPlug->fullName() ) );			
 				}
 				// cast is ok - see comment above.
+				++g_statistics.local().computeCount;
 				n->compute( const_cast<ValuePlug *>( m_resultPlug ), Context::current() );
 			}
 		}
@@ -397,6 +446,7 @@ IECore::MurmurHash ValuePlug::hash() const
 				throw IECore::Exception( boost::str( boost::format( "Unable to compute hash for Plug \"%s\" as it has no ComputeNode." ) % fullName() ) );			
 			}
 			IECore::MurmurHash emptyHash;
+			++g_statistics.local().hashCount;
 			n->hash( this, Context::current(), h );
 			if( h == emptyHash )
 			{
@@ -495,3 +545,40 @@ void ValuePlug::setCacheMemoryLimit( size_t bytes )
 {
 	Computation::setCacheMemoryLimit( bytes );
 }
+
+size_t ValuePlug::cacheMemoryUsage()
+{
+	return Computation::cacheMemoryUsage();
+}
+
+void ValuePlug::clearCache()
+{
+	Computation::clearCache();
+}
+
+void ValuePlug::registerPermanentValue( IECore::ConstObjectPtr value )
+{
+	PermanentValues::accessor accessor;
+	permanentValues().insert( accessor, value.get() );
+	accessor->second = value;
+}
+
+ValuePlug::Statistics ValuePlug::statistics()
+{
+	Statistics result;
+	for( ThreadSpecificStatistics::const_iterator it = g_statistics.begin(), eIt = g_statistics.end(); it != eIt; ++it )
+	{
+		result.hashCount += it->hashCount;
+		result.computeCount += it->computeCount;
+		result.cacheHitCount += it->cacheHitCount;
+	}
+	return result;
+}
+
+void ValuePlug::resetStatistics()
+{
+	for( ThreadSpecificStatistics::iterator it = g_statistics.begin(), eIt = g_statistics.end(); it != eIt; ++it )
+	{
+		*it = Statistics();
+	}
+}
@@ -0,0 +1,164 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/BackgroundTask.h"
+
+#include "GafferBindings/BackgroundTaskBinding.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+using namespace GafferBindings;
+
+// Calls a python callable on the background thread.
+struct PythonFunction
+{
+
+	PythonFunction( object function )
+		:	m_function( function )
+	{
+	}
+
+	void operator()( const Canceller &canceller )
+	{
+		IECorePython::ScopedGILLock gilLock;
+		try
+		{
+			// the canceller is owned by the task, but we pass python a
+			// reference of its own, so that it remains valid if python
+			// holds on to it after the task has completed.
+			m_function( CancellerPtr( const_cast<Canceller *>( &canceller ) ) );
+		}
+		catch( const error_already_set & )
+		{
+			if( canceller.cancelled() )
+			{
+				// the exception was most likely the result of
+				// the cancellation, so isn't worth reporting.
+				PyErr_Clear();
+			}
+			else
+			{
+				PyErr_Print();
+			}
+		}
+	}
+
+	object m_function;
+
+};
+
+// Python 2 provides no PyGILState_Check(), so we compare the
+// thread state for this thread with the one holding the GIL.
+static bool haveGIL()
+{
+	PyThreadState *threadState = PyGILState_GetThisThreadState();
+	return threadState && threadState == _PyThreadState_Current;
+}
+
+class PythonBackgroundTask : public BackgroundTask
+{
+
+	public :
+
+		PythonBackgroundTask( object function )
+			:	BackgroundTask( PythonFunction( function ) )
+		{
+		}
+
+		virtual ~PythonBackgroundTask()
+		{
+			// the base class destructor would call the base class
+			// wait(), so we must wait ourselves.
+			cancelAndWait();
+		}
+
+		virtual void wait()
+		{
+			// the task needs the GIL in order to finish, so if we're
+			// holding it we must release it while we wait. we may be waited
+			// for either directly from python, or from c++ code called from
+			// python - BackgroundTask::cancelAndWaitForAll() being called
+			// by a plug edit for instance.
+			if( haveGIL() )
+			{
+				IECorePython::ScopedGILRelease gilRelease;
+				BackgroundTask::wait();
+			}
+			else
+			{
+				BackgroundTask::wait();
+			}
+		}
+
+};
+
+static BackgroundTaskPtr construct( object function )
+{
+	return new PythonBackgroundTask( function );
+}
+
+static void check( const Canceller &canceller )
+{
+	Canceller::check( &canceller );
+}
+
+void GafferBindings::bindBackgroundTask()
+{
+
+	IECorePython::RefCountedClass<Canceller, IECore::RefCounted>( "Canceller" )
+		.def( init<>() )
+		.def( "cancel", &Canceller::cancel )
+		.def( "cancelled", &Canceller::cancelled )
+		.def( "check", &check )
+	;
+
+	IECorePython::RefCountedClass<BackgroundTask, IECore::RefCounted>( "BackgroundTask" )
+		.def( "__init__", make_constructor( construct ) )
+		.def( "cancel", &BackgroundTask::cancel )
+		.def( "wait", &BackgroundTask::wait )
+		.def( "cancelAndWait", &BackgroundTask::cancelAndWait )
+		.def( "done", &BackgroundTask::done )
+		.def( "cancelAndWaitForAll", &BackgroundTask::cancelAndWaitForAll )
+		.staticmethod( "cancelAndWaitForAll" )
+	;
+
+}
@@ -0,0 +1,703 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "boost/format.hpp"
+#include "boost/algorithm/string/predicate.hpp"
+
+#include "IECore/FileIndexedIO.h"
+#include "IECore/SimpleTypedData.h"
+#include "IECore/VectorTypedData.h"
+#include "IECore/ObjectVector.h"
+
+#include "IECorePython/ScopedGILLock.h"
+
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
+
+#include "GafferBindings/BinarySerialisation.h"
+#include "GafferBindings/Serialisation.h"
+#include "GafferBindings/PlugBinding.h"
+#include "GafferBindings/ValuePlugBinding.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferBindings;
+using namespace boost::python;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal constants
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The serialisation is stored as three lists of operations which are replayed
+// in order by the Loader. The lists correspond to the hierarchy, connection and
+// post script sections of a python serialisation. Each operation has a path,
+// identifying the GraphComponent it applies to, and an integer argument which
+// indexes into one of the value pools shared by all operations.
+enum Operation
+{
+	// Path names the new child, argument indexes the python constructor in the string pool.
+	Construct = 0,
+	// Argument indexes python in the string pool, to be executed as-is.
+	Execute = 1,
+	// Argument indexes the value in the relevant pool.
+	SetFloat = 2,
+	SetInt = 3,
+	SetBool = 4,
+	SetString = 5,
+	SetObject = 6,
+	// Path is the destination plug, argument indexes the source path in the string pool.
+	SetInput = 7,
+	// Argument is unused.
+	SetReadOnly = 8
+};
+
+const int g_version = 1;
+const char *g_entryName = "gafferScript";
+
+const IECore::InternedString g_versionName( "version" );
+const IECore::InternedString g_modulesName( "modules" );
+const IECore::InternedString g_stringsName( "strings" );
+const IECore::InternedString g_floatsName( "floats" );
+const IECore::InternedString g_intsName( "ints" );
+const IECore::InternedString g_objectsName( "objects" );
+const IECore::InternedString g_hierarchyName( "hierarchy" );
+const IECore::InternedString g_connectionsName( "connections" );
+const IECore::InternedString g_postScriptName( "postScript" );
+const IECore::InternedString g_operationsName( "operations" );
+const IECore::InternedString g_pathsName( "paths" );
+const IECore::InternedString g_argumentsName( "arguments" );
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Writer
+//////////////////////////////////////////////////////////////////////////
+
+class BinarySerialisation::Writer
+{
+
+	public :
+
+		Writer( const GraphComponent *parent, const Set *filter, CompoundObject *result )
+			:	m_serialisation( parent, "parent", filter, false ), m_parent( parent ), m_filter( filter )
+		{
+			m_strings = new StringVectorData;
+			m_floats = new FloatVectorData;
+			m_ints = new IntVectorData;
+			m_objects = new ObjectVector;
+
+			result->members()[g_versionName] = new IntData( g_version );
+			result->members()[g_stringsName] = m_strings;
+			result->members()[g_floatsName] = m_floats;
+			result->members()[g_intsName] = m_ints;
+			result->members()[g_objectsName] = m_objects;
+
+			m_hierarchy = phase( result, g_hierarchyName );
+			m_connections = phase( result, g_connectionsName );
+			m_postScript = phase( result, g_postScriptName );
+
+			walkChildren();
+
+			StringVectorDataPtr modules = new StringVectorData;
+			modules->writable().insert( modules->writable().end(), m_modules.begin(), m_modules.end() );
+			result->members()[g_modulesName] = modules;
+		}
+
+	private :
+
+		struct Phase
+		{
+			vector<int> *operations;
+			vector<string> *paths;
+			vector<int> *arguments;
+		};
+
+		Phase phase( CompoundObject *result, const IECore::InternedString &name )
+		{
+			CompoundObjectPtr phaseObject = new CompoundObject;
+			IntVectorDataPtr operations = new IntVectorData;
+			StringVectorDataPtr paths = new StringVectorData;
+			IntVectorDataPtr arguments = new IntVectorData;
+			phaseObject->members()[g_operationsName] = operations;
+			phaseObject->members()[g_pathsName] = paths;
+			phaseObject->members()[g_argumentsName] = arguments;
+			result->members()[name] = phaseObject;
+
+			Phase p;
+			p.operations = &operations->writable();
+			p.paths = &paths->writable();
+			p.arguments = &arguments->writable();
+			return p;
+		}
+
+		void addOperation( Phase &phase, Operation operation, const std::string &path, int argument )
+		{
+			phase.operations->push_back( operation );
+			phase.paths->push_back( path );
+			phase.arguments->push_back( argument );
+		}
+
+		int addString( const std::string &s )
+		{
+			m_strings->writable().push_back( s );
+			return m_strings->readable().size() - 1;
+		}
+
+		int addInt( int i )
+		{
+			m_ints->writable().push_back( i );
+			return m_ints->readable().size() - 1;
+		}
+
+		int addFloat( float f )
+		{
+			m_floats->writable().push_back( f );
+			return m_floats->readable().size() - 1;
+		}
+
+		int addObject( ObjectPtr o )
+		{
+			m_objects->members().push_back( o );
+			return m_objects->members().size() - 1;
+		}
+
+		// Mirrors the top level of the python Serialisation.
+		void walkChildren()
+		{
+			IECorePython::ScopedGILLock gilLock;
+
+			const Serialisation::Serialiser *parentSerialiser = Serialisation::serialiser( m_parent );
+			for( GraphComponent::ChildIterator it = m_parent->children().begin(), eIt = m_parent->children().end(); it != eIt; it++ )
+			{
+				const GraphComponent *child = it->get();
+				if( m_filter && !m_filter->contains( child ) )
+				{
+					continue;
+				}
+				if( !parentSerialiser->childNeedsSerialisation( child ) )
+				{
+					continue;
+				}
+
+				const std::string &childName = child->getName().string();
+				std::string childIdentifier;
+				if( parentSerialiser->childNeedsConstruction( child ) )
+				{
+					const Serialisation::Serialiser *childSerialiser = Serialisation::serialiser( child );
+					addOperation( m_hierarchy, Construct, childName, addString( childSerialiser->constructor( child ) ) );
+					childIdentifier = "__children[\"" + childName + "\"]";
+				}
+				else
+				{
+					childIdentifier = "parent[\"" + childName + "\"]";
+				}
+				walk( child, childName, childIdentifier );
+			}
+		}
+
+		// Mirrors Serialisation::walk().
+		void walk( const GraphComponent *graphComponent, const std::string &path, const std::string &identifier )
+		{
+			const Serialisation::Serialiser *serialiser = Serialisation::serialiser( graphComponent );
+
+			serialiser->moduleDependencies( graphComponent, m_modules );
+			postConstructor( graphComponent, serialiser, path, identifier );
+			postHierarchy( graphComponent, serialiser, path, identifier );
+			postScript( graphComponent, serialiser, identifier );
+
+			for( GraphComponent::ChildIterator it = graphComponent->children().begin(), eIt = graphComponent->children().end(); it != eIt; it++ )
+			{
+				const GraphComponent *child = it->get();
+				if( !serialiser->childNeedsSerialisation( child ) )
+				{
+					continue;
+				}
+				const std::string &childName = child->getName().string();
+				const std::string childPath = path + "." + childName;
+				if( serialiser->childNeedsConstruction( child ) )
+				{
+					const Serialisation::Serialiser *childSerialiser = Serialisation::serialiser( child );
+					addOperation( m_hierarchy, Construct, childPath, addString( childSerialiser->constructor( child ) ) );
+				}
+				walk( child, childPath, identifier + "[\"" + childName + "\"]" );
+			}
+		}
+
+		void postConstructor( const GraphComponent *graphComponent, const Serialisation::Serialiser *serialiser, const std::string &path, const std::string &identifier )
+		{
+			// If the serialiser does nothing more than the standard setValue() call,
+			// then we can store the value natively and avoid python entirely, both
+			// now and when loading. We only fall back to python for the value types
+			// addValue() doesn't support.
+			const ValuePlug *valuePlug = IECore::runTimeCast<const ValuePlug>( graphComponent );
+			const ValuePlugSerialiser *valuePlugSerialiser = dynamic_cast<const ValuePlugSerialiser *>( serialiser );
+			if( valuePlug && valuePlugSerialiser && valuePlugSerialiser->postConstructorSetsValueOnly() )
+			{
+				if( !ValuePlugSerialiser::valueNeedsSerialisation( valuePlug, m_serialisation ) || addValue( valuePlug, path ) )
+				{
+					return;
+				}
+			}
+
+			const std::string s = serialiser->postConstructor( graphComponent, identifier, m_serialisation );
+			if( s.size() )
+			{
+				addOperation( m_hierarchy, Execute, path, addString( s ) );
+			}
+		}
+
+		void postHierarchy( const GraphComponent *graphComponent, const Serialisation::Serialiser *serialiser, const std::string &path, const std::string &identifier )
+		{
+			const std::string s = serialiser->postHierarchy( graphComponent, identifier, m_serialisation );
+			if( s.empty() )
+			{
+				return;
+			}
+
+			// As above, we can store standard connections and flags natively.
+			const Plug *plug = IECore::runTimeCast<const Plug>( graphComponent );
+			const PlugSerialiser *plugSerialiser = dynamic_cast<const PlugSerialiser *>( serialiser );
+			if( plug && plugSerialiser && s == plugSerialiser->PlugSerialiser::postHierarchy( graphComponent, identifier, m_serialisation ) )
+			{
+				const Plug *input = plug->getInput<Plug>();
+				if( input && m_serialisation.identifier( input ).size() )
+				{
+					addOperation( m_connections, SetInput, path, addString( relativePath( input ) ) );
+				}
+				if( plug->getFlags( Plug::ReadOnly ) )
+				{
+					addOperation( m_connections, SetReadOnly, path, 0 );
+				}
+				return;
+			}
+
+			addOperation( m_connections, Execute, path, addString( s ) );
+		}
+
+		void postScript( const GraphComponent *graphComponent, const Serialisation::Serialiser *serialiser, const std::string &identifier )
+		{
+			const std::string s = serialiser->postScript( graphComponent, identifier, m_serialisation );
+			if( s.size() )
+			{
+				addOperation( m_postScript, Execute, "", addString( s ) );
+			}
+		}
+
+		// Returns false if the plug type isn't supported natively.
+		bool addValue( const ValuePlug *plug, const std::string &path )
+		{
+			switch( plug->typeId() )
+			{
+				case FloatPlugTypeId :
+					addOperation( m_hierarchy, SetFloat, path, addFloat( static_cast<const FloatPlug *>( plug )->getValue() ) );
+					return true;
+				case IntPlugTypeId :
+					addOperation( m_hierarchy, SetInt, path, addInt( static_cast<const IntPlug *>( plug )->getValue() ) );
+					return true;
+				case BoolPlugTypeId :
+					addOperation( m_hierarchy, SetBool, path, addInt( static_cast<const BoolPlug *>( plug )->getValue() ) );
+					return true;
+				case StringPlugTypeId :
+					addOperation( m_hierarchy, SetString, path, addString( static_cast<const StringPlug *>( plug )->getValue() ) );
+					return true;
+				case M33fPlugTypeId :
+					addOperation( m_hierarchy, SetObject, path, addObject( new M33fData( static_cast<const M33fPlug *>( plug )->getValue() ) ) );
+					return true;
+				case M44fPlugTypeId :
+					addOperation( m_hierarchy, SetObject, path, addObject( new M44fData( static_cast<const M44fPlug *>( plug )->getValue() ) ) );
+					return true;
+				case AtomicBox3fPlugTypeId :
+					addOperation( m_hierarchy, SetObject, path, addObject( new Box3fData( static_cast<const AtomicBox3fPlug *>( plug )->getValue() ) ) );
+					return true;
+				case AtomicBox2iPlugTypeId :
+					addOperation( m_hierarchy, SetObject, path, addObject( new Box2iData( static_cast<const AtomicBox2iPlug *>( plug )->getValue() ) ) );
+					return true;
+				case ObjectPlugTypeId :
+					return addObjectValue<ObjectPlug>( plug, path );
+				case BoolVectorDataPlugTypeId :
+					return addObjectValue<BoolVectorDataPlug>( plug, path );
+				case IntVectorDataPlugTypeId :
+					return addObjectValue<IntVectorDataPlug>( plug, path );
+				case FloatVectorDataPlugTypeId :
+					return addObjectValue<FloatVectorDataPlug>( plug, path );
+				case StringVectorDataPlugTypeId :
+					return addObjectValue<StringVectorDataPlug>( plug, path );
+				case InternedStringVectorDataPlugTypeId :
+					return addObjectValue<InternedStringVectorDataPlug>( plug, path );
+				case V3fVectorDataPlugTypeId :
+					return addObjectValue<V3fVectorDataPlug>( plug, path );
+				case Color3fVectorDataPlugTypeId :
+					return addObjectValue<Color3fVectorDataPlug>( plug, path );
+				case ObjectVectorPlugTypeId :
+					return addObjectValue<ObjectVectorPlug>( plug, path );
+				case CompoundObjectPlugTypeId :
+					return addObjectValue<CompoundObjectPlug>( plug, path );
+				default :
+					return false;
+			}
+		}
+
+		template<typename T>
+		bool addObjectValue( const ValuePlug *plug, const std::string &path )
+		{
+			typename T::ConstValuePtr value = static_cast<const T *>( plug )->getValue();
+			if( !value )
+			{
+				return false;
+			}
+			addOperation( m_hierarchy, SetObject, path, addObject( value->copy() ) );
+			return true;
+		}
+
+		std::string relativePath( const GraphComponent *graphComponent ) const
+		{
+			std::string result;
+			while( graphComponent && graphComponent != m_parent )
+			{
+				result = result.empty() ? graphComponent->getName().string() : graphComponent->getName().string() + "." + result;
+				graphComponent = graphComponent->parent<GraphComponent>();
+			}
+			return result;
+		}
+
+		// Used only to provide identifiers to the Serialisers.
+		const Serialisation m_serialisation;
+		const GraphComponent *m_parent;
+		const Set *m_filter;
+
+		std::set<std::string> m_modules;
+
+		StringVectorDataPtr m_strings;
+		FloatVectorDataPtr m_floats;
+		IntVectorDataPtr m_ints;
+		ObjectVectorPtr m_objects;
+
+		Phase m_hierarchy;
+		Phase m_connections;
+		Phase m_postScript;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Loader
+//////////////////////////////////////////////////////////////////////////
+
+class BinarySerialisation::Loader
+{
+
+	public :
+
+		Loader( const CompoundObject *serialisation, GraphComponent *parent, object &executionDict )
+			:	m_serialisation( serialisation ), m_parent( parent ), m_executionDict( executionDict )
+		{
+			const IntData *version = serialisation->member<IntData>( g_versionName );
+			if( !version || version->readable() > g_version )
+			{
+				throw IECore::Exception( "BinarySerialisation : unsupported version" );
+			}
+
+			m_strings = &serialisation->member<StringVectorData>( g_stringsName, true )->readable();
+			m_floats = &serialisation->member<FloatVectorData>( g_floatsName, true )->readable();
+			m_ints = &serialisation->member<IntVectorData>( g_intsName, true )->readable();
+			m_objects = &serialisation->member<ObjectVector>( g_objectsName, true )->members();
+		}
+
+		void load()
+		{
+			const vector<string> &modules = m_serialisation->member<StringVectorData>( g_modulesName, true )->readable();
+			for( vector<string>::const_iterator it = modules.begin(), eIt = modules.end(); it != eIt; ++it )
+			{
+				if( it->size() )
+				{
+					exec( ( "import " + *it ).c_str(), m_executionDict, m_executionDict );
+				}
+			}
+
+			m_executionDict["__children"] = m_children;
+
+			replay( g_hierarchyName );
+			replay( g_connectionsName );
+			replay( g_postScriptName );
+
+			m_executionDict["__children"].del();
+		}
+
+	private :
+
+		void replay( const IECore::InternedString &phaseName )
+		{
+			const CompoundObject *phase = m_serialisation->member<CompoundObject>( phaseName, true );
+			const vector<int> &operations = phase->member<IntVectorData>( g_operationsName, true )->readable();
+			const vector<string> &paths = phase->member<StringVectorData>( g_pathsName, true )->readable();
+			const vector<int> &arguments = phase->member<IntVectorData>( g_argumentsName, true )->readable();
+
+			for( size_t i = 0, e = operations.size(); i < e; ++i )
+			{
+				const std::string &path = paths[i];
+				const int argument = arguments[i];
+				switch( operations[i] )
+				{
+					case Construct :
+						construct( path, (*m_strings)[argument] );
+						break;
+					case Execute :
+						exec( (*m_strings)[argument].c_str(), m_executionDict, m_executionDict );
+						break;
+					case SetFloat :
+						resolve<FloatPlug>( path )->setValue( (*m_floats)[argument] );
+						break;
+					case SetInt :
+						resolve<IntPlug>( path )->setValue( (*m_ints)[argument] );
+						break;
+					case SetBool :
+						resolve<BoolPlug>( path )->setValue( (*m_ints)[argument] );
+						break;
+					case SetString :
+						resolve<StringPlug>( path )->setValue( (*m_strings)[argument] );
+						break;
+					case SetObject :
+						setObject( resolve<ValuePlug>( path ), (*m_objects)[argument].get() );
+						break;
+					case SetInput :
+						resolve<Plug>( path )->setInput( resolve<Plug>( (*m_strings)[argument] ) );
+						break;
+					case SetReadOnly :
+						resolve<Plug>( path )->setFlags( Plug::ReadOnly, true );
+						break;
+					default :
+						throw IECore::Exception( boost::str( boost::format( "BinarySerialisation : unknown operation %d" ) % operations[i] ) );
+				}
+			}
+		}
+
+		void construct( const std::string &path, const std::string &constructor )
+		{
+			object pythonChild = eval( constructor.c_str(), m_executionDict, m_executionDict );
+			GraphComponentPtr child = extract<GraphComponentPtr>( pythonChild );
+
+			const size_t separator = path.rfind( '.' );
+			if( separator == std::string::npos )
+			{
+				m_parent->addChild( child );
+				m_children[path] = pythonChild;
+				m_topLevel[path] = child.get();
+			}
+			else
+			{
+				resolve<GraphComponent>( path.substr( 0, separator ) )->addChild( child );
+			}
+		}
+
+		// Paths are always relative to m_parent. We keep a map of the top level
+		// children we've constructed, both to avoid a linear search of m_parent's
+		// children, and to cope with the renaming of children which clash with
+		// existing names.
+		template<typename T>
+		T *resolve( const std::string &path )
+		{
+			const size_t separator = path.find( '.' );
+			const std::string head = path.substr( 0, separator );
+
+			GraphComponent *g = 0;
+			TopLevelMap::const_iterator it = m_topLevel.find( head );
+			if( it != m_topLevel.end() )
+			{
+				g = it->second;
+			}
+			else
+			{
+				g = m_parent->getChild<GraphComponent>( head );
+			}
+
+			if( g && separator != std::string::npos )
+			{
+				g = g->descendant<GraphComponent>( path.substr( separator + 1 ) );
+			}
+
+			T *result = IECore::runTimeCast<T>( g );
+			if( !result )
+			{
+				throw IECore::Exception( boost::str( boost::format( "BinarySerialisation : unable to find %s \"%s\"" ) % T::staticTypeName() % path ) );
+			}
+			return result;
+		}
+
+		void setObject( ValuePlug *plug, const Object *value )
+		{
+			switch( plug->typeId() )
+			{
+				case M33fPlugTypeId :
+					setTypedValue<M33fPlug, M33fData>( plug, value );
+					break;
+				case M44fPlugTypeId :
+					setTypedValue<M44fPlug, M44fData>( plug, value );
+					break;
+				case AtomicBox3fPlugTypeId :
+					setTypedValue<AtomicBox3fPlug, Box3fData>( plug, value );
+					break;
+				case AtomicBox2iPlugTypeId :
+					setTypedValue<AtomicBox2iPlug, Box2iData>( plug, value );
+					break;
+				case ObjectPlugTypeId :
+					setObjectValue<ObjectPlug>( plug, value );
+					break;
+				case BoolVectorDataPlugTypeId :
+					setObjectValue<BoolVectorDataPlug>( plug, value );
+					break;
+				case IntVectorDataPlugTypeId :
+					setObjectValue<IntVectorDataPlug>( plug, value );
+					break;
+				case FloatVectorDataPlugTypeId :
+					setObjectValue<FloatVectorDataPlug>( plug, value );
+					break;
+				case StringVectorDataPlugTypeId :
+					setObjectValue<StringVectorDataPlug>( plug, value );
+					break;
+				case InternedStringVectorDataPlugTypeId :
+					setObjectValue<InternedStringVectorDataPlug>( plug, value );
+					break;
+				case V3fVectorDataPlugTypeId :
+					setObjectValue<V3fVectorDataPlug>( plug, value );
+					break;
+				case Color3fVectorDataPlugTypeId :
+					setObjectValue<Color3fVectorDataPlug>( plug, value );
+					break;
+				case ObjectVectorPlugTypeId :
+					setObjectValue<ObjectVectorPlug>( plug, value );
+					break;
+				case CompoundObjectPlugTypeId :
+					setObjectValue<CompoundObjectPlug>( plug, value );
+					break;
+				default :
+					throw IECore::Exception( boost::str( boost::format( "BinarySerialisation : unsupported plug type \"%s\" for \"%s\"" ) % plug->typeName() % plug->fullName() ) );
+			}
+		}
+
+		template<typename PlugType, typename DataType>
+		void setTypedValue( ValuePlug *plug, const Object *value )
+		{
+			const DataType *data = IECore::runTimeCast<const DataType>( value );
+			if( !data )
+			{
+				throw IECore::Exception( boost::str( boost::format( "BinarySerialisation : unexpected value type for \"%s\"" ) % plug->fullName() ) );
+			}
+			static_cast<PlugType *>( plug )->setValue( data->readable() );
+		}
+
+		template<typename PlugType>
+		void setObjectValue( ValuePlug *plug, const Object *value )
+		{
+			const typename PlugType::ValueType *typedValue = IECore::runTimeCast<const typename PlugType::ValueType>( value );
+			if( !typedValue )
+			{
+				throw IECore::Exception( boost::str( boost::format( "BinarySerialisation : unexpected value type for \"%s\"" ) % plug->fullName() ) );
+			}
+			static_cast<PlugType *>( plug )->setValue( typedValue );
+		}
+
+		const CompoundObject *m_serialisation;
+		GraphComponent *m_parent;
+		object &m_executionDict;
+		// Equivalent to the __children dictionary in a python serialisation,
+		// and provided under that name to any python we execute.
+		dict m_children;
+
+		typedef std::map<std::string, GraphComponent *> TopLevelMap;
+		TopLevelMap m_topLevel;
+
+		const vector<string> *m_strings;
+		const vector<float> *m_floats;
+		const vector<int> *m_ints;
+		const ObjectVector::MemberContainer *m_objects;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// BinarySerialisation
+//////////////////////////////////////////////////////////////////////////
+
+BinarySerialisation::BinarySerialisation( const Gaffer::GraphComponent *parent, const Gaffer::Set *filter )
+	:	m_result( new CompoundObject )
+{
+	Writer writer( parent, filter, m_result.get() );
+}
+
+IECore::ConstCompoundObjectPtr BinarySerialisation::result() const
+{
+	return m_result;
+}
+
+void BinarySerialisation::save( const std::string &fileName ) const
+{
+	IndexedIOPtr io = new FileIndexedIO( fileName, IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+	m_result->save( io, g_entryName );
+}
+
+void BinarySerialisation::load( const IECore::CompoundObject *serialisation, Gaffer::GraphComponent *parent, boost::python::object &executionDict )
+{
+	IECorePython::ScopedGILLock gilLock;
+	Loader loader( serialisation, parent, executionDict );
+	loader.load();
+}
+
+IECore::ConstCompoundObjectPtr BinarySerialisation::read( const std::string &fileName )
+{
+	IndexedIOPtr io = new FileIndexedIO( fileName, IndexedIO::rootPath, IndexedIO::Read );
+	ConstCompoundObjectPtr result = IECore::runTimeCast<const CompoundObject>( Object::load( io, g_entryName ) );
+	if( !result )
+	{
+		throw IECore::IOException( "File \"" + fileName + "\" does not contain a binary script" );
+	}
+	return result;
+}
+
+bool BinarySerialisation::isBinaryFileName( const std::string &fileName )
+{
+	return boost::ends_with( fileName, fileExtension() );
+}
+
+const std::string &BinarySerialisation::fileExtension()
+{
+	static std::string g_extension( ".gfb" );
+	return g_extension;
+}
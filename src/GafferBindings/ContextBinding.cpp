@@ -42,6 +42,7 @@
 #include "IECorePython/RefCountedBinding.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
 
 #include "GafferBindings/SignalBinding.h"
 #include "GafferBindings/ContextBinding.h"
@@ -130,6 +131,11 @@ static ContextPtr current()
 	return const_cast<Context *>( Context::current() );
 }
 
+static CancellerPtr canceller( const Context &context )
+{
+	return const_cast<Canceller *>( context.canceller() );
+}
+
 void bindContext()
 {	
 	scope s = IECorePython::RefCountedClass<Context, IECore::RefCounted>( "Context" )
@@ -155,6 +161,9 @@ void bindContext()
 		.def( self == self )
 		.def( self != self )
 		.def( "substitute", &Context::substitute )
+		.def( "substitutionHash", &Context::substitutionHash )
+		.def( "setCanceller", &Context::setCanceller )
+		.def( "canceller", &canceller )
 		.def( "current", &current ).staticmethod( "current" )
 		;
 
@@ -53,6 +53,7 @@
 #include "GafferBindings/ScriptNodeBinding.h"
 #include "GafferBindings/SignalBinding.h"
 #include "GafferBindings/NodeBinding.h"
+#include "GafferBindings/BinarySerialisation.h"
 
 using namespace boost::python;
 using namespace Gaffer;
@@ -113,6 +114,13 @@ class ScriptNodeWrapper : public NodeWrapper<ScriptNode>
 		
 		virtual void serialiseToFile( const std::string &fileName, const Node *parent, const Set *filter ) const
 		{
+			if( BinarySerialisation::isBinaryFileName( fileName ) )
+			{
+				BinarySerialisation serialisation( parent ? parent : this, filter );
+				serialisation.save( fileName );
+				return;
+			}
+			
 			std::string s = serialise( parent, filter );
 			
 			std::ofstream f( fileName.c_str() );
@@ -131,12 +139,30 @@ class ScriptNodeWrapper : public NodeWrapper<ScriptNode>
 		
 		virtual void load()
 		{
-			const std::string s = readFile( fileNamePlug()->getValue() );
+			const std::string fileName = fileNamePlug()->getValue();
+			if( BinarySerialisation::isBinaryFileName( fileName ) )
+			{
+				IECore::ConstCompoundObjectPtr serialisation = BinarySerialisation::read( fileName );
+				
+				deleteNodes();
+				variablesPlug()->clearChildren();
+				
+				IECorePython::ScopedGILLock gilLock;
+				object e = executionDict( 0 );
+				BinarySerialisation::load( serialisation.get(), this, e );
+				// there's no python script to pass to observers, but they still
+				// need to know that the script has been loaded.
+				scriptExecutedSignal()( this, "" );
+			}
+			else
+			{
+				const std::string s = readFile( fileName );
 			
-			deleteNodes();
-			variablesPlug()->clearChildren();
+				deleteNodes();
+				variablesPlug()->clearChildren();
 
-			execute( s );
+				execute( s );
+			}
 			
 			UndoContext undoDisabled( this, UndoContext::Disabled );
 			unsavedChangesPlug()->setValue( false );
@@ -60,9 +60,25 @@ using namespace boost::python;
 
 Serialisation::Serialisation( const Gaffer::GraphComponent *parent, const std::string &parentName, const Gaffer::Set *filter )
 	:	m_parent( parent ), m_parentName( parentName ), m_filter( filter )
+{
+	serialiseChildren();
+}
+
+Serialisation::Serialisation( const Gaffer::GraphComponent *parent, const std::string &parentName, const Gaffer::Set *filter, bool walk )
+	:	m_parent( parent ), m_parentName( parentName ), m_filter( filter )
+{
+	if( walk )
+	{
+		serialiseChildren();
+	}
+}
+
+void Serialisation::serialiseChildren()
 {
 	IECorePython::ScopedGILLock gilLock;
 	
+	const GraphComponent *parent = m_parent;
+	const std::string &parentName = m_parentName;
 	const Serialiser *parentSerialiser = serialiser( parent );
 	for( GraphComponent::ChildIterator it = parent->children().begin(), eIt = parent->children().end(); it != eIt; it++ )
 	{
@@ -70,6 +70,11 @@ class SplinePlugSerialiser : public CompoundPlugSerialiser
 			return CompoundPlugSerialiser::postConstructor( child, identifier, serialisation ) + identifier + ".clearPoints()\n";
 		}
 		
+		virtual bool postConstructorSetsValueOnly() const
+		{
+			return false;
+		}
+		
 };
 
 template<typename T>
@@ -40,6 +40,7 @@
 #include "IECore/MessageHandler.h"
 #include "IECore/NullObject.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/Node.h"
@@ -80,7 +81,14 @@ static void setValue( typename T::Ptr p, typename T::ValuePtr v, bool copy=true
 template<typename T>
 static IECore::ObjectPtr getValue( typename T::Ptr p, bool copy=true )
 {
-	typename IECore::ConstObjectPtr v = p->getValue();
+	typename IECore::ConstObjectPtr v;
+	{
+		// we release the GIL so that other python threads may run while
+		// we compute - in particular the ui thread, when the computation
+		// is being performed by a BackgroundTask.
+		IECorePython::ScopedGILRelease gilRelease;
+		v = p->getValue();
+	}
 	if( v )
 	{
 		if( copy )
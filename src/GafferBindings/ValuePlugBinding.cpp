@@ -125,28 +125,38 @@ std::string ValuePlugSerialiser::constructor( const Gaffer::GraphComponent *grap
 std::string ValuePlugSerialiser::postConstructor( const Gaffer::GraphComponent *graphComponent, const std::string &identifier, const Serialisation &serialisation ) const
 {
 	const Plug *plug = static_cast<const Plug *>( graphComponent );
-	// output a setValue() call if the plug is serialisable and has no input.
-	// we don't do this for non-leaf plugs, since some children may have connections
-	// which make setting the value inappropriate.
-	if( plug->direction() == Plug::In && plug->getFlags( Plug::Serialisable ) && !plug->children().size() )
+	if( valueNeedsSerialisation( plug, serialisation ) )
 	{
-		if( !serialisation.identifier( plug->getInput<Plug>() ).size() )
+		object pythonPlug( PlugPtr( const_cast<Plug *>( plug ) ) );
+		if( PyObject_HasAttrString( pythonPlug.ptr(), "getValue" ) )
 		{
-			object pythonPlug( PlugPtr( const_cast<Plug *>( plug ) ) );
-			if( PyObject_HasAttrString( pythonPlug.ptr(), "getValue" ) )
-			{
-				object pythonValue = pythonPlug.attr( "getValue" )();
-				std::string value = extract<std::string>( pythonValue.attr( "__repr__" )() );
-				return identifier + ".setValue( " + value + " )\n";
-			}
+			object pythonValue = pythonPlug.attr( "getValue" )();
+			std::string value = extract<std::string>( pythonValue.attr( "__repr__" )() );
+			return identifier + ".setValue( " + value + " )\n";
 		}
 	}
 	return "";
 }
 
+bool ValuePlugSerialiser::postConstructorSetsValueOnly() const
+{
+	return true;
+}
+
+bool ValuePlugSerialiser::valueNeedsSerialisation( const Gaffer::Plug *plug, const Serialisation &serialisation )
+{
+	// we serialise the value if the plug is serialisable and has no input.
+	// we don't do this for non-leaf plugs, since some children may have connections
+	// which make setting the value inappropriate.
+	return
+		plug->direction() == Plug::In && plug->getFlags( Plug::Serialisable ) && !plug->children().size() &&
+		!serialisation.identifier( plug->getInput<Plug>() ).size()
+	;
+}
+
 void GafferBindings::bindValuePlug()
 {
-	IECorePython::RunTimeTypedClass<ValuePlug>()
+	scope s = IECorePython::RunTimeTypedClass<ValuePlug>()
 		.GAFFERBINDINGS_DEFPLUGWRAPPERFNS( ValuePlug )
 		.def( "settable", &ValuePlug::settable )
 		.def( "setToDefault", &ValuePlug::setToDefault )
@@ -156,8 +166,22 @@ void GafferBindings::bindValuePlug()
 		.staticmethod( "getCacheMemoryLimit" )
 		.def( "setCacheMemoryLimit", &ValuePlug::setCacheMemoryLimit )
 		.staticmethod( "setCacheMemoryLimit" )
+		.def( "cacheMemoryUsage", &ValuePlug::cacheMemoryUsage )
+		.staticmethod( "cacheMemoryUsage" )
+		.def( "clearCache", &ValuePlug::clearCache )
+		.staticmethod( "clearCache" )
+		.def( "statistics", &ValuePlug::statistics )
+		.staticmethod( "statistics" )
+		.def( "resetStatistics", &ValuePlug::resetStatistics )
+		.staticmethod( "resetStatistics" )
 		.def( "__repr__", &repr )
 	;
+	
+	class_<ValuePlug::Statistics>( "Statistics" )
+		.def_readonly( "hashCount", &ValuePlug::Statistics::hashCount )
+		.def_readonly( "computeCount", &ValuePlug::Statistics::computeCount )
+		.def_readonly( "cacheHitCount", &ValuePlug::Statistics::cacheHitCount )
+	;
 
 	Serialisation::registerSerialiser( Gaffer::ValuePlug::staticTypeId(), new ValuePlugSerialiser );
 }
@@ -100,22 +100,33 @@ bool ChannelDataProcessor::channelEnabled( const std::string &channel ) const
 		return false;
 	}
 
-	// Grab the intersection of the channels from the "channels" plug and the image input to see which channels we are to operate on.
-	IECore::ConstStringVectorDataPtr channelNamesData = inPlug()->channelNamesPlug()->getValue();
-	std::vector<std::string> maskChannels = channelNamesData->readable();
-	channelMaskPlug()->maskChannels( maskChannels );
-
-	// Check to see if the channel that we wish to process is masked.
-	return ( std::find( maskChannels.begin(), maskChannels.end(), channel ) != maskChannels.end() );
+	// Grab the intersection of the channels from the "channels" plug and the image input to see which channels we
+	// are to operate on. This is cached by the ChannelMaskPlug against the plug hashes, so per tile we need only
+	// hash the plugs and test a bit - the channel names themselves are only evaluated once per distinct hash.
+	IECore::ConstBoolVectorDataPtr channelMask = channelMaskPlug()->channelMask( inPlug()->channelNamesPlug() );
+	return ChannelMaskPlug::channelEnabled( channelMask.get(), channel );
 }
 
 IECore::ConstFloatVectorDataPtr ChannelDataProcessor::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	IECore::FloatVectorDataPtr outData = inPlug()->channelData( channelName, tileOrigin )->copy();
+	IECore::ConstFloatVectorDataPtr inData = inPlug()->channelData( channelName, tileOrigin );
+	
+	float value;
+	if( ImagePlug::isUniformTile( inData.get(), value ) && processUniformChannelData( context, parent, channelName, value ) )
+	{
+		return ImagePlug::uniformTile( value );
+	}
+	
+	IECore::FloatVectorDataPtr outData = inData->copy();
 	processChannelData( context, parent, channelName, outData );
 	return outData;
 }
 
+bool ChannelDataProcessor::processUniformChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, float &value ) const
+{
+	return false;
+}
+
 void ChannelDataProcessor::hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	h = inPlug()->formatPlug()->hash();
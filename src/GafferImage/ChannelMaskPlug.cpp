@@ -34,12 +34,40 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/atomic.h"
+
+#include "IECore/LRUCache.h"
+
 #include "GafferImage/ChannelMaskPlug.h"
 #include "Gaffer/TypedObjectPlug.h"
 
 using namespace GafferImage;
 using namespace IECore;
 
+namespace
+{
+
+typedef tbb::concurrent_hash_map<std::string, size_t> ChannelIdMap;
+ChannelIdMap g_channelIds;
+tbb::atomic<size_t> g_nextChannelId;
+
+// Masks are keyed by the hashes of the input channels and the mask channels.
+// We compute the masks in ChannelMaskPlug::channelMask() and set() them in the
+// cache, so the getter just reports a miss by returning 0.
+ConstBoolVectorDataPtr missingChannelMaskGetter( const MurmurHash &key, size_t &cost )
+{
+	cost = 0;
+	return 0;
+}
+
+// The masks are small, so rather than measure their memory usage we
+// give each a cost of 1, limiting the number we keep.
+typedef LRUCache<MurmurHash, ConstBoolVectorDataPtr> ChannelMaskCache;
+ChannelMaskCache g_channelMasks( missingChannelMaskGetter, 10000 );
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( ChannelMaskPlug );
 
 ChannelMaskPlug::ChannelMaskPlug(
@@ -61,19 +89,121 @@ void ChannelMaskPlug::maskChannels( std::vector<std::string> &inChannels ) const
 	ConstStringVectorDataPtr channelNamesData = getValue();
 	const std::vector<std::string> &maskChannels = channelNamesData->readable();
 
-	// Intersect the inChannels and the maskChannels in place.
-	std::vector<std::string>::iterator cIt( inChannels.begin() );
-	while ( cIt != inChannels.end() )
+	// Build a bitset of the mask channels, so that we can intersect
+	// the inChannels and the maskChannels in place in linear time.
+	std::vector<bool> mask;
+	for( std::vector<std::string>::const_iterator it = maskChannels.begin(); it != maskChannels.end(); ++it )
 	{
-		if ( std::find( maskChannels.begin(), maskChannels.end(), (*cIt) ) == maskChannels.end() )
+		const size_t id = channelId( *it );
+		if( id >= mask.size() )
 		{
-			cIt = inChannels.erase( cIt );
+			mask.resize( id + 1, false );
 		}
-		else
+		mask[id] = true;
+	}
+
+	std::vector<std::string>::iterator outIt( inChannels.begin() );
+	for( std::vector<std::string>::iterator cIt = inChannels.begin(); cIt != inChannels.end(); ++cIt )
+	{
+		const size_t id = channelId( *cIt );
+		if( id < mask.size() && mask[id] )
 		{
-			++cIt;
+			if( outIt != cIt )
+			{
+				outIt->swap( *cIt );
+			}
+			++outIt;
+		}
+	}
+	inChannels.erase( outIt, inChannels.end() );
+}
+
+IECore::ConstBoolVectorDataPtr ChannelMaskPlug::channelMask( const IECore::StringVectorData *inChannels ) const
+{
+	ConstStringVectorDataPtr maskChannelsData = getValue();
+	
+	MurmurHash key = inChannels->Object::hash();
+	key.append( maskChannelsData->Object::hash() );
+	
+	if( ConstBoolVectorDataPtr result = findChannelMask( key ) )
+	{
+		return result;
+	}
+	
+	return storeChannelMask( key, computeChannelMask( inChannels ) );
+}
+
+IECore::ConstBoolVectorDataPtr ChannelMaskPlug::channelMask( const Gaffer::StringVectorDataPlug *inChannelsPlug ) const
+{
+	// We key the mask on the plug hashes rather than on the values,
+	// so that the channel lists need only be evaluated when the mask
+	// isn't cached already.
+	MurmurHash key = inChannelsPlug->hash();
+	hash( key );
+	
+	if( ConstBoolVectorDataPtr result = findChannelMask( key ) )
+	{
+		return result;
+	}
+	
+	ConstStringVectorDataPtr inChannels = inChannelsPlug->getValue();
+	return storeChannelMask( key, computeChannelMask( inChannels.get() ) );
+}
+
+IECore::ConstBoolVectorDataPtr ChannelMaskPlug::computeChannelMask( const IECore::StringVectorData *inChannels ) const
+{
+	std::vector<std::string> channels = inChannels->readable();
+	maskChannels( channels );
+	
+	BoolVectorDataPtr result = new BoolVectorData;
+	std::vector<bool> &bits = result->writable();
+	for( std::vector<std::string>::const_iterator it = channels.begin(); it != channels.end(); ++it )
+	{
+		const size_t id = channelId( *it );
+		if( id >= bits.size() )
+		{
+			bits.resize( id + 1, false );
 		}
+		bits[id] = true;
 	}
+	
+	return result;
+}
+
+IECore::ConstBoolVectorDataPtr ChannelMaskPlug::findChannelMask( const IECore::MurmurHash &key )
+{
+	return g_channelMasks.get( key );
+}
+
+IECore::ConstBoolVectorDataPtr ChannelMaskPlug::storeChannelMask( const IECore::MurmurHash &key, IECore::ConstBoolVectorDataPtr channelMask )
+{
+	g_channelMasks.set( key, channelMask, 1 );
+	return channelMask;
+}
+
+bool ChannelMaskPlug::channelEnabled( const IECore::BoolVectorData *channelMask, const std::string &channel )
+{
+	const std::vector<bool> &bits = channelMask->readable();
+	const size_t id = channelId( channel );
+	return id < bits.size() && bits[id];
+}
+
+size_t ChannelMaskPlug::channelId( const std::string &channel )
+{
+	{
+		ChannelIdMap::const_accessor a;
+		if( g_channelIds.find( a, channel ) )
+		{
+			return a->second;
+		}
+	}
+	
+	ChannelIdMap::accessor a;
+	if( g_channelIds.insert( a, channel ) )
+	{
+		a->second = g_nextChannelId++;
+	}
+	return a->second;
 }
 
 void ChannelMaskPlug::removeDuplicateIndices( std::vector<std::string> &inChannels )
@@ -102,20 +232,24 @@ void ChannelMaskPlug::removeDuplicateIndices( std::vector<std::string> &inChanne
 	}
 }
 
-int ChannelMaskPlug::channelIndex( std::string channel )
+int ChannelMaskPlug::channelIndex( const std::string &channel )
 {
-	// Strip from the channel string any layer information...
+	// Ignore any layer information at the start of the channel string...
 	size_t pos = channel.find_last_of(".");
-	if ( pos != std::string::npos )
+	pos = pos == std::string::npos ? 0 : pos + 1;
+	
+	///\todo: Replace this temporary code below with a lookup into a table of channels and their indexes
+	if( channel.size() - pos == 1 )
 	{
-		channel.erase( channel.begin(), channel.begin()+pos+1 );
+		switch( channel[pos] )
+		{
+			case 'R' : return 0;
+			case 'G' : return 1;
+			case 'B' : return 2;
+			case 'A' : return 3;
+			default : break;
+		}
 	}
-
-	///\todo: Replace this temporary code below with a lookup into a table of channels and their indexes
-	if ( channel == "R") return 0;
-	if ( channel == "G") return 1;
-	if ( channel == "B") return 2;
-	if ( channel == "A") return 3;
 	
 	return 0;
 }
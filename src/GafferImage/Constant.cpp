@@ -156,18 +156,6 @@ IECore::ConstStringVectorDataPtr Constant::computeChannelNames( const Gaffer::Co
 
 IECore::ConstFloatVectorDataPtr Constant::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	FloatVectorDataPtr resultData = new FloatVectorData;
-	vector<float> &result = resultData->writable();
-	result.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
-	
 	int idx = channelName == "R" ? 0 : channelName == "G" ? 1 : channelName == "B" ? 2 : 3;
-	const float v = colorPlug()->getValue()[idx];
-	
-	float *ptr = &result[0];
-	for( int i = 0; i < ImagePlug::tileSize() * ImagePlug::tileSize(); i++ )
-	{
-		*ptr++ = v;
-	}
-	
-	return resultData;
+	return ImagePlug::uniformTile( colorPlug()->getValue()[idx] );
 }
@@ -38,14 +38,21 @@
 #include "boost/bind/placeholders.hpp"
 #include "boost/lexical_cast.hpp"
 
+#include "tbb/spin_rw_mutex.h"
+#include "tbb/atomic.h"
+
 #include "IECore/LRUCache.h"
 #include "IECore/DisplayDriverServer.h"
 #include "IECore/ImageDisplayDriver.h"
 #include "IECore/MessageHandler.h"
+#include "IECore/BoxAlgo.h"
+
+#include "Gaffer/Context.h"
 
 #include "GafferImage/Display.h"
 
 using namespace std;
+using namespace Imath;
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferImage;
@@ -82,9 +89,19 @@ class GafferDisplayDriver : public IECore::ImageDisplayDriver
 
 		GafferDisplayDriver( const Imath::Box2i &displayWindow, const Imath::Box2i &dataWindow,
 			const vector<string> &channelNames, ConstCompoundDataPtr parameters )
-			:	ImageDisplayDriver( displayWindow, dataWindow, channelNames, parameters )
+			:	ImageDisplayDriver( displayWindow, dataWindow, channelNames, parameters ),
+				m_id( ++g_numDrivers ), m_displayWindow( displayWindow ), m_channelNames( new StringVectorData( channelNames ) )
 		{
 			m_parameters = parameters ? parameters->copy() : CompoundDataPtr( new CompoundData );
+			
+			// the display driver receives data in the y-down space of the renderer,
+			// whereas we work in the y-up space of GafferImage.
+			m_dataWindow = flip( dataWindow );
+			m_minTileOrigin = ImagePlug::tileOrigin( m_dataWindow.min );
+			const Imath::V2i numTiles = ( ImagePlug::tileOrigin( m_dataWindow.max ) - m_minTileOrigin ) / ImagePlug::tileSize() + Imath::V2i( 1 );
+			m_numTilesX = numTiles.x;
+			m_tileGenerations.resize( numTiles.x * numTiles.y, 0 );
+			
 			instanceCreatedSignal()( this );
 		}
 
@@ -99,10 +116,93 @@ class GafferDisplayDriver : public IECore::ImageDisplayDriver
 		
 		virtual void imageData( const Imath::Box2i &box, const float *data, size_t dataSize )
 		{
-			ImageDisplayDriver::imageData( box, data, dataSize );
+			{
+				Mutex::scoped_lock lock( m_mutex );
+				ImageDisplayDriver::imageData( box, data, dataSize );
+				
+				// bump the generation of each tile the bucket touches, so that
+				// only those tiles get new hashes.
+				const Imath::Box2i bound = IECore::boxIntersection( flip( box ), m_dataWindow );
+				const Imath::V2i minTileOrigin = ImagePlug::tileOrigin( bound.min );
+				const Imath::V2i maxTileOrigin = ImagePlug::tileOrigin( bound.max );
+				for( int y = minTileOrigin.y; y <= maxTileOrigin.y; y += ImagePlug::tileSize() )
+				{
+					for( int x = minTileOrigin.x; x <= maxTileOrigin.x; x += ImagePlug::tileSize() )
+					{
+						m_tileGenerations[tileIndex( Imath::V2i( x, y ) )]++;
+					}
+				}
+			}
 			dataReceivedSignal()( this, box );
 		}
 		
+		/// Returns a number uniquely identifying this driver.
+		size_t id() const
+		{
+			return m_id;
+		}
+		
+		/// Returns the display window in the space of the renderer.
+		const Imath::Box2i &displayWindow() const
+		{
+			return m_displayWindow;
+		}
+		
+		/// Returns the data window in the space of GafferImage.
+		const Imath::Box2i &dataWindow() const
+		{
+			return m_dataWindow;
+		}
+		
+		const StringVectorData *channelNames() const
+		{
+			return m_channelNames.get();
+		}
+		
+		/// Returns a number which is incremented every time data is received
+		/// for the specified tile.
+		unsigned tileGeneration( const Imath::V2i &tileOrigin ) const
+		{
+			Mutex::scoped_lock lock( m_mutex, false );
+			const int index = tileIndex( tileOrigin );
+			return index >= 0 ? m_tileGenerations[index] : 0;
+		}
+		
+		/// Copies a tile from the image held by the driver.
+		ConstFloatVectorDataPtr channelData( const std::string &channelName, const Imath::V2i &tileOrigin ) const
+		{
+			const int tileSize = ImagePlug::tileSize();
+			const Imath::Box2i tileBound( tileOrigin, tileOrigin + Imath::V2i( tileSize - 1 ) );
+			const Imath::Box2i bound = IECore::boxIntersection( tileBound, m_dataWindow );
+			if( bound.isEmpty() )
+			{
+				return ImagePlug::blackTile();
+			}
+			
+			FloatVectorDataPtr resultData = new FloatVectorData;
+			std::vector<float> &result = resultData->writable();
+			result.resize( tileSize * tileSize, 0.0f );
+			
+			Mutex::scoped_lock lock( m_mutex, false );
+			
+			ConstFloatVectorDataPtr channelData = image()->getChannel<float>( channelName );
+			if( !channelData )
+			{
+				return ImagePlug::blackTile();
+			}
+			const std::vector<float> &channel = channelData->readable();
+			
+			const int dataWidth = m_dataWindow.size().x + 1;
+			for( int y = bound.min.y; y <= bound.max.y; y++ )
+			{
+				const float *src = &channel[( m_dataWindow.max.y - y ) * dataWidth + bound.min.x - m_dataWindow.min.x];
+				float *dst = &result[( y - tileBound.min.y ) * tileSize + bound.min.x - tileBound.min.x];
+				std::copy( src, src + bound.size().x + 1, dst );
+			}
+			
+			return resultData;
+		}
+		
 		virtual void imageClose()
 		{
 			ImageDisplayDriver::imageClose();
@@ -130,7 +230,42 @@ class GafferDisplayDriver : public IECore::ImageDisplayDriver
 
 	private :
 	
+		// Converts a box between the y-down space of the renderer and
+		// the y-up space of GafferImage (or vice versa).
+		Imath::Box2i flip( const Imath::Box2i &box ) const
+		{
+			return Imath::Box2i(
+				Imath::V2i( box.min.x, m_displayWindow.max.y - box.max.y ),
+				Imath::V2i( box.max.x, m_displayWindow.max.y - box.min.y )
+			);
+		}
+		
+		int tileIndex( const Imath::V2i &tileOrigin ) const
+		{
+			const Imath::V2i t = ( tileOrigin - m_minTileOrigin ) / ImagePlug::tileSize();
+			if( t.x < 0 || t.y < 0 || t.x >= m_numTilesX )
+			{
+				return -1;
+			}
+			const size_t index = t.y * m_numTilesX + t.x;
+			return index < m_tileGenerations.size() ? index : -1;
+		}
+	
 		static const DisplayDriverDescription<GafferDisplayDriver> g_description;
+		static tbb::atomic<size_t> g_numDrivers;
+		
+		const size_t m_id;
+		const Imath::Box2i m_displayWindow;
+		Imath::Box2i m_dataWindow;
+		ConstStringVectorDataPtr m_channelNames;
+		
+		// protects the image buffer and the tile generations, as the
+		// data arrives on the server thread but is read on compute threads.
+		typedef tbb::spin_rw_mutex Mutex;
+		mutable Mutex m_mutex;
+		Imath::V2i m_minTileOrigin;
+		int m_numTilesX;
+		std::vector<unsigned> m_tileGenerations;
 
 		IECore::ConstCompoundDataPtr m_parameters;
 		DataReceivedSignal m_dataReceivedSignal;
@@ -139,6 +274,7 @@ class GafferDisplayDriver : public IECore::ImageDisplayDriver
 };
 
 const DisplayDriver::DisplayDriverDescription<GafferDisplayDriver> GafferDisplayDriver::g_description;
+tbb::atomic<size_t> GafferDisplayDriver::g_numDrivers;
 
 } // namespace GafferImage
 
@@ -188,6 +324,13 @@ Display::Display( const std::string &name )
 	// we don't want caching for the output image, because we're basically
 	// caching the whole thing internally ourselves anyway.
 	imagePrimitivePlug()->setFlags( Plug::Cacheable, false );
+	// but we do want caching for the channel data, because the tile hashes
+	// only change when new data arrives for them, and this saves downstream
+	// nodes from recomputing the tiles which haven't changed.
+	if( !halfTileStorage() )
+	{
+		outPlug()->channelDataPlug()->setFlags( Plug::Cacheable, true );
+	}
 		
 	plugSetSignal().connect( boost::bind( &Display::plugSet, this, ::_1 ) );
 	GafferDisplayDriver::instanceCreatedSignal().connect( boost::bind( &Display::driverCreated, this, ::_1 ) );
@@ -253,6 +396,96 @@ IECore::ConstImagePrimitivePtr Display::computeImagePrimitive( const Gaffer::Con
 	return m_driver ? m_driver->image() : 0;
 }
 
+void Display::hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		ImagePrimitiveNode::hashFormatPlug( output, context, h );
+		return;
+	}
+	h.append( (uint64_t)driver->id() );
+}
+
+void Display::hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		ImagePrimitiveNode::hashChannelNamesPlug( output, context, h );
+		return;
+	}
+	h.append( (uint64_t)driver->id() );
+}
+
+void Display::hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		ImagePrimitiveNode::hashDataWindowPlug( output, context, h );
+		return;
+	}
+	h.append( (uint64_t)driver->id() );
+}
+
+void Display::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		ImagePrimitiveNode::hashChannelDataPlug( output, context, h );
+		return;
+	}
+	
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	h.append( (uint64_t)driver->id() );
+	h.append( context->get<std::string>( ImagePlug::channelNameContextName ) );
+	h.append( tileOrigin );
+	h.append( driver->tileGeneration( tileOrigin ) );
+}
+
+GafferImage::Format Display::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		return ImagePrimitiveNode::computeFormat( context, parent );
+	}
+	const Box2i &displayWindow = driver->displayWindow();
+	return GafferImage::Format( displayWindow.size().x + 1, displayWindow.size().y + 1 );
+}
+
+Imath::Box2i Display::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		return ImagePrimitiveNode::computeDataWindow( context, parent );
+	}
+	return driver->dataWindow();
+}
+
+IECore::ConstStringVectorDataPtr Display::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		return ImagePrimitiveNode::computeChannelNames( context, parent );
+	}
+	return driver->channelNames();
+}
+
+IECore::ConstFloatVectorDataPtr Display::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	GafferDisplayDriverPtr driver = m_driver;
+	if( !driver )
+	{
+		return ImagePrimitiveNode::computeChannelData( channelName, tileOrigin, context, parent );
+	}
+	return driver->channelData( channelName, tileOrigin );
+}
+
 void Display::plugSet( Gaffer::Plug *plug )
 {
 	if( plug == portPlug() )
@@ -130,11 +130,26 @@ void FilterProcessor::hashChannelNamesPlug( const GafferImage::ImagePlug *output
 
 void FilterProcessor::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
+	const Imath::V2i tileOrigin = context->get<Imath::V2i>( ImagePlug::tileOriginContextName );
 	const ImagePlugList& inputs( m_inputs.inputs() );
 	const ImagePlugList::const_iterator end( m_inputs.endIterator() );
 	for( ImagePlugList::const_iterator it( inputs.begin() ); it != end; it++ )
 	{
-		if ( (*it)->getInput<ValuePlug>() )	(*it)->channelDataPlug()->hash( h );
+		if ( !(*it)->getInput<ValuePlug>() )
+		{
+			continue;
+		}
+		
+		// Inputs which don't cover the tile are known to be black there,
+		// so we don't need to ask them for a hash.
+		if ( tileOutsideDataWindow( tileOrigin, (*it)->dataWindowPlug()->getValue() ) )
+		{
+			h.append( blackTileHash() );
+		}
+		else
+		{
+			(*it)->channelDataPlug()->hash( h );
+		}
 	}
 }
 
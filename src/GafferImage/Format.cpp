@@ -44,11 +44,15 @@
 #include "GafferImage/TypeIds.h"
 #include "IECore/TypedData.inl"
 #include "IECore/MurmurHash.h"
+#include "IECore/MessageHandler.h"
 #include "Gaffer/ApplicationRoot.h"
 #include "boost/format.hpp"
 #include "boost/foreach.hpp"
 #include "boost/bind.hpp"
 
+#include "tbb/spin_rw_mutex.h"
+#include "tbb/concurrent_queue.h"
+
 using namespace Gaffer;
 using namespace GafferImage;
 
@@ -109,6 +113,18 @@ namespace IECore
 	template class TypedData< Format >;
 };
 
+namespace
+{
+
+typedef tbb::spin_rw_mutex FormatMapMutex;
+FormatMapMutex g_formatMapMutex;
+
+// Notifications queued by registerFormatDeferred(), waiting for
+// emitPendingSignals() to be called on the main thread.
+tbb::concurrent_queue<std::string> g_pendingFormatNames;
+
+} // namespace
+
 Format::FormatMap &Format::formatMap()
 {
 	static Format::FormatMap map;
@@ -123,6 +139,8 @@ std::ostream& GafferImage::operator<<(std::ostream& os, GafferImage::Format cons
 
 void Format::formatNames( std::vector< std::string > &names )
 {
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex, false );
+
 	names.clear();
 	names.reserve( formatMap().size() );
 	
@@ -135,14 +153,18 @@ void Format::formatNames( std::vector< std::string > &names )
 
 std::string Format::formatName( const Format &format )
 {
-	FormatMap::iterator it( formatMap().begin() );
-	FormatMap::iterator end( formatMap().end() );
-	
-	for (; it != end; ++it)
 	{
-		if ( format == (*it).second )
+		FormatMapMutex::scoped_lock lock( g_formatMapMutex, false );
+		
+		FormatMap::iterator it( formatMap().begin() );
+		FormatMap::iterator end( formatMap().end() );
+		
+		for (; it != end; ++it)
 		{
-			return (*it).first;
+			if ( format == (*it).second )
+			{
+				return (*it).first;
+			}
 		}
 	}
 	
@@ -152,23 +174,57 @@ std::string Format::formatName( const Format &format )
 	return name;
 }
 
-const Format &Format::registerFormat( const Format &format, const std::string &name )
+const Format &Format::insertFormat( const Format &format, const std::string &name, bool &inserted )
 {
-	FormatMap::iterator it( formatMap().begin() );
-	FormatMap::iterator end( formatMap().end() );
+	inserted = false;
 	
-	for (; it != end; ++it)
+	// The common case is that the format is registered already, so we
+	// first search with a reader lock, allowing concurrent lookups.
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex, false );
+	while( true )
 	{
-		if ( format == (*it).second )
+		FormatMap::iterator it( formatMap().begin() );
+		FormatMap::iterator end( formatMap().end() );
+		
+		for (; it != end; ++it)
+		{
+			if ( format == (*it).second )
+			{
+				return (*it).second;
+			}
+		}
+		
+		if( lock.upgrade_to_writer() )
 		{
-			return (*it).second;
+			// we were upgraded without releasing the lock,
+			// so we know the search above is still valid.
+			break;
 		}
+		// we had to release the lock to upgrade, so another thread
+		// may have registered the format in the meantime. search again.
 	}
 	
-	formatMap().insert( FormatEntry( name, format ) );
-	formatAddedSignal()( name );
-	
-	return format;
+	std::pair<FormatMap::iterator, bool> r = formatMap().insert( FormatEntry( name, format ) );
+	inserted = r.second;
+	return r.first->second;
+}
+
+const Format &Format::registerFormat( const Format &format, const std::string &name )
+{
+	bool inserted = false;
+	const Format &result = insertFormat( format, name, inserted );
+	if( inserted )
+	{
+		formatAddedSignal()( name );
+	}
+	else if( !( result == format ) )
+	{
+		IECore::msg(
+			IECore::Msg::Warning, "Format::registerFormat",
+			boost::format( "Format name \"%s\" is already in use by a different format." ) % name
+		);
+	}
+	return result;
 }
 
 const Format &Format::registerFormat( const Format &format )
@@ -178,23 +234,58 @@ const Format &Format::registerFormat( const Format &format )
 	return registerFormat( format, name );
 }
 
+const Format &Format::registerFormatDeferred( const Format &format )
+{
+	std::string name;
+	generateFormatName( name, format );
+	
+	bool inserted = false;
+	const Format &result = insertFormat( format, name, inserted );
+	if( inserted )
+	{
+		// we may be on any thread, so we mustn't emit signals
+		// (and thereby call into python) ourselves.
+		g_pendingFormatNames.push( name );
+	}
+	return result;
+}
+
+void Format::emitPendingSignals()
+{
+	std::string name;
+	while( g_pendingFormatNames.try_pop( name ) )
+	{
+		formatAddedSignal()( name );
+	}
+}
+
 void Format::removeFormat( const Format &format )
 {
-	FormatMap::iterator it( formatMap().begin() );
-	FormatMap::iterator end( formatMap().end() );
-	for (; it != end; ++it)
+	std::string name;
 	{
-		if ( format == (*it).second )
+		FormatMapMutex::scoped_lock lock( g_formatMapMutex );
+		FormatMap::iterator it( formatMap().begin() );
+		FormatMap::iterator end( formatMap().end() );
+		for (; it != end; ++it)
 		{
-			formatRemovedSignal()( (*it).first );
-			formatMap().erase( it );
-			return;
+			if ( format == (*it).second )
+			{
+				name = (*it).first;
+				formatMap().erase( it );
+				break;
+			}
 		}
 	}
+	
+	if( name.size() )
+	{
+		formatRemovedSignal()( name );
+	}
 }
 
 void Format::removeFormat( const std::string &name )
 {
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex );
 	formatMap().erase( name );
 }
 
@@ -212,6 +303,7 @@ Format::UnaryFormatSignal &Format::formatRemovedSignal()
 
 const Format &Format::getFormat( const std::string &name )
 {
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex, false );
 	FormatMap::iterator it( formatMap().find( name ) );
 	
 	if ( it == formatMap().end() )
@@ -263,11 +355,13 @@ const Format Format::getDefaultFormat( ScriptNode *scriptNode )
 
 void Format::removeAllFormats()
 {
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex );
 	formatMap().clear();
 }
 
 int Format::formatCount()
 {
+	FormatMapMutex::scoped_lock lock( g_formatMapMutex, false );
 	return formatMap().size();
 }
 
@@ -232,46 +232,92 @@ void Grade::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaf
 	whiteClampPlug()->hash( h );
 }
 
-void Grade::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, FloatVectorDataPtr outData ) const
+namespace
 {
-	// Calculate the valid data window that we are to merge.
-	const int dataWidth = ImagePlug::tileSize()*ImagePlug::tileSize();
-
-	// Do some pre-processing.
-	int channelIndex = ChannelMaskPlug::channelIndex( channel );
-	const float gamma = gammaPlug()->getValue()[channelIndex];
-	const float invGamma = 1. / gamma;	
-	const float multiply = multiplyPlug()->getValue()[channelIndex];
-	const float gain = gainPlug()->getValue()[channelIndex];
-	const float lift = liftPlug()->getValue()[channelIndex];
-	const float whitePoint = whitePointPlug()->getValue()[channelIndex];
-	const float blackPoint = blackPointPlug()->getValue()[channelIndex];
-	const float offset = offsetPlug()->getValue()[channelIndex];
-	const bool whiteClamp = whiteClampPlug()->getValue();	
-	const bool blackClamp = blackClampPlug()->getValue();	
-
-	const float A = multiply * ( gain - lift ) / ( whitePoint - blackPoint );
-	const float B = offset + lift - A * blackPoint;
-
-	// Get some useful pointers.	
-	float *outPtr = &(outData->writable()[0]);
-	const float *END = outPtr + dataWidth;
 
-	while (outPtr != END)
+// The per-pixel grading operation, with the plug values for
+// a particular channel baked in.
+struct GradeFunctor
+{
+
+	GradeFunctor( const Grade *grade, const std::string &channel )
+	{
+		int channelIndex = ChannelMaskPlug::channelIndex( channel );
+		const float gamma = grade->gammaPlug()->getValue()[channelIndex];
+		const float multiply = grade->multiplyPlug()->getValue()[channelIndex];
+		const float gain = grade->gainPlug()->getValue()[channelIndex];
+		const float lift = grade->liftPlug()->getValue()[channelIndex];
+		const float whitePoint = grade->whitePointPlug()->getValue()[channelIndex];
+		const float blackPoint = grade->blackPointPlug()->getValue()[channelIndex];
+		const float offset = grade->offsetPlug()->getValue()[channelIndex];
+		
+		invGamma = 1. / gamma;	
+		whiteClamp = grade->whiteClampPlug()->getValue();	
+		blackClamp = grade->blackClampPlug()->getValue();	
+		A = multiply * ( gain - lift ) / ( whitePoint - blackPoint );
+		B = offset + lift - A * blackPoint;
+	}
+
+	inline float operator()( float colour ) const
 	{
 		// Calculate the colour of the graded pixel.
-		float colour = *outPtr;	// As the input has been copied to outData, grab the input colour from there.
 		const float c = A * colour + B;
 		colour = ( c >= 0.f && invGamma != 1.f ? (float)pow( c, invGamma ) : c );
 
 		// Clamp the white and blacks if necessary.
 		if ( blackClamp && colour < 0.f ) colour = 0.f;
 		if ( whiteClamp && colour > 1.f ) colour = 1.f;
+		
+		return colour;
+	}
+
+	float A;
+	float B;
+	float invGamma;
+	bool blackClamp;
+	bool whiteClamp;
 
-		// Write back the result.
-		*outPtr++ = colour;	
+};
+
+// Templated on the tile size so that the loop length is known at compile
+// time, and the compiler is free to unroll and vectorise it.
+template<int TileSize>
+void gradeTile( float *outPtr, const GradeFunctor &grade )
+{
+	// As the input has been copied to outData, we grab the input colour from there.
+	const float *END = outPtr + TileSize * TileSize;
+	while (outPtr != END)
+	{
+		*outPtr = grade( *outPtr );
+		++outPtr;
+	}
+}
+
+} // namespace
+
+void Grade::processChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, FloatVectorDataPtr outData ) const
+{
+	const GradeFunctor grade( this, channel );
+	float *outPtr = &(outData->writable()[0]);
+	switch( ImagePlug::tileSize() )
+	{
+		case 128 :
+			gradeTile<128>( outPtr, grade );
+			break;
+		case 256 :
+			gradeTile<256>( outPtr, grade );
+			break;
+		default :
+			gradeTile<64>( outPtr, grade );
+			break;
 	}
 }
 
+bool Grade::processUniformChannelData( const Gaffer::Context *context, const ImagePlug *parent, const std::string &channel, float &value ) const
+{
+	value = GradeFunctor( this, channel )( value );
+	return true;
+}
+
 } // namespace GafferImage
 
@@ -35,6 +35,19 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "OpenImageIO/imageio.h"
+OIIO_NAMESPACE_USING
+
+#include "IECore/LRUCache.h"
+#include "IECore/VectorTypedData.h"
+#include "IECore/SimpleTypedData.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferImage/ImageNode.h"
@@ -45,6 +58,171 @@ using namespace IECore;
 using namespace GafferImage;
 using namespace Gaffer;
 
+//////////////////////////////////////////////////////////////////////////
+// Half precision tile cache
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+bool initialHalfTileStorage()
+{
+	const char *halfTiles = getenv( "GAFFERIMAGE_HALFTILES" );
+	return halfTiles && !strcmp( halfTiles, "1" );
+}
+
+const bool g_halfTileStorage = initialHalfTileStorage();
+
+// We compute tiles ourselves in computeImagePlugs() and set() them in the
+// caches, so the getters just report a miss by returning 0. This means a
+// tile can be looked up with a single call to get(), even if it is evicted
+// by another thread in the meantime.
+template<typename Ptr>
+Ptr missingTileGetter( const MurmurHash &h, size_t &cost )
+{
+	cost = 0;
+	return 0;
+}
+
+// Holds HalfVectorData for regular tiles, and FloatData for uniform tiles,
+// which we store at full precision so they can be reconstituted exactly.
+typedef LRUCache<MurmurHash, ConstDataPtr> HalfTileCache;
+
+// The total memory limit, shared between the half and float tile caches.
+const size_t g_defaultTileCacheMemoryLimit = 1024 * 1024 * 500;
+
+size_t floatTileCacheMemoryLimit( size_t totalLimit )
+{
+	return totalLimit / 4;
+}
+
+HalfTileCache &halfTileCache()
+{
+	static HalfTileCache g_halfTileCache(
+		missingTileGetter<ConstDataPtr>,
+		g_defaultTileCacheMemoryLimit - floatTileCacheMemoryLimit( g_defaultTileCacheMemoryLimit )
+	);
+	return g_halfTileCache;
+}
+
+// Converting a tile from half to float on every fetch would be a significant
+// cost for tiles which are fetched repeatedly, so we keep the most recently
+// used tiles at full precision too, in a smaller cache in front of the half
+// tile cache.
+typedef LRUCache<MurmurHash, ConstFloatVectorDataPtr> FloatTileCache;
+
+FloatTileCache &floatTileCache()
+{
+	static FloatTileCache g_floatTileCache(
+		missingTileGetter<ConstFloatVectorDataPtr>,
+		floatTileCacheMemoryLimit( g_defaultTileCacheMemoryLimit )
+	);
+	return g_floatTileCache;
+}
+
+HalfVectorDataPtr floatToHalf( const FloatVectorData *floatData )
+{
+	const vector<float> &floatTile = floatData->readable();
+	HalfVectorDataPtr halfData = new HalfVectorData;
+	vector<half> &halfTile = halfData->writable();
+	halfTile.resize( floatTile.size() );
+	convert_types( TypeDesc::FLOAT, &floatTile[0], TypeDesc::HALF, &halfTile[0], floatTile.size() );
+	return halfData;
+}
+
+FloatVectorDataPtr halfToFloat( const HalfVectorData *halfData )
+{
+	const vector<half> &halfTile = halfData->readable();
+	FloatVectorDataPtr floatData = new FloatVectorData;
+	vector<float> &floatTile = floatData->writable();
+	floatTile.resize( halfTile.size() );
+	convert_types( TypeDesc::HALF, &halfTile[0], TypeDesc::FLOAT, &floatTile[0], halfTile.size() );
+	return floatData;
+}
+
+// Records the tiles output by computeImagePlugs() while computing another
+// tile on the same thread. If computeChannelData() returns one of them then
+// the node is passing through an upstream tile which has been stored already,
+// and storing it again under our own hash would just duplicate it. We hold
+// references to the tiles so that a new tile can't be allocated at the address
+// of a freed one and be mistaken for it.
+class UpstreamTiles
+{
+
+	public :
+
+		UpstreamTiles()
+			:	m_stack( g_stacks.local() )
+		{
+			m_stack.push_back( this );
+		}
+
+		~UpstreamTiles()
+		{
+			m_stack.pop_back();
+		}
+
+		bool contains( const FloatVectorData *tile ) const
+		{
+			for( vector<ConstFloatVectorDataPtr>::const_iterator it = m_tiles.begin(), eIt = m_tiles.end(); it != eIt; ++it )
+			{
+				if( it->get() == tile )
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static void tileOutput( ConstFloatVectorDataPtr tile )
+		{
+			Stack &stack = g_stacks.local();
+			if( !stack.empty() )
+			{
+				stack.back()->m_tiles.push_back( tile );
+			}
+		}
+
+	private :
+
+		typedef vector<UpstreamTiles *> Stack;
+		static tbb::enumerable_thread_specific<Stack> g_stacks;
+
+		Stack &m_stack;
+		vector<ConstFloatVectorDataPtr> m_tiles;
+
+};
+
+tbb::enumerable_thread_specific<UpstreamTiles::Stack> UpstreamTiles::g_stacks;
+
+} // namespace
+
+bool ImageNode::halfTileStorage()
+{
+	return g_halfTileStorage;
+}
+
+size_t ImageNode::getHalfTileCacheMemoryLimit()
+{
+	return halfTileCache().getMaxCost() + floatTileCache().getMaxCost();
+}
+
+void ImageNode::setHalfTileCacheMemoryLimit( size_t bytes )
+{
+	const size_t floatLimit = floatTileCacheMemoryLimit( bytes );
+	halfTileCache().setMaxCost( bytes - floatLimit );
+	floatTileCache().setMaxCost( floatLimit );
+}
+
+size_t ImageNode::halfTileCacheMemoryUsage()
+{
+	return halfTileCache().currentCost() + floatTileCache().currentCost();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ImageNode implementation
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( ImageNode );
 
 size_t ImageNode::g_firstPlugIndex = 0;
@@ -55,6 +233,12 @@ ImageNode::ImageNode( const std::string &name )
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new ImagePlug( "out", Gaffer::Plug::Out ) );
 	addChild( new BoolPlug( "enabled", Gaffer::Plug::In, true ) );
+	
+	if( halfTileStorage() )
+	{
+		// we cache the channel data ourselves in computeImagePlugs().
+		outPlug()->channelDataPlug()->setFlags( Plug::Cacheable, false );
+	}
 }
 
 ImageNode::~ImageNode()
@@ -168,12 +352,92 @@ void ImageNode::computeImagePlugs( ValuePlug *output, const Context *context ) c
 		{
 			throw Exception( "The image:tileOrigin must be a multiple of ImagePlug::tileSize()" );
 		}
-		static_cast<FloatVectorDataPlug *>( output )->setValue(
-			computeChannelData( channelName, tileOrigin, context, imagePlug )
-		);
+		
+		if( !halfTileStorage() )
+		{
+			static_cast<FloatVectorDataPlug *>( output )->setValue(
+				computeChannelData( channelName, tileOrigin, context, imagePlug )
+			);
+			return;
+		}
+		
+		if( !useHalfTileCache() )
+		{
+			ConstFloatVectorDataPtr floatData = computeChannelData( channelName, tileOrigin, context, imagePlug );
+			UpstreamTiles::tileOutput( floatData );
+			static_cast<FloatVectorDataPlug *>( output )->setValue( floatData );
+			return;
+		}
+		
+		// Use the tile caches. As with the ValuePlug cache, there is
+		// a window between looking up a tile and setting it in which
+		// another thread may compute the same tile.
+		const MurmurHash hash = output->hash();
+		FloatTileCache &floatCache = floatTileCache();
+		HalfTileCache &halfCache = halfTileCache();
+		
+		ConstFloatVectorDataPtr floatData = floatCache.get( hash );
+		if( !floatData )
+		{
+			if( ConstDataPtr cachedData = halfCache.get( hash ) )
+			{
+				if( const FloatData *uniformData = runTimeCast<const FloatData>( cachedData.get() ) )
+				{
+					floatData = ImagePlug::uniformTile( uniformData->readable() );
+				}
+				else
+				{
+					floatData = halfToFloat( static_cast<const HalfVectorData *>( cachedData.get() ) );
+				}
+				floatCache.set( hash, floatData, floatData->memoryUsage() );
+			}
+			else
+			{
+				bool passThrough = false;
+				{
+					UpstreamTiles upstreamTiles;
+					floatData = computeChannelData( channelName, tileOrigin, context, imagePlug );
+					passThrough = upstreamTiles.contains( floatData.get() );
+				}
+				
+				if( passThrough )
+				{
+					// the tile is stored upstream already, so we just remove
+					// the empty entries left behind by our lookups.
+					floatCache.erase( hash );
+					halfCache.erase( hash );
+				}
+				else
+				{
+					float uniformValue;
+					if( ImagePlug::isUniformTile( floatData.get(), uniformValue ) )
+					{
+						DataPtr uniformData = new FloatData( uniformValue );
+						halfCache.set( hash, uniformData, uniformData->memoryUsage() );
+					}
+					else
+					{
+						// we output the tile at the precision it is stored, so that
+						// the result doesn't depend on whether or not it was cached.
+						HalfVectorDataPtr halfData = floatToHalf( floatData.get() );
+						halfCache.set( hash, halfData, halfData->memoryUsage() );
+						floatData = halfToFloat( halfData.get() );
+					}
+					floatCache.set( hash, floatData, floatData->memoryUsage() );
+				}
+			}
+		}
+		
+		UpstreamTiles::tileOutput( floatData );
+		static_cast<FloatVectorDataPlug *>( output )->setValue( floatData );
 	}
 }
 
+bool ImageNode::useHalfTileCache() const
+{
+	return halfTileStorage();
+}
+
 void ImageNode::compute( ValuePlug *output, const Context *context ) const
 {
 	ImagePlug *imagePlug = output->ancestor<ImagePlug>();
@@ -35,12 +35,19 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <cstdlib>
+#include <cstring>
+
+#include "boost/format.hpp"
+
 #include "tbb/tbb.h"
 #include "IECore/Exception.h"
 #include "IECore/BoxOps.h"
 #include "IECore/BoxAlgo.h"
+#include "IECore/MessageHandler.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
 
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/FormatPlug.h"
@@ -96,6 +103,7 @@ class CopyTiles
 			{
 				for( int tileOriginX = minTileOrigin.x; tileOriginX <= maxTileOrigin.x; tileOriginX += m_tileSize )
 				{
+					Canceller::check( context->canceller() );
 					for( vector<string>::const_iterator it = m_channelNames.begin(), eIt = m_channelNames.end(); it != eIt; it++ )
 					{
 						context->set( ImagePlug::channelNameContextName, *it );
@@ -141,6 +149,26 @@ const IECore::InternedString ImagePlug::tileOriginContextName = "image:tileOrigi
 
 size_t ImagePlug::g_firstPlugIndex = 0;
 
+static int initialTileSize()
+{
+	const char *tileSize = getenv( "GAFFERIMAGE_TILESIZE" );
+	if( !tileSize )
+	{
+		return 64;
+	}
+	
+	const int result = atoi( tileSize );
+	if( result != 64 && result != 128 && result != 256 )
+	{
+		IECore::msg( IECore::Msg::Warning, "ImagePlug::tileSize", boost::format( "Unsupported GAFFERIMAGE_TILESIZE \"%s\" - using 64 instead." ) % tileSize );
+		return 64;
+	}
+	
+	return result;
+}
+
+const int ImagePlug::g_tileSize = initialTileSize();
+
 ImagePlug::ImagePlug( const std::string &name, Direction direction, unsigned flags )
 	:	CompoundPlug( name, direction, flags )
 {
@@ -202,16 +230,91 @@ ImagePlug::~ImagePlug()
 
 const IECore::FloatVectorData *ImagePlug::whiteTile()
 {
-	static IECore::ConstFloatVectorDataPtr g_whiteTile( new IECore::FloatVectorData( std::vector<float>( ImagePlug::tileSize()*ImagePlug::tileSize(), 1. ) ) );
+	static IECore::ConstFloatVectorDataPtr g_whiteTile( uniformTile( 1.0f ) );
 	return g_whiteTile.get();
 };
 
 const IECore::FloatVectorData *ImagePlug::blackTile()
 {
-	static IECore::ConstFloatVectorDataPtr g_blackTile( new IECore::FloatVectorData( std::vector<float>( ImagePlug::tileSize()*ImagePlug::tileSize(), 0. ) ) );
+	static IECore::ConstFloatVectorDataPtr g_blackTile( uniformTile( 0.0f ) );
 	return g_blackTile.get();
 };
 
+namespace
+{
+
+// Uniform tiles are stored by the bit pattern of their value, so that
+// even NaNs and negative zeroes map to a tile of their own.
+typedef concurrent_hash_map<unsigned int, ConstFloatVectorDataPtr> UniformTiles;
+
+UniformTiles &uniformTiles()
+{
+	static UniformTiles g_uniformTiles;
+	return g_uniformTiles;
+}
+
+unsigned int uniformTileKey( float value )
+{
+	unsigned int result;
+	memcpy( &result, &value, sizeof( result ) );
+	return result;
+}
+
+// We don't want a stream of arbitrary values to fill memory with tiles
+// that are never freed, so we stop sharing new values once the tiles
+// we hold reach this size.
+const size_t g_maxUniformTilesMemory = 64 * 1024 * 1024;
+
+} // namespace
+
+IECore::ConstFloatVectorDataPtr ImagePlug::uniformTile( float value )
+{
+	UniformTiles &tiles = uniformTiles();
+	const unsigned int key = uniformTileKey( value );
+	
+	{
+		UniformTiles::const_accessor readAccessor;
+		if( tiles.find( readAccessor, key ) )
+		{
+			return readAccessor->second;
+		}
+	}
+
+	ConstFloatVectorDataPtr tile = new FloatVectorData( std::vector<float>( tileSize() * tileSize(), value ) );
+	if( tiles.size() * tileSize() * tileSize() * sizeof( float ) >= g_maxUniformTilesMemory )
+	{
+		return tile;
+	}
+
+	UniformTiles::accessor writeAccessor;
+	if( tiles.insert( writeAccessor, key ) )
+	{
+		writeAccessor->second = tile;
+		// the tile will be held by the registry forever, so
+		// there's no need for the cache to charge for it.
+		ValuePlug::registerPermanentValue( tile );
+	}
+	return writeAccessor->second;
+}
+
+bool ImagePlug::isUniformTile( const IECore::FloatVectorData *tile, float &value )
+{
+	const std::vector<float> &v = tile->readable();
+	if( v.empty() )
+	{
+		return false;
+	}
+	
+	UniformTiles::const_accessor accessor;
+	if( !uniformTiles().find( accessor, uniformTileKey( v[0] ) ) || accessor->second.get() != tile )
+	{
+		return false;
+	}
+	
+	value = v[0];
+	return true;
+}
+
 bool ImagePlug::acceptsChild( const GraphComponent *potentialChild ) const
 {
 	return children().size() != 4;
@@ -355,6 +458,7 @@ IECore::MurmurHash ImagePlug::imageHash() const
 		{
 			for( int tileOriginX = minTileOrigin.x; tileOriginX<=maxTileOrigin.x; tileOriginX += tileSize() )
 			{
+				Canceller::check( context->canceller() );
 				for( vector<string>::const_iterator it = channelNames.begin(), eIt = channelNames.end(); it!=eIt; it++ )
 				{
 					context->set( ImagePlug::channelNameContextName, *it );
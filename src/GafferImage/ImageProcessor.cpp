@@ -35,12 +35,16 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/atomic.h"
+
 #include "GafferImage/ImageProcessor.h"
 #include "Gaffer/Context.h"
 
 using namespace Gaffer;
 using namespace GafferImage;
 
+static tbb::atomic<size_t> g_tilesSkipped;
+
 IE_CORE_DEFINERUNTIMETYPED( ImageProcessor );
 
 size_t ImageProcessor::g_firstPlugIndex = 0;
@@ -86,6 +90,32 @@ const Plug *ImageProcessor::correspondingInput( const Plug *output ) const
 	return ImageNode::correspondingInput( output );
 }
 
+size_t ImageProcessor::tilesSkipped()
+{
+	return g_tilesSkipped;
+}
+
+void ImageProcessor::resetTilesSkipped()
+{
+	g_tilesSkipped = 0;
+}
+
+void ImageProcessor::tileSkipped()
+{
+	++g_tilesSkipped;
+}
+
+bool ImageProcessor::tileOutsideDataWindow( const Imath::V2i &tileOrigin, const Imath::Box2i &dataWindow )
+{
+	return !ImagePlug::tileBound( tileOrigin ).intersects( dataWindow );
+}
+
+const IECore::MurmurHash &ImageProcessor::blackTileHash()
+{
+	static IECore::MurmurHash g_blackTileHash = ImagePlug::blackTile()->Object::hash();
+	return g_blackTileHash;
+}
+
 void ImageProcessor::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	/// \todo Can this be simplified using the same logic used in SceneProcessor::hash()? It would
@@ -104,7 +134,11 @@ void ImageProcessor::hash( const Gaffer::ValuePlug *output, const Gaffer::Contex
 		if( output == imagePlug->channelDataPlug() )
 		{
 			const std::string &channel = context->get<std::string>( ImagePlug::channelNameContextName );
-			if ( channelEnabled( channel ) )
+			if ( tileOutsideDataWindow( context->get<Imath::V2i>( ImagePlug::tileOriginContextName ), imagePlug->dataWindowPlug()->getValue() ) )
+			{
+				h = blackTileHash();
+			}
+			else if ( channelEnabled( channel ) )
 			{
 				hashChannelDataPlug( imagePlug, context, h );
 				h.append( context->get<std::string>( ImagePlug::channelNameContextName ) );
@@ -161,7 +195,12 @@ void ImageProcessor::compute( ValuePlug *output, const Context *context ) const
 			if( output == imagePlug->channelDataPlug() )
 			{
 				const std::string &channel = context->get<std::string>( ImagePlug::channelNameContextName );
-				if ( channelEnabled( channel ) )
+				if ( tileOutsideDataWindow( context->get<Imath::V2i>( ImagePlug::tileOriginContextName ), imagePlug->dataWindowPlug()->getValue() ) )
+				{
+					tileSkipped();
+					static_cast<FloatVectorDataPlug *>( output )->setValue( ImagePlug::blackTile() );
+				}
+				else if ( channelEnabled( channel ) )
 				{
 					computeImagePlugs( output, context );
 				}
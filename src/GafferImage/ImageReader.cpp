@@ -66,11 +66,40 @@ static ImageCache *imageCache()
 		if( lock.upgrade_to_writer() )
 		{
 			cache = ImageCache::create();
+			// Keep tiles in the native format of the file, so that half
+			// float images take half the memory. They are converted to
+			// float as we fetch them in computeChannelData().
+			cache->attribute( "forcefloat", 0 );
 		}
 	}
 	return cache;
 }
 
+// Returns the spec for the requested mip level, clamping the level to those
+// available in the file.
+static const ImageSpec *imageSpec( ustring fileName, int mipLevel, int &actualMipLevel )
+{
+	actualMipLevel = 0;
+	const ImageSpec *spec = imageCache()->imagespec( fileName, 0, 0 );
+	while( spec && actualMipLevel < mipLevel )
+	{
+		const ImageSpec *levelSpec = imageCache()->imagespec( fileName, 0, actualMipLevel + 1 );
+		if( !levelSpec )
+		{
+			break;
+		}
+		spec = levelSpec;
+		actualMipLevel++;
+	}
+	return spec;
+}
+
+static const ImageSpec *imageSpec( const std::string &fileName, int mipLevel )
+{
+	int actualMipLevel;
+	return imageSpec( ustring( fileName.c_str() ), mipLevel, actualMipLevel );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // ImageReader implementation
 //////////////////////////////////////////////////////////////////////////
@@ -84,6 +113,7 @@ ImageReader::ImageReader( const std::string &name )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new StringPlug( "fileName" ) );
+	addChild( new IntPlug( "mipLevel", Plug::In, 0, 0 ) );
 	
 	// disable caching on our outputs, as OIIO is already doing caching for us.
 	for( OutputPlugIterator it( outPlug() ); it!=it.end(); it++ )
@@ -106,6 +136,28 @@ const Gaffer::StringPlug *ImageReader::fileNamePlug() const
 	return getChild<StringPlug>( g_firstPlugIndex );
 }
 
+Gaffer::IntPlug *ImageReader::mipLevelPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 1 );
+}
+
+const Gaffer::IntPlug *ImageReader::mipLevelPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 1 );
+}
+
+int ImageReader::numMipLevels() const
+{
+	std::string fileName = fileNamePlug()->getValue();
+	ustring uFileName( fileName.c_str() );
+	int result = 0;
+	while( imageCache()->imagespec( uFileName, 0, result ) )
+	{
+		result++;
+	}
+	return result;
+}
+
 bool ImageReader::enabled() const
 {
 	std::string fileName = fileNamePlug()->getValue();
@@ -117,7 +169,7 @@ void ImageReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 {
 	ImageNode::affects( input, outputs );
 
-	if( input==fileNamePlug() )
+	if( input==fileNamePlug() || input==mipLevelPlug() )
 	{
 		for( ValuePlugIterator it( outPlug() ); it != it.end(); it++ )
 		{
@@ -126,19 +178,28 @@ void ImageReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 	}
 }
 
+void ImageReader::hashFileNameAndMipLevel( IECore::MurmurHash &h ) const
+{
+	const std::string fileName = fileNamePlug()->getValue();
+	int mipLevel;
+	imageSpec( ustring( fileName.c_str() ), mipLevelPlug()->getValue(), mipLevel );
+	h.append( fileName );
+	h.append( mipLevel );
+}
+
 void ImageReader::hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	fileNamePlug()->hash( h );
+	hashFileNameAndMipLevel( h );
 }
 
 void ImageReader::hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	fileNamePlug()->hash( h );
+	hashFileNameAndMipLevel( h );
 }
 
 void ImageReader::hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	fileNamePlug()->hash( h );
+	hashFileNameAndMipLevel( h );
 }
 
 void ImageReader::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -146,14 +207,15 @@ void ImageReader::hashChannelDataPlug( const GafferImage::ImagePlug *output, con
 	// Hash the XY coordinates of the tile that we are drawing...
 	h.append( context->get<V2i>( ImagePlug::tileOriginContextName ) );
 	
-	// ... along with the file name.
-	fileNamePlug()->hash( h );
+	// ... along with the file name and level.
+	hashFileNameAndMipLevel( h );
 }
 
 GafferImage::Format ImageReader::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageCache()->imagespec( ustring( fileName.c_str() ) );
+	int mipLevel;
+	const ImageSpec *spec = imageSpec( ustring( fileName.c_str() ), mipLevelPlug()->getValue(), mipLevel );
 
 	GafferImage::Format format(
 		Imath::Box2i(
@@ -162,13 +224,23 @@ GafferImage::Format ImageReader::computeFormat( const Gaffer::Context *context,
 		),
 		1.
 	);
-	return GafferImage::Format::registerFormat( format );
+	// We register the format so that it is available to the user, but we're
+	// on a compute thread so must defer the notification to the main thread.
+	// We return our own format rather than the registered one, because a
+	// different format may already have been registered using the same name.
+	// The lower resolution mip levels are of no interest to the user, so we
+	// only register the full resolution format.
+	if( mipLevel == 0 )
+	{
+		GafferImage::Format::registerFormatDeferred( format );
+	}
+	return format;
 }
 
 Imath::Box2i ImageReader::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageCache()->imagespec( ustring( fileName.c_str() ) );
+	const ImageSpec *spec = imageSpec( fileName, mipLevelPlug()->getValue() );
 
 	const int yOffset = ( spec->full_y + spec->full_height ) - spec->y;	
 	return Box2i(
@@ -180,7 +252,7 @@ Imath::Box2i ImageReader::computeDataWindow( const Gaffer::Context *context, con
 IECore::ConstStringVectorDataPtr ImageReader::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
 {
 	std::string fileName = fileNamePlug()->getValue();
-	const ImageSpec *spec = imageCache()->imagespec( ustring( fileName.c_str() ) );
+	const ImageSpec *spec = imageSpec( fileName, mipLevelPlug()->getValue() );
 	StringVectorDataPtr result = new StringVectorData();
 	result->writable() = spec->channelnames;
 	return result;
@@ -190,7 +262,8 @@ IECore::ConstFloatVectorDataPtr ImageReader::computeChannelData( const std::stri
 {
 	std::string fileName = fileNamePlug()->getValue();
 	ustring uFileName( fileName.c_str() );
-	const ImageSpec *spec = imageCache()->imagespec( uFileName );
+	int mipLevel;
+	const ImageSpec *spec = imageSpec( uFileName, mipLevelPlug()->getValue(), mipLevel );
 	
 	vector<string>::const_iterator channelIt = find( spec->channelnames.begin(), spec->channelnames.end(), channelName );
 	if( channelIt == spec->channelnames.end() )
@@ -205,7 +278,7 @@ IECore::ConstFloatVectorDataPtr ImageReader::computeChannelData( const std::stri
 	size_t channelIndex = channelIt - spec->channelnames.begin();
 	imageCache()->get_pixels(
 		uFileName,
-		0, 0, // subimage, miplevel
+		0, mipLevel, // subimage, miplevel
 		tileOrigin.x, tileOrigin.x + ImagePlug::tileSize(),
 		yOffset, yOffset + ImagePlug::tileSize(), 
 		0, 1,
@@ -214,6 +287,25 @@ IECore::ConstFloatVectorDataPtr ImageReader::computeChannelData( const std::stri
 		&(channelData[0])
 	);
 	
+	// If every pixel has the same value then we can return a shared uniform
+	// tile, which costs nothing in the cache and allows downstream nodes to
+	// avoid processing the pixels individually.
+	const float firstValue = channelData[0];
+	bool uniform = true;
+	for( vector<float>::const_iterator it = channelData.begin(), eIt = channelData.end(); it != eIt; ++it )
+	{
+		if( *it != firstValue )
+		{
+			uniform = false;
+			break;
+		}
+	}
+	
+	if( uniform )
+	{
+		return ImagePlug::uniformTile( firstValue );
+	}
+	
 	// Create the output data buffer.
 	FloatVectorDataPtr resultData = new FloatVectorData;
 	vector<float> &result = resultData->writable();	
@@ -228,3 +320,7 @@ IECore::ConstFloatVectorDataPtr ImageReader::computeChannelData( const std::stri
 	return resultData;
 }
 
+bool ImageReader::useHalfTileCache() const
+{
+	return false;
+}
@@ -324,17 +324,20 @@ void ImageStats::compute( ValuePlug *output, const Context *context ) const
 
 	// Loop over the ROI and compute the min, max and average channel values and then set our outputs.
 	Sampler s( inPlug(), channelName, regionOfInterest );	
+	s.prefetch();
 
 	float min = std::numeric_limits<float>::max();
 	float max = std::numeric_limits<float>::min();
 	float average = 0.f;
 
 	double sum = 0.;
+	const int width = regionOfInterest.size().x + 1;
 	for( int y = regionOfInterest.min.y; y <= regionOfInterest.max.y; ++y )
 	{
-		for( int x = regionOfInterest.min.x; x <= regionOfInterest.max.x; ++x )
+		const float *row = s.sampleRow( regionOfInterest.min.x, y, width );
+		for( int x = 0; x < width; ++x )
 		{
-			float v = s.sample( x, y );
+			float v = row[x];
 			min = std::min( v, min );
 			max = std::max( v, max );
 			sum += v;
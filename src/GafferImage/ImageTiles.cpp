@@ -0,0 +1,254 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+
+#include "IECore/BoxAlgo.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
+
+#include "GafferImage/ImageTiles.h"
+
+using namespace tbb;
+using namespace IECore;
+using namespace Imath;
+using namespace Gaffer;
+using namespace GafferImage;
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of UpdateTiles:
+// Hashes the tiles within a window in parallel, and computes those
+// which have changed.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const char *g_channelNames[4] = { "R", "G", "B", "A" };
+
+class UpdateTiles
+{
+	public:
+	
+		UpdateTiles(
+				const ImagePlug *plug,
+				const std::vector<std::string> &channelNames,
+				const std::vector<V2i> &tileOrigins,
+				const ImageTiles::TileMap &previousTiles,
+				std::vector<ImageTiles::Tile> &tiles,
+				std::vector<char> &computed,
+				const Context *context
+			) :
+				m_plug( plug ),
+				m_channelNames( channelNames ),
+				m_tileOrigins( tileOrigins ),
+				m_previousTiles( previousTiles ),
+				m_tiles( tiles ),
+				m_computed( computed ),
+				m_parentContext( context )
+		{}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			// Context::current() is per-thread, so we must
+			// scope our own copy in the worker thread.
+			ContextPtr context = new Context( *m_parentContext );
+			Context::Scope scope( context );
+			
+			bool hasChannel[4];
+			for( int c = 0; c < 4; ++c )
+			{
+				hasChannel[c] = std::find( m_channelNames.begin(), m_channelNames.end(), g_channelNames[c] ) != m_channelNames.end();
+			}
+
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Canceller::check( context->canceller() );
+				ImageTiles::Tile &tile = m_tiles[i];
+				context->set( ImagePlug::tileOriginContextName, m_tileOrigins[i] );
+				for( int c = 0; c < 4; ++c )
+				{
+					if( hasChannel[c] )
+					{
+						context->set( ImagePlug::channelNameContextName, std::string( g_channelNames[c] ) );
+						tile.hash.append( g_channelNames[c] );
+						tile.hash.append( m_plug->channelDataPlug()->hash() );
+					}
+				}
+				
+				ImageTiles::TileMap::const_iterator it = m_previousTiles.find( m_tileOrigins[i] );
+				if( it != m_previousTiles.end() && it->second.hash == tile.hash )
+				{
+					tile = it->second;
+					continue;
+				}
+				
+				for( int c = 0; c < 4; ++c )
+				{
+					if( hasChannel[c] )
+					{
+						context->set( ImagePlug::channelNameContextName, std::string( g_channelNames[c] ) );
+						tile.channels[c] = m_plug->channelDataPlug()->getValue();
+					}
+				}
+				m_computed[i] = 1;
+			}
+		}
+
+	private:
+
+		const ImagePlug *m_plug;
+		const std::vector<std::string> &m_channelNames;
+		const std::vector<V2i> &m_tileOrigins;
+		const ImageTiles::TileMap &m_previousTiles;
+		std::vector<ImageTiles::Tile> &m_tiles;
+		std::vector<char> &m_computed;
+		const Context *m_parentContext;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ImageTiles
+//////////////////////////////////////////////////////////////////////////
+
+ImageTiles::ImageTiles()
+{
+}
+
+ImageTiles::~ImageTiles()
+{
+}
+
+std::vector<Imath::V2i> ImageTiles::tileOrigins( const Imath::Box2i &window )
+{
+	std::vector<V2i> result;
+	if( window.isEmpty() )
+	{
+		return result;
+	}
+	
+	const int tileSize = ImagePlug::tileSize();
+	const V2i minOrigin = ImagePlug::tileOrigin( window.min );
+	const V2i maxOrigin = ImagePlug::tileOrigin( window.max );
+	result.reserve( ( ( maxOrigin.x - minOrigin.x ) / tileSize + 1 ) * ( ( maxOrigin.y - minOrigin.y ) / tileSize + 1 ) );
+	for( int y = minOrigin.y; y <= maxOrigin.y; y += tileSize )
+	{
+		for( int x = minOrigin.x; x <= maxOrigin.x; x += tileSize )
+		{
+			result.push_back( V2i( x, y ) );
+		}
+	}
+	return result;
+}
+
+size_t ImageTiles::update( const ImagePlug *image, const Imath::Box2i &window )
+{
+	const Box2i dataWindow = image->dataWindowPlug()->getValue();
+	ConstStringVectorDataPtr channelNamesData = image->channelNamesPlug()->getValue();
+	
+	m_window = boxIntersection( window, dataWindow );
+	const std::vector<V2i> origins = tileOrigins( m_window );
+
+	std::vector<Tile> tiles( origins.size() );
+	std::vector<char> computed( origins.size(), 0 );
+	parallel_for(
+		blocked_range<size_t>( 0, origins.size() ),
+		UpdateTiles( image, channelNamesData->readable(), origins, m_tiles, tiles, computed, Context::current() )
+	);
+	
+	TileMap newTiles;
+	for( size_t i = 0; i < origins.size(); ++i )
+	{
+		newTiles.insert( newTiles.end(), TileMap::value_type( origins[i], tiles[i] ) );
+	}
+	m_tiles.swap( newTiles );
+
+	return std::count( computed.begin(), computed.end(), 1 );
+}
+
+void ImageTiles::clear()
+{
+	m_window = Box2i();
+	m_tiles.clear();
+}
+
+const Imath::Box2i &ImageTiles::window() const
+{
+	return m_window;
+}
+
+const ImageTiles::TileMap &ImageTiles::tiles() const
+{
+	return m_tiles;
+}
+
+const ImageTiles::Tile *ImageTiles::tile( const Imath::V2i &tileOrigin ) const
+{
+	TileMap::const_iterator it = m_tiles.find( tileOrigin );
+	return it != m_tiles.end() ? &(it->second) : 0;
+}
+
+Imath::Color4f ImageTiles::sample( const Imath::V2i &pixel ) const
+{
+	Color4f result( 0.0f );
+	if( !m_window.intersects( pixel ) )
+	{
+		return result;
+	}
+	
+	const V2i tileOrigin = ImagePlug::tileOrigin( pixel );
+	const Tile *t = tile( tileOrigin );
+	if( !t )
+	{
+		return result;
+	}
+	
+	const int tileSize = ImagePlug::tileSize();
+	const size_t index = ( pixel.y - tileOrigin.y ) * tileSize + ( pixel.x - tileOrigin.x );
+	for( int c = 0; c < 4; ++c )
+	{
+		if( t->channels[c] )
+		{
+			result[c] = t->channels[c]->readable()[index];
+		}
+	}
+	return result;
+}
@@ -356,13 +356,32 @@ IECore::ConstFloatVectorDataPtr Implementation::computeChannelData( const std::s
 	
 	GafferImage::FilterPtr filter = GafferImage::Filter::create( filterPlug()->getValue() );
 	Sampler sampler( inPlug(), channelName, sampleBox, filter );
+	sampler.prefetch();
+	
+	if( t[0][1] == 0.0f && t[1][0] == 0.0f && t[0][0] > 0.0f )
+	{
+		// There's no rotation or flip, so each output row maps onto a single
+		// input row and we can filter whole spans at once.
+		for ( int j = 0; j < ImagePlug::tileSize(); ++j )
+		{
+			Imath::V3f p( tile.min.x+.5, j+tile.min.y+.5, 1. );
+			p *= t;
+			sampler.sampleRow( p.x, p.y, t[0][0], ImagePlug::tileSize(), &(out[ j*ImagePlug::tileSize() ]) );
+		}
+		return outDataPtr;
+	}
+	
+	// In the general case the sample position moves by a constant
+	// amount for each step along the output row.
+	const Imath::V2f step( t[0][0], t[0][1] );
 	for ( int j = 0; j < ImagePlug::tileSize(); ++j )
 	{
+		Imath::V3f p( tile.min.x+.5, j+tile.min.y+.5, 1. );
+		p *= t;
+		float *outRow = &(out[ j*ImagePlug::tileSize() ]);
 		for ( int i = 0; i < ImagePlug::tileSize(); ++i )
 		{
-			Imath::V3f p( i+tile.min.x+.5, j+tile.min.y+.5, 1. );
-			p *= t;
-			out[ i + j*ImagePlug::tileSize() ] = sampler.sample( p.x, p.y );
+			outRow[i] = sampler.sample( p.x + i * step.x, p.y + i * step.y );
 		}
 	}
 
@@ -463,6 +482,16 @@ void ImageTransform::compute( ValuePlug *output, const Context *context ) const
 		Imath::V2f scale = transformPlug()->scalePlug()->getValue();
 		GafferImage::Format f = inPlug()->formatPlug()->getValue();
 
+		// When the transform doesn't shrink the image, the implementation can resample the
+		// input with the whole transform in a single pass. In this case we leave the format
+		// as it is, which disables the internal Reformat. Otherwise the Reformat prefilters
+		// the input to the scaled resolution so that it doesn't alias.
+		if( scale.x >= 1.0f && scale.y >= 1.0f )
+		{
+			static_cast<FormatPlug *>( output )->setValue( f );
+			return;
+		}
+
 		Imath::Box2i newDisplayWindow(
 			Imath::V2i( IECore::fastFloatFloor( f.getDisplayWindow().min.x * scale.x ), IECore::fastFloatFloor( f.getDisplayWindow().min.y * scale.y ) ),
 			Imath::V2i( IECore::fastFloatCeil( f.getDisplayWindow().max.x * scale.x ), IECore::fastFloatCeil( f.getDisplayWindow().max.y * scale.y ) )
@@ -249,23 +249,26 @@ void ImageWriter::execute( const Contexts &contexts ) const
 		spec.x = dataWindow.min.x;
 		spec.y = dataWindow.min.y;
 	
+		// Only allow tiled output if our file format supports it, and
+		// write tiles which match our own tile size when it does.
+		int writeMode = writeModePlug()->getValue() & out->supports( "tile" );
+		if ( writeMode == Tile )
+		{
+			spec.tile_width = spec.tile_height = ImagePlug::tileSize();
+		}
+
 		if ( !out->open( fileName, spec ) )
 		{
 			throw IECore::Exception( boost::str( boost::format( "Could not open \"%s\", error = %s" ) % fileName % out->geterror() ) );
 		}
 
-		// Only allow tiled output if our file format supports it.	
-		int writeMode = writeModePlug()->getValue() & out->supports( "tile" );
-	
 		if ( writeMode == Scanline )
 		{
 			// Create a buffer for the scanline.
-			float scanline[ nChannels*dataWindowWidth ];
+			std::vector<float> scanline( nChannels*dataWindowWidth, 0.0f );
 			
 			if ( imageIsBlack )
 			{
-				memset( scanline, 0, sizeof(float) * nChannels*dataWindowWidth );
-
 				for ( int y = spec.y; y < spec.y + dataWindowHeight; ++y )
 				{
 					if ( !out->write_scanline( y, 0, TypeDesc::FLOAT, &scanline[0] ) )
@@ -301,13 +304,14 @@ void ImageWriter::execute( const Contexts &contexts ) const
 		// Tiled output
 		else
 		{
-			// Create a buffer for the tile.
+			// Create a buffer for the tile. This is allocated on the heap
+			// rather than the stack, as the larger tile sizes would quickly
+			// exhaust the stack for images with many channels.
 			const int tileSize = ImagePlug::tileSize();
-			float tile[ nChannels*tileSize*tileSize ];
+			std::vector<float> tile( nChannels*tileSize*tileSize, 0.0f );
 
 			if ( imageIsBlack )
 			{
-				memset( tile, 0,  sizeof(float) * nChannels*tileSize*tileSize );
 				for ( int tileY = 0; tileY < dataWindowHeight; tileY += tileSize )
 				{
 					for ( int tileX = 0; tileX < dataWindowWidth; tileX += tileSize )
@@ -326,20 +330,23 @@ void ImageWriter::execute( const Contexts &contexts ) const
 				{
 					for ( int tileX = 0; tileX < dataWindowWidth; tileX += tileSize )
 					{
-						float *outPtr = &tile[0];	
-
-						const int r = std::min( tileSize+tileX, dataWindowWidth );
-						const int t = std::min( tileSize+tileY, dataWindowHeight );
+						// Tiles on the right and top edges may only be partially covered by the data window.
+						const int r = std::min( tileSize, dataWindowWidth - tileX );
+						const int t = std::min( tileSize, dataWindowHeight - tileY );
+						if ( r < tileSize || t < tileSize )
+						{
+							std::fill( tile.begin(), tile.end(), 0.0f );
+						}
 
 						for ( int y = 0; y < t; ++y )
 						{
 							for ( std::vector<const float *>::iterator channelDataIt( channelPtrs.begin() ); channelDataIt != channelPtrs.end(); channelDataIt++ )
 							{
-								const int inc = channelPtrs.size();
-								const float *inRowPtr = (*channelDataIt) + ( tileY + t - y - 1 ) * dataWindowWidth;
-								for ( int x = 0; x < r; ++x, outPtr += inc )
+								float *outPtr = &tile[0] + y * tileSize * nChannels + (channelDataIt - channelPtrs.begin());
+								const float *inRowPtr = (*channelDataIt) + ( tileY + y ) * dataWindowWidth + tileX;
+								for ( int x = 0; x < r; ++x, outPtr += nChannels )
 								{
-									*outPtr = *inRowPtr+(tileX+x);
+									*outPtr = *inRowPtr++;
 								}
 							}
 						}
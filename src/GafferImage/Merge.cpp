@@ -116,7 +116,21 @@ IECore::ConstFloatVectorDataPtr Merge::computeChannelData( const std::string &ch
 	const ImagePlugList::const_iterator end( m_inputs.endIterator() );
 	for( ImagePlugList::const_iterator it( m_inputs.inputs().begin() ); it != end; it++ )
 	{
-		if ( (*it)->getInput<ValuePlug>() )
+		if ( !(*it)->getInput<ValuePlug>() )
+		{
+			continue;
+		}
+		
+		// Inputs which don't cover the tile contribute transparent black,
+		// which we can supply without fetching their tiles. The uniform
+		// tile handling in mergeTiles() then avoids processing their pixels.
+		if ( tileOutsideDataWindow( tileOrigin, (*it)->dataWindowPlug()->getValue() ) )
+		{
+			tileSkipped();
+			inData.push_back( ImagePlug::blackTile() );
+			inAlpha.push_back( ImagePlug::blackTile() );
+		}
+		else
 		{
 			inData.push_back( (*it)->channelData( channelName, tileOrigin ) );
 			inAlpha.push_back( (*it)->channelData( "A", tileOrigin ) );
@@ -128,21 +142,21 @@ IECore::ConstFloatVectorDataPtr Merge::computeChannelData( const std::string &ch
 	switch( operation )
 	{
 		default:
-		case( kAdd ): return doMergeOperation( opAdd, inData, inAlpha, tileOrigin ); break;
-		case( kAtop ): return doMergeOperation( opAtop, inData, inAlpha, tileOrigin ); break;
-		case( kDivide ): return doMergeOperation( opDivide, inData, inAlpha, tileOrigin ); break;
-		case( kIn ): return doMergeOperation( opIn, inData, inAlpha, tileOrigin ); break;
-		case( kOut ): return doMergeOperation( opOut, inData, inAlpha, tileOrigin ); break;
-		case( kMask ): return doMergeOperation( opMask, inData, inAlpha, tileOrigin ); break;
-		case( kMatte ): return doMergeOperation( opMatte, inData, inAlpha, tileOrigin ); break;
-		case( kMultiply ): return doMergeOperation( opMultiply, inData, inAlpha, tileOrigin ); break;
-		case( kOver ): return doMergeOperation( opOver, inData, inAlpha, tileOrigin ); break;
-		case( kSubtract ): return doMergeOperation( opSubtract, inData, inAlpha, tileOrigin ); break;
-		case( kUnder ): return doMergeOperation( opUnder, inData, inAlpha, tileOrigin ); break;
+		case( kAdd ): return doMergeOperation( opAdd, TransparentAIsIdentity | TransparentBIsIdentity, inData, inAlpha, tileOrigin ); break;
+		case( kAtop ): return doMergeOperation( opAtop, TransparentAIsIdentity, inData, inAlpha, tileOrigin ); break;
+		case( kDivide ): return doMergeOperation( opDivide, NoIdentities, inData, inAlpha, tileOrigin ); break;
+		case( kIn ): return doMergeOperation( opIn, NoIdentities, inData, inAlpha, tileOrigin ); break;
+		case( kOut ): return doMergeOperation( opOut, NoIdentities, inData, inAlpha, tileOrigin ); break;
+		case( kMask ): return doMergeOperation( opMask, NoIdentities, inData, inAlpha, tileOrigin ); break;
+		case( kMatte ): return doMergeOperation( opMatte, TransparentAIsIdentity, inData, inAlpha, tileOrigin ); break;
+		case( kMultiply ): return doMergeOperation( opMultiply, NoIdentities, inData, inAlpha, tileOrigin ); break;
+		case( kOver ): return doMergeOperation( opOver, TransparentAIsIdentity | TransparentBIsIdentity, inData, inAlpha, tileOrigin ); break;
+		case( kSubtract ): return doMergeOperation( opSubtract, TransparentBIsIdentity, inData, inAlpha, tileOrigin ); break;
+		case( kUnder ): return doMergeOperation( opUnder, TransparentAIsIdentity | TransparentBIsIdentity, inData, inAlpha, tileOrigin ); break;
 	}
 
 	// We should never get here...
-	return doMergeOperation( opAdd, inData, inAlpha, tileOrigin );
+	return doMergeOperation( opAdd, TransparentAIsIdentity | TransparentBIsIdentity, inData, inAlpha, tileOrigin );
 }
 
 bool Merge::hasAlpha( ConstStringVectorDataPtr channelNamesData ) const
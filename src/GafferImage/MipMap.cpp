@@ -0,0 +1,378 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/format.hpp"
+
+#include "Gaffer/Context.h"
+
+#include "GafferImage/MipMap.h"
+#include "GafferImage/Sampler.h"
+#include "GafferImage/FormatPlug.h"
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferImage;
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of MipMapLevel - a node which halves the resolution of
+// its input. MipMap uses a chain of these to build the pyramid.
+//////////////////////////////////////////////////////////////////////////
+
+namespace GafferImage
+{
+
+namespace Detail
+{
+
+class MipMapLevel : public ImageProcessor
+{
+
+	public :
+
+		MipMapLevel( const std::string &name=staticTypeName() );
+		virtual ~MipMapLevel(){};
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( MipMapLevel, MipMapLevelTypeId, ImageProcessor );
+
+		virtual void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const;
+
+	protected :
+
+		virtual void hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		virtual void hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+
+		virtual GafferImage::Format computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual Imath::Box2i computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual IECore::ConstStringVectorDataPtr computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const;
+		virtual IECore::ConstFloatVectorDataPtr computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const;
+
+	private :
+
+		// Returns the window in the input which is averaged to
+		// make the tile with the specified origin.
+		static Box2i inputWindow( const V2i &tileOrigin );
+		// Returns a sampler for accessing the input window.
+		Sampler inputSampler( const std::string &channelName, const V2i &tileOrigin ) const;
+
+};
+
+IE_CORE_DEFINERUNTIMETYPED( MipMapLevel );
+
+MipMapLevel::MipMapLevel( const std::string &name )
+	:	ImageProcessor( name )
+{
+}
+
+void MipMapLevel::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	ImageProcessor::affects( input, outputs );
+
+	if( input == inPlug()->formatPlug() )
+	{
+		outputs.push_back( outPlug()->formatPlug() );
+	}
+	else if( input == inPlug()->dataWindowPlug() )
+	{
+		outputs.push_back( outPlug()->dataWindowPlug() );
+		outputs.push_back( outPlug()->channelDataPlug() );
+	}
+	else if( input == inPlug()->channelNamesPlug() )
+	{
+		outputs.push_back( outPlug()->channelNamesPlug() );
+	}
+	else if( input == inPlug()->channelDataPlug() )
+	{
+		outputs.push_back( outPlug()->channelDataPlug() );
+	}
+}
+
+void MipMapLevel::hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	inPlug()->formatPlug()->hash( h );
+}
+
+void MipMapLevel::hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	inPlug()->dataWindowPlug()->hash( h );
+}
+
+void MipMapLevel::hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h = inPlug()->channelNamesPlug()->hash();
+}
+
+void MipMapLevel::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	const V2i tileOrigin = context->get<V2i>( ImagePlug::tileOriginContextName );
+	const std::string &channelName = context->get<std::string>( ImagePlug::channelNameContextName );
+
+	Sampler sampler = inputSampler( channelName, tileOrigin );
+	sampler.hash( h );
+	inPlug()->dataWindowPlug()->hash( h );
+}
+
+GafferImage::Format MipMapLevel::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	const Format inFormat = inPlug()->formatPlug()->getValue();
+	return Format( MipMap::levelWindow( inFormat.getDisplayWindow(), 1 ), inFormat.getPixelAspect() );
+}
+
+Imath::Box2i MipMapLevel::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return MipMap::levelWindow( inPlug()->dataWindowPlug()->getValue(), 1 );
+}
+
+IECore::ConstStringVectorDataPtr MipMapLevel::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return inPlug()->channelNamesPlug()->getValue();
+}
+
+IECore::ConstFloatVectorDataPtr MipMapLevel::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	const Box2i window = inputWindow( tileOrigin );
+	Sampler sampler = inputSampler( channelName, tileOrigin );
+
+	float uniformValue;
+	if( sampler.uniform( uniformValue ) )
+	{
+		return ImagePlug::uniformTile( uniformValue );
+	}
+
+	sampler.prefetch();
+
+	const int tileSize = ImagePlug::tileSize();
+	const int inputWidth = window.size().x + 1;
+
+	FloatVectorDataPtr resultData = new FloatVectorData;
+	vector<float> &result = resultData->writable();
+	result.resize( tileSize * tileSize );
+
+	// Each output pixel is the average of a 2x2 block of input pixels. We
+	// accumulate a pair of input rows at a time.
+	for( int y = 0; y < tileSize; ++y )
+	{
+		float *out = &(result[ y * tileSize ]);
+
+		const float *row = sampler.sampleRow( window.min.x, window.min.y + y * 2, inputWidth );
+		for( int x = 0; x < tileSize; ++x )
+		{
+			out[x] = row[x*2] + row[x*2+1];
+		}
+
+		row = sampler.sampleRow( window.min.x, window.min.y + y * 2 + 1, inputWidth );
+		for( int x = 0; x < tileSize; ++x )
+		{
+			out[x] = ( out[x] + row[x*2] + row[x*2+1] ) * 0.25f;
+		}
+	}
+
+	return resultData;
+}
+
+Box2i MipMapLevel::inputWindow( const V2i &tileOrigin )
+{
+	return Box2i( tileOrigin * 2, tileOrigin * 2 + V2i( ImagePlug::tileSize() * 2 - 1 ) );
+}
+
+Sampler MipMapLevel::inputSampler( const std::string &channelName, const V2i &tileOrigin ) const
+{
+	// The sampler expands the window by the radius of the filter, which is a single
+	// pixel for the box filter. We only ever sample whole pixels, so we shrink the
+	// window to compensate, and avoid accessing neighbouring tiles unnecessarily.
+	// Pixels outside the data window must be treated as black, but when the window is
+	// entirely within the data window we clamp instead, as this allows the sampler to
+	// identify uniform input of any value.
+	const Box2i window = inputWindow( tileOrigin );
+	const Box2i dataWindow = inPlug()->dataWindowPlug()->getValue();
+	const Sampler::BoundingMode boundingMode = dataWindow.intersects( window.min ) && dataWindow.intersects( window.max ) ? Sampler::Clamp : Sampler::Black;
+	return Sampler( inPlug(), channelName, Box2i( window.min + V2i( 1 ), window.max - V2i( 1 ) ), Filter::create( "Box" ), boundingMode );
+}
+
+} // namespace Detail
+
+} // namespace GafferImage
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of MipMap
+//////////////////////////////////////////////////////////////////////////
+
+static const int g_maxLevel = 16;
+
+static std::string levelNodeName( int level )
+{
+	return boost::str( boost::format( "__level%d" ) % level );
+}
+
+IE_CORE_DEFINERUNTIMETYPED( MipMap );
+
+size_t MipMap::g_firstPlugIndex = 0;
+
+MipMap::MipMap( const std::string &name )
+	:	ImageProcessor( name )
+{
+	storeIndexOfNextChild( g_firstPlugIndex );
+	addChild( new IntPlug( "level", Plug::In, 0, 0, g_maxLevel ) );
+
+	// Build the chain of internal nodes which compute each level
+	// from the one above.
+	ImagePlug *levelIn = inPlug();
+	for( int level = 1; level <= g_maxLevel; ++level )
+	{
+		Detail::MipMapLevel *levelNode = new Detail::MipMapLevel( levelNodeName( level ) );
+		levelNode->inPlug()->setInput( levelIn );
+		addChild( levelNode );
+		levelIn = levelNode->outPlug();
+	}
+}
+
+MipMap::~MipMap()
+{
+}
+
+Gaffer::IntPlug *MipMap::levelPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex );
+}
+
+const Gaffer::IntPlug *MipMap::levelPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex );
+}
+
+void MipMap::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	ImageProcessor::affects( input, outputs );
+
+	// Our outputs are computed by the internal nodes, which
+	// depend only on our input.
+	if( input == levelPlug() || input->parent<ImagePlug>() == inPlug() )
+	{
+		for( ValuePlugIterator it( outPlug() ); it != it.end(); it++ )
+		{
+			outputs.push_back( it->get() );
+		}
+	}
+}
+
+bool MipMap::enabled() const
+{
+	if( !ImageProcessor::enabled() )
+	{
+		return false;
+	}
+
+	return levelPlug()->getValue() > 0;
+}
+
+int MipMap::maxLevel()
+{
+	return g_maxLevel;
+}
+
+Imath::Box2i MipMap::levelWindow( const Imath::Box2i &window, int level )
+{
+	if( window.isEmpty() )
+	{
+		return window;
+	}
+
+	// Divide, rounding towards negative infinity.
+	const int s = 1 << level;
+	return Box2i(
+		V2i(
+			window.min.x >= 0 ? window.min.x / s : ( window.min.x - s + 1 ) / s,
+			window.min.y >= 0 ? window.min.y / s : ( window.min.y - s + 1 ) / s
+		),
+		V2i(
+			window.max.x >= 0 ? window.max.x / s : ( window.max.x - s + 1 ) / s,
+			window.max.y >= 0 ? window.max.y / s : ( window.max.y - s + 1 ) / s
+		)
+	);
+}
+
+const ImagePlug *MipMap::levelOutPlug() const
+{
+	const int level = std::min( levelPlug()->getValue(), g_maxLevel );
+	if( level <= 0 )
+	{
+		return inPlug();
+	}
+	return getChild<Detail::MipMapLevel>( levelNodeName( level ) )->outPlug();
+}
+
+void MipMap::hashFormatPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h = levelOutPlug()->formatPlug()->hash();
+}
+
+void MipMap::hashDataWindowPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h = levelOutPlug()->dataWindowPlug()->hash();
+}
+
+void MipMap::hashChannelNamesPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h = levelOutPlug()->channelNamesPlug()->hash();
+}
+
+void MipMap::hashChannelDataPlug( const GafferImage::ImagePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h = levelOutPlug()->channelDataPlug()->hash();
+}
+
+GafferImage::Format MipMap::computeFormat( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return levelOutPlug()->formatPlug()->getValue();
+}
+
+Imath::Box2i MipMap::computeDataWindow( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return levelOutPlug()->dataWindowPlug()->getValue();
+}
+
+IECore::ConstStringVectorDataPtr MipMap::computeChannelNames( const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return levelOutPlug()->channelNamesPlug()->getValue();
+}
+
+IECore::ConstFloatVectorDataPtr MipMap::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
+{
+	return levelOutPlug()->channelDataPlug()->getValue();
+}
@@ -209,11 +209,6 @@ struct Contribution
 
 IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string &channelName, const Imath::V2i &tileOrigin, const Gaffer::Context *context, const ImagePlug *parent ) const
 {
-	// Allocate the new tile
-	FloatVectorDataPtr outDataPtr = new FloatVectorData;
-	std::vector<float> &out = outDataPtr->writable();
-	out.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
-
 	// Create some useful variables...
 	Imath::V2i formatOffset( formatPlug()->getValue().getDisplayWindow().min );	
 	Imath::Box2i tile( tileOrigin-formatOffset, Imath::V2i( tileOrigin.x - formatOffset.x + ImagePlug::tileSize() - 1, tileOrigin.y - formatOffset.y + ImagePlug::tileSize() - 1 ) );
@@ -232,11 +227,33 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 			Imath::V2i( IECore::fastFloatFloor( tile.max.x / scaleFactorD.x ), IECore::fastFloatCeil( tile.max.y / scaleFactorD.y ) )
 		);
 		Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
+		
+		// Resizing a uniform image yields the same uniform image.
+		float uniformValue;
+		if( sampler.uniform( uniformValue ) )
+		{
+			return ImagePlug::uniformTile( uniformValue );
+		}
+		
+		sampler.prefetch();
+
+		// The input pixel for each output column is the same for every row.
+		std::vector<int> inX( ImagePlug::tileSize() );
+		for ( int x = tile.min.x, tx = 0; x <= tile.max.x; ++x, ++tx )
+		{
+			inX[tx] = IECore::fastFloatFloor( (x+.5f)/scaleFactor.x );
+		}
+		const int rowWidth = inX.back() - inX.front() + 1;
+
+		FloatVectorDataPtr outDataPtr = new FloatVectorData;
+		std::vector<float> &out = outDataPtr->writable();
+		out.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
 		for ( int y = tile.min.y, ty = 0; y <= tile.max.y; ++y, ++ty )
 		{
-			for ( int x = tile.min.x, tx = 0; x <= tile.max.x; ++x, ++tx )
+			const float *row = sampler.sampleRow( inX.front(), IECore::fastFloatFloor( (y+.5f)/scaleFactor.y ), rowWidth );
+			for ( int tx = 0; tx < ImagePlug::tileSize(); ++tx )
 			{
-				out[ tx + ImagePlug::tileSize() * ty ] = sampler.sample( (x+.5f)/scaleFactor.x, (y+.5f)/scaleFactor.y ); 
+				out[ tx + ImagePlug::tileSize() * ty ] = row[ inX[tx] - inX.front() ]; 
 			}
 		}
 		return outDataPtr;
@@ -259,13 +276,30 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 		Imath::V2i( sampleMaxX + fWidth, sampleMaxY + fHeight )
 	);
 
+	// As above, a uniform input gives a uniform output.
+	Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
+	float uniformValue;
+	if( sampler.uniform( uniformValue ) )
+	{
+		return ImagePlug::uniformTile( uniformValue );
+	}
+
+	sampler.prefetch();
+
+	// Allocate the new tile
+	FloatVectorDataPtr outDataPtr = new FloatVectorData;
+	std::vector<float> &out = outDataPtr->writable();
+	out.resize( ImagePlug::tileSize() * ImagePlug::tileSize() );
+
 	int sampleBoxWidth = sampleBox.size().x + 1;
 	int sampleBoxHeight = sampleBox.size().y + 1;
 	
 	// Create a temporary buffer that we can write the result of the first pass to.
 	// We extend the buffer vertically as we will need additional information in the
-	// vertical squash (the second pass) to properly convolve the filter.
-	float buffer[ ImagePlug::tileSize() * sampleBoxHeight ];
+	// vertical squash (the second pass) to properly convolve the filter. It lives on
+	// the heap as it grows with the tile size, and would risk overflowing the stack
+	// for the larger tile sizes.
+	std::vector<float> buffer( ImagePlug::tileSize() * sampleBoxHeight );
 	
 	// Create several buffers for each pixel in the output row (or column depending on the pass)
 	// into which we can place the indices for the pixels that are contribute to it's result and
@@ -309,9 +343,9 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 	
 	// Now that we know the contribution of each pixel from the others on the row, compute the
 	// horizontally scaled buffer which we will use as input in the vertical scale pass.
-	Sampler sampler( inPlug(), channelName, sampleBox, f, Sampler::Clamp );
 	for ( int k = 0; k < sampleBoxHeight; ++k )
 	{
+		const float *row = sampler.sampleRow( sampleBox.min.x, k + sampleBox.min.y, sampleBoxWidth );
 		for ( int i = 0, contributionIdx = 0; i < ImagePlug::tileSize(); ++i, contributionIdx += fWidth )
 		{
 			float intensity = 0;
@@ -325,7 +359,7 @@ IECore::ConstFloatVectorDataPtr Reformat::computeChannelData( const std::string
 					continue;
 				}
 
-				float value = sampler.sample( contributor.pixel, k + sampleBox.min.y );
+				float value = row[ contributor.pixel - sampleBox.min.x ];
 				intensity += value * contributor.weight;
 			}
 
@@ -163,24 +163,17 @@ IECore::ConstStringVectorDataPtr RemoveChannels::computeChannelNames( const Gaff
 	if( mode == Remove ) // Remove the selected channels
 	{
 		IECore::ConstStringVectorDataPtr inChannelsData = inPlug()->channelNamesPlug()->getValue();
-		std::vector<std::string> inChannels( inChannelsData->readable() );
-		IECore::ConstStringVectorDataPtr inSelectionData = channelSelectionPlug()->getValue();
-		const std::vector<std::string> &channelSelection( inSelectionData->readable() );
+		const std::vector<std::string> &inChannels( inChannelsData->readable() );
+		IECore::ConstBoolVectorDataPtr channelMask = channelSelectionPlug()->channelMask( inChannelsData.get() );
 
-		std::vector<std::string>::iterator it( inChannels.begin() );
-		while ( it != inChannels.end() )
+		std::vector<std::string> &outChannels = result->writable();
+		for( std::vector<std::string>::const_iterator it = inChannels.begin(); it != inChannels.end(); ++it )
 		{
-			if ( std::find( channelSelection.begin(), channelSelection.end(), (*it) ) != channelSelection.end() )
+			if( !ChannelMaskPlug::channelEnabled( channelMask.get(), *it ) )
 			{
-				it = inChannels.erase( it );
-			}
-			else
-			{
-				++it;
+				outChannels.push_back( *it );
 			}
 		}
-
-		result->writable() = inChannels;
 	}
 	else // Keep the selected channels
 	{
@@ -34,13 +34,85 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "Gaffer/Context.h"
 #include "GafferImage/Sampler.h"
 
+using namespace tbb;
 using namespace Gaffer;
 using namespace IECore;
 using namespace GafferImage;
 
+//////////////////////////////////////////////////////////////////////////
+// Implementation of PrefetchTiles:
+// Computes the tiles of a Sampler's cache in parallel.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+class PrefetchTiles
+{
+	public:
+	
+		PrefetchTiles(
+				std::vector<ConstFloatVectorDataPtr> &dataCache,
+				const ImagePlug *plug,
+				const std::string &channelName,
+				const Imath::Box2i &cacheWindow,
+				int cacheWidth,
+				const Context *context
+			) :
+				m_dataCache( dataCache ),
+				m_plug( plug ),
+				m_channelName( channelName ),
+				m_cacheWindow( cacheWindow ),
+				m_cacheWidth( cacheWidth ),
+				m_parentContext( context )
+		{}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			// Context::current() is per-thread, so we must
+			// scope the sampler's context in the worker thread.
+			ContextPtr context = new Context( *m_parentContext );
+			Context::Scope scope( context );
+			
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				if( m_dataCache[i] )
+				{
+					continue;
+				}
+				const Imath::V2i tileOrigin(
+					m_cacheWindow.min.x + ( i % m_cacheWidth ) * ImagePlug::tileSize(),
+					m_cacheWindow.min.y + ( i / m_cacheWidth ) * ImagePlug::tileSize()
+				);
+				m_dataCache[i] = m_plug->channelData( m_channelName, tileOrigin );
+			}
+		}
+
+	private:
+
+		std::vector<ConstFloatVectorDataPtr> &m_dataCache;
+		const ImagePlug *m_plug;
+		const std::string &m_channelName;
+		const Imath::Box2i &m_cacheWindow;
+		const int m_cacheWidth;
+		const Context *m_parentContext;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Implementation of Sampler
+//////////////////////////////////////////////////////////////////////////
+
 Sampler::Sampler( const GafferImage::ImagePlug *plug, const std::string &channelName, const Imath::Box2i &window, BoundingMode boundingMode )
 	: m_plug( plug ),
 	m_channelName( channelName ),
@@ -86,6 +158,200 @@ void Sampler::setSampleWindow( const Imath::Box2i &window )
 	m_dataCache.resize( m_cacheWidth * cacheHeight, NULL );
 }
 
+bool Sampler::uniform( float &value )
+{
+	if( m_sampleWindow.isEmpty() )
+	{
+		return false;
+	}
+
+	bool first = true;
+	for ( int y = m_cacheWindow.min.y; y <= m_cacheWindow.max.y; y += GafferImage::ImagePlug::tileSize() )
+	{
+		for ( int x = m_cacheWindow.min.x; x <= m_cacheWindow.max.x; x += GafferImage::ImagePlug::tileSize() )
+		{
+			// Fill the cache as we go, so the tiles are available
+			// for sampling if they turn out not to be uniform.
+			const Imath::V2i cacheIndex = ( Imath::V2i( x, y ) - m_cacheWindow.min ) / Imath::V2i( ImagePlug::tileSize() );
+			IECore::ConstFloatVectorDataPtr &tile = m_dataCache[ cacheIndex.x + cacheIndex.y * m_cacheWidth ];
+			if( !tile )
+			{
+				tile = m_plug->channelData( m_channelName, Imath::V2i( x, y ) );
+			}
+			
+			float tileValue;
+			if( !ImagePlug::isUniformTile( tile.get(), tileValue ) )
+			{
+				return false;
+			}
+			if( first )
+			{
+				value = tileValue;
+				first = false;
+			}
+			else if( tileValue != value )
+			{
+				return false;
+			}
+		}
+	}
+	
+	// In Black mode, samples outside the sample window are black
+	// rather than the value of the tiles.
+	return m_boundingMode == Clamp || value == 0.0f;
+}
+
+const float *Sampler::sampleRow( int x, int y, int count )
+{
+	const int lastX = x + count - 1;
+	
+	// Fast path for runs which lie within a single tile, where
+	// we can just point straight at the tile data.
+	if(
+		y >= m_sampleWindow.min.y && y <= m_sampleWindow.max.y &&
+		x >= m_sampleWindow.min.x && lastX <= m_sampleWindow.max.x &&
+		ImagePlug::tileOrigin( Imath::V2i( x, y ) ).x == ImagePlug::tileOrigin( Imath::V2i( lastX, y ) ).x
+	)
+	{
+		const float *tileData;
+		Imath::V2i tileOrigin;
+		Imath::V2i tileIndex;
+		cachedData( Imath::V2i( x, y ), tileData, tileOrigin, tileIndex );
+		return tileData + tileIndex.y * ImagePlug::tileSize() + tileIndex.x;
+	}
+
+	// Otherwise we must gather the samples into our buffer.
+	m_rowBuffer.resize( count );
+	float *out = &(m_rowBuffer[0]);
+	
+	if( m_boundingMode == Black )
+	{
+		if( y < m_sampleWindow.min.y || y > m_sampleWindow.max.y )
+		{
+			std::fill( out, out + count, 0.0f );
+			return out;
+		}
+	}
+	else
+	{
+		y = std::max( std::min( y, m_sampleWindow.max.y ), m_sampleWindow.min.y );
+	}
+	
+	// Split the run into the parts before, within and after the sample window.
+	const int insideMinX = std::min( std::max( x, m_sampleWindow.min.x ), lastX + 1 );
+	const int insideMaxX = std::max( std::min( lastX, m_sampleWindow.max.x ), insideMinX - 1 );
+
+	const float before = m_boundingMode == Black ? 0.0f : sample( m_sampleWindow.min.x, y );
+	std::fill( out, out + ( insideMinX - x ), before );
+
+	copyRow( insideMinX, y, insideMaxX - insideMinX + 1, out + ( insideMinX - x ) );
+
+	const float after = m_boundingMode == Black ? 0.0f : sample( m_sampleWindow.max.x, y );
+	std::fill( out + ( insideMaxX + 1 - x ), out + count, after );
+
+	return out;
+}
+
+void Sampler::sampleRow( float x, float y, float step, int count, float *out )
+{
+	// Perform an early-out for the box filter.
+	if ( static_cast<GafferImage::TypeId>( m_filter->typeId() ) == GafferImage::BoxFilterTypeId )
+	{
+		const int minX = IECore::fastFloatFloor( x );
+		const int maxX = IECore::fastFloatFloor( x + ( count - 1 ) * step );
+		const float *row = sampleRow( minX, IECore::fastFloatFloor( y ), maxX - minX + 1 );
+		for( int i = 0; i < count; ++i )
+		{
+			out[i] = row[ IECore::fastFloatFloor( x + i * step ) - minX ];
+		}
+		return;
+	}
+
+	const int width = m_filter->width();
+
+	// The vertical weights are the same for every sample in the row.
+	m_weightsY.resize( width );
+	const int tapY = m_filter->tap( y - m_cacheWindow.min.y ) + m_cacheWindow.min.y;
+	float weightedSumY = 0.0f;
+	for( int j = 0; j < width; ++j )
+	{
+		weightedSumY += m_weightsY[j] = m_filter->weight( y, tapY + j );
+	}
+
+	// First pass : filter vertically, into a single row which covers
+	// all the horizontal taps for the span.
+	const int minTapX = m_filter->tap( x - m_cacheWindow.min.x ) + m_cacheWindow.min.x;
+	const int maxTapX = m_filter->tap( x + ( count - 1 ) * step - m_cacheWindow.min.x ) + m_cacheWindow.min.x + width - 1;
+	const int columns = maxTapX - minTapX + 1;
+	m_columnBuffer.resize( columns );
+	std::fill( m_columnBuffer.begin(), m_columnBuffer.end(), 0.0f );
+	for( int j = 0; j < width; ++j )
+	{
+		const float w = m_weightsY[j];
+		if( w == 0.0f )
+		{
+			continue;
+		}
+		const float *row = sampleRow( minTapX, tapY + j, columns );
+		for( int i = 0; i < columns; ++i )
+		{
+			m_columnBuffer[i] += row[i] * w;
+		}
+	}
+
+	// Second pass : filter horizontally.
+	m_weightsX.resize( width );
+	for( int i = 0; i < count; ++i )
+	{
+		const float center = x + i * step;
+		const int tapX = m_filter->tap( center - m_cacheWindow.min.x ) + m_cacheWindow.min.x;
+		const float *column = &(m_columnBuffer[tapX - minTapX]);
+		float weightedSum = 0.0f;
+		float colour = 0.0f;
+		for( int k = 0; k < width; ++k )
+		{
+			const float w = m_filter->weight( center, tapX + k );
+			weightedSum += w;
+			colour += column[k] * w;
+		}
+		weightedSum *= weightedSumY;
+		out[i] = weightedSum == 0 ? 0 : colour / weightedSum;
+	}
+}
+
+void Sampler::prefetch()
+{
+	if( m_sampleWindow.isEmpty() )
+	{
+		return;
+	}
+
+	parallel_for(
+		blocked_range<size_t>( 0, m_dataCache.size() ),
+		PrefetchTiles( m_dataCache, m_plug, m_channelName, m_cacheWindow, m_cacheWidth, Context::current() )
+	);
+}
+
+void Sampler::copyRow( int x, int y, int count, float *out )
+{
+	const int tileSize = ImagePlug::tileSize();
+	while( count > 0 )
+	{
+		const float *tileData;
+		Imath::V2i tileOrigin;
+		Imath::V2i tileIndex;
+		cachedData( Imath::V2i( x, y ), tileData, tileOrigin, tileIndex );
+		
+		const int n = std::min( count, tileSize - tileIndex.x );
+		const float *in = tileData + tileIndex.y * tileSize + tileIndex.x;
+		std::copy( in, in + n, out );
+		
+		x += n;
+		out += n;
+		count -= n;
+	}
+}
+
 void Sampler::hash( IECore::MurmurHash &h ) const
 {
 	for ( int x = m_cacheWindow.min.x; x <= m_cacheWindow.max.x; x += GafferImage::ImagePlug::tileSize() )
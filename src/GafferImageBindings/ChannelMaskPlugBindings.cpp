@@ -76,6 +76,16 @@ static boost::python::list maskChannelList( GafferImage::ChannelMaskPlug &plug,
 	return result;
 }
 
+static IECore::BoolVectorDataPtr channelMask( const GafferImage::ChannelMaskPlug &plug, const IECore::StringVectorData *inChannels )
+{
+	return plug.channelMask( inChannels )->copy();
+}
+
+static IECore::BoolVectorDataPtr channelMaskFromPlug( const GafferImage::ChannelMaskPlug &plug, const Gaffer::StringVectorDataPlug *inChannelsPlug )
+{
+	return plug.channelMask( inChannelsPlug )->copy();
+}
+
 static boost::python::list removeDuplicates( boost::python::object channelList )
 {
 	std::vector<std::string> channels;
@@ -111,6 +121,10 @@ namespace GafferImageBindings
 		.def( "maskChannels", &maskChannelList )
 		.def( "removeDuplicateIndices", &removeDuplicates ).staticmethod("removeDuplicateIndices")
 		.def( "channelIndex", &ChannelMaskPlug::channelIndex ).staticmethod("channelIndex")
+		.def( "channelMask", &channelMask )
+		.def( "channelMask", &channelMaskFromPlug )
+		.def( "channelEnabled", &ChannelMaskPlug::channelEnabled ).staticmethod("channelEnabled")
+		.def( "channelId", &ChannelMaskPlug::channelId ).staticmethod("channelId")
 	;
 }
 
@@ -128,12 +128,14 @@ void bindFormat()
 		// Static bindings
 		.def( "formatAddedSignal", &Format::formatAddedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "formatAddedSignal" )
 		.def( "formatRemovedSignal", &Format::formatRemovedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "formatRemovedSignal" )
+		.def( "emitPendingSignals", &Format::emitPendingSignals ).staticmethod( "emitPendingSignals" )
 		.def( "setDefaultFormat", setDefaultFormatPtr1, return_value_policy<reference_existing_object>() )
 		.def( "setDefaultFormat", setDefaultFormatPtr2, return_value_policy<reference_existing_object>() ).staticmethod( "setDefaultFormat" )
 		.def( "getDefaultFormat", &Format::getDefaultFormat, return_value_policy<return_by_value>() ).staticmethod( "getDefaultFormat" )
 		.def( "removeAllFormats", &Format::removeAllFormats ).staticmethod( "removeAllFormats" )
 		.def( "registerFormat", registerFormatPtr1, return_value_policy<reference_existing_object>() )
 		.def( "registerFormat", registerFormatPtr2, return_value_policy<reference_existing_object>() ).staticmethod( "registerFormat" )
+		.def( "registerFormatDeferred", &Format::registerFormatDeferred, return_value_policy<reference_existing_object>() ).staticmethod( "registerFormatDeferred" )
 		.def( "removeFormat", removeFormatPtr1, return_value_policy<reference_existing_object>() )
 		.def( "removeFormat", removeFormatPtr2, return_value_policy<reference_existing_object>() ).staticmethod( "removeFormat" )
 		.def( "formatCount", &Format::formatCount, return_value_policy<return_by_value>() ).staticmethod( "formatCount" )
@@ -39,6 +39,7 @@
 
 #include "IECore/RunTimeTyped.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 #include "GafferImage/FormatPlug.h"
 #include "GafferImageBindings/FormatBinding.h"
 #include "GafferImageBindings/FormatPlugBinding.h"
@@ -49,6 +50,14 @@ using namespace GafferBindings;
 using namespace GafferImage;
 using namespace GafferImageBindings;
 
+static GafferImage::Format getValue( const FormatPlug *plug )
+{
+	// we release the GIL so that computations triggered from python can
+	// run concurrently on other threads.
+	IECorePython::ScopedGILRelease r;
+	return plug->getValue();
+}
+
 std::string FormatPlugSerialiser::constructor( const Gaffer::GraphComponent *graphComponent ) const
 {
 	object o( GraphComponentPtr( const_cast<GraphComponent *>( graphComponent ) ) );
@@ -133,7 +142,7 @@ void GafferImageBindings::bindFormatPlug()
 		.GAFFERBINDINGS_DEFPLUGWRAPPERFNS( FormatPlug )
 		.def( "defaultValue", &FormatPlug::defaultValue, return_value_policy<copy_const_reference>() )
 		.def( "setValue", &FormatPlug::setValue )
-		.def( "getValue", &FormatPlug::getValue )
+		.def( "getValue", &getValue )
 	;
 	
 	Serialisation::registerSerialiser( static_cast<IECore::TypeId>(FormatPlugTypeId), new FormatPlugSerialiser );
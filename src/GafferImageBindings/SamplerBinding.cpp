@@ -49,6 +49,28 @@ using namespace GafferImage;
 namespace GafferImageBindings
 {
 
+static FloatVectorDataPtr sampleRow( Sampler &sampler, int x, int y, int count )
+{
+	FloatVectorDataPtr result = new FloatVectorData;
+	if( count > 0 )
+	{
+		const float *row = sampler.sampleRow( x, y, count );
+		result->writable().assign( row, row + count );
+	}
+	return result;
+}
+
+static FloatVectorDataPtr sampleFilteredRow( Sampler &sampler, float x, float y, float step, int count )
+{
+	FloatVectorDataPtr result = new FloatVectorData;
+	if( count > 0 )
+	{
+		result->writable().resize( count );
+		sampler.sampleRow( x, y, step, count, &(result->writable()[0]) );
+	}
+	return result;
+}
+
 void bindSampler()
 {
 	enum_<Sampler::BoundingMode>( "BoundingMode" )
@@ -70,6 +92,9 @@ void bindSampler()
 		.def( "hash", &Sampler::hash )
 		.def( "sample", (float (Sampler::*)( int, int ) )&Sampler::sample )
 		.def( "sample", (float (Sampler::*)( float, float ) )&Sampler::sample )
+		.def( "sampleRow", &sampleRow )
+		.def( "sampleRow", &sampleFilteredRow )
+		.def( "prefetch", &Sampler::prefetch )
 	;
 }
 
@@ -38,6 +38,7 @@
 #include "boost/python.hpp"
 
 #include "IECorePython/ScopedGILRelease.h"
+#include "IECorePython/RefCountedBinding.h"
 
 #include "GafferBindings/DependencyNodeBinding.h"
 #include "GafferBindings/ExecutableBinding.h"
@@ -63,16 +64,35 @@
 #include "GafferImage/ImageWriter.h"
 #include "GafferImage/ImageTransform.h"
 #include "GafferImage/ImageStats.h"
+#include "GafferImage/MipMap.h"
+#include "GafferImage/ImageTiles.h"
 #include "GafferImageBindings/RemoveChannelsBinding.h"
 #include "GafferImageBindings/ChannelMaskPlugBindings.h"
 
 using namespace boost::python;
 using namespace GafferImage;
 
-static IECore::FloatVectorDataPtr channelData( const ImagePlug &plug,  const std::string &channelName, const Imath::V2i &tile  )
+static IECore::FloatVectorDataPtr channelData( const ImagePlug &plug,  const std::string &channelName, const Imath::V2i &tile, bool copy = true )
 {
+	IECore::ConstFloatVectorDataPtr d;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		d = plug.channelData( channelName, tile );
+	}
+	if( !d )
+	{
+		return 0;
+	}
+	return copy ? d->copy() : IECore::constPointerCast<IECore::FloatVectorData>( d );
+}
+
+static bool isUniformTile( const ImagePlug &plug, const std::string &channelName, const Imath::V2i &tile )
+{
+	// We can't bind ImagePlug::isUniformTile() directly, as the channelData()
+	// binding returns copies, which are never uniform tiles.
 	IECore::ConstFloatVectorDataPtr d = plug.channelData( channelName, tile );
-	return d ? d->copy() : 0;
+	float value;
+	return ImagePlug::isUniformTile( d.get(), value );
 }
 
 static IECore::ImagePrimitivePtr image( const ImagePlug &plug )
@@ -81,6 +101,46 @@ static IECore::ImagePrimitivePtr image( const ImagePlug &plug )
 	return plug.image();
 }
 
+static boost::python::list imageTilesTileOrigins( const Imath::Box2i &window )
+{
+	boost::python::list result;
+	const std::vector<Imath::V2i> origins = ImageTiles::tileOrigins( window );
+	for( std::vector<Imath::V2i>::const_iterator it = origins.begin(), eIt = origins.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+static size_t imageTilesUpdate( ImageTiles &imageTiles, const ImagePlug *image, const Imath::Box2i &window )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return imageTiles.update( image, window );
+}
+
+static size_t imageTilesNumTiles( const ImageTiles &imageTiles )
+{
+	return imageTiles.tiles().size();
+}
+
+static IECore::MurmurHash imageTilesTileHash( const ImageTiles &imageTiles, const Imath::V2i &tileOrigin )
+{
+	const ImageTiles::Tile *tile = imageTiles.tile( tileOrigin );
+	return tile ? tile->hash : IECore::MurmurHash();
+}
+
+static IECore::FloatVectorDataPtr imageTilesChannelData( const ImageTiles &imageTiles, const Imath::V2i &tileOrigin, const std::string &channelName )
+{
+	const std::string rgba( "RGBA" );
+	const size_t channelIndex = channelName.size() == 1 ? rgba.find( channelName ) : std::string::npos;
+	const ImageTiles::Tile *tile = imageTiles.tile( tileOrigin );
+	if( !tile || channelIndex == std::string::npos || !tile->channels[channelIndex] )
+	{
+		return 0;
+	}
+	return tile->channels[channelIndex]->copy();
+}
+
 BOOST_PYTHON_MODULE( _GafferImage )
 {
 	
@@ -95,8 +155,9 @@ BOOST_PYTHON_MODULE( _GafferImage )
 				)
 			)	
 		)
-		.def( "channelData", &channelData )
+		.def( "channelData", &channelData, ( boost::python::arg_( "_copy" ) = true ) )
 		.def( "channelDataHash", &ImagePlug::channelDataHash )
+		.def( "isUniformTile", &isUniformTile )
 		.def( "image", &image )
 		.def( "imageHash", &ImagePlug::imageHash )
 		.def( "tileSize", &ImagePlug::tileSize ).staticmethod( "tileSize" )
@@ -104,14 +165,24 @@ BOOST_PYTHON_MODULE( _GafferImage )
 		.def( "tileOrigin", &ImagePlug::tileOrigin ).staticmethod( "tileOrigin" )
 	;
 
-	GafferBindings::DependencyNodeClass<ImageNode>();
-	GafferBindings::DependencyNodeClass<ImageReader>();
+	GafferBindings::DependencyNodeClass<ImageNode>()
+		.def( "halfTileStorage", &ImageNode::halfTileStorage ).staticmethod( "halfTileStorage" )
+		.def( "getHalfTileCacheMemoryLimit", &ImageNode::getHalfTileCacheMemoryLimit ).staticmethod( "getHalfTileCacheMemoryLimit" )
+		.def( "setHalfTileCacheMemoryLimit", &ImageNode::setHalfTileCacheMemoryLimit ).staticmethod( "setHalfTileCacheMemoryLimit" )
+		.def( "halfTileCacheMemoryUsage", &ImageNode::halfTileCacheMemoryUsage ).staticmethod( "halfTileCacheMemoryUsage" )
+	;
+	GafferBindings::DependencyNodeClass<ImageReader>()
+		.def( "numMipLevels", &ImageReader::numMipLevels )
+	;
 	GafferBindings::DependencyNodeClass<ImagePrimitiveNode>();
 	GafferBindings::DependencyNodeClass<Display>()
 		.def( "dataReceivedSignal", &Display::dataReceivedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "dataReceivedSignal" )
 		.def( "imageReceivedSignal", &Display::imageReceivedSignal, return_value_policy<reference_existing_object>() ).staticmethod( "imageReceivedSignal" )
 	;
-	GafferBindings::DependencyNodeClass<ImageProcessor>();
+	GafferBindings::DependencyNodeClass<ImageProcessor>()
+		.def( "tilesSkipped", &ImageProcessor::tilesSkipped ).staticmethod( "tilesSkipped" )
+		.def( "resetTilesSkipped", &ImageProcessor::resetTilesSkipped ).staticmethod( "resetTilesSkipped" )
+	;
 	GafferBindings::DependencyNodeClass<FilterProcessor>();
 	GafferBindings::DependencyNodeClass<ChannelDataProcessor>();
 	GafferBindings::DependencyNodeClass<OpenColorIO>();
@@ -123,6 +194,21 @@ BOOST_PYTHON_MODULE( _GafferImage )
 	GafferBindings::DependencyNodeClass<Reformat>();
 	GafferBindings::DependencyNodeClass<ImageTransform>();
 	GafferBindings::DependencyNodeClass<ImageStats>();
+	GafferBindings::DependencyNodeClass<MipMap>()
+		.def( "maxLevel", &MipMap::maxLevel ).staticmethod( "maxLevel" )
+		.def( "levelWindow", &MipMap::levelWindow ).staticmethod( "levelWindow" )
+	;
+	IECorePython::RefCountedClass<ImageTiles, IECore::RefCounted>( "ImageTiles" )
+		.def( init<>() )
+		.def( "tileOrigins", &imageTilesTileOrigins ).staticmethod( "tileOrigins" )
+		.def( "update", &imageTilesUpdate )
+		.def( "clear", &ImageTiles::clear )
+		.def( "window", &ImageTiles::window, return_value_policy<copy_const_reference>() )
+		.def( "numTiles", &imageTilesNumTiles )
+		.def( "tileHash", &imageTilesTileHash )
+		.def( "channelData", &imageTilesChannelData )
+		.def( "sample", &ImageTiles::sample )
+	;
 	GafferImageBindings::bindRemoveChannels();
 	GafferImageBindings::bindFormat();
 	GafferImageBindings::bindFormatPlug();
@@ -36,8 +36,10 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <math.h>
+#include <map>
 
 #include "boost/bind.hpp"
+#include "boost/function.hpp"
 #include "boost/bind/placeholders.hpp"
 #include "boost/format.hpp"
 
@@ -45,7 +47,6 @@
 #include "IECore/BoxOps.h"
 #include "IECore/BoxAlgo.h"
 
-#include "IECoreGL/ToGLTextureConverter.h"
 #include "IECoreGL/TextureLoader.h"
 #include "IECoreGL/Texture.h"
 #include "IECoreGL/ShaderLoader.h"
@@ -59,6 +60,9 @@
 #include "GafferUI/Pointer.h"
 
 #include "GafferImage/Format.h"
+#include "GafferImage/ImageReader.h"
+#include "GafferImage/MipMap.h"
+#include "GafferImage/ImageTiles.h"
 
 #include "GafferImageUI/ImageView.h"
 
@@ -82,8 +86,14 @@ class ImageViewGadget : public GafferUI::Gadget
 
 	public :
 
+		typedef boost::function<void ( int, const Imath::Box2i & )> TilesRequestFunction;
+
+		/// The tilesRequest function is called when the zoom or panning
+		/// of the viewport is such that a different mip level, or tiles
+		/// from a different part of the image, are needed. The gadget is
+		/// then given them with setImage().
 		ImageViewGadget(
-			IECore::ConstImagePrimitivePtr image,
+			TilesRequestFunction tilesRequest,
 			GafferImage::ImageStatsPtr imageStats,
 			int &channelToView,
 			Imath::V2f &mousePos,
@@ -93,11 +103,8 @@ class ImageViewGadget : public GafferUI::Gadget
 			Color4f &averageColor
 		)
 			:	Gadget( defaultName<ImageViewGadget>() ),
-				m_displayBound( image->bound() ),
-				m_displayWindow( image->getDisplayWindow() ),
-				m_dataWindow( image->getDataWindow() ),
-				m_image( image->copy() ),
-				m_texture( 0 ),
+				m_mipLevel( 0 ),
+				m_tilesRequest( tilesRequest ),
 				m_mousePos( mousePos ),
 				m_sampleColor( 0.f),
 				m_dragSelecting( false ),
@@ -105,28 +112,6 @@ class ImageViewGadget : public GafferUI::Gadget
 				m_channelToView( channelToView ),
 				m_imageStats( imageStats )
 		{
-			V3f dataMin( m_dataWindow.min.x, m_dataWindow.min.y, 0.f );
-			V3f dataMax( 1.f + m_dataWindow.max.x, 1.f + m_dataWindow.max.y, 0.f );
-			V3f dataCenter = ( dataMin + dataMax ) / 2.f;
-			
-			V3f dispMin( m_displayWindow.min.x, m_displayWindow.min.y, 0.f );
-			V3f dispMax( 1.f + m_displayWindow.max.x, 1.f + m_displayWindow.max.y, 0.f );
-			V3f dispCenter = ( dispMin + dispMax ) / 2.f;
-
-			const int yOffset = ( m_displayWindow.min.y + m_displayWindow.size().y + 1 ) - m_dataWindow.min.y;
-			m_dataBound = Box3f(
-				V3f(
-					dataMin.x - dispCenter.x,
-					( yOffset - ( m_dataWindow.size().y + 1 ) ) - dispCenter.y,
-					0.f
-				),
-				V3f(
-					dataMax.x - dispCenter.x,
-					( yOffset ) - dispCenter.y,
-					0.f
-				)
-			);
-
 			keyPressSignal().connect( boost::bind( &ImageViewGadget::keyPress, this, ::_1,  ::_2 ) );
 			buttonPressSignal().connect( boost::bind( &ImageViewGadget::buttonPress, this, ::_1,  ::_2 ) );
 			buttonReleaseSignal().connect( boost::bind( &ImageViewGadget::buttonRelease, this, ::_1,  ::_2 ) );
@@ -136,8 +121,6 @@ class ImageViewGadget : public GafferUI::Gadget
 			dragEndSignal().connect( boost::bind( &ImageViewGadget::dragEnd, this, ::_1, ::_2 ) );
 			mouseMoveSignal().connect( boost::bind( &ImageViewGadget::mouseMove, this, ::_1, ::_2 ) );
 
-			sampleColor = ImageViewGadget::sampleColor( mousePos );
-
 			// Create some useful structs that we will use to hold information needed
 			// to draw the UI elements that display the color readouts to the screen.	
 			m_colorUiElements.reserve(4);
@@ -160,6 +143,65 @@ class ImageViewGadget : public GafferUI::Gadget
 		{
 		};
 
+		/// Sets the image to be displayed. The display and data windows are those of
+		/// the full resolution image, with the data window flipped as for
+		/// ImagePlug::image(). The tiles may be from a lower resolution mip level,
+		/// with the specified display window, in which case they are stretched to
+		/// fill the full resolution display window. The tileWindow is the full
+		/// resolution window the tiles were requested for.
+		void setImage(
+			const Imath::Box2i &displayWindow,
+			const Imath::Box2i &dataWindow,
+			const Imath::Box2i &levelDisplayWindow,
+			int mipLevel,
+			const Imath::Box2i &tileWindow,
+			GafferImage::ConstImageTilesPtr tiles
+		)
+		{
+			m_displayWindow = displayWindow;
+			m_dataWindow = dataWindow;
+			m_levelDisplayWindow = levelDisplayWindow;
+			m_mipLevel = mipLevel;
+			m_tileWindow = tileWindow;
+			m_tiles = tiles;
+
+			V3f dataMin( m_dataWindow.min.x, m_dataWindow.min.y, 0.f );
+			V3f dataMax( 1.f + m_dataWindow.max.x, 1.f + m_dataWindow.max.y, 0.f );
+			
+			V3f dispMin( m_displayWindow.min.x, m_displayWindow.min.y, 0.f );
+			V3f dispMax( 1.f + m_displayWindow.max.x, 1.f + m_displayWindow.max.y, 0.f );
+			m_displayCenter = ( dispMin + dispMax ) / 2.f;
+			m_displayBound = Box3f( dispMin - m_displayCenter, dispMax - m_displayCenter );
+
+			const int yOffset = ( m_displayWindow.min.y + m_displayWindow.size().y + 1 ) - m_dataWindow.min.y;
+			m_dataBound = Box3f(
+				V3f(
+					dataMin.x - m_displayCenter.x,
+					( yOffset - ( m_dataWindow.size().y + 1 ) ) - m_displayCenter.y,
+					0.f
+				),
+				V3f(
+					dataMax.x - m_displayCenter.x,
+					( yOffset ) - m_displayCenter.y,
+					0.f
+				)
+			);
+			
+			// The data window in the unflipped pixel space of the tiles.
+			m_pixelDataWindow = Box2i(
+				V2i( m_dataWindow.min.x, m_displayWindow.max.y - m_dataWindow.max.y ),
+				V2i( m_dataWindow.max.x, m_displayWindow.max.y - m_dataWindow.min.y )
+			);
+			
+			m_levelScale = V2f(
+				float( m_displayWindow.size().x + 1 ) / ( m_levelDisplayWindow.size().x + 1 ),
+				float( m_displayWindow.size().y + 1 ) / ( m_levelDisplayWindow.size().y + 1 )
+			);
+
+			*m_colorUiElements[0].color = sampleColor( m_mousePos );
+			renderRequestSignal()( this );
+		}
+
 		virtual Imath::Box3f bound() const
 		{
 			///\todo: Return an extended bounding box here which includes the infoBox() UI element.
@@ -235,8 +277,72 @@ class ImageViewGadget : public GafferUI::Gadget
 			return g_shader.get();
 		}
 
-		void renderImageWindow( const Imath::Box2f &box, const IECoreGL::Texture *texture, int channelToView ) const
+		/// Returns a texture for the tile, reusing the one from the last
+		/// render if the tile hasn't changed since.
+		const IECoreGL::Texture *tileTexture( const V2i &tileOrigin, const ImageTiles::Tile &tile ) const
+		{
+			TextureMap::iterator it = m_textures.find( tileOrigin );
+			if( it != m_textures.end() && it->second.first == tile.hash )
+			{
+				return it->second.second.get();
+			}
+			
+			// Interleave the channels, with missing channels
+			// treated as black and missing alpha as opaque.
+			const int tileSize = ImagePlug::tileSize();
+			const size_t numPixels = tileSize * tileSize;
+			std::vector<float> interleaved( numPixels * 4 );
+			for( int c = 0; c < 4; ++c )
+			{
+				const float *in = tile.channels[c] ? &(tile.channels[c]->readable()[0]) : 0;
+				const float missing = c == 3 ? 1.0f : 0.0f;
+				float *out = &(interleaved[c]);
+				for( size_t i = 0; i < numPixels; ++i, out += 4 )
+				{
+					*out = in ? in[i] : missing;
+				}
+			}
+
+			GLuint textureName;
+			glGenTextures( 1, &textureName );
+			IECoreGL::TexturePtr texture = new IECoreGL::Texture( textureName );
+			{
+				Texture::ScopedBinding scope( *texture );
+				glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+				glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA16F_ARB, tileSize, tileSize, 0, GL_RGBA, GL_FLOAT, &interleaved[0] );
+				// Nearest filtering and edge clamping keep the seams between
+				// tiles invisible.
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+				glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+			}
+			
+			m_textures[tileOrigin] = TextureMap::mapped_type( tile.hash, texture );
+			return texture.get();
+		}
+
+		/// Draws the tiles which intersect the visible region, uploading
+		/// textures for any which have changed since the last render.
+		void renderTiles( const Imath::Box2f &visibleBound, int channelToView ) const
 		{
+			// Discard the textures for tiles we no longer hold.
+			const ImageTiles::TileMap &tiles = m_tiles->tiles();
+			for( TextureMap::iterator it = m_textures.begin(); it != m_textures.end(); )
+			{
+				TextureMap::iterator next = it; next++;
+				if( tiles.find( it->first ) == tiles.end() )
+				{
+					m_textures.erase( it );
+				}
+				it = next;
+			}
+			
+			if( tiles.empty() )
+			{
+				return;
+			}
+
 			glPushAttrib( GL_COLOR_BUFFER_BIT );
 
 			glEnable( GL_BLEND );
@@ -244,10 +350,9 @@ class ImageViewGadget : public GafferUI::Gadget
 
 			glEnable( GL_TEXTURE_2D );
 			glActiveTexture( GL_TEXTURE0 );
-			texture->bind();
 
 			IECoreGL::Shader::SetupPtr setup( new IECoreGL::Shader::Setup( shader() ) );
-			setup->addUniformParameter( "texture", texture );
+			setup->addUniformParameter( "texture", tileTexture( tiles.begin()->first, tiles.begin()->second ) );
 
 			const IECore::IntDataPtr channelToViewData( new IECore::IntData( channelToView ) );
 			setup->addUniformParameter( "channelToView", IECore::staticPointerCast<const IECore::Data>( channelToViewData ) );
@@ -255,18 +360,34 @@ class ImageViewGadget : public GafferUI::Gadget
 
 			glColor3f( 1.0f, 1.0f, 1.0f );
 
-			glBegin( GL_QUADS );
-
-			glTexCoord2f( 1, 0 );
-			glVertex2f( box.max.x, box.min.y );
-			glTexCoord2f( 1, 1 );
-			glVertex2f( box.max.x, box.max.y );
-			glTexCoord2f( 0, 1 );
-			glVertex2f( box.min.x, box.max.y );	
-			glTexCoord2f( 0, 0 );
-			glVertex2f( box.min.x, box.min.y );
+			const float tileSize = ImagePlug::tileSize();
+			for( ImageTiles::TileMap::const_iterator it = tiles.begin(), eIt = tiles.end(); it != eIt; ++it )
+			{
+				const Box2f box(
+					levelToGadgetSpace( V2f( it->first ) ),
+					levelToGadgetSpace( V2f( it->first ) + V2f( tileSize ) )
+				);
+				if( !box.intersects( visibleBound ) )
+				{
+					continue;
+				}
 
-			glEnd();
+				glActiveTexture( GL_TEXTURE0 );
+				tileTexture( it->first, it->second )->bind();
+				
+				glBegin( GL_QUADS );
+
+				glTexCoord2f( 1, 0 );
+				glVertex2f( box.max.x, box.min.y );
+				glTexCoord2f( 1, 1 );
+				glVertex2f( box.max.x, box.max.y );
+				glTexCoord2f( 0, 1 );
+				glVertex2f( box.min.x, box.max.y );	
+				glTexCoord2f( 0, 0 );
+				glVertex2f( box.min.x, box.min.y );
+
+				glEnd();
+			}
 
 			glPopAttrib();
 		}
@@ -329,6 +450,18 @@ class ImageViewGadget : public GafferUI::Gadget
 					);
 		}
 
+		/// Returns the part of the gadget which is visible in the viewport.
+		Box2f visibleGadgetBound() const
+		{
+			const ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
+			const LineSegment3f l0 = viewportGadget->rasterToGadgetSpace( V2f( 0 ), this );
+			const LineSegment3f l1 = viewportGadget->rasterToGadgetSpace( V2f( viewportGadget->getViewport() ), this );
+			Box2f result;
+			result.extendBy( V2f( l0.p0.x, l0.p0.y ) );
+			result.extendBy( V2f( l1.p0.x, l1.p0.y ) );
+			return result;
+		}
+
 		/// Transforms and returns a point from raster space to display space.
 		V2f rasterToDisplaySpace( const V2f &point ) const
 		{
@@ -359,39 +492,34 @@ class ImageViewGadget : public GafferUI::Gadget
 			return Box2f( gadgetToDisplaySpace( box.min ), gadgetToDisplaySpace( box.max ) );
 		}
 
+		/// Transforms a point from the pixel space of the mip level
+		/// being displayed into gadget space.
+		V2f levelToGadgetSpace( const V2f &point ) const
+		{
+			return V2f(
+				m_displayWindow.min.x + ( point.x - m_levelDisplayWindow.min.x ) * m_levelScale.x - m_displayCenter.x,
+				m_displayWindow.min.y + ( point.y - m_levelDisplayWindow.min.y ) * m_levelScale.y - m_displayCenter.y
+			);
+		}
+
 		/// Samples a color from the image.
-		///\todo: This method currently samples a pixel from the ImagePrimitive and this means that the sampled colour is the result of the image preprocessor.
+		///\todo: This method currently samples a pixel from the tiles we display and this means that the sampled colour is the result of the image preprocessor.
 		/// Instead we should really be sampling from the input image plug so that the user is presented with raw colour data.
 		Color4f sampleColor( const V2f &point ) const
 		{
-			V2i samplePos(
-				fastFloatRound( point.x - .5 ) - m_dataWindow.min.x,
-				( ( m_displayWindow.max.y - fastFloatRound( point.y - .5 ) ) - m_dataWindow.min.y )
-			);
-			
-			if ( samplePos.x < 0 || samplePos.y < 0 || samplePos.x > m_dataWindow.size().x || samplePos.y > m_dataWindow.size().y )
+			if( !m_tiles )
 			{
-				return Color4f( 0.f, 0.f, 0.f, 0.f );
-			}
-
-			Color4f color;
-			std::vector<std::string> channelNames;
-			m_image->channelNames( channelNames );
-			std::string channel[4] = { "R", "G", "B", "A" };
-			for ( int c = 0; c < 4; ++c )
-			{
-				if ( std::find( channelNames.begin(), channelNames.end(), channel[c] ) != channelNames.end() )
-				{
-					const std::vector<float> &channelData = m_image->getChannel<float>( channel[c] )->readable();
-					color[c] = channelData[ samplePos.y * ( m_dataWindow.size().x + 1 ) + samplePos.x ];
-				}
-				else
-				{
-					color[c] = 0.f;
-				}
+				return Color4f( 0.f );
 			}
-
-			return color;
+			
+			// Find the pixel in the mip level we hold, which may be at
+			// a lower resolution than our display window.
+			const V2i levelPos(
+				m_levelDisplayWindow.min.x + fastFloatFloor( ( fastFloatRound( point.x - .5 ) - m_displayWindow.min.x ) / m_levelScale.x ),
+				m_levelDisplayWindow.min.y + fastFloatFloor( ( fastFloatRound( point.y - .5 ) - m_displayWindow.min.y ) / m_levelScale.y )
+			);
+			
+			return m_tiles->sample( levelPos );
 		};
 
 		bool buttonRelease( GadgetPtr gadget, const ButtonEvent &event )
@@ -594,18 +722,9 @@ class ImageViewGadget : public GafferUI::Gadget
 
 		virtual void doRender( const Style *style ) const
 		{
-
-			if( !m_texture )
+			if( !m_tiles )
 			{
-				// convert image to texture
-				ToGLTextureConverterPtr converter = new ToGLTextureConverter( staticPointerCast<const ImagePrimitive>( m_image ), true );
-				m_texture = IECore::runTimeCast<IECoreGL::Texture>( converter->convert() );
-
-				{
-					Texture::ScopedBinding scope( *m_texture );
-					glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
-					glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
-				}
+				return;
 			}
 
 			// Transform them to Raster Space
@@ -617,6 +736,48 @@ class ImageViewGadget : public GafferUI::Gadget
 			Box2f dispRasterBox( displayRasterBox() );
 			Box2f dataRasterBox( ImageViewGadget::dataRasterBox() );
 
+			// Request a lower resolution mip level if we're zoomed out far enough
+			// that each pixel on screen covers several pixels of the image, or a
+			// higher one if we've zoomed back in.
+			const float imagePixelsPerRasterPixel = float( m_displayWindow.size().x + 1 ) / std::max( 1.f, fabsf( dispRasterBox.size().x ) );
+			int mipLevel = 0;
+			while( mipLevel < MipMap::maxLevel() && imagePixelsPerRasterPixel >= float( 1 << ( mipLevel + 1 ) ) )
+			{
+				mipLevel++;
+			}
+			
+			// Find the part of the image which is visible, and request the tiles
+			// for it if we don't have them already. We ask for a margin around the
+			// visible region so that we needn't make a new request every time the
+			// viewport is panned a little.
+			const Box2f visibleBound = visibleGadgetBound();
+			const Box2i visibleWindow = boxIntersection(
+				Box2i(
+					V2i( fastFloatFloor( visibleBound.min.x + m_displayCenter.x ), fastFloatFloor( visibleBound.min.y + m_displayCenter.y ) ),
+					V2i( fastFloatFloor( visibleBound.max.x + m_displayCenter.x ), fastFloatFloor( visibleBound.max.y + m_displayCenter.y ) )
+				),
+				m_pixelDataWindow
+			);
+			
+			const bool covered =
+				visibleWindow.isEmpty() ||
+				(
+					m_tileWindow.min.x <= visibleWindow.min.x && m_tileWindow.min.y <= visibleWindow.min.y &&
+					m_tileWindow.max.x >= visibleWindow.max.x && m_tileWindow.max.y >= visibleWindow.max.y
+				);
+			
+			if( m_tilesRequest && ( mipLevel != m_mipLevel || !covered ) )
+			{
+				Box2i requestWindow = visibleWindow;
+				if( !requestWindow.isEmpty() )
+				{
+					const V2i margin = ( requestWindow.size() + V2i( 1 ) ) / 2;
+					requestWindow.min -= margin;
+					requestWindow.max += margin;
+				}
+				m_tilesRequest( mipLevel, requestWindow );
+			}
+
 			{
 				ViewportGadget::RasterScope rasterScope( viewportGadget );
 
@@ -627,11 +788,7 @@ class ImageViewGadget : public GafferUI::Gadget
 			}
 
 			// Draw the image data.
-			{
-				// Get the bounds of the data window in Gadget space.
-				Box2f b( V2f( m_dataBound.min.x, m_dataBound.min.y ), V2f( m_dataBound.max.x, m_dataBound.max.y ) );
-				renderImageWindow( b, (const Texture *)m_texture.get(), m_channelToView );
-			}
+			renderTiles( visibleBound, m_channelToView );
 
 			ViewportGadget::RasterScope rasterScope( viewportGadget );
 
@@ -838,12 +995,22 @@ class ImageViewGadget : public GafferUI::Gadget
 			Imath::Box2f swatchBox;
 		};
 
+		typedef std::pair<IECore::MurmurHash, IECoreGL::ConstTexturePtr> TextureAndHash;
+		typedef std::map<Imath::V2i, TextureAndHash, ImageTiles::OriginLess> TextureMap;
+
 		Imath::Box3f m_displayBound;
 		Imath::Box3f m_dataBound;
+		Imath::V3f m_displayCenter;
 		Imath::Box2i m_displayWindow;
 		Imath::Box2i m_dataWindow;
-		ConstImagePrimitivePtr m_image;
-		mutable ConstTexturePtr m_texture;
+		Imath::Box2i m_pixelDataWindow;
+		Imath::Box2i m_levelDisplayWindow;
+		Imath::V2f m_levelScale;
+		int m_mipLevel;
+		Imath::Box2i m_tileWindow;
+		GafferImage::ConstImageTilesPtr m_tiles;
+		mutable TextureMap m_textures;
+		TilesRequestFunction m_tilesRequest;
 
 		Imath::V2f &m_mousePos;
 		Imath::V3f m_dragStartPosition;
@@ -874,6 +1041,8 @@ ImageView::ViewDescription<ImageView> ImageView::g_viewDescription( GafferImage:
 
 ImageView::ImageView( const std::string &name )
 	:	View( name, new GafferImage::ImagePlug() ),
+		m_mipLevel( 0 ),
+		m_tiles( new ImageTiles ),
 		m_channelToView(0),
 		m_mousePos(0.),
 		m_sampleColor(0.),
@@ -883,10 +1052,15 @@ ImageView::ImageView( const std::string &name )
 {
 	// Create an internal ImageStats node 
 	addChild( new GafferImage::ImageStats( "imageStats" ) );
+	// And the nodes used to provide mip levels
+	addChild( new GafferImage::MipMap( "mipMap" ) );
+	addChild( new GafferImage::ImageReader( "mipMapReader" ) );
 }
 
 ImageView::ImageView( const std::string &name, Gaffer::PlugPtr input )
 	:	View( name, input ),
+		m_mipLevel( 0 ),
+		m_tiles( new ImageTiles ),
 		m_channelToView(0),
 		m_mousePos( 0. ),
 		m_sampleColor(0.),
@@ -896,6 +1070,9 @@ ImageView::ImageView( const std::string &name, Gaffer::PlugPtr input )
 {
 	// Create an internal ImageStats node 
 	addChild( new GafferImage::ImageStats( "imageStats" ) );
+	// And the nodes used to provide mip levels
+	addChild( new GafferImage::MipMap( "mipMap" ) );
+	addChild( new GafferImage::ImageReader( "mipMapReader" ) );
 }
 
 ImageView::~ImageView()
@@ -912,9 +1089,60 @@ const GafferImage::ImageStats *ImageView::imageStatsNode() const
 	return getChild<ImageStats>( "imageStats" );
 }
 
+GafferImage::MipMap *ImageView::mipMapNode()
+{
+	return getChild<MipMap>( "mipMap" );
+}
+
+GafferImage::ImageReader *ImageView::mipMapReaderNode()
+{
+	return getChild<ImageReader>( "mipMapReader" );
+}
+
+const GafferImage::ImagePlug *ImageView::mipLevelPlug( const GafferImage::ImagePlug *imagePlug )
+{
+	if( m_mipLevel == 0 )
+	{
+		return imagePlug;
+	}
+
+	// If the image is coming straight from a file containing mip levels, then we
+	// can read the level we want directly.
+	const ImageReader *reader = runTimeCast<const ImageReader>( imagePlug->source<ImagePlug>()->node() );
+	if( reader && reader->mipLevelPlug()->getValue() == 0 && reader->numMipLevels() > m_mipLevel )
+	{
+		ImageReader *mipMapReader = mipMapReaderNode();
+		mipMapReader->fileNamePlug()->setValue( reader->fileNamePlug()->getValue() );
+		mipMapReader->mipLevelPlug()->setValue( m_mipLevel );
+		return mipMapReader->outPlug();
+	}
+	
+	// Otherwise we compute it.
+	MipMap *mipMap = mipMapNode();
+	if( mipMap->inPlug()->getInput<ImagePlug>() != imagePlug )
+	{
+		mipMap->inPlug()->setInput( const_cast<ImagePlug *>( imagePlug ) );
+	}
+	mipMap->levelPlug()->setValue( m_mipLevel );
+	return mipMap->outPlug();
+}
+
+void ImageView::tilesRequest( int mipLevel, const Imath::Box2i &window )
+{
+	if( mipLevel == m_mipLevel && window == m_tileWindow )
+	{
+		return;
+	}
+	m_mipLevel = mipLevel;
+	m_tileWindow = window;
+	updateRequestSignal()( this );
+}
+
 void ImageView::update()
 {
-	IECore::ConstImagePrimitivePtr image = 0;
+	Box2i displayWindow;
+	Box2i dataWindow;
+	Box2i levelDisplayWindow;
 	{
 		Context::Scope context( getContext() );
 		ImagePlug *imagePlug = preprocessedInPlug<ImagePlug>();
@@ -922,31 +1150,64 @@ void ImageView::update()
 		{
 			throw IECore::Exception( "ImageView::preprocessedInPlug() is not an ImagePlug" );
 		}
-		image = imagePlug->image();
+		
+		// The gadget draws the full resolution windows, using the same
+		// flipped y axis as ImagePlug::image().
+		displayWindow = imagePlug->formatPlug()->getValue().getDisplayWindow();
+		dataWindow = imagePlug->dataWindowPlug()->getValue();
+		if( dataWindow.isEmpty() )
+		{
+			dataWindow = Box2i( V2i( 0 ) );
+		}
+		else
+		{
+			dataWindow = Box2i(
+				V2i( dataWindow.min.x, displayWindow.max.y - dataWindow.max.y ),
+				V2i( dataWindow.max.x, displayWindow.max.y - dataWindow.min.y )
+			);
+		}
+		
+		// But we only compute the tiles which are visible, at the
+		// resolution needed for the current zoom. Tiles which are
+		// unchanged since the last update are reused.
+		const ImagePlug *levelPlug = mipLevelPlug( imagePlug );
+		levelDisplayWindow = levelPlug->formatPlug()->getValue().getDisplayWindow();
+		Box2i levelWindow = MipMap::levelWindow( m_tileWindow, m_mipLevel );
+		if( !levelWindow.isEmpty() )
+		{
+			// Allow for the rounding of the window to the level.
+			levelWindow.min -= V2i( 1 );
+			levelWindow.max += V2i( 1 );
+		}
+		m_tiles->update( levelPlug, levelWindow );
 	}
 
-	if( image )
+	GafferImage::ImagePlug *imagePlug( inPlug<ImagePlug>() ? inPlug<ImagePlug>() : preprocessedInPlug<ImagePlug>() );
+	if( !imagePlug )
 	{
-		GafferImage::ImagePlug *imagePlug( inPlug<ImagePlug>() ? inPlug<ImagePlug>() : preprocessedInPlug<ImagePlug>() );
-		if( !imagePlug )
-		{
-			throw IECore::Exception("ImageView: Failed to find an input ImagePlug");
-		}
+		throw IECore::Exception("ImageView: Failed to find an input ImagePlug");
+	}
 
-		imageStatsNode()->inPlug()->setInput( imagePlug );
-		imageStatsNode()->channelsPlug()->setInput( imagePlug->channelNamesPlug() );
+	imageStatsNode()->inPlug()->setInput( imagePlug );
+	imageStatsNode()->channelsPlug()->setInput( imagePlug->channelNamesPlug() );
 
-		Detail::ImageViewGadgetPtr imageViewGadget = new Detail::ImageViewGadget( image, imageStatsNode(), m_channelToView, m_mousePos, m_sampleColor, m_minColor, m_maxColor, m_averageColor );
-		bool hadChild = viewportGadget()->getChild<Gadget>();
-		viewportGadget()->setChild( imageViewGadget );
-		if( !hadChild )
-		{
-			viewportGadget()->frame( imageViewGadget->bound() );
-		}
+	// We reuse the existing gadget if we have one, so that it can keep
+	// the textures for the tiles which haven't changed.
+	Detail::ImageViewGadgetPtr imageViewGadget = dynamic_cast<Detail::ImageViewGadget *>( viewportGadget()->getChild<Gadget>() );
+	const bool newGadget = !imageViewGadget;
+	if( newGadget )
+	{
+		imageViewGadget = new Detail::ImageViewGadget(
+			boost::bind( &ImageView::tilesRequest, this, ::_1, ::_2 ),
+			imageStatsNode(), m_channelToView, m_mousePos, m_sampleColor, m_minColor, m_maxColor, m_averageColor
+		);
 	}
-	else
+	
+	imageViewGadget->setImage( displayWindow, dataWindow, levelDisplayWindow, m_mipLevel, m_tileWindow, m_tiles );
+	
+	if( newGadget )
 	{
-		viewportGadget()->setChild( 0 );	
+		viewportGadget()->setChild( imageViewGadget );
+		viewportGadget()->frame( imageViewGadget->bound() );
 	}
 }
-
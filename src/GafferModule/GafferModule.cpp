@@ -63,6 +63,7 @@
 #include "GafferBindings/ProceduralHolderBinding.h"
 #include "GafferBindings/PreferencesBinding.h"
 #include "GafferBindings/ContextBinding.h"
+#include "GafferBindings/BackgroundTaskBinding.h"
 #include "GafferBindings/BoxPlugBinding.h"
 #include "GafferBindings/ExpressionBinding.h"
 #include "GafferBindings/TransformPlugBinding.h"
@@ -115,6 +116,7 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindProceduralHolder();
 	bindPreferences();
 	bindContext();
+	bindBackgroundTask();
 	bindBoxPlug();
 	bindExpression();
 	bindTransformPlug();
@@ -197,7 +197,7 @@ IECore::ConstObjectPtr AttributeCache::computeProcessedObject( const ScenePath &
 		return inputGeometry;
 	}
 	
-	IECore::PrimitivePtr result = inputGeometry->copy();
+	IECore::PrimitivePtr result = shallowCopy( inputGeometry.get() );
 	for( std::vector<IECore::InterpolatedCache::AttributeHandle>::const_iterator it = attributeNames.begin(); it!=attributeNames.end(); it++ )
 	{
 		if( it->value().compare( 0, 8, "primVar:" )==0 )
@@ -94,7 +94,7 @@ IECore::ConstCompoundObjectPtr Attributes::computeProcessedAttributes( const Sce
 		return inputAttributes;
 	}
 	
-	CompoundObjectPtr result = inputAttributes->copy();
+	CompoundObjectPtr result = shallowCopy( inputAttributes.get() );
 	ap->fillCompoundObject( result->members() );
 	
 	return result;
@@ -175,7 +175,7 @@ IECore::ConstCompoundObjectPtr Displays::computeProcessedGlobals( const Gaffer::
 		return inputGlobals;
 	}
 	
-	CompoundObjectPtr result = inputGlobals->copy();
+	CompoundObjectPtr result = shallowCopy( inputGlobals.get() );
 	
 	// add our displays to the result
 	for( InputCompoundPlugIterator it( dsp ); it != it.end(); it++ )
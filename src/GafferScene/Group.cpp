@@ -445,7 +445,7 @@ IECore::ConstInternedStringVectorDataPtr Group::computeChildNames( const ScenePa
 
 IECore::ConstCompoundObjectPtr Group::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	IECore::CompoundObjectPtr result = inPlug()->globalsPlug()->getValue()->copy();
+	IECore::CompoundObjectPtr result = shallowCopy( inPlug()->globalsPlug()->getValue().get() );
 	
 	std::string groupName = namePlug()->getValue();
 
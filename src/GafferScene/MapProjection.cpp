@@ -181,7 +181,7 @@ IECore::ConstObjectPtr MapProjection::computeProcessedObject( const ScenePath &p
 	
 	// do the work
 	
-	PrimitivePtr result = inputPrimitive->copy();
+	PrimitivePtr result = shallowCopy( inputPrimitive );
 	
 	FloatVectorDataPtr sData = new FloatVectorData();
 	FloatVectorDataPtr tData = new FloatVectorData();
@@ -141,7 +141,9 @@ IECore::ConstObjectPtr MeshType::computeProcessedObject( const ScenePath &path,
 		return inputObject;
 	}
 	
-	IECore::MeshPrimitivePtr result = inputGeometry->copy();
+	// MeshNormalsOp replaces "N" rather than modifying it, so it is safe to share
+	// the input variables.
+	IECore::MeshPrimitivePtr result = IECore::staticPointerCast<IECore::MeshPrimitive>( shallowCopy( inputGeometry ) );
 	result->setInterpolation( meshType );
 	if( meshType != "linear" )
 	{
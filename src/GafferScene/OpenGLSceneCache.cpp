@@ -0,0 +1,405 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <map>
+
+#include "tbb/parallel_for.h"
+#include "tbb/atomic.h"
+
+#include "IECore/MessageHandler.h"
+#include "IECore/WorldBlock.h"
+#include "IECore/NullObject.h"
+
+#include "IECoreGL/Renderer.h"
+#include "IECoreGL/Scene.h"
+#include "IECoreGL/Group.h"
+#include "IECoreGL/State.h"
+#include "IECoreGL/NameStateComponent.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
+
+#include "GafferScene/OpenGLSceneCache.h"
+#include "GafferScene/SceneProcedural.h"
+
+using namespace std;
+using namespace tbb;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+std::string locationName( const ScenePlug::ScenePath &path )
+{
+	std::string result;
+	for( ScenePlug::ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
+	{
+		result += "/" + it->string();
+	}
+	return result;
+}
+
+// Renders the contents of a single location, without recursing
+// to the children. The full attributes are used so that the contents
+// don't depend on any state inherited from the parent groups.
+class LocationProcedural : public SceneProcedural
+{
+
+	public :
+
+		LocationProcedural( const ScenePlug *scene, const Context *context, const ScenePlug::ScenePath &path, bool drawBound )
+			:	SceneProcedural( scene, context, path ), m_drawBound( drawBound )
+		{
+		}
+
+		virtual void render( RendererPtr renderer ) const
+		{
+			Context::Scope scopedContext( m_context );
+
+			ConstCompoundObjectPtr attributes = m_scenePlug->fullAttributes( m_scenePath );
+			renderAttributes( attributes.get(), renderer.get() );
+			renderObject( renderer.get() );
+			if( m_drawBound )
+			{
+				renderBound( renderer.get() );
+			}
+		}
+
+	private :
+
+		bool m_drawBound;
+
+};
+
+IECoreGL::GroupPtr convert( const ScenePlug *scene, const Context *context, const ScenePlug::ScenePath &path, bool drawBound )
+{
+	IECoreGL::RendererPtr renderer = new IECoreGL::Renderer;
+	renderer->setOption( "gl:mode", new StringData( "deferred" ) );
+	{
+		WorldBlock world( renderer );
+		renderer->setAttribute( "name", new StringData( locationName( path ) ) );
+		SceneProceduralPtr procedural = new LocationProcedural( scene, context, path, drawBound );
+		procedural->render( renderer );
+	}
+	return renderer->scene()->root();
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// Location and update implementation
+//////////////////////////////////////////////////////////////////////////
+
+struct OpenGLSceneCache::Location
+{
+
+	Location( const ScenePlug::ScenePath &path )
+		:	name( path.size() ? path.back() : InternedString() ), group( new IECoreGL::Group ), visible( true )
+	{
+		group->getState()->add( new IECoreGL::NameStateComponent( locationName( path ) ) );
+	}
+
+	InternedString name;
+	// The group representing the location, containing the
+	// content group followed by the groups of the children.
+	IECoreGL::GroupPtr group;
+	IECoreGL::GroupPtr content;
+
+	MurmurHash transformHash;
+	MurmurHash attributesHash;
+	MurmurHash childNamesHash;
+	MurmurHash contentHash;
+
+	bool visible;
+	ConstInternedStringVectorDataPtr childNames;
+	std::vector<LocationPtr> children;
+
+};
+
+struct OpenGLSceneCache::UpdateState
+{
+
+	UpdateState( const ScenePlug *scene, const Context *context, const PathMatcher *pathsToExpand )
+		:	scene( scene ), context( context ), pathsToExpand( pathsToExpand )
+	{
+		numConverted = 0;
+	}
+
+	const ScenePlug *scene;
+	const Context *context;
+	const PathMatcher *pathsToExpand;
+	mutable tbb::atomic<size_t> numConverted;
+
+};
+
+class OpenGLSceneCache::UpdateChildren
+{
+
+	public :
+
+		UpdateChildren( const UpdateState &state, Location *location, const ScenePlug::ScenePath &path, const MurmurHash &attributesHash )
+			:	m_state( state ), m_location( location ), m_path( path ), m_attributesHash( attributesHash )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			ScenePlug::ScenePath childPath = m_path;
+			childPath.push_back( InternedString() );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				Location *child = m_location->children[i].get();
+				childPath.back() = child->name;
+				updateLocation( m_state, child, childPath, m_attributesHash );
+			}
+		}
+
+	private :
+
+		const UpdateState &m_state;
+		Location *m_location;
+		const ScenePlug::ScenePath &m_path;
+		const MurmurHash &m_attributesHash;
+
+};
+
+void OpenGLSceneCache::updateLocation( const UpdateState &state, Location *location, const ScenePlug::ScenePath &path, const IECore::MurmurHash &parentAttributesHash )
+{
+	Canceller::check( state.context->canceller() );
+
+	ContextPtr pathContext = new Context( *state.context );
+	pathContext->set( ScenePlug::scenePathContextName, path );
+	Context::Scope scopedContext( pathContext );
+
+	MurmurHash attributesHash;
+	try
+	{
+		// The transform is applied to the group directly, so changing it
+		// never requires the contents to be reconverted.
+
+		const MurmurHash transformHash = state.scene->transformPlug()->hash();
+		if( transformHash != location->transformHash )
+		{
+			location->group->setTransform( state.scene->transformPlug()->getValue() );
+			location->transformHash = transformHash;
+		}
+
+		const MurmurHash localAttributesHash = state.scene->attributesPlug()->hash();
+		if( localAttributesHash != location->attributesHash )
+		{
+			ConstCompoundObjectPtr attributes = state.scene->attributesPlug()->getValue();
+			const BoolData *visibilityData = attributes->member<BoolData>( "gaffer:visibility" );
+			location->visible = !visibilityData || visibilityData->readable();
+			location->attributesHash = localAttributesHash;
+		}
+
+		// The contents are rendered using the full attributes, so we
+		// must accumulate the hashes of the attributes of all our ancestors.
+		attributesHash = parentAttributesHash;
+		attributesHash.append( localAttributesHash );
+
+		const MurmurHash childNamesHash = state.scene->childNamesPlug()->hash();
+		if( childNamesHash != location->childNamesHash )
+		{
+			location->childNames = state.scene->childNamesPlug()->getValue();
+			location->childNamesHash = childNamesHash;
+		}
+
+		const std::vector<InternedString> &childNames = location->childNames->readable();
+		const bool expanded = !state.pathsToExpand || state.pathsToExpand->match( path ) == Filter::Match;
+		const bool drawChildren = location->visible && expanded && childNames.size();
+		const bool drawBound = location->visible && !expanded && childNames.size();
+
+		// Contents
+
+		MurmurHash contentHash;
+		if( location->visible )
+		{
+			contentHash = attributesHash;
+			contentHash.append( state.scene->objectPlug()->hash() );
+			if( drawBound )
+			{
+				contentHash.append( state.scene->boundPlug()->hash() );
+			}
+		}
+
+		const bool contentChanged = contentHash != location->contentHash;
+		if( contentChanged )
+		{
+			location->content = 0;
+			if( location->visible )
+			{
+				ConstObjectPtr object = state.scene->objectPlug()->getValue();
+				if( drawBound || !runTimeCast<const NullObject>( object.get() ) )
+				{
+					location->content = convert( state.scene, pathContext.get(), path, drawBound );
+					state.numConverted++;
+				}
+			}
+			location->contentHash = contentHash;
+		}
+
+		// Children. Existing child locations are reused by name,
+		// so that reordering or adding children doesn't require any
+		// reconversion.
+
+		std::vector<LocationPtr> children;
+		if( drawChildren )
+		{
+			children.reserve( childNames.size() );
+			if( location->children.size() )
+			{
+				std::map<InternedString, LocationPtr> existingChildren;
+				for( std::vector<LocationPtr>::const_iterator it = location->children.begin(), eIt = location->children.end(); it != eIt; ++it )
+				{
+					existingChildren[(*it)->name] = *it;
+				}
+
+				ScenePlug::ScenePath childPath = path;
+				childPath.push_back( InternedString() );
+				for( std::vector<InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+				{
+					std::map<InternedString, LocationPtr>::const_iterator cIt = existingChildren.find( *it );
+					if( cIt != existingChildren.end() )
+					{
+						children.push_back( cIt->second );
+					}
+					else
+					{
+						childPath.back() = *it;
+						children.push_back( LocationPtr( new Location( childPath ) ) );
+					}
+				}
+			}
+			else
+			{
+				ScenePlug::ScenePath childPath = path;
+				childPath.push_back( InternedString() );
+				for( std::vector<InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
+				{
+					childPath.back() = *it;
+					children.push_back( LocationPtr( new Location( childPath ) ) );
+				}
+			}
+		}
+
+		if( contentChanged || children != location->children )
+		{
+			location->children.swap( children );
+			rebuildGroup( location );
+		}
+	}
+	catch( const std::exception &e )
+	{
+		// the hashes are only updated once the corresponding part of the
+		// location has been updated successfully, so after cancellation
+		// the next update will pick up where we left off.
+		Canceller::check( state.context->canceller() );
+		IECore::msg( IECore::Msg::Error, "OpenGLSceneCache::update", e.what() );
+		// reset everything so that we try again on the next update.
+		location->transformHash = location->attributesHash = location->childNamesHash = location->contentHash = MurmurHash();
+		location->content = 0;
+		location->children.clear();
+		rebuildGroup( location );
+		return;
+	}
+
+	if( location->children.size() )
+	{
+		parallel_for(
+			blocked_range<size_t>( 0, location->children.size() ),
+			UpdateChildren( state, location, path, attributesHash )
+		);
+	}
+}
+
+void OpenGLSceneCache::rebuildGroup( Location *location )
+{
+	location->group->clearChildren();
+	if( location->content )
+	{
+		location->group->addChild( location->content );
+	}
+	for( std::vector<LocationPtr>::const_iterator it = location->children.begin(), eIt = location->children.end(); it != eIt; ++it )
+	{
+		location->group->addChild( (*it)->group );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// OpenGLSceneCache
+//////////////////////////////////////////////////////////////////////////
+
+OpenGLSceneCache::OpenGLSceneCache()
+	:	m_scene( new IECoreGL::Scene )
+{
+	clear();
+}
+
+OpenGLSceneCache::~OpenGLSceneCache()
+{
+}
+
+size_t OpenGLSceneCache::update( const ScenePlug *scene, const Gaffer::Context *context, const IECore::PathMatcherData *pathsToExpand )
+{
+	UpdateState state( scene, context, pathsToExpand ? &pathsToExpand->readable() : 0 );
+	updateLocation( state, m_root.get(), ScenePlug::ScenePath(), MurmurHash() );
+	return state.numConverted;
+}
+
+void OpenGLSceneCache::clear()
+{
+	m_root.reset( new Location( ScenePlug::ScenePath() ) );
+	m_scene->root()->clearChildren();
+	m_scene->root()->addChild( m_root->group );
+}
+
+IECoreGL::Scene *OpenGLSceneCache::scene()
+{
+	return m_scene.get();
+}
+
+const IECoreGL::Scene *OpenGLSceneCache::scene() const
+{
+	return m_scene.get();
+}
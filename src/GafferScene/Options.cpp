@@ -85,7 +85,7 @@ void Options::hashProcessedGlobals( const Gaffer::Context *context, IECore::Murm
 
 IECore::ConstCompoundObjectPtr Options::computeProcessedGlobals( const Gaffer::Context *context, IECore::ConstCompoundObjectPtr inputGlobals ) const
 {
-	IECore::CompoundObjectPtr result = inputGlobals->copy();
+	IECore::CompoundObjectPtr result = shallowCopy( inputGlobals.get() );
 	optionsPlug()->fillCompoundObject( result->members() );
 	return result;
 }
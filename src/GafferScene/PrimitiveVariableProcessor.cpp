@@ -129,7 +129,7 @@ IECore::ConstObjectPtr PrimitiveVariableProcessor::computeProcessedObject( const
 	Tokenizer names( namesValue, boost::char_separator<char>( " " ) );
 		
 	bool invert = invertNamesPlug()->getValue();
-	IECore::PrimitivePtr result = inputGeometry->copy();
+	IECore::PrimitivePtr result = shallowCopy( inputGeometry.get() );
 	IECore::PrimitiveVariableMap::iterator next;
 	for( IECore::PrimitiveVariableMap::iterator it = result->variables.begin(); it != result->variables.end(); it = next )
 	{
@@ -244,7 +244,7 @@ IECore::ConstCompoundObjectPtr Prune::computeGlobals( const Gaffer::Context *con
 		}
 	}
 	
-	CompoundObjectPtr outputGlobals = inputGlobals->copy();
+	CompoundObjectPtr outputGlobals = shallowCopy( inputGlobals.get() );
 	outputGlobals->members()["gaffer:forwardDeclarations"] = outputForwardDeclarations;
 	return outputGlobals;
 }
@@ -35,6 +35,10 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "IECore/MeshPrimitive.h"
+#include "IECore/PointsPrimitive.h"
+#include "IECore/CurvesPrimitive.h"
+
 #include "Gaffer/Context.h"
 
 #include "GafferScene/SceneElementProcessor.h"
@@ -312,3 +316,38 @@ SceneElementProcessor::BoundMethod SceneElementProcessor::boundMethod() const
 	
 	return PassThrough;
 }
+
+IECore::PrimitivePtr SceneElementProcessor::shallowCopy( const IECore::Primitive *primitive )
+{
+	PrimitivePtr result = 0;
+	if( const MeshPrimitive *mesh = runTimeCast<const MeshPrimitive>( primitive ) )
+	{
+		result = new MeshPrimitive( mesh->verticesPerFace(), mesh->vertexIds(), mesh->interpolation() );
+	}
+	else if( const PointsPrimitive *points = runTimeCast<const PointsPrimitive>( primitive ) )
+	{
+		result = new PointsPrimitive( points->getNumPoints() );
+	}
+	else if( const CurvesPrimitive *curves = runTimeCast<const CurvesPrimitive>( primitive ) )
+	{
+		result = new CurvesPrimitive( curves->verticesPerCurve(), curves->basis(), curves->periodic() );
+	}
+	
+	if( !result || result->typeId() != primitive->typeId() )
+	{
+		// either we don't know how to make a shallow copy, or we've been given
+		// a derived type which may have additional state we'd miss.
+		return primitive->copy();
+	}
+	
+	// PrimitiveVariable stores its data by pointer, so this shares
+	// the data rather than copying it.
+	result->variables = primitive->variables;
+	const CompoundDataMap &blindData = primitive->blindData()->readable();
+	if( blindData.size() )
+	{
+		result->blindData()->writable() = blindData;
+	}
+	
+	return result;
+}
@@ -283,3 +283,10 @@ Imath::Box3f SceneNode::unionOfTransformedChildBounds( const ScenePath &path, co
 	}
 	return result;
 }
+
+IECore::CompoundObjectPtr SceneNode::shallowCopy( const IECore::CompoundObject *object )
+{
+	CompoundObjectPtr result = new CompoundObject;
+	result->members() = object->members();
+	return result;
+}
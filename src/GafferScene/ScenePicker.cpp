@@ -0,0 +1,766 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+
+#include "OpenEXR/ImathBoxAlgo.h"
+#include "OpenEXR/ImathPlane.h"
+#include "OpenEXR/ImathLimits.h"
+
+#include "IECore/Exception.h"
+#include "IECore/NullObject.h"
+#include "IECore/VisibleRenderable.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
+
+#include "GafferScene/ScenePicker.h"
+
+using namespace std;
+using namespace tbb;
+using namespace Imath;
+using namespace IECore;
+using namespace Gaffer;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const size_t g_maxLeafSize = 4;
+// the number of candidate objects we refine in parallel
+// before checking if we can stop.
+const size_t g_rayBatchSize = 16;
+
+std::string objectName( const ScenePlug::ScenePath &path )
+{
+	std::string result;
+	for( ScenePlug::ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
+	{
+		result += "/" + it->string();
+	}
+	return result;
+}
+
+void traverse( const ScenePlug *scene, const PathMatcher *pathsToExpand, const Context *context, const ScenePlug::ScenePath &path, const M44f &parentTransform, std::vector<ScenePicker::Object> &objects );
+
+// Traverses the children of a location in parallel, with
+// each child's objects going into a separate vector.
+class TraverseChildren
+{
+
+	public :
+
+		TraverseChildren( const ScenePlug *scene, const PathMatcher *pathsToExpand, const Context *context, const ScenePlug::ScenePath &parentPath, const std::vector<InternedString> &childNames, const M44f &parentTransform, std::vector<std::vector<ScenePicker::Object> > &childObjects )
+			:	m_scene( scene ), m_pathsToExpand( pathsToExpand ), m_context( context ), m_parentPath( parentPath ), m_childNames( childNames ), m_parentTransform( parentTransform ), m_childObjects( childObjects )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			ScenePlug::ScenePath childPath = m_parentPath;
+			childPath.push_back( InternedString() );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				childPath.back() = m_childNames[i];
+				traverse( m_scene, m_pathsToExpand, m_context, childPath, m_parentTransform, m_childObjects[i] );
+			}
+		}
+
+	private :
+
+		const ScenePlug *m_scene;
+		const PathMatcher *m_pathsToExpand;
+		const Context *m_context;
+		const ScenePlug::ScenePath &m_parentPath;
+		const std::vector<InternedString> &m_childNames;
+		const M44f &m_parentTransform;
+		std::vector<std::vector<ScenePicker::Object> > &m_childObjects;
+
+};
+
+// Mirrors the traversal made by the SceneProcedural, so that we
+// find exactly the things it draws.
+void traverse( const ScenePlug *scene, const PathMatcher *pathsToExpand, const Context *context, const ScenePlug::ScenePath &path, const M44f &parentTransform, std::vector<ScenePicker::Object> &objects )
+{
+	Canceller::check( context->canceller() );
+
+	ContextPtr pathContext = new Context( *context );
+	pathContext->set( ScenePlug::scenePathContextName, path );
+	Context::Scope scopedContext( pathContext );
+
+	ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
+	const BoolData *visibilityData = attributes->member<BoolData>( "gaffer:visibility" );
+	if( visibilityData && !visibilityData->readable() )
+	{
+		return;
+	}
+
+	const M44f transform = scene->transformPlug()->getValue() * parentTransform;
+
+	ConstInternedStringVectorDataPtr childNamesData = scene->childNamesPlug()->getValue();
+	const std::vector<InternedString> &childNames = childNamesData->readable();
+	if( childNames.size() && pathsToExpand && pathsToExpand->match( path ) != Filter::Match )
+	{
+		// the SceneProcedural draws the bounding box of unexpanded
+		// locations. the box encloses any object at the location,
+		// so we needn't add the object separately.
+		ScenePicker::Object o;
+		o.name = objectName( path );
+		o.transform = transform;
+		o.bound = Imath::transform( scene->boundPlug()->getValue(), transform );
+		if( !o.bound.isEmpty() )
+		{
+			objects.push_back( o );
+		}
+		return;
+	}
+
+	ConstObjectPtr object = scene->objectPlug()->getValue();
+	if( !runTimeCast<const NullObject>( object.get() ) )
+	{
+		ScenePicker::Object o;
+		o.name = objectName( path );
+		o.transform = transform;
+		if( const VisibleRenderable *renderable = runTimeCast<const VisibleRenderable>( object.get() ) )
+		{
+			o.bound = Imath::transform( renderable->bound(), transform );
+			o.mesh = runTimeCast<const MeshPrimitive>( renderable );
+		}
+		else
+		{
+			// cameras and lights are drawn specially by the
+			// SceneProcedural, so we just use the bound of
+			// the location.
+			o.bound = Imath::transform( scene->boundPlug()->getValue(), transform );
+		}
+		if( !o.bound.isEmpty() )
+		{
+			objects.push_back( o );
+		}
+	}
+
+	if( !childNames.size() )
+	{
+		return;
+	}
+
+	std::vector<std::vector<ScenePicker::Object> > childObjects( childNames.size() );
+	parallel_for(
+		blocked_range<size_t>( 0, childNames.size() ),
+		TraverseChildren( scene, pathsToExpand, context, path, childNames, transform, childObjects )
+	);
+
+	for( std::vector<std::vector<ScenePicker::Object> >::const_iterator it = childObjects.begin(), eIt = childObjects.end(); it != eIt; ++it )
+	{
+		objects.insert( objects.end(), it->begin(), it->end() );
+	}
+}
+
+struct CentroidLess
+{
+
+	CentroidLess( int axis )
+		:	m_axis( axis )
+	{
+	}
+
+	bool operator()( const ScenePicker::Object &a, const ScenePicker::Object &b ) const
+	{
+		return a.bound.min[m_axis] + a.bound.max[m_axis] < b.bound.min[m_axis] + b.bound.max[m_axis];
+	}
+
+	int m_axis;
+
+};
+
+// Intersects the segment p0 + d * t, for t in [0,1], with a box.
+bool intersect( const Box3f &box, const V3f &p0, const V3f &d, const V3f &inverseDirection, float &t )
+{
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+	for( int i = 0; i < 3; ++i )
+	{
+		if( d[i] == 0.0f )
+		{
+			// The segment is parallel to the slab. We can't use the
+			// inverse direction, because an origin lying on one of the
+			// faces would give 0 * inf = NaN, so we just check that the
+			// origin lies between the faces.
+			if( p0[i] < box.min[i] || p0[i] > box.max[i] )
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float tNear = ( box.min[i] - p0[i] ) * inverseDirection[i];
+		float tFar = ( box.max[i] - p0[i] ) * inverseDirection[i];
+		if( tNear > tFar )
+		{
+			std::swap( tNear, tFar );
+		}
+		t0 = std::max( t0, tNear );
+		t1 = std::min( t1, tFar );
+		if( t0 > t1 )
+		{
+			return false;
+		}
+	}
+	t = t0;
+	return true;
+}
+
+// Intersects the segment p0 + d * t, for t in [0,1], with a triangle.
+bool intersect( const V3f &p0, const V3f &d, const V3f &v0, const V3f &v1, const V3f &v2, float &t )
+{
+	const V3f e1 = v1 - v0;
+	const V3f e2 = v2 - v0;
+	const V3f p = d.cross( e2 );
+	const float det = e1.dot( p );
+	if( det == 0.0f )
+	{
+		return false;
+	}
+	const float inverseDet = 1.0f / det;
+	const V3f s = p0 - v0;
+	const float u = s.dot( p ) * inverseDet;
+	if( u < 0.0f || u > 1.0f )
+	{
+		return false;
+	}
+	const V3f q = s.cross( e1 );
+	const float v = d.dot( q ) * inverseDet;
+	if( v < 0.0f || u + v > 1.0f )
+	{
+		return false;
+	}
+	t = e2.dot( q ) * inverseDet;
+	return t >= 0.0f && t <= 1.0f;
+}
+
+// Calls f( v0, v1, v2 ) for each triangle of the mesh, stopping if it returns true.
+template<typename F>
+bool visitTriangles( const MeshPrimitive *mesh, const std::vector<V3f> &p, F &f )
+{
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = mesh->vertexIds()->readable();
+	size_t faceStart = 0;
+	for( std::vector<int>::const_iterator it = verticesPerFace.begin(), eIt = verticesPerFace.end(); it != eIt; ++it )
+	{
+		for( int i = 1; i < *it - 1; ++i )
+		{
+			if( f( p[vertexIds[faceStart]], p[vertexIds[faceStart+i]], p[vertexIds[faceStart+i+1]] ) )
+			{
+				return true;
+			}
+		}
+		faceStart += *it;
+	}
+	return false;
+}
+
+const std::vector<V3f> *meshPoints( const MeshPrimitive *mesh )
+{
+	const V3fVectorData *p = mesh->variableData<V3fVectorData>( "P", PrimitiveVariable::Vertex );
+	return p ? &p->readable() : 0;
+}
+
+struct ClosestTriangleHit
+{
+
+	ClosestTriangleHit( const V3f &p0, const V3f &d )
+		:	t( limits<float>::max() ), m_p0( p0 ), m_d( d )
+	{
+	}
+
+	bool operator()( const V3f &v0, const V3f &v1, const V3f &v2 )
+	{
+		float triangleT;
+		if( intersect( m_p0, m_d, v0, v1, v2, triangleT ) )
+		{
+			t = std::min( t, triangleT );
+		}
+		return false;
+	}
+
+	float t;
+
+	private :
+
+		V3f m_p0;
+		V3f m_d;
+
+};
+
+// Refines the candidates for a ray query, storing the parameter
+// at which the line hits each object, or a value greater than 1
+// if it misses.
+class RefineRay
+{
+
+	public :
+
+		RefineRay( const std::vector<ScenePicker::Object> &objects, const std::vector<std::pair<float, size_t> > &candidates, const LineSegment3f &line, std::vector<float> &hits )
+			:	m_objects( objects ), m_candidates( candidates ), m_line( line ), m_hits( hits )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const ScenePicker::Object &object = m_objects[m_candidates[i].second];
+				const std::vector<V3f> *p = object.mesh ? meshPoints( object.mesh.get() ) : 0;
+				if( !p )
+				{
+					m_hits[i] = m_candidates[i].first;
+					continue;
+				}
+
+				// as the transform is affine, the parameterisation
+				// of the line is the same in object space.
+				const M44f inverseTransform = object.transform.inverse();
+				const V3f p0 = m_line.p0 * inverseTransform;
+				const V3f p1 = m_line.p1 * inverseTransform;
+				ClosestTriangleHit hit( p0, p1 - p0 );
+				visitTriangles( object.mesh.get(), *p, hit );
+				m_hits[i] = hit.t;
+			}
+		}
+
+	private :
+
+		const std::vector<ScenePicker::Object> &m_objects;
+		const std::vector<std::pair<float, size_t> > &m_candidates;
+		const LineSegment3f &m_line;
+		std::vector<float> &m_hits;
+
+};
+
+enum Containment
+{
+	Outside,
+	Intersecting,
+	Inside
+};
+
+Containment containment( const Box3f &box, const std::vector<Plane3f> &planes )
+{
+	Containment result = Inside;
+	for( std::vector<Plane3f>::const_iterator it = planes.begin(), eIt = planes.end(); it != eIt; ++it )
+	{
+		// the corners furthest along and against the normal
+		V3f furthest, nearest;
+		for( int i = 0; i < 3; ++i )
+		{
+			furthest[i] = it->normal[i] >= 0.0f ? box.max[i] : box.min[i];
+			nearest[i] = it->normal[i] >= 0.0f ? box.min[i] : box.max[i];
+		}
+		if( it->distanceTo( furthest ) < 0.0f )
+		{
+			return Outside;
+		}
+		if( it->distanceTo( nearest ) < 0.0f )
+		{
+			result = Intersecting;
+		}
+	}
+	return result;
+}
+
+// Returns true if any part of the segment p0->p1 is
+// inside all the planes.
+bool intersect( const V3f &p0, const V3f &p1, const std::vector<Plane3f> &planes )
+{
+	float t0 = 0.0f;
+	float t1 = 1.0f;
+	for( std::vector<Plane3f>::const_iterator it = planes.begin(), eIt = planes.end(); it != eIt; ++it )
+	{
+		const float d0 = it->distanceTo( p0 );
+		const float d1 = it->distanceTo( p1 );
+		if( d0 < 0.0f && d1 < 0.0f )
+		{
+			return false;
+		}
+		if( d0 < 0.0f )
+		{
+			t0 = std::max( t0, d0 / ( d0 - d1 ) );
+		}
+		else if( d1 < 0.0f )
+		{
+			t1 = std::min( t1, d0 / ( d0 - d1 ) );
+		}
+		if( t0 > t1 )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// A triangle intersects a convex frustum if one of its edges
+// passes through the frustum, or if one of the edges of the
+// frustum passes through the triangle.
+struct TriangleInFrustum
+{
+
+	TriangleInFrustum( const std::vector<Plane3f> &planes, const std::vector<LineSegment3f> &edges )
+		:	m_planes( planes ), m_edges( edges )
+	{
+	}
+
+	bool operator()( const V3f &v0, const V3f &v1, const V3f &v2 ) const
+	{
+		if( intersect( v0, v1, m_planes ) || intersect( v1, v2, m_planes ) || intersect( v2, v0, m_planes ) )
+		{
+			return true;
+		}
+		float t;
+		for( std::vector<LineSegment3f>::const_iterator it = m_edges.begin(), eIt = m_edges.end(); it != eIt; ++it )
+		{
+			if( intersect( it->p0, it->p1 - it->p0, v0, v1, v2, t ) )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	private :
+
+		const std::vector<Plane3f> &m_planes;
+		const std::vector<LineSegment3f> &m_edges;
+
+};
+
+// Refines the candidates for a frustum query, which are the objects
+// whose bounds intersect the frustum without being contained by it.
+class RefineFrustum
+{
+
+	public :
+
+		RefineFrustum( const std::vector<ScenePicker::Object> &objects, const std::vector<size_t> &candidates, const std::vector<Plane3f> &planes, const std::vector<LineSegment3f> &edges, std::vector<char> &hits )
+			:	m_objects( objects ), m_candidates( candidates ), m_planes( planes ), m_edges( edges ), m_hits( hits )
+		{
+		}
+
+		void operator()( const blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const ScenePicker::Object &object = m_objects[m_candidates[i]];
+				const std::vector<V3f> *p = object.mesh ? meshPoints( object.mesh.get() ) : 0;
+				if( !p )
+				{
+					m_hits[i] = true;
+					continue;
+				}
+
+				std::vector<V3f> worldP( p->size() );
+				for( size_t j = 0, e = p->size(); j < e; ++j )
+				{
+					worldP[j] = (*p)[j] * object.transform;
+				}
+
+				TriangleInFrustum triangleInFrustum( m_planes, m_edges );
+				m_hits[i] = visitTriangles( object.mesh.get(), worldP, triangleInFrustum );
+			}
+		}
+
+	private :
+
+		const std::vector<ScenePicker::Object> &m_objects;
+		const std::vector<size_t> &m_candidates;
+		const std::vector<Plane3f> &m_planes;
+		const std::vector<LineSegment3f> &m_edges;
+		std::vector<char> &m_hits;
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ScenePicker implementation
+//////////////////////////////////////////////////////////////////////////
+
+ScenePicker::ScenePicker( const ScenePlug *scene, const Gaffer::Context *context, const IECore::PathMatcherData *pathsToExpand )
+{
+	ContextPtr c = new Context( *context );
+	traverse( scene, pathsToExpand ? &pathsToExpand->readable() : 0, c.get(), ScenePlug::ScenePath(), M44f(), m_objects );
+
+	if( m_objects.size() )
+	{
+		m_nodes.reserve( 2 * m_objects.size() / g_maxLeafSize + 1 );
+		build( 0, m_objects.size() );
+	}
+}
+
+ScenePicker::~ScenePicker()
+{
+}
+
+size_t ScenePicker::build( size_t begin, size_t end )
+{
+	const size_t index = m_nodes.size();
+	m_nodes.push_back( Node() );
+
+	Box3f bound, centroidBound;
+	for( size_t i = begin; i < end; ++i )
+	{
+		bound.extendBy( m_objects[i].bound );
+		centroidBound.extendBy( m_objects[i].bound.center() );
+	}
+
+	if( end - begin <= g_maxLeafSize )
+	{
+		Node &node = m_nodes[index];
+		node.bound = bound;
+		node.begin = begin;
+		node.end = end;
+		node.leaf = true;
+		return index;
+	}
+
+	// split at the median centroid along the longest axis
+	const size_t middle = ( begin + end ) / 2;
+	std::nth_element( m_objects.begin() + begin, m_objects.begin() + middle, m_objects.begin() + end, CentroidLess( centroidBound.majorAxis() ) );
+
+	const size_t left = build( begin, middle );
+	const size_t right = build( middle, end );
+
+	Node &node = m_nodes[index];
+	node.bound = bound;
+	node.begin = left;
+	node.end = right;
+	node.leaf = false;
+	return index;
+}
+
+std::string ScenePicker::objectAt( const IECore::LineSegment3f &line ) const
+{
+	if( m_nodes.empty() )
+	{
+		return "";
+	}
+
+	// find the objects whose bounds are hit
+
+	const V3f d = line.p1 - line.p0;
+	const V3f inverseDirection( 1.0f / d.x, 1.0f / d.y, 1.0f / d.z );
+
+	std::vector<std::pair<float, size_t> > candidates;
+	std::vector<size_t> toVisit( 1, 0 );
+	while( toVisit.size() )
+	{
+		const Node &node = m_nodes[toVisit.back()];
+		toVisit.pop_back();
+
+		float t;
+		if( !intersect( node.bound, line.p0, d, inverseDirection, t ) )
+		{
+			continue;
+		}
+
+		if( !node.leaf )
+		{
+			toVisit.push_back( node.begin );
+			toVisit.push_back( node.end );
+			continue;
+		}
+
+		for( size_t i = node.begin; i < node.end; ++i )
+		{
+			if( intersect( m_objects[i].bound, line.p0, d, inverseDirection, t ) )
+			{
+				candidates.push_back( std::pair<float, size_t>( t, i ) );
+			}
+		}
+	}
+
+	// refine the candidates in order of distance, a batch at a time,
+	// stopping as soon as the remaining ones can't be closer than the
+	// closest hit found so far.
+
+	std::sort( candidates.begin(), candidates.end() );
+
+	float closestT = limits<float>::max();
+	const Object *closest = 0;
+	std::vector<float> hits( candidates.size() );
+	for( size_t batchBegin = 0; batchBegin < candidates.size() && candidates[batchBegin].first < closestT; batchBegin += g_rayBatchSize )
+	{
+		const size_t batchEnd = std::min( batchBegin + g_rayBatchSize, candidates.size() );
+		parallel_for( blocked_range<size_t>( batchBegin, batchEnd ), RefineRay( m_objects, candidates, line, hits ) );
+
+		for( size_t i = batchBegin; i < batchEnd; ++i )
+		{
+			if( hits[i] <= 1.0f && hits[i] < closestT )
+			{
+				closestT = hits[i];
+				closest = &m_objects[candidates[i].second];
+			}
+		}
+	}
+
+	return closest ? closest->name : "";
+}
+
+size_t ScenePicker::objectsAt( const std::vector<IECore::LineSegment3f> &cornerLines, std::vector<std::string> &objectNames ) const
+{
+	if( cornerLines.size() != 4 )
+	{
+		throw IECore::Exception( "Expected four corner lines" );
+	}
+
+	if( m_nodes.empty() )
+	{
+		return objectNames.size();
+	}
+
+	// make the planes bounding the frustum, with their
+	// normals pointing inwards.
+
+	V3f centre( 0 );
+	for( std::vector<LineSegment3f>::const_iterator it = cornerLines.begin(), eIt = cornerLines.end(); it != eIt; ++it )
+	{
+		centre += ( it->p0 + it->p1 ) / 8.0f;
+	}
+
+	std::vector<Plane3f> planes;
+	for( size_t i = 0; i < 6; ++i )
+	{
+		V3f p0, p1, p2;
+		if( i < 4 )
+		{
+			p0 = cornerLines[i].p0;
+			p1 = cornerLines[i].p1;
+			p2 = cornerLines[(i+1)%4].p0;
+		}
+		else
+		{
+			// near and far planes
+			p0 = i == 4 ? cornerLines[0].p0 : cornerLines[0].p1;
+			p1 = i == 4 ? cornerLines[1].p0 : cornerLines[1].p1;
+			p2 = i == 4 ? cornerLines[2].p0 : cornerLines[2].p1;
+		}
+
+		V3f normal = ( p1 - p0 ).cross( p2 - p0 );
+		if( normal.length() == 0.0f )
+		{
+			// degenerate frustum
+			return objectNames.size();
+		}
+		normal.normalize();
+		Plane3f plane( normal, normal.dot( p0 ) );
+		if( plane.distanceTo( centre ) < 0.0f )
+		{
+			plane = Plane3f( -normal, -plane.distance );
+		}
+		planes.push_back( plane );
+	}
+
+	// find the objects whose bounds are in the frustum. those which are entirely
+	// contained are accepted immediately, and the others become candidates for
+	// refinement.
+
+	std::vector<char> accepted( m_objects.size(), false );
+	std::vector<size_t> candidates;
+	std::vector<std::pair<size_t, bool> > toVisit( 1, std::pair<size_t, bool>( 0, false ) );
+	while( toVisit.size() )
+	{
+		const Node &node = m_nodes[toVisit.back().first];
+		Containment c = toVisit.back().second ? Inside : containment( node.bound, planes );
+		toVisit.pop_back();
+
+		if( c == Outside )
+		{
+			continue;
+		}
+
+		if( !node.leaf )
+		{
+			toVisit.push_back( std::pair<size_t, bool>( node.begin, c == Inside ) );
+			toVisit.push_back( std::pair<size_t, bool>( node.end, c == Inside ) );
+			continue;
+		}
+
+		for( size_t i = node.begin; i < node.end; ++i )
+		{
+			const Containment objectContainment = c == Inside ? Inside : containment( m_objects[i].bound, planes );
+			if( objectContainment == Inside )
+			{
+				accepted[i] = true;
+			}
+			else if( objectContainment == Intersecting )
+			{
+				candidates.push_back( i );
+			}
+		}
+	}
+
+	std::vector<char> hits( candidates.size(), false );
+	parallel_for( blocked_range<size_t>( 0, candidates.size() ), RefineFrustum( m_objects, candidates, planes, cornerLines, hits ) );
+	for( size_t i = 0, e = candidates.size(); i < e; ++i )
+	{
+		accepted[candidates[i]] = hits[i];
+	}
+
+	for( size_t i = 0, e = m_objects.size(); i < e; ++i )
+	{
+		if( accepted[i] )
+		{
+			objectNames.push_back( m_objects[i].name );
+		}
+	}
+
+	return objectNames.size();
+}
+
+size_t ScenePicker::numObjects() const
+{
+	return m_objects.size();
+}
+
+Imath::Box3f ScenePicker::bound() const
+{
+	return m_nodes.size() ? m_nodes[0].bound : Box3f();
+}
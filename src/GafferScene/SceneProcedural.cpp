@@ -214,84 +214,11 @@ void SceneProcedural::render( RendererPtr renderer ) const
 		
 		// attributes
 		
-		for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
-		{
-			if( const StateRenderable *s = runTimeCast<const StateRenderable>( it->second.get() ) )
-			{
-				s->render( renderer );
-			}
-			else if( const ObjectVector *o = runTimeCast<const ObjectVector>( it->second.get() ) )
-			{
-				for( ObjectVector::MemberContainer::const_iterator it = o->members().begin(), eIt = o->members().end(); it != eIt; it++ )
-				{
-					const StateRenderable *s = runTimeCast<const StateRenderable>( it->get() );
-					if( s )
-					{
-						s->render( renderer );
-					}
-				}
-			}
-			else if( const Data *d = runTimeCast<const Data>( it->second.get() ) )
-			{
-				renderer->setAttribute( it->first, d );
-			}
-		}
+		renderAttributes( attributes.get(), renderer.get() );
 		
 		// object
 		
-		std::set<float> deformationTimes;
-		motionTimes( ( m_options.deformationBlur && m_attributes.deformationBlur ) ? m_attributes.deformationBlurSegments : 0, deformationTimes );
-		{
-			ContextPtr timeContext = new Context( *m_context );
-			Context::Scope scopedTimeContext( timeContext );
-		
-			unsigned timeIndex = 0;
-			for( std::set<float>::const_iterator it = deformationTimes.begin(), eIt = deformationTimes.end(); it != eIt; it++, timeIndex++ )
-			{
-				timeContext->setFrame( *it );
-				ConstObjectPtr object = m_scenePlug->objectPlug()->getValue();
-				if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
-				{
-					if( deformationTimes.size() > 1 && timeIndex == 0 )
-					{
-						renderer->motionBegin( deformationTimes );
-					}
-						
-						primitive->render( renderer );
-					
-					if( deformationTimes.size() > 1 && timeIndex == deformationTimes.size() - 1 )
-					{
-						renderer->motionEnd();
-					}
-				}
-				else if( const Camera *camera = runTimeCast<const Camera>( object.get() ) )
-				{
-					/// \todo This absolutely does not belong here, but until we have
-					/// a mechanism for drawing manipulators, we don't have any other
-					/// means of visualising the cameras.
-					if( renderer->isInstanceOf( "IECoreGL::Renderer" ) )
-					{
-						drawCamera( camera, renderer.get() );
-					}
-					break; // no motion blur for these chappies.
-				}
-				else if( const Light *light = runTimeCast<const Light>( object.get() ) )
-				{
-					/// \todo This doesn't belong here.
-					if( renderer->isInstanceOf( "IECoreGL::Renderer" ) )
-					{
-						drawLight( light, renderer.get() );
-					}
-					break; // no motion blur for these chappies.
-				}
-				else if( const VisibleRenderable* renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
-				{
-					renderable->render( renderer );
-					break; // no motion blur for these chappies.
-				}
-			
-			}
-		}
+		renderObject( renderer.get() );
 	
 		// children
 
@@ -306,11 +233,7 @@ void SceneProcedural::render( RendererPtr renderer ) const
 			
 			if( !expand )
 			{
-				renderer->setAttribute( "gl:primitive:wireframe", new BoolData( true ) );
-				renderer->setAttribute( "gl:primitive:solid", new BoolData( false ) );
-				renderer->setAttribute( "gl:curvesPrimitive:useGLLines", new BoolData( true ) );
-				Box3f b = m_scenePlug->boundPlug()->getValue();
-				CurvesPrimitive::createBox( b )->render( renderer );	
+				renderBound( renderer.get() );
 			}
 			else
 			{
@@ -337,6 +260,98 @@ IECore::MurmurHash SceneProcedural::hash() const
 	return IECore::MurmurHash();
 }
 
+void SceneProcedural::renderAttributes( const IECore::CompoundObject *attributes, IECore::Renderer *renderer ) const
+{
+	for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
+	{
+		if( const StateRenderable *s = runTimeCast<const StateRenderable>( it->second.get() ) )
+		{
+			s->render( renderer );
+		}
+		else if( const ObjectVector *o = runTimeCast<const ObjectVector>( it->second.get() ) )
+		{
+			for( ObjectVector::MemberContainer::const_iterator it = o->members().begin(), eIt = o->members().end(); it != eIt; it++ )
+			{
+				const StateRenderable *s = runTimeCast<const StateRenderable>( it->get() );
+				if( s )
+				{
+					s->render( renderer );
+				}
+			}
+		}
+		else if( const Data *d = runTimeCast<const Data>( it->second.get() ) )
+		{
+			renderer->setAttribute( it->first, d );
+		}
+	}
+}
+
+void SceneProcedural::renderObject( IECore::Renderer *renderer ) const
+{
+	std::set<float> deformationTimes;
+	motionTimes( ( m_options.deformationBlur && m_attributes.deformationBlur ) ? m_attributes.deformationBlurSegments : 0, deformationTimes );
+	{
+		ContextPtr timeContext = new Context( *m_context );
+		Context::Scope scopedTimeContext( timeContext );
+	
+		unsigned timeIndex = 0;
+		for( std::set<float>::const_iterator it = deformationTimes.begin(), eIt = deformationTimes.end(); it != eIt; it++, timeIndex++ )
+		{
+			timeContext->setFrame( *it );
+			ConstObjectPtr object = m_scenePlug->objectPlug()->getValue();
+			if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
+			{
+				if( deformationTimes.size() > 1 && timeIndex == 0 )
+				{
+					renderer->motionBegin( deformationTimes );
+				}
+					
+					primitive->render( renderer );
+				
+				if( deformationTimes.size() > 1 && timeIndex == deformationTimes.size() - 1 )
+				{
+					renderer->motionEnd();
+				}
+			}
+			else if( const Camera *camera = runTimeCast<const Camera>( object.get() ) )
+			{
+				/// \todo This absolutely does not belong here, but until we have
+				/// a mechanism for drawing manipulators, we don't have any other
+				/// means of visualising the cameras.
+				if( renderer->isInstanceOf( "IECoreGL::Renderer" ) )
+				{
+					drawCamera( camera, renderer );
+				}
+				break; // no motion blur for these chappies.
+			}
+			else if( const Light *light = runTimeCast<const Light>( object.get() ) )
+			{
+				/// \todo This doesn't belong here.
+				if( renderer->isInstanceOf( "IECoreGL::Renderer" ) )
+				{
+					drawLight( light, renderer );
+				}
+				break; // no motion blur for these chappies.
+			}
+			else if( const VisibleRenderable* renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
+			{
+				renderable->render( renderer );
+				break; // no motion blur for these chappies.
+			}
+		
+		}
+	}
+}
+
+void SceneProcedural::renderBound( IECore::Renderer *renderer ) const
+{
+	renderer->setAttribute( "gl:primitive:wireframe", new BoolData( true ) );
+	renderer->setAttribute( "gl:primitive:solid", new BoolData( false ) );
+	renderer->setAttribute( "gl:curvesPrimitive:useGLLines", new BoolData( true ) );
+	Box3f b = m_scenePlug->boundPlug()->getValue();
+	CurvesPrimitive::createBox( b )->render( renderer );
+}
+
 void SceneProcedural::updateAttributes( bool full )
 {
 	Context::Scope scopedContext( m_context );
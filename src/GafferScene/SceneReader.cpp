@@ -46,6 +46,7 @@
 #include "IECore/SceneCache.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Canceller.h"
 #include "GafferScene/SceneReader.h"
 
 using namespace Imath;
@@ -135,6 +136,8 @@ IECore::ConstCompoundObjectPtr SceneReader::computeAttributes( const ScenePath &
 	
 	for( SceneInterface::NameList::iterator it = nameList.begin(); it != nameList.end(); ++it )
 	{
+		Canceller::check( context->canceller() );
+		
 		// these internal attributes should be ignored:
 		if( *it == SceneCache::animatedObjectTopologyAttribute )
 		{
@@ -181,6 +184,7 @@ IECore::ConstObjectPtr SceneReader::computeObject( const ScenePath &path, const
 	
 	if( s->hasObject() )
 	{
+		Canceller::check( context->canceller() );
 		ConstObjectPtr o = s->readObject( context->getFrame() / g_frameRate );
 		return o ? o : ConstObjectPtr( parent->objectPlug()->defaultValue() );
 	}
@@ -52,13 +52,14 @@ IE_CORE_DEFINERUNTIMETYPED( Shader );
 size_t Shader::g_firstPlugIndex = 0;
 
 Shader::Shader( const std::string &name )
-	:	DependencyNode( name )
+	:	ComputeNode( name )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 	addChild( new StringPlug( "name" ) );
 	addChild( new StringPlug( "type" ) );
 	addChild( new CompoundPlug( "parameters" ) );
 	addChild( new BoolPlug( "enabled", Gaffer::Plug::In, true ) );
+	addChild( new ObjectPlug( "__state", Gaffer::Plug::Out, new IECore::ObjectVector ) );
 }
 
 Shader::~Shader()
@@ -117,10 +118,19 @@ const Gaffer::BoolPlug *Shader::enabledPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 3 );
 }
 	
+Gaffer::ObjectPlug *Shader::statePlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::ObjectPlug *Shader::statePlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+	
 IECore::MurmurHash Shader::stateHash() const
 {
-	NetworkBuilder networkBuilder( this );
-	return networkBuilder.stateHash();
+	return statePlug()->hash();
 }
 
 void Shader::stateHash( IECore::MurmurHash &h ) const
@@ -130,16 +140,21 @@ void Shader::stateHash( IECore::MurmurHash &h ) const
 
 IECore::ConstObjectVectorPtr Shader::state() const
 {
-	NetworkBuilder networkBuilder( this );
-	return networkBuilder.state();
+	return IECore::staticPointerCast<const IECore::ObjectVector>( statePlug()->getValue() );
 }
 
 void Shader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
-	DependencyNode::affects( input, outputs );
+	ComputeNode::affects( input, outputs );
+	
+	if( input == namePlug() || input == typePlug() )
+	{
+		outputs.push_back( statePlug() );
+	}
 		
 	if( parametersPlug()->isAncestorOf( input ) || input == enabledPlug() )
 	{
+		outputs.push_back( statePlug() );
 		const Plug *out = outPlug();
 		if( out )
 		{
@@ -161,6 +176,29 @@ void Shader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs
 	}
 }
 
+void Shader::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ComputeNode::hash( output, context, h );
+	
+	if( output == statePlug() )
+	{
+		NetworkBuilder networkBuilder( this );
+		h.append( networkBuilder.stateHash() );
+	}
+}
+
+void Shader::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == statePlug() )
+	{
+		NetworkBuilder networkBuilder( this );
+		static_cast<ObjectPlug *>( output )->setValue( networkBuilder.state() );
+		return;
+	}
+	
+	ComputeNode::compute( output, context );
+}
+
 void Shader::parameterHash( const Gaffer::Plug *parameterPlug, NetworkBuilder &network, IECore::MurmurHash &h ) const
 {
 	const Plug *inputPlug = parameterPlug->source<Plug>();
@@ -128,22 +128,25 @@ void ShaderAssignment::hashProcessedAttributes( const ScenePath &path, const Gaf
 		
 IECore::ConstCompoundObjectPtr ShaderAssignment::computeProcessedAttributes( const ScenePath &path, const Gaffer::Context *context, IECore::ConstCompoundObjectPtr inputAttributes ) const
 {
-	CompoundObjectPtr result = inputAttributes->copy();
-	
 	const Shader *shader = shaderPlug()->source<Plug>()->ancestor<Shader>();
-	if( shader )
+	if( !shader )
 	{
-		// Shader::state() returns a const object, so that in the future it may
-		// come from a cached value. we're putting it into our result which, once
-		// returned, will also be treated as const and cached. for that reason the
-		// temporary const_cast needed to put it into the result is justified -
-		// we never change the object and nor can anyone after it is returned.
-		ObjectVectorPtr state = constPointerCast<ObjectVector>( shader->state() );
-		if( state->members().size() )
-		{
-			result->members()["shader"] = state;
-		}
+		return inputAttributes;
 	}
 	
+	// Shader::state() returns a const object which comes from the cache, and
+	// is shared between every location the shader is assigned to. we're putting it
+	// into our result which, once returned, will also be treated as const and cached.
+	// for that reason the temporary const_cast needed to put it into the result is
+	// justified - we never change the object and nor can anyone after it is returned.
+	ObjectVectorPtr state = constPointerCast<ObjectVector>( shader->state() );
+	if( !state->members().size() )
+	{
+		return inputAttributes;
+	}
+
+	CompoundObjectPtr result = shallowCopy( inputAttributes.get() );
+	result->members()["shader"] = state;
+	
 	return result;
 }
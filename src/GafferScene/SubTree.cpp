@@ -149,7 +149,7 @@ IECore::ConstInternedStringVectorDataPtr SubTree::computeChildNames( const Scene
 
 IECore::ConstCompoundObjectPtr SubTree::computeGlobals( const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	IECore::CompoundObjectPtr result = inPlug()->globalsPlug()->getValue()->copy();
+	IECore::CompoundObjectPtr result = shallowCopy( inPlug()->globalsPlug()->getValue().get() );
 
 	const IECore::CompoundData *inputForwardDeclarations = result->member<IECore::CompoundData>( "gaffer:forwardDeclarations" );
 	if( inputForwardDeclarations )
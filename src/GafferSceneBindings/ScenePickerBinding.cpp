@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////
+//  
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//  
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//  
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//  
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//  
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//  
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/python.hpp"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/Context.h"
+
+#include "GafferScene/ScenePicker.h"
+
+#include "GafferSceneBindings/ScenePickerBinding.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+using namespace GafferScene;
+
+static ScenePickerPtr construct( ScenePlugPtr scene, ContextPtr context, IECore::PathMatcherDataPtr pathsToExpand )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return new ScenePicker( scene.get(), context.get(), pathsToExpand.get() );
+}
+
+static std::string objectAt( const ScenePicker &picker, const IECore::LineSegment3f &line )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return picker.objectAt( line );
+}
+
+static list objectsAt( const ScenePicker &picker, object cornerLines )
+{
+	std::vector<IECore::LineSegment3f> lines;
+	for( size_t i = 0, e = len( cornerLines ); i < e; ++i )
+	{
+		lines.push_back( extract<IECore::LineSegment3f>( cornerLines[i] ) );
+	}
+	
+	std::vector<std::string> objectNames;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		picker.objectsAt( lines, objectNames );
+	}
+	
+	list result;
+	for( std::vector<std::string>::const_iterator it = objectNames.begin(), eIt = objectNames.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+void GafferSceneBindings::bindScenePicker()
+{
+
+	IECorePython::RefCountedClass<ScenePicker, IECore::RefCounted>( "ScenePicker" )
+		.def( "__init__", make_constructor(
+		
+				construct,
+				default_call_policies(),
+				(	
+					boost::python::arg( "scene" ),
+					boost::python::arg( "context" ),
+					boost::python::arg( "pathsToExpand" ) = IECore::PathMatcherDataPtr( 0 )
+				)
+			)
+		)
+		.def( "objectAt", &objectAt )
+		.def( "objectsAt", &objectsAt )
+		.def( "numObjects", &ScenePicker::numObjects )
+		.def( "bound", &ScenePicker::bound )
+	;
+	
+}
@@ -40,6 +40,7 @@
 #include "boost/tokenizer.hpp"
 
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 #include "GafferBindings/PlugBinding.h"
 
@@ -108,7 +109,11 @@ static IECore::ObjectPtr objectWrapper( const ScenePlug &plug, object scenePath,
 {
 	ScenePlug::ScenePath p;
 	objectToScenePath( scenePath, p );
-	IECore::ConstObjectPtr o = plug.object( p );
+	IECore::ConstObjectPtr o;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		o = plug.object( p );
+	}
 	return copy ? o->copy() : IECore::constPointerCast<IECore::Object>( o );
 }
 
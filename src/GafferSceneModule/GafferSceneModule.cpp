@@ -86,6 +86,8 @@
 #include "GafferSceneBindings/RenderBinding.h"
 #include "GafferSceneBindings/ShaderBinding.h"
 #include "GafferSceneBindings/ConstraintBinding.h"
+#include "GafferSceneBindings/ScenePickerBinding.h"
+#include "GafferSceneBindings/OpenGLSceneCacheBinding.h"
 
 using namespace boost::python;
 using namespace GafferScene;
@@ -128,6 +130,8 @@ BOOST_PYTHON_MODULE( _GafferScene )
 	bindPathMatcher();
 	bindPathMatcherData();
 	bindSceneProcedural();
+	bindScenePicker();
+	bindOpenGLSceneCache();
 	bindShader();
 	
 	GafferBindings::DependencyNodeClass<Options>();	
@@ -39,13 +39,14 @@
 #include "boost/bind/placeholders.hpp"
 #include "boost/tokenizer.hpp"
 
-#include "IECore/ParameterisedProcedural.h"
 #include "IECore/VectorTypedData.h"
+#include "IECore/MessageHandler.h"
 
 #include "Gaffer/Context.h"
 #include "Gaffer/BlockedConnection.h"
 
-#include "GafferScene/SceneProcedural.h"
+#include "GafferScene/OpenGLSceneCache.h"
+#include "GafferScene/ScenePicker.h"
 #include "GafferScene/PathMatcherData.h"
 #include "GafferScene/StandardOptions.h"
 
@@ -59,41 +60,62 @@ using namespace GafferScene;
 using namespace GafferSceneUI;
 
 //////////////////////////////////////////////////////////////////////////
-// Implementation of a ParameterisedProcedural wrapping a SceneProcedural.
-// We need this to allow us to use the RenderableGadget for doing our
-// display.
-/// \todo Build our own scene representation.
+// Implementation of a RenderableGadget::Picker wrapping a ScenePicker.
+// This allows the RenderableGadget to pick objects on the CPU rather
+// than by rerendering the scene in GL selection mode. The ScenePicker
+// is built on demand, so that we don't pay for it until the user
+// actually clicks in the viewer.
 //////////////////////////////////////////////////////////////////////////
 
-class WrappingProcedural : public IECore::ParameterisedProcedural
+class WrappingPicker : public RenderableGadget::Picker
 {
 
 	public :
 
-		WrappingProcedural( SceneProceduralPtr sceneProcedural )
-			:	ParameterisedProcedural( "" ), m_sceneProcedural( sceneProcedural )
+		WrappingPicker( ConstScenePlugPtr scenePlug, const Context *context, const PathMatcherData *pathsToExpand )
+			:	m_scenePlug( scenePlug ), m_context( new Context( *context ) ), m_pathsToExpand( pathsToExpand ? pathsToExpand->copy() : 0 )
 		{
 		}
 
-	protected :
-	
-		virtual Imath::Box3f doBound( ConstCompoundObjectPtr args ) const
+		virtual std::string objectAt( const IECore::LineSegment3f &lineInGadgetSpace ) const
 		{
-			return m_sceneProcedural->bound();
+			const ScenePicker *picker = scenePicker();
+			return picker ? picker->objectAt( lineInGadgetSpace ) : "";
 		}
 
-		virtual void doRender( RendererPtr renderer, ConstCompoundObjectPtr args ) const
+		virtual void objectsAt( const std::vector<IECore::LineSegment3f> &cornerLinesInGadgetSpace, std::vector<std::string> &objectNames ) const
 		{
-			m_sceneProcedural->render( renderer );
+			if( const ScenePicker *picker = scenePicker() )
+			{
+				picker->objectsAt( cornerLinesInGadgetSpace, objectNames );
+			}
 		}
 
 	private :
-	
-		SceneProceduralPtr m_sceneProcedural;
 
-};
+		const ScenePicker *scenePicker() const
+		{
+			if( !m_scenePicker )
+			{
+				try
+				{
+					m_scenePicker = new ScenePicker( m_scenePlug.get(), m_context.get(), m_pathsToExpand.get() );
+				}
+				catch( const std::exception &e )
+				{
+					IECore::msg( IECore::Msg::Error, "SceneView picking", e.what() );
+					return 0;
+				}
+			}
+			return m_scenePicker.get();
+		}
+
+		ConstScenePlugPtr m_scenePlug;
+		ContextPtr m_context;
+		PathMatcherDataPtr m_pathsToExpand;
+		mutable ScenePickerPtr m_scenePicker;
 
-IE_CORE_DECLAREPTR( WrappingProcedural );
+};
 
 //////////////////////////////////////////////////////////////////////////
 // SceneView implementation
@@ -105,7 +127,8 @@ SceneView::ViewDescription<SceneView> SceneView::g_viewDescription( GafferScene:
 
 SceneView::SceneView()
 	:	View3D( defaultName<SceneView>(), new GafferScene::ScenePlug() ),
-		m_renderableGadget( new RenderableGadget )
+		m_renderableGadget( new RenderableGadget ),
+		m_sceneCache( new OpenGLSceneCache )
 {
 	viewportGadget()->setChild( m_renderableGadget );
 
@@ -160,12 +183,14 @@ void SceneView::contextChanged( const IECore::InternedString &name )
 
 void SceneView::update()
 {
-	SceneProceduralPtr p = new SceneProcedural( preprocessedInPlug<ScenePlug>(), getContext(), ScenePlug::ScenePath(), expandedPaths() );
-	WrappingProceduralPtr wp = new WrappingProcedural( p );
+	// the cache reconverts only the locations which have changed since
+	// the last update, modifying its scene in place.
+	m_sceneCache->update( preprocessedInPlug<ScenePlug>(), getContext(), expandedPaths() );
 	
-	bool hadRenderable = m_renderableGadget->getRenderable();
-	m_renderableGadget->setRenderable( wp );
-	if( !hadRenderable )
+	bool hadScene = m_renderableGadget->getScene();
+	m_renderableGadget->setScene( m_sceneCache->scene() );
+	m_renderableGadget->setPicker( new WrappingPicker( preprocessedInPlug<ScenePlug>(), getContext(), expandedPaths() ) );
+	if( !hadScene )
 	{
 		viewportGadget()->frame( m_renderableGadget->bound() );
 	}
@@ -35,6 +35,10 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/task_scheduler_init.h"
+
+#include "IECore/Exception.h"
+
 #include "GafferBindings/DependencyNodeBinding.h"
 
 #include "GafferTest/MultiplyNode.h"
@@ -44,6 +48,20 @@
 using namespace boost::python;
 using namespace GafferTest;
 
+// Limits the number of threads used for parallel computations initiated
+// from the calling thread, for the lifetime of the process. TBB honours the
+// requested count only if it is applied before the scheduler is first used,
+// so this should be called before any computation is performed.
+static void setNumThreads( int numThreads )
+{
+	static tbb::task_scheduler_init *g_taskSchedulerInit = 0;
+	if( g_taskSchedulerInit )
+	{
+		throw IECore::Exception( "setNumThreads() may only be called once" );
+	}
+	g_taskSchedulerInit = new tbb::task_scheduler_init( numThreads );
+}
+
 BOOST_PYTHON_MODULE( _GafferTest )
 {
 	
@@ -51,5 +69,6 @@ BOOST_PYTHON_MODULE( _GafferTest )
 
 	def( "testRecursiveChildIterator", &testRecursiveChildIterator );
 	def( "testFilteredRecursiveChildIterator", &testFilteredRecursiveChildIterator );
+	def( "setNumThreads", &setNumThreads );
 
 }
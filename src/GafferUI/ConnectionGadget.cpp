@@ -35,9 +35,14 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "boost/bind.hpp"
 #include "boost/bind/placeholders.hpp"
 
+#include "OpenEXR/ImathFun.h"
+#include "OpenEXR/ImathLimits.h"
+
 #include "IECore/Exception.h"
 
 #include "Gaffer/UndoContext.h"
@@ -54,6 +59,40 @@ using namespace GafferUI;
 using namespace Imath;
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////////
+// Curve utilities. These must match the curve drawn by
+// Style::renderConnection().
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const float g_halfWidth = 0.25f;
+const int g_numCurveSteps = 50;
+
+void controlPoints( const V3f &srcPos, const V3f &srcTangent, const V3f &dstPos, const V3f &dstTangent, V3f &v1, V3f &v2 )
+{
+	const V3f d = dstPos - srcPos;
+	v1 = srcPos + srcTangent * d.dot( srcTangent ) * 0.25f;
+	v2 = dstPos - dstTangent * d.dot( dstTangent ) * 0.25f;
+}
+
+V3f curvePoint( const V3f &v0, const V3f &v1, const V3f &v2, const V3f &v3, float t )
+{
+	const float s = 1.0f - t;
+	return v0 * ( s * s * s ) + v1 * ( 3.0f * s * s * t ) + v2 * ( 3.0f * s * t * t ) + v3 * ( t * t * t );
+}
+
+float distanceToSegment( const V3f &p, const V3f &a, const V3f &b )
+{
+	const V3f ab = b - a;
+	const float l2 = ab.length2();
+	const float t = l2 > 0.0f ? clamp( ( p - a ).dot( ab ) / l2, 0.0f, 1.0f ) : 0.0f;
+	return ( p - ( a + ab * t ) ).length();
+}
+
+} // namespace
+
 IE_CORE_DEFINERUNTIMETYPED( ConnectionGadget );
 
 ConnectionGadget::ConnectionGadget( GafferUI::NodulePtr srcNodule, GafferUI::NodulePtr dstNodule )
@@ -215,6 +254,57 @@ Imath::Box3f ConnectionGadget::bound() const
 	return r;
 }
 
+Imath::Box3f ConnectionGadget::curveBound() const
+{
+	const_cast<ConnectionGadget *>( this )->setPositionsFromNodules();
+
+	// The curve lies within the hull of its control points. We include both
+	// the full and minimised curves, as minimised connections are drawn in
+	// full when highlighted.
+	V3f v1, v2;
+	controlPoints( m_srcPos, m_srcTangent, m_dstPos, m_dstTangent, v1, v2 );
+	
+	Box3f r;
+	r.extendBy( m_srcPos );
+	r.extendBy( v1 );
+	r.extendBy( v2 );
+	r.extendBy( m_dstPos );
+	
+	if( m_minimised )
+	{
+		V3f srcPos, srcTangent;
+		drawnSource( false, srcPos, srcTangent );
+		controlPoints( srcPos, srcTangent, m_dstPos, m_dstTangent, v1, v2 );
+		r.extendBy( srcPos );
+		r.extendBy( v1 );
+		r.extendBy( v2 );
+	}
+	
+	r.min -= V3f( g_halfWidth );
+	r.max += V3f( g_halfWidth );
+	return r;
+}
+
+float ConnectionGadget::distanceTo( const Imath::V3f &point ) const
+{
+	const_cast<ConnectionGadget *>( this )->setPositionsFromNodules();
+
+	V3f v0, srcTangent;
+	drawnSource( highlighted(), v0, srcTangent );
+	V3f v1, v2;
+	controlPoints( v0, srcTangent, m_dstPos, m_dstTangent, v1, v2 );
+	
+	float result = limits<float>::max();
+	V3f previous = v0;
+	for( int i = 1; i < g_numCurveSteps; ++i )
+	{
+		const V3f p = curvePoint( v0, v1, v2, m_dstPos, i / (float)( g_numCurveSteps - 1 ) );
+		result = std::min( result, distanceToSegment( point, previous, p ) );
+		previous = p;
+	}
+	return result;
+}
+
 void ConnectionGadget::updateDragEndPoint( const Imath::V3f position, const Imath::V3f &tangent )
 {
 	if( m_dragEnd==Gaffer::Plug::Out )
@@ -231,6 +321,7 @@ void ConnectionGadget::updateDragEndPoint( const Imath::V3f position, const Imat
 	{
 		throw IECore::Exception( "Not dragging" );
 	}
+	dirtyIndex();
 	renderRequestSignal()( this );
 }
 
@@ -238,24 +329,38 @@ void ConnectionGadget::doRender( const Style *style ) const
 {
 	const_cast<ConnectionGadget *>( this )->setPositionsFromNodules();
 	
-	Style::State state = m_hovering ? Style::HighlightedState : Style::NormalState;
-	if( state != Style::HighlightedState )
+	const bool isHighlighted = highlighted();
+	V3f adjustedSrcPos, adjustedSrcTangent;
+	drawnSource( isHighlighted, adjustedSrcPos, adjustedSrcTangent );
+		
+	style->renderConnection( adjustedSrcPos, adjustedSrcTangent, m_dstPos, m_dstTangent, isHighlighted ? Style::HighlightedState : Style::NormalState );
+}
+
+void ConnectionGadget::dirtyIndex()
+{
+	if( GraphGadget *graphGadget = parent<GraphGadget>() )
 	{
-		if( nodeSelected( m_srcNodule ) || nodeSelected( m_dstNodule ) )
-		{
-			state = Style::HighlightedState;
-		}
+		graphGadget->dirtyIndex( this );
 	}
-	
-	V3f adjustedSrcPos = m_srcPos;
-	V3f adjustedSrcTangent = m_srcTangent;
-	if( m_minimised && state != Style::HighlightedState )
+}
+
+bool ConnectionGadget::highlighted() const
+{
+	return m_hovering || nodeSelected( m_srcNodule ) || nodeSelected( m_dstNodule );
+}
+
+void ConnectionGadget::drawnSource( bool highlighted, Imath::V3f &srcPos, Imath::V3f &srcTangent ) const
+{
+	if( m_minimised && !highlighted )
 	{
-		adjustedSrcPos = m_dstPos + m_dstTangent * 1.5f;
-		adjustedSrcTangent = -m_dstTangent;
+		srcPos = m_dstPos + m_dstTangent * 1.5f;
+		srcTangent = -m_dstTangent;
+	}
+	else
+	{
+		srcPos = m_srcPos;
+		srcTangent = m_srcTangent;
 	}
-		
-	style->renderConnection( adjustedSrcPos, adjustedSrcTangent, m_dstPos, m_dstTangent, state );
 }
 
 bool ConnectionGadget::buttonPress( GadgetPtr gadget, const ButtonEvent &event )
@@ -324,6 +429,7 @@ bool ConnectionGadget::dragEnd( GadgetPtr gadget, const DragDropEvent &event )
 	}
 
 	m_dragEnd = Gaffer::Plug::Invalid;
+	dirtyIndex();
 	renderRequestSignal()( this );
 	return true;
 }
@@ -35,11 +35,14 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "boost/bind.hpp"
 #include "boost/bind/placeholders.hpp"
 
 #include "OpenEXR/ImathRandom.h"
 #include "OpenEXR/ImathPlane.h"
+#include "OpenEXR/ImathBoxAlgo.h"
 
 #include "IECore/NullObject.h"
 
@@ -75,10 +78,35 @@ static const InternedString g_positionPlugName( "__uiPosition" );
 static const InternedString g_inputConnectionsMinimisedPlugName( "__uiInputConnectionsMinimised" );
 static const InternedString g_outputConnectionsMinimisedPlugName( "__uiOutputConnectionsMinimised" );
 
+// size of the cells in the spatial index
+static const float g_indexCellSize = 16.0f;
+// gadgets covering more cells than this are stored separately
+static const int g_maxIndexCells = 64;
+
+// Returns the region of the xy plane visible with the current
+// GL projection, in the current object space.
+static Box2f visibleBound()
+{
+	M44f projection, modelView;
+	glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+	glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+	const M44f clipToObject = ( modelView * projection ).inverse();
+	
+	Box2f result;
+	for( int i = 0; i < 8; ++i )
+	{
+		const V3f clip( i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 );
+		V3f p;
+		clipToObject.multVecMatrix( clip, p );
+		result.extendBy( V2f( p.x, p.y ) );
+	}
+	return result;
+}
+
 IE_CORE_DEFINERUNTIMETYPED( GraphGadget );
 
 GraphGadget::GraphGadget( Gaffer::NodePtr root, Gaffer::SetPtr filter )
-	:	m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( 0 ), m_dragReconnectSrcNodule( 0 ), m_dragReconnectDstNodule( 0 )
+	:	m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( 0 ), m_dragReconnectSrcNodule( 0 ), m_dragReconnectDstNodule( 0 ), m_nextIndexOrder( 0 )
 {
 	keyPressSignal().connect( boost::bind( &GraphGadget::keyPressed, this, ::_1,  ::_2 ) );
 	buttonPressSignal().connect( boost::bind( &GraphGadget::buttonPress, this, ::_1,  ::_2 ) );
@@ -344,83 +372,107 @@ const GraphLayout *GraphGadget::getLayout() const
 
 NodeGadget *GraphGadget::nodeGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const
 {
-	const ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
-				
-	std::vector<GadgetPtr> gadgetsUnderMouse;
-	viewportGadget->gadgetsAt(
-		viewportGadget->gadgetToRasterSpace( lineInGadgetSpace.p0, this ),
-		gadgetsUnderMouse
-	);
-				
-	if( !gadgetsUnderMouse.size() )
+	const V2f p( lineInGadgetSpace.p0.x, lineInGadgetSpace.p0.y );
+	std::vector<Gadget *> gadgets;
+	gadgetsIntersecting( Box2f( p, p ), gadgets );
+
+	// search in reverse drawing order, so we find
+	// the node drawn on top.
+	for( std::vector<Gadget *>::const_reverse_iterator it = gadgets.rbegin(), eIt = gadgets.rend(); it != eIt; ++it )
 	{
-		return 0;
+		NodeGadget *nodeGadget = runTimeCast<NodeGadget>( *it );
+		if( !nodeGadget )
+		{
+			continue;
+		}
+		const Box3f b = nodeGadget->transformedBound( this );
+		if( b.min.x <= p.x && p.x <= b.max.x && b.min.y <= p.y && p.y <= b.max.y )
+		{
+			return nodeGadget;
+		}
 	}
 	
-	NodeGadget *nodeGadget = runTimeCast<NodeGadget>( gadgetsUnderMouse[0] );
-	if( !nodeGadget )
-	{
-		nodeGadget = gadgetsUnderMouse[0]->ancestor<NodeGadget>();
-	}
-
-	return nodeGadget;
+	return 0;
 }
 
 ConnectionGadget *GraphGadget::connectionGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const
 {
-	const ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
-	
-	std::vector<GadgetPtr> gadgetsUnderMouse;
-	viewportGadget->gadgetsAt( viewportGadget->gadgetToRasterSpace( lineInGadgetSpace.p0, this ), gadgetsUnderMouse );
-	
-	if ( !gadgetsUnderMouse.size() )
-	{
-		return 0;
-	}
+	const V3f p( lineInGadgetSpace.p0.x, lineInGadgetSpace.p0.y, 0 );
+	std::vector<Gadget *> gadgets;
+	gadgetsIntersecting( Box2f( V2f( p.x, p.y ) ), gadgets );
 	
-	ConnectionGadget *connectionGadget = runTimeCast<ConnectionGadget>( gadgetsUnderMouse[0] );
-	if ( !connectionGadget )
+	// connections are half a unit wide
+	for( std::vector<Gadget *>::const_reverse_iterator it = gadgets.rbegin(), eIt = gadgets.rend(); it != eIt; ++it )
 	{
-		connectionGadget = gadgetsUnderMouse[0]->ancestor<ConnectionGadget>();
+		ConnectionGadget *connectionGadget = runTimeCast<ConnectionGadget>( *it );
+		if( connectionGadget && connectionGadget->distanceTo( p ) <= 0.25f )
+		{
+			return connectionGadget;
+		}
 	}
 	
-	return connectionGadget;
+	return 0;
 }
 
-ConnectionGadget *GraphGadget::reconnectionGadgetAt( NodeGadget *gadget, const IECore::LineSegment3f &lineInGadgetSpace ) const
+size_t GraphGadget::gadgetsIntersecting( const Imath::Box2f &box, std::vector<Gadget *> &gadgets ) const
 {
-	std::vector<GadgetPtr> gadgetsUnderMouse;
+	updateIndex();
 	
-	Imath::V3f center = gadget->transformedBound( this ).center();
-	const Imath::V3f corner0 = center - Imath::V3f( 2, 2, 1 );
-	const Imath::V3f corner1 = center + Imath::V3f( 2, 2, 1 );
+	std::set<Gadget *> candidates( m_largeIndexedGadgets );
 	
-	std::vector<IECoreGL::HitRecord> selection;
+	const Box2i cells(
+		V2i( (int)floorf( box.min.x / g_indexCellSize ), (int)floorf( box.min.y / g_indexCellSize ) ),
+		V2i( (int)floorf( box.max.x / g_indexCellSize ), (int)floorf( box.max.y / g_indexCellSize ) )
+	);
+	for( int y = cells.min.y; y <= cells.max.y; ++y )
 	{
-		ViewportGadget::SelectionScope selectionScope( corner0, corner1, this, selection, IECoreGL::Selector::IDRender );
-		
-		const Style *s = style();
-		s->bind();
-		
-		for ( ChildContainer::const_iterator it = children().begin(); it != children().end(); ++it )
+		for( int x = cells.min.x; x <= cells.max.x; ++x )
 		{
-			if ( ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( it->get() ) )
+			IndexCellMap::const_iterator it = m_indexCells.find( IndexCell( x, y ) );
+			if( it != m_indexCells.end() )
 			{
-				// don't consider the node's own connections, or connections without a source nodule
-				if ( c->srcNodule() && gadget->node() != c->srcNodule()->plug()->node() && gadget->node() != c->dstNodule()->plug()->node() )
-				{
-					c->render( s );
-				}
+				candidates.insert( it->second.begin(), it->second.end() );
 			}
 		}
 	}
 	
-	for ( std::vector<IECoreGL::HitRecord>::const_iterator it = selection.begin(); it != selection.end(); ++it )
+	std::vector<std::pair<size_t, Gadget *> > intersecting;
+	for( std::set<Gadget *>::const_iterator it = candidates.begin(), eIt = candidates.end(); it != eIt; ++it )
 	{
-		GadgetPtr gadget = Gadget::select( it->name.value() );
-		if ( gadget )
+		const IndexEntry &entry = m_indexEntries.find( *it )->second;
+		if( entry.bound.intersects( box ) )
 		{
-			return runTimeCast<ConnectionGadget>( gadget );
+			intersecting.push_back( std::pair<size_t, Gadget *>( entry.order, *it ) );
+		}
+	}
+	
+	std::sort( intersecting.begin(), intersecting.end() );
+	for( std::vector<std::pair<size_t, Gadget *> >::const_iterator it = intersecting.begin(), eIt = intersecting.end(); it != eIt; ++it )
+	{
+		gadgets.push_back( it->second );
+	}
+	
+	return gadgets.size();
+}
+
+ConnectionGadget *GraphGadget::reconnectionGadgetAt( NodeGadget *gadget, const IECore::LineSegment3f &lineInGadgetSpace ) const
+{
+	const V3f center = gadget->transformedBound( this ).center();
+	const V2f center2( center.x, center.y );
+
+	std::vector<Gadget *> gadgets;
+	gadgetsIntersecting( Box2f( center2 - V2f( 2 ), center2 + V2f( 2 ) ), gadgets );
+	
+	for( std::vector<Gadget *>::const_reverse_iterator it = gadgets.rbegin(), eIt = gadgets.rend(); it != eIt; ++it )
+	{
+		ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( *it );
+		// don't consider the node's own connections, or connections without a source nodule
+		if( c && c->srcNodule() && gadget->node() != c->srcNodule()->plug()->node() && gadget->node() != c->dstNodule()->plug()->node() )
+		{
+			if( c->distanceTo( V3f( center.x, center.y, 0 ) ) <= 2.0f )
+			{
+				return c;
+			}
 		}
 	}
 	
@@ -431,10 +483,17 @@ void GraphGadget::doRender( const Style *style ) const
 {
 	glDisable( GL_DEPTH_TEST );
 	
+	// find the gadgets which are visible, so we don't render the others. we
+	// use the current GL projection rather than the viewport, so that when
+	// we're rendered for selection only the gadgets in the selection region
+	// are rendered.
+	std::vector<Gadget *> visibleGadgets;
+	gadgetsIntersecting( visibleBound(), visibleGadgets );
+	
 	// render connection first so they go underneath
-	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+	for( std::vector<Gadget *>::const_iterator it = visibleGadgets.begin(), eIt = visibleGadgets.end(); it != eIt; ++it )
 	{
-		ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( it->get() );
+		ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( *it );
 		if ( c && c != m_dragReconnectCandidate )
 		{
 			c->render( style );
@@ -467,10 +526,19 @@ void GraphGadget::doRender( const Style *style ) const
 		}
 	}
 	
-	// then render the rest on top
+	// then render the nodes on top
+	for( std::vector<Gadget *>::const_iterator it = visibleGadgets.begin(), eIt = visibleGadgets.end(); it != eIt; ++it )
+	{
+		if( !(*it)->isInstanceOf( ConnectionGadget::staticTypeId() ) )
+		{
+			(*it)->render( style );
+		}
+	}
+	
+	// and anything else which isn't indexed
 	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
 	{
-		if( !((*it)->isInstanceOf( ConnectionGadget::staticTypeId() )) )
+		if( !(*it)->isInstanceOf( ConnectionGadget::staticTypeId() ) && !(*it)->isInstanceOf( NodeGadget::staticTypeId() ) )
 		{
 			static_cast<const Gadget *>( it->get() )->render( style );
 		}
@@ -618,16 +686,17 @@ bool GraphGadget::buttonPress( GadgetPtr gadget, const ButtonEvent &event )
 			return false;
 		}
 		
-		ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
-				
-		std::vector<GadgetPtr> gadgetsUnderMouse;
-		viewportGadget->gadgetsAt(
-			viewportGadget->gadgetToRasterSpace( event.line.p0, this ),
-			gadgetsUnderMouse
-		);
-				
-		if( !gadgetsUnderMouse.size() || gadgetsUnderMouse[0] == this )
+		// we use the spatial index rather than a gl selection
+		// render to find what's under the mouse, as it's much
+		// cheaper for large graphs.
+		NodeGadget *nodeGadget = nodeGadgetAt( event.line );
+		if( !nodeGadget )
 		{
+			if( connectionGadgetAt( event.line ) )
+			{
+				// leave it to the connection to handle
+				return false;
+			}
 			// background click. clear selection unless shift is
 			// held, in which case we're expecting a shift drag
 			// to add to the selection.
@@ -638,12 +707,6 @@ bool GraphGadget::buttonPress( GadgetPtr gadget, const ButtonEvent &event )
 			return true;
 		}
 				
-		NodeGadget *nodeGadget = runTimeCast<NodeGadget>( gadgetsUnderMouse[0] );
-		if( !nodeGadget )
-		{
-			nodeGadget = gadgetsUnderMouse[0]->ancestor<NodeGadget>();
-		}
-				
 		if( nodeGadget )
 		{				
 			Gaffer::NodePtr node = nodeGadget->node();
@@ -1183,6 +1246,9 @@ void GraphGadget::addNodeGadget( Gaffer::Node *node )
 	NodeGadgetEntry nodeGadgetEntry;
 	nodeGadgetEntry.inputChangedConnection = node->plugInputChangedSignal().connect( boost::bind( &GraphGadget::inputChanged, this, ::_1 ) );
 	nodeGadgetEntry.plugSetConnection = node->plugSetSignal().connect( boost::bind( &GraphGadget::plugSet, this, ::_1 ) );	
+	nodeGadgetEntry.childAddedConnection = node->childAddedSignal().connect( boost::bind( &GraphGadget::nodeChildrenChanged, this, ::_1, ::_2 ) );
+	nodeGadgetEntry.childRemovedConnection = node->childRemovedSignal().connect( boost::bind( &GraphGadget::nodeChildrenChanged, this, ::_1, ::_2 ) );
+	nodeGadgetEntry.nameChangedConnection = node->nameChangedSignal().connect( boost::bind( &GraphGadget::nodeNameChanged, this, ::_1 ) );
 	nodeGadgetEntry.gadget = nodeGadget.get();
 	
 	m_nodeGadgets[node] = nodeGadgetEntry;
@@ -1201,9 +1267,13 @@ void GraphGadget::removeNodeGadget( const Gaffer::Node *node )
 	NodeGadgetMap::iterator it = m_nodeGadgets.find( node );
 	if( it!=m_nodeGadgets.end() )
 	{
+		removeFromIndex( it->second.gadget );
 		removeChild( it->second.gadget );
 		it->second.inputChangedConnection.disconnect();
 		it->second.plugSetConnection.disconnect();
+		it->second.childAddedConnection.disconnect();
+		it->second.childRemovedConnection.disconnect();
+		it->second.nameChangedConnection.disconnect();
 		
 		m_nodeGadgets.erase( it );
 		
@@ -1234,6 +1304,7 @@ void GraphGadget::updateNodeGadgetTransform( NodeGadget *nodeGadget )
 	}
 
 	nodeGadget->setTransform( m );
+	dirtyIndex( nodeGadget, true );
 }
 
 void GraphGadget::addConnectionGadgets( Gaffer::GraphComponent *plugParent )
@@ -1267,6 +1338,7 @@ void GraphGadget::addConnectionGadgets( Gaffer::GraphComponent *plugParent )
 					{
 						assert( connection->dstNodule()->plug()->getInput<Gaffer::Plug>() == *pIt ); 
 						connection->setNodules( srcNodule, connection->dstNodule() );
+						dirtyIndex( connection );
 					}
 				}
 			}
@@ -1316,6 +1388,7 @@ void GraphGadget::addConnectionGadget( Gaffer::Plug *dstPlug )
 	ConnectionGadgetPtr connection = new ConnectionGadget( srcNodule, dstNodule );
 	updateConnectionGadgetMinimisation( connection.get() );
 	addChild( connection );
+	dirtyIndex( connection.get() );
 
 	m_connectionGadgets[dstPlug] = connection.get();
 }
@@ -1344,6 +1417,7 @@ void GraphGadget::removeConnectionGadgets( const Gaffer::GraphComponent *plugPar
 				if( connection )
 				{
 					connection->setNodules( 0, connection->dstNodule() );
+					dirtyIndex( connection );
 				}
 			}
 		}
@@ -1362,6 +1436,7 @@ void GraphGadget::removeConnectionGadget( const Gaffer::Plug *dstPlug )
 	if( connection )
 	{
 		m_connectionGadgets.erase( dstPlug );
+		removeFromIndex( connection );
 		removeChild( connection );
 	}
 }
@@ -1384,4 +1459,153 @@ void GraphGadget::updateConnectionGadgetMinimisation( ConnectionGadget *gadget )
 		minimised = minimised || getNodeOutputConnectionsMinimised( srcNodule->plug()->node() );
 	}
 	gadget->setMinimised( minimised );
+	dirtyIndex( gadget );
+}
+
+void GraphGadget::nodeChildrenChanged( Gaffer::GraphComponent *node, Gaffer::GraphComponent *child )
+{
+	// adding or removing plugs may change the size
+	// of the NodeGadget.
+	if( NodeGadget *nodeGadget = findNodeGadget( static_cast<Gaffer::Node *>( node ) ) )
+	{
+		dirtyIndex( nodeGadget, true );
+	}
+}
+
+void GraphGadget::nodeNameChanged( Gaffer::GraphComponent *node )
+{
+	// the name is displayed on the NodeGadget, so
+	// renaming may change its size.
+	if( NodeGadget *nodeGadget = findNodeGadget( static_cast<Gaffer::Node *>( node ) ) )
+	{
+		dirtyIndex( nodeGadget, true );
+	}
+}
+
+void GraphGadget::dirtyIndex( Gadget *gadget )
+{
+	IndexEntryMap::iterator it = m_indexEntries.find( gadget );
+	if( it == m_indexEntries.end() )
+	{
+		IndexEntry entry;
+		entry.large = false;
+		entry.order = m_nextIndexOrder++;
+		m_indexEntries.insert( IndexEntryMap::value_type( gadget, entry ) );
+	}
+	m_dirtyIndexGadgets.insert( gadget );
+}
+
+void GraphGadget::dirtyIndex( const NodeGadget *nodeGadget, bool includeConnections )
+{
+	dirtyIndex( const_cast<NodeGadget *>( nodeGadget ) );
+	if( includeConnections )
+	{
+		std::vector<ConnectionGadget *> connections;
+		connectionGadgets( nodeGadget->node(), connections );
+		for( std::vector<ConnectionGadget *>::const_iterator it = connections.begin(), eIt = connections.end(); it != eIt; ++it )
+		{
+			dirtyIndex( *it );
+		}
+	}
+}
+
+void GraphGadget::removeFromIndex( Gadget *gadget )
+{
+	unindexGadget( gadget );
+	m_indexEntries.erase( gadget );
+	m_dirtyIndexGadgets.erase( gadget );
+}
+
+void GraphGadget::updateIndex() const
+{
+	for( std::set<Gadget *>::const_iterator it = m_dirtyIndexGadgets.begin(), eIt = m_dirtyIndexGadgets.end(); it != eIt; ++it )
+	{
+		unindexGadget( *it );
+		indexGadget( *it );
+	}
+	m_dirtyIndexGadgets.clear();
+}
+
+void GraphGadget::indexGadget( Gadget *gadget ) const
+{
+	IndexEntryMap::iterator it = m_indexEntries.find( gadget );
+	if( it == m_indexEntries.end() )
+	{
+		return;
+	}
+	IndexEntry &entry = it->second;
+	
+	Box3f bound;
+	if( const ConnectionGadget *connectionGadget = runTimeCast<ConnectionGadget>( gadget ) )
+	{
+		bound = transform( connectionGadget->curveBound(), connectionGadget->getTransform() );
+	}
+	else
+	{
+		bound = gadget->transformedBound( this );
+	}
+	
+	if( bound.isEmpty() )
+	{
+		entry.bound = Box2f();
+		return;
+	}
+	
+	entry.bound = Box2f( V2f( bound.min.x, bound.min.y ), V2f( bound.max.x, bound.max.y ) );
+	const Box2i cells(
+		V2i( (int)floorf( bound.min.x / g_indexCellSize ), (int)floorf( bound.min.y / g_indexCellSize ) ),
+		V2i( (int)floorf( bound.max.x / g_indexCellSize ), (int)floorf( bound.max.y / g_indexCellSize ) )
+	);
+	
+	if( ( cells.size().x + 1 ) * ( cells.size().y + 1 ) > g_maxIndexCells )
+	{
+		entry.large = true;
+		m_largeIndexedGadgets.insert( gadget );
+		return;
+	}
+	
+	entry.cells = cells;
+	for( int y = cells.min.y; y <= cells.max.y; ++y )
+	{
+		for( int x = cells.min.x; x <= cells.max.x; ++x )
+		{
+			m_indexCells[IndexCell( x, y )].push_back( gadget );
+		}
+	}
+}
+
+void GraphGadget::unindexGadget( Gadget *gadget ) const
+{
+	IndexEntryMap::iterator it = m_indexEntries.find( gadget );
+	if( it == m_indexEntries.end() )
+	{
+		return;
+	}
+	IndexEntry &entry = it->second;
+
+	if( entry.large )
+	{
+		m_largeIndexedGadgets.erase( gadget );
+		entry.large = false;
+	}
+	
+	for( int y = entry.cells.min.y; y <= entry.cells.max.y; ++y )
+	{
+		for( int x = entry.cells.min.x; x <= entry.cells.max.x; ++x )
+		{
+			IndexCellMap::iterator cIt = m_indexCells.find( IndexCell( x, y ) );
+			if( cIt == m_indexCells.end() )
+			{
+				continue;
+			}
+			std::vector<Gadget *> &cellGadgets = cIt->second;
+			cellGadgets.erase( std::remove( cellGadgets.begin(), cellGadgets.end(), gadget ), cellGadgets.end() );
+			if( cellGadgets.empty() )
+			{
+				m_indexCells.erase( cIt );
+			}
+		}
+	}
+	entry.cells = Box2i();
+	entry.bound = Box2f();
 }
@@ -56,14 +56,14 @@ ObjectView::ObjectView( const std::string &name )
 	viewportGadget()->setChild( m_renderableGadget );
 }
 
-void ObjectView::update()
+Gaffer::ObjectPlug *ObjectView::objectPlug()
 {
-	ConstVisibleRenderablePtr renderable = 0;
-	{
-		Context::Scope context( getContext() );
-		renderable = runTimeCast<const VisibleRenderable>( View3D::preprocessedInPlug<ObjectPlug>()->getValue() );
-	}
+	return View3D::preprocessedInPlug<ObjectPlug>();
+}
 
+void ObjectView::setObject( IECore::ConstObjectPtr object )
+{
+	ConstVisibleRenderablePtr renderable = runTimeCast<const VisibleRenderable>( object );
 	bool hadRenderable = m_renderableGadget->getRenderable();
 	m_renderableGadget->setRenderable( renderable );
 	if( !hadRenderable && renderable )
@@ -71,3 +71,13 @@ void ObjectView::update()
 		viewportGadget()->frame( m_renderableGadget->bound() );
 	}
 }
+
+void ObjectView::update()
+{
+	ConstObjectPtr object = 0;
+	{
+		Context::Scope context( getContext() );
+		object = objectPlug()->getValue();
+	}
+	setObject( object );
+}
@@ -101,6 +101,10 @@ Imath::Box3f RenderableGadget::bound() const
 	{
 		return m_renderable->bound();
 	}
+	else if( m_scene )
+	{
+		return m_scene->root()->bound();
+	}
 	else
 	{
 		return Imath::Box3f();
@@ -139,7 +143,7 @@ void RenderableGadget::doRender( const Style *style ) const
 
 void RenderableGadget::setRenderable( IECore::ConstVisibleRenderablePtr renderable )
 {
-	if( renderable!=m_renderable )
+	if( renderable!=m_renderable || ( !renderable && m_scene ) )
 	{
 		m_renderable = renderable;
 		m_scene = 0;
@@ -164,13 +168,59 @@ IECore::ConstVisibleRenderablePtr RenderableGadget::getRenderable() const
 	return m_renderable;
 }
 
+void RenderableGadget::setScene( IECoreGL::ScenePtr scene )
+{
+	m_renderable = 0;
+	m_scene = scene;
+	if( m_scene )
+	{
+		m_scene->setCamera( 0 );
+		applySelection();
+	}
+	renderRequestSignal()( this );
+}
+
+IECoreGL::Scene *RenderableGadget::getScene()
+{
+	return m_scene.get();
+}
+
+const IECoreGL::Scene *RenderableGadget::getScene() const
+{
+	return m_scene.get();
+}
+
 IECoreGL::State *RenderableGadget::baseState()
 {
 	return m_baseState.get();
 }
 
+RenderableGadget::Picker::~Picker()
+{
+}
+
+void RenderableGadget::setPicker( PickerPtr picker )
+{
+	m_picker = picker;
+}
+
+RenderableGadget::Picker *RenderableGadget::getPicker()
+{
+	return m_picker.get();
+}
+
+const RenderableGadget::Picker *RenderableGadget::getPicker() const
+{
+	return m_picker.get();
+}
+
 std::string RenderableGadget::objectAt( const IECore::LineSegment3f &lineInGadgetSpace ) const
 {	
+	if( m_picker )
+	{
+		return m_picker->objectAt( lineInGadgetSpace );
+	}
+	
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( lineInGadgetSpace, this, selection, IECoreGL::Selector::IDRender );
@@ -186,6 +236,24 @@ std::string RenderableGadget::objectAt( const IECore::LineSegment3f &lineInGadge
 
 size_t RenderableGadget::objectsAt( const Imath::V3f &corner0InGadgetSpace, const Imath::V3f &corner1InGadgetSpace, std::vector<std::string> &objectNames ) const
 {
+	if( m_picker )
+	{
+		// make lines through the four corners of the rectangle in raster space
+		const ViewportGadget *viewportGadget = ancestor<ViewportGadget>();
+		Box2f rasterRegion;
+		rasterRegion.extendBy( viewportGadget->gadgetToRasterSpace( corner0InGadgetSpace, this ) );
+		rasterRegion.extendBy( viewportGadget->gadgetToRasterSpace( corner1InGadgetSpace, this ) );
+		
+		std::vector<IECore::LineSegment3f> cornerLines;
+		cornerLines.push_back( viewportGadget->rasterToGadgetSpace( rasterRegion.min, this ) );
+		cornerLines.push_back( viewportGadget->rasterToGadgetSpace( V2f( rasterRegion.max.x, rasterRegion.min.y ), this ) );
+		cornerLines.push_back( viewportGadget->rasterToGadgetSpace( rasterRegion.max, this ) );
+		cornerLines.push_back( viewportGadget->rasterToGadgetSpace( V2f( rasterRegion.min.x, rasterRegion.max.y ), this ) );
+		
+		m_picker->objectsAt( cornerLines, objectNames );
+		return objectNames.size();
+	}
+
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( corner0InGadgetSpace, corner1InGadgetSpace, this, selection, IECoreGL::Selector::OcclusionQuery );
@@ -35,11 +35,21 @@
 //  
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <climits>
+#include <map>
+
+#include "boost/format.hpp"
+
 #include "OpenEXR/ImathVec.h"
 
+#include "IECore/Exception.h"
+
 #include "Gaffer/Plug.h"
 #include "Gaffer/PlugIterator.h"
 #include "Gaffer/DependencyNode.h"
+#include "Gaffer/ScriptNode.h"
+#include "Gaffer/UndoContext.h"
 
 #include "GafferUI/StandardGraphLayout.h"
 #include "GafferUI/GraphGadget.h"
@@ -239,6 +249,536 @@ void StandardGraphLayout::positionNodes( GraphGadget *graph, Gaffer::Set *nodes,
 	
 }
 
+void StandardGraphLayout::layoutNodes( GraphGadget *graph, Gaffer::Set *nodes ) const
+{
+	Adjacency graphAdjacency;
+	std::vector<Node *> graphNodes;
+	if( !adjacency( graph, nodes, graphAdjacency, graphNodes ) )
+	{
+		return;
+	}
+	
+	std::vector<V2f> positions;
+	layeredPositions( graphAdjacency, positions );
+	
+	// offset the layout so that the centroid of the nodes stays where it was
+	
+	V2f oldCentroid( 0 ), newCentroid( 0 );
+	for( size_t i = 0, e = graphNodes.size(); i < e; ++i )
+	{
+		oldCentroid += graph->getNodePosition( graphNodes[i] );
+		newCentroid += positions[i];
+	}
+	const V2f offset = ( oldCentroid - newCentroid ) / graphNodes.size();
+	
+	Node *root = graph->getRoot();
+	ScriptNode *script = IECore::runTimeCast<ScriptNode>( root );
+	if( !script )
+	{
+		script = root->scriptNode();
+	}
+	
+	UndoContext undoContext( script );
+	for( size_t i = 0, e = graphNodes.size(); i < e; ++i )
+	{
+		graph->setNodePosition( graphNodes[i], positions[i] + offset );
+	}
+}
+
+size_t StandardGraphLayout::adjacency( GraphGadget *graph, Gaffer::Set *nodes, Adjacency &adjacency, std::vector<Gaffer::Node *> &nodesOut ) const
+{
+	adjacency.sizes.clear();
+	adjacency.edges.clear();
+	nodesOut.clear();
+	
+	std::map<const Node *, size_t> indices;
+	if( nodes )
+	{
+		for( size_t i = 0, s = nodes->size(); i < s; ++i )
+		{
+			Node *node = IECore::runTimeCast<Node>( nodes->member( i ) );
+			if( node && graph->nodeGadget( node ) && indices.insert( std::pair<const Node *, size_t>( node, nodesOut.size() ) ).second )
+			{
+				nodesOut.push_back( node );
+			}
+		}
+	}
+	else
+	{
+		for( NodeIterator it( graph->getRoot() ); it != it.end(); ++it )
+		{
+			if( graph->nodeGadget( it->get() ) )
+			{
+				indices[it->get()] = nodesOut.size();
+				nodesOut.push_back( it->get() );
+			}
+		}
+	}
+	
+	for( size_t i = 0, e = nodesOut.size(); i < e; ++i )
+	{
+		Node *node = nodesOut[i];
+		NodeGadget *nodeGadget = graph->nodeGadget( node );
+		
+		const Box3f bound = nodeGadget->bound();
+		adjacency.sizes.push_back( bound.isEmpty() ? V2f( 0 ) : V2f( bound.size().x, bound.size().y ) );
+		
+		for( RecursiveInputPlugIterator it( node ); it != it.end(); ++it )
+		{
+			const Plug *input = (*it)->getInput<Plug>();
+			if( !input || !nodeGadget->nodule( it->get() ) )
+			{
+				continue;
+			}
+			std::map<const Node *, size_t>::const_iterator sIt = indices.find( input->node() );
+			if( sIt != indices.end() && sIt->second != i )
+			{
+				adjacency.edges.push_back( std::pair<size_t, size_t>( sIt->second, i ) );
+			}
+		}
+	}
+	
+	return nodesOut.size();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Layered layout utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const float g_horizontalSpacing = 1.0f;
+const float g_verticalSpacing = 3.0f;
+const int g_numOrderingSweeps = 12;
+const int g_numPlacementSweeps = 8;
+// vertices inserted along long connections are weighted more heavily
+// during placement, so that long connections are drawn straight.
+const float g_dummyVertexWeight = 4.0f;
+
+typedef std::vector<std::vector<size_t> > Neighbours;
+typedef std::vector<std::vector<size_t> > Layers;
+
+// Sorts a layer according to the mean rank of each vertex's neighbours
+// in the adjacent layer, updating the ranks to match. Vertices without
+// neighbours keep their current rank.
+void orderLayer( std::vector<size_t> &layer, const Neighbours &neighbours, std::vector<size_t> &rank )
+{
+	std::vector<std::pair<float, size_t> > keys;
+	keys.reserve( layer.size() );
+	for( size_t i = 0, e = layer.size(); i < e; ++i )
+	{
+		const std::vector<size_t> &n = neighbours[layer[i]];
+		float key = rank[layer[i]];
+		if( n.size() )
+		{
+			float sum = 0;
+			for( std::vector<size_t>::const_iterator it = n.begin(), eIt = n.end(); it != eIt; ++it )
+			{
+				sum += rank[*it];
+			}
+			key = sum / n.size();
+		}
+		keys.push_back( std::pair<float, size_t>( key, i ) );
+	}
+	
+	// the position in the layer is used to break ties,
+	// so equal vertices keep their current order.
+	std::sort( keys.begin(), keys.end() );
+	
+	std::vector<size_t> sorted( layer.size() );
+	for( size_t i = 0, e = keys.size(); i < e; ++i )
+	{
+		sorted[i] = layer[keys[i].second];
+		rank[sorted[i]] = i;
+	}
+	layer.swap( sorted );
+}
+
+// Counts the crossings between the connections from upperLayer to the layer
+// below it. Listing the connections in order of upper rank then lower rank, the
+// crossings are the inversions in the sequence of lower ranks, which we count
+// with a Fenwick tree in O( E log V ).
+size_t countCrossings( const std::vector<size_t> &upperLayer, const Neighbours &down, const std::vector<size_t> &rank, size_t lowerLayerSize )
+{
+	std::vector<size_t> lowerRanks;
+	for( std::vector<size_t>::const_iterator it = upperLayer.begin(), eIt = upperLayer.end(); it != eIt; ++it )
+	{
+		const size_t start = lowerRanks.size();
+		const std::vector<size_t> &n = down[*it];
+		for( std::vector<size_t>::const_iterator nIt = n.begin(), neIt = n.end(); nIt != neIt; ++nIt )
+		{
+			lowerRanks.push_back( rank[*nIt] );
+		}
+		std::sort( lowerRanks.begin() + start, lowerRanks.end() );
+	}
+	
+	std::vector<size_t> tree( lowerLayerSize + 1, 0 );
+	size_t result = 0;
+	for( size_t i = 0, e = lowerRanks.size(); i < e; ++i )
+	{
+		size_t numLessOrEqual = 0;
+		for( size_t j = lowerRanks[i] + 1; j > 0; j -= j & -j )
+		{
+			numLessOrEqual += tree[j];
+		}
+		result += i - numLessOrEqual;
+		for( size_t j = lowerRanks[i] + 1; j <= lowerLayerSize; j += j & -j )
+		{
+			tree[j]++;
+		}
+	}
+	
+	return result;
+}
+
+size_t countCrossings( const Layers &layers, const Neighbours &down, const std::vector<size_t> &rank )
+{
+	size_t result = 0;
+	for( size_t l = 0; l + 1 < layers.size(); ++l )
+	{
+		result += countCrossings( layers[l], down, rank, layers[l+1].size() );
+	}
+	return result;
+}
+
+struct PlacementBlock
+{
+	float weightedSum;
+	float weight;
+	size_t size;
+};
+
+// Positions the vertices of a layer as close as possible (in the least squares
+// sense) to the mean position of their neighbours, while preserving their order
+// and keeping them separated by their widths plus the spacing. Subtracting the
+// minimum offset of each vertex from the start of the layer turns this into
+// an isotonic regression, which we solve in linear time using the pool adjacent
+// violators algorithm.
+void placeLayer( const std::vector<size_t> &layer, const Neighbours &neighbours, const std::vector<float> &widths, const std::vector<float> &weights, std::vector<float> &x )
+{
+	std::vector<float> offsets( layer.size(), 0.0f );
+	std::vector<PlacementBlock> blocks;
+	blocks.reserve( layer.size() );
+	for( size_t i = 0, e = layer.size(); i < e; ++i )
+	{
+		const size_t v = layer[i];
+		if( i )
+		{
+			offsets[i] = offsets[i-1] + ( widths[layer[i-1]] + widths[v] ) / 2.0f + g_horizontalSpacing;
+		}
+		
+		float desired = x[v];
+		const std::vector<size_t> &n = neighbours[v];
+		if( n.size() )
+		{
+			desired = 0;
+			for( std::vector<size_t>::const_iterator it = n.begin(), eIt = n.end(); it != eIt; ++it )
+			{
+				desired += x[*it];
+			}
+			desired /= n.size();
+		}
+		
+		PlacementBlock block = { weights[v] * ( desired - offsets[i] ), weights[v], 1 };
+		blocks.push_back( block );
+		while( blocks.size() > 1 )
+		{
+			PlacementBlock &previous = blocks[blocks.size()-2];
+			const PlacementBlock &last = blocks.back();
+			if( previous.weightedSum / previous.weight < last.weightedSum / last.weight )
+			{
+				break;
+			}
+			previous.weightedSum += last.weightedSum;
+			previous.weight += last.weight;
+			previous.size += last.size;
+			blocks.pop_back();
+		}
+	}
+	
+	size_t i = 0;
+	for( std::vector<PlacementBlock>::const_iterator it = blocks.begin(), eIt = blocks.end(); it != eIt; ++it )
+	{
+		const float position = it->weightedSum / it->weight;
+		for( size_t j = 0; j < it->size; ++j, ++i )
+		{
+			x[layer[i]] = position + offsets[i];
+		}
+	}
+}
+
+} // namespace
+
+void StandardGraphLayout::layeredPositions( const Adjacency &adjacency, std::vector<Imath::V2f> &positions )
+{
+	const size_t numNodes = adjacency.sizes.size();
+	positions.resize( numNodes );
+	if( !numNodes )
+	{
+		return;
+	}
+	
+	Neighbours successors( numNodes );
+	std::vector<size_t> inDegree( numNodes, 0 );
+	for( std::vector<std::pair<size_t, size_t> >::const_iterator it = adjacency.edges.begin(), eIt = adjacency.edges.end(); it != eIt; ++it )
+	{
+		if( it->first >= numNodes || it->second >= numNodes )
+		{
+			throw IECore::Exception( boost::str( boost::format( "Edge ( %d, %d ) references a node out of range" ) % it->first % it->second ) );
+		}
+		if( it->first != it->second )
+		{
+			successors[it->first].push_back( it->second );
+			inDegree[it->second]++;
+		}
+	}
+	
+	// find a topological ordering of the nodes. if we find a cycle
+	// we break it by visiting the first unvisited node.
+	
+	std::vector<size_t> order;
+	order.reserve( numNodes );
+	std::vector<size_t> orderIndex( numNodes, numNodes ); // numNodes means unvisited
+	std::vector<size_t> toVisit;
+	for( size_t v = numNodes; v > 0; --v )
+	{
+		if( !inDegree[v-1] )
+		{
+			toVisit.push_back( v - 1 );
+		}
+	}
+	
+	size_t nextUnvisited = 0;
+	while( order.size() < numNodes )
+	{
+		if( toVisit.empty() )
+		{
+			while( orderIndex[nextUnvisited] != numNodes )
+			{
+				nextUnvisited++;
+			}
+			toVisit.push_back( nextUnvisited );
+		}
+		
+		const size_t v = toVisit.back();
+		toVisit.pop_back();
+		if( orderIndex[v] != numNodes )
+		{
+			continue;
+		}
+		
+		orderIndex[v] = order.size();
+		order.push_back( v );
+		for( std::vector<size_t>::const_iterator it = successors[v].begin(), eIt = successors[v].end(); it != eIt; ++it )
+		{
+			if( orderIndex[*it] == numNodes && --inDegree[*it] == 0 )
+			{
+				toVisit.push_back( *it );
+			}
+		}
+	}
+	
+	// orient all edges to agree with the ordering, so cycles are broken
+	// by reversing an edge, and remove duplicates.
+	
+	Neighbours forwardSuccessors( numNodes ), forwardPredecessors( numNodes );
+	for( size_t v = 0; v < numNodes; ++v )
+	{
+		for( std::vector<size_t>::const_iterator it = successors[v].begin(), eIt = successors[v].end(); it != eIt; ++it )
+		{
+			if( orderIndex[v] < orderIndex[*it] )
+			{
+				forwardSuccessors[v].push_back( *it );
+			}
+			else
+			{
+				forwardSuccessors[*it].push_back( v );
+			}
+		}
+	}
+	for( size_t v = 0; v < numNodes; ++v )
+	{
+		std::vector<size_t> &s = forwardSuccessors[v];
+		std::sort( s.begin(), s.end() );
+		s.erase( std::unique( s.begin(), s.end() ), s.end() );
+		for( std::vector<size_t>::const_iterator it = s.begin(), eIt = s.end(); it != eIt; ++it )
+		{
+			forwardPredecessors[*it].push_back( v );
+		}
+	}
+	
+	// assign layers using the longest path from the sources, and then pull
+	// nodes down to sit directly above their nearest successor, so sources
+	// feeding only deep nodes don't have needlessly long connections.
+	
+	std::vector<int> layer( numNodes, 0 );
+	for( std::vector<size_t>::const_iterator it = order.begin(), eIt = order.end(); it != eIt; ++it )
+	{
+		const std::vector<size_t> &p = forwardPredecessors[*it];
+		for( std::vector<size_t>::const_iterator pIt = p.begin(), peIt = p.end(); pIt != peIt; ++pIt )
+		{
+			layer[*it] = std::max( layer[*it], layer[*pIt] + 1 );
+		}
+	}
+	
+	for( std::vector<size_t>::const_reverse_iterator it = order.rbegin(), eIt = order.rend(); it != eIt; ++it )
+	{
+		const std::vector<size_t> &s = forwardSuccessors[*it];
+		if( s.empty() )
+		{
+			continue;
+		}
+		int l = INT_MAX;
+		for( std::vector<size_t>::const_iterator sIt = s.begin(), seIt = s.end(); sIt != seIt; ++sIt )
+		{
+			l = std::min( l, layer[*sIt] - 1 );
+		}
+		layer[*it] = l;
+	}
+	
+	const size_t numLayers = *std::max_element( layer.begin(), layer.end() ) + 1;
+	
+	// insert dummy vertices along edges spanning more than one layer,
+	// so that all edges connect adjacent layers. vertices numbered
+	// numNodes and above are dummies.
+	
+	std::vector<int> vertexLayer( layer.begin(), layer.end() );
+	Neighbours up( numNodes ), down( numNodes );
+	for( std::vector<size_t>::const_iterator it = order.begin(), eIt = order.end(); it != eIt; ++it )
+	{
+		const std::vector<size_t> &s = forwardSuccessors[*it];
+		for( std::vector<size_t>::const_iterator sIt = s.begin(), seIt = s.end(); sIt != seIt; ++sIt )
+		{
+			size_t previous = *it;
+			for( int l = layer[*it] + 1; l < layer[*sIt]; ++l )
+			{
+				const size_t dummy = vertexLayer.size();
+				vertexLayer.push_back( l );
+				up.push_back( std::vector<size_t>( 1, previous ) );
+				down.push_back( std::vector<size_t>() );
+				down[previous].push_back( dummy );
+				previous = dummy;
+			}
+			down[previous].push_back( *sIt );
+			up[*sIt].push_back( previous );
+		}
+	}
+	
+	const size_t numVertices = vertexLayer.size();
+	
+	// order the vertices within each layer to reduce crossings, sweeping
+	// down and up the layers and keeping the best ordering found.
+	
+	Layers layers( numLayers );
+	std::vector<size_t> rank( numVertices );
+	for( std::vector<size_t>::const_iterator it = order.begin(), eIt = order.end(); it != eIt; ++it )
+	{
+		rank[*it] = layers[layer[*it]].size();
+		layers[layer[*it]].push_back( *it );
+	}
+	for( size_t v = numNodes; v < numVertices; ++v )
+	{
+		rank[v] = layers[vertexLayer[v]].size();
+		layers[vertexLayer[v]].push_back( v );
+	}
+	
+	Layers bestLayers = layers;
+	size_t bestCrossings = countCrossings( layers, down, rank );
+	for( int i = 0; i < g_numOrderingSweeps && bestCrossings; ++i )
+	{
+		if( i % 2 == 0 )
+		{
+			for( size_t l = 1; l < numLayers; ++l )
+			{
+				orderLayer( layers[l], up, rank );
+			}
+		}
+		else
+		{
+			for( size_t l = numLayers - 1; l > 0; --l )
+			{
+				orderLayer( layers[l-1], down, rank );
+			}
+		}
+		
+		const size_t crossings = countCrossings( layers, down, rank );
+		if( crossings < bestCrossings )
+		{
+			bestCrossings = crossings;
+			bestLayers = layers;
+		}
+	}
+	layers.swap( bestLayers );
+	
+	// assign horizontal positions, by sweeping down and up the layers
+	// placing each vertex as close as possible to its neighbours in the
+	// previous layer, and finishing with a pass which considers the
+	// neighbours on both sides.
+	
+	std::vector<float> widths( numVertices, 0.0f );
+	std::vector<float> weights( numVertices, g_dummyVertexWeight );
+	for( size_t v = 0; v < numNodes; ++v )
+	{
+		widths[v] = adjacency.sizes[v].x;
+		weights[v] = 1.0f;
+	}
+	
+	std::vector<float> x( numVertices, 0.0f );
+	const Neighbours noNeighbours( numVertices );
+	for( size_t l = 0; l < numLayers; ++l )
+	{
+		placeLayer( layers[l], noNeighbours, widths, weights, x );
+	}
+	
+	for( int i = 0; i < g_numPlacementSweeps; ++i )
+	{
+		if( i % 2 == 0 )
+		{
+			for( size_t l = 1; l < numLayers; ++l )
+			{
+				placeLayer( layers[l], up, widths, weights, x );
+			}
+		}
+		else
+		{
+			for( size_t l = numLayers - 1; l > 0; --l )
+			{
+				placeLayer( layers[l-1], down, widths, weights, x );
+			}
+		}
+	}
+	
+	Neighbours allNeighbours( up );
+	for( size_t v = 0; v < numVertices; ++v )
+	{
+		allNeighbours[v].insert( allNeighbours[v].end(), down[v].begin(), down[v].end() );
+	}
+	for( size_t l = 0; l < numLayers; ++l )
+	{
+		placeLayer( layers[l], allNeighbours, widths, weights, x );
+	}
+	
+	// assign vertical positions, with connections flowing from top to bottom.
+	
+	std::vector<float> layerHeights( numLayers, 0.0f );
+	for( size_t v = 0; v < numNodes; ++v )
+	{
+		layerHeights[layer[v]] = std::max( layerHeights[layer[v]], adjacency.sizes[v].y );
+	}
+	
+	std::vector<float> layerY( numLayers, 0.0f );
+	for( size_t l = 1; l < numLayers; ++l )
+	{
+		layerY[l] = layerY[l-1] - ( layerHeights[l-1] / 2.0f + g_verticalSpacing + layerHeights[l] / 2.0f );
+	}
+	
+	for( size_t v = 0; v < numNodes; ++v )
+	{
+		positions[v] = V2f( x[v], layerY[layer[v]] );
+	}
+}
+
 bool StandardGraphLayout::connectNodeInternal( GraphGadget *graph, Gaffer::Node *node, Gaffer::Set *potentialInputs, bool insertIfPossible ) const
 {
 	// we only want to connect plugs which are visible in the ui - otherwise
@@ -70,5 +70,7 @@ void GafferUIBindings::bindConnectionGadget()
 		.def( "setNodules", &ConnectionGadget::setNodules )
 		.def( "setMinimised", &ConnectionGadget::setMinimised )
 		.def( "getMinimised", &ConnectionGadget::getMinimised )
+		.def( "curveBound", &ConnectionGadget::curveBound )
+		.def( "distanceTo", &ConnectionGadget::distanceTo )
 	;
 }
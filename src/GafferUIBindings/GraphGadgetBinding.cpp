@@ -130,6 +130,19 @@ static ConnectionGadgetPtr connectionGadgetAt( GraphGadget &g, const IECore::Lin
 	return g.connectionGadgetAt( lineSegmentInGadgetSpace );
 }
 
+static list gadgetsIntersecting( GraphGadget &g, const Imath::Box2f &box )
+{
+	std::vector<Gadget *> gadgets;
+	g.gadgetsIntersecting( box, gadgets );
+
+	boost::python::list l;
+	for( std::vector<Gadget *>::const_iterator it=gadgets.begin(), eIt=gadgets.end(); it!=eIt; ++it )
+	{
+		l.append( GadgetPtr( *it ) );
+	}
+	return l;
+}
+
 void GafferUIBindings::bindGraphGadget()
 {
 	scope s = IECorePython::RunTimeTypedClass<GraphGadget>()
@@ -154,6 +167,7 @@ void GafferUIBindings::bindGraphGadget()
 		.def( "getLayout", &getLayout )
 		.def( "nodeGadgetAt", &nodeGadgetAt )
 		.def( "connectionGadgetAt", &connectionGadgetAt )
+		.def( "gadgetsIntersecting", &gadgetsIntersecting )
 	;
 
 	GafferBindings::SignalBinder<GraphGadget::GraphGadgetSignal, GafferBindings::DefaultSignalCaller<GraphGadget::GraphGadgetSignal>, GraphGadgetSlotCaller>::bind( "GraphGadgetSignal" );	
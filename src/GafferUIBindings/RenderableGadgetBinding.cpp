@@ -39,6 +39,7 @@
 #include "boost/python/suite/indexing/container_utils.hpp"
 
 #include "IECoreGL/State.h"
+#include "IECoreGL/Scene.h"
 
 #include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/ScopedGILRelease.h"
@@ -77,6 +78,11 @@ static void setRenderable( RenderableGadget &g, IECore::VisibleRenderablePtr ren
 	g.setRenderable( renderable );
 }
 
+static IECoreGL::ScenePtr getScene( RenderableGadget &g )
+{
+	return g.getScene();
+}
+
 static void setSelection( RenderableGadget &g, object pythonSelection )
 {
 	std::vector<std::string> vectorSelection;
@@ -104,6 +110,8 @@ void GafferUIBindings::bindRenderableGadget()
 		.def( "__init__", make_constructor( construct, default_call_policies(), ( boost::python::arg( "renderable" ) = IECore::VisibleRenderablePtr() ) ) )
 		.def( "setRenderable", &setRenderable )
 		.def( "getRenderable", (IECore::VisibleRenderablePtr (RenderableGadget::*)())&RenderableGadget::getRenderable )
+		.def( "setScene", &RenderableGadget::setScene )
+		.def( "getScene", &getScene )
 		.def( "baseState", &baseState )
 		.def( "objectAt", &RenderableGadget::objectAt )
 		.def( "setSelection", &setSelection )
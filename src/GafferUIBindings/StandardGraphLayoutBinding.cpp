@@ -39,15 +39,53 @@
 #include "GafferUIBindings/StandardGraphLayoutBinding.h"
 #include "GafferUI/StandardGraphLayout.h"
 
+#include "IECore/VectorTypedData.h"
+#include "IECore/Exception.h"
+
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/Set.h"
+
+#include "GafferUI/GraphGadget.h"
 
 using namespace boost::python;
 using namespace GafferUIBindings;
 using namespace GafferUI;
 
+static void layoutNodes( StandardGraphLayout &layout, GraphGadget &graph, Gaffer::Set *nodes )
+{
+	layout.layoutNodes( &graph, nodes );
+}
+
+static IECore::V2fVectorDataPtr layeredPositions( const IECore::V2fVectorData *sizes, const IECore::V2iVectorData *edges )
+{
+	StandardGraphLayout::Adjacency adjacency;
+	adjacency.sizes = sizes->readable();
+	const std::vector<Imath::V2i> &e = edges->readable();
+	for( std::vector<Imath::V2i>::const_iterator it = e.begin(), eIt = e.end(); it != eIt; ++it )
+	{
+		if( it->x < 0 || it->y < 0 )
+		{
+			throw IECore::Exception( "Edges must not contain negative indices" );
+		}
+		adjacency.edges.push_back( std::pair<size_t, size_t>( it->x, it->y ) );
+	}
+	
+	IECore::V2fVectorDataPtr result = new IECore::V2fVectorData;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		StandardGraphLayout::layeredPositions( adjacency, result->writable() );
+	}
+	return result;
+}
+
 void GafferUIBindings::bindStandardGraphLayout()
 {
 	IECorePython::RunTimeTypedClass<StandardGraphLayout>()
 		.def( init<>() )
+		.def( "layoutNodes", &layoutNodes, ( arg_( "graph" ), arg_( "nodes" ) = object() ) )
+		.def( "layeredPositions", &layeredPositions, ( arg_( "sizes" ), arg_( "edges" ) ) )
+		.staticmethod( "layeredPositions" )
 	;
 }
@@ -102,6 +102,11 @@ static void registerView2( IECore::TypeId nodeType, const std::string &plugPath,
 	View::registerView( nodeType, plugPath, ViewCreator( creator ) );
 }
 
+static ObjectPlugPtr objectPlug( ObjectView &v )
+{
+	return v.objectPlug();
+}
+
 Gaffer::NodePtr GafferUIBindings::getPreprocessor( View &v )
 {
 	return v.getPreprocessor<Node>();
@@ -129,6 +134,9 @@ void GafferUIBindings::bindView()
 	typedef GafferBindings::NodeWrapper<ObjectView> ObjectViewWrapper;
 	IE_CORE_DECLAREPTR( ObjectViewWrapper );
 	
-	GafferBindings::NodeClass<ObjectView, ObjectViewWrapperPtr>();
+	GafferBindings::NodeClass<ObjectView, ObjectViewWrapperPtr>()
+		.def( "objectPlug", &objectPlug )
+		.def( "setObject", &ObjectView::setObject )
+	;
 	
 }
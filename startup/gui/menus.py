@@ -190,6 +190,7 @@ nodeMenu.append( "/Image/Color/Grade", GafferImage.Grade )
 nodeMenu.append( "/Image/Color/OpenColorIO", GafferImage.OpenColorIO, searchText = "OpenColorIO" )
 nodeMenu.append( "/Image/Color/RemoveChannels", GafferImage.RemoveChannels )
 nodeMenu.append( "/Image/Filter/Merge", GafferImage.Merge )
+nodeMenu.append( "/Image/Filter/MipMap", GafferImage.MipMap )
 nodeMenu.append( "/Image/Filter/Reformat", GafferImage.Reformat )
 nodeMenu.append( "/Image/Filter/Transform", GafferImage.ImageTransform, searchText = "ImageTransform" )
 nodeMenu.append( "/Image/Utility/Select", GafferImage.Select )